@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFixedSizeSymmetricEigenSolver_h
+#define itkFixedSizeSymmetricEigenSolver_h
+
+#include <type_traits>
+
+namespace itk
+{
+/** \class FixedSizeSymmetricEigenSolver
+ * Eigenvalues and eigenvectors of a small symmetric matrix of size known at compile time,
+ * without any heap allocation.
+ *
+ * The 2x2 case is solved in closed form. Larger sizes use the cyclic Jacobi method, which is
+ * accurate also for (almost) repeated eigenvalues, and converges in a few sweeps for 3x3 matrices.
+ *
+ * The matrix is given by its packed upper triangle, in the order of PackedIndex:
+ * (0,0), (0,1), (1,1), (0,2), (1,2), (2,2), ..., the same than StructureTensor::LowerTriangleToLinearIndex.
+ * The eigenvalues are sorted in ascending order, and the eigenvectors are the columns of
+ * the VSize x VSize row major matrix eigenVectors, in the same order than the eigenvalues.
+ *
+ * ComputeEigenValues skips the eigenvectors, for the 2x2 case and the accumulation of the Jacobi rotations.
+ *
+ * Compute and ComputeEigenValues are static and thread safe.
+ *
+ * \sa StructureTensor
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <unsigned int VSize, typename TValue = double>
+class FixedSizeSymmetricEigenSolver
+{
+public:
+  /** Standard type alias */
+  using Self = FixedSizeSymmetricEigenSolver;
+  using ValueType = TValue;
+
+  static constexpr unsigned int Size = VSize;
+  static constexpr unsigned int NumberOfPackedEntries = VSize * (VSize + 1) / 2;
+
+  /** Position of the entry (r,c) in the packed upper triangle, assuming that r <= c. */
+  static constexpr unsigned int
+  PackedIndex(unsigned int r, unsigned int c)
+  {
+    return r + (c + 1) * c / 2;
+  }
+
+  /** eigenValues holds VSize values, and eigenVectors VSize * VSize. */
+  static void
+  Compute(const ValueType * packedMatrix, ValueType * eigenValues, ValueType * eigenVectors);
+
+  /** Only the eigenvalues. */
+  static void
+  ComputeEigenValues(const ValueType * packedMatrix, ValueType * eigenValues);
+
+private:
+  /** Closed form for 2x2. The eigenvectors are not computed if eigenVectors is nullptr. */
+  static void
+  Compute(const ValueType * packedMatrix, ValueType * eigenValues, ValueType * eigenVectors, std::true_type);
+  /** Cyclic Jacobi. The rotations are not accumulated if eigenVectors is nullptr. */
+  static void
+  Compute(const ValueType * packedMatrix, ValueType * eigenValues, ValueType * eigenVectors, std::false_type);
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFixedSizeSymmetricEigenSolver.hxx"
+#endif
+
+#endif
@@ -0,0 +1,195 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFixedSizeSymmetricEigenSolver_hxx
+#define itkFixedSizeSymmetricEigenSolver_hxx
+
+#include "itkFixedSizeSymmetricEigenSolver.h"
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace itk
+{
+template <unsigned int VSize, typename TValue>
+void
+FixedSizeSymmetricEigenSolver<VSize, TValue>::Compute(const ValueType * packedMatrix,
+                                                      ValueType *       eigenValues,
+                                                      ValueType *       eigenVectors)
+{
+  static_assert(VSize > 1, "FixedSizeSymmetricEigenSolver requires a size greater than 1.");
+  Self::Compute(packedMatrix, eigenValues, eigenVectors, std::integral_constant<bool, VSize == 2>());
+}
+
+template <unsigned int VSize, typename TValue>
+void
+FixedSizeSymmetricEigenSolver<VSize, TValue>::ComputeEigenValues(const ValueType * packedMatrix,
+                                                                 ValueType *       eigenValues)
+{
+  static_assert(VSize > 1, "FixedSizeSymmetricEigenSolver requires a size greater than 1.");
+  Self::Compute(packedMatrix, eigenValues, nullptr, std::integral_constant<bool, VSize == 2>());
+}
+
+template <unsigned int VSize, typename TValue>
+void
+FixedSizeSymmetricEigenSolver<VSize, TValue>::Compute(const ValueType * packedMatrix,
+                                                      ValueType *       eigenValues,
+                                                      ValueType *       eigenVectors,
+                                                      std::true_type)
+{
+  const ValueType a = packedMatrix[0];
+  const ValueType b = packedMatrix[1];
+  const ValueType c = packedMatrix[2];
+  const ValueType mean = (a + c) / 2;
+  const ValueType halfDifference = (a - c) / 2;
+  const ValueType radius = std::hypot(halfDifference, b);
+  eigenValues[0] = mean - radius;
+  eigenValues[1] = mean + radius;
+  if (eigenVectors == nullptr)
+  {
+    return;
+  }
+
+  if (radius == 0)
+  {
+    eigenVectors[0] = 1;
+    eigenVectors[1] = 0;
+    eigenVectors[2] = 0;
+    eigenVectors[3] = 1;
+    return;
+  }
+  // Eigenvector of the largest eigenvalue, from the row of (A - lambda I) with less cancellation.
+  ValueType x;
+  ValueType y;
+  if (halfDifference >= 0)
+  {
+    x = halfDifference + radius;
+    y = b;
+  }
+  else
+  {
+    x = b;
+    y = radius - halfDifference;
+  }
+  const ValueType norm = std::hypot(x, y);
+  x /= norm;
+  y /= norm;
+  eigenVectors[0] = -y;
+  eigenVectors[1] = x;
+  eigenVectors[2] = x;
+  eigenVectors[3] = y;
+}
+
+template <unsigned int VSize, typename TValue>
+void
+FixedSizeSymmetricEigenSolver<VSize, TValue>::Compute(const ValueType * packedMatrix,
+                                                      ValueType *       eigenValues,
+                                                      ValueType *       eigenVectors,
+                                                      std::false_type)
+{
+  constexpr unsigned int maxSweeps = 50;
+
+  ValueType a[VSize][VSize];
+  for (unsigned int c = 0; c < VSize; ++c)
+  {
+    for (unsigned int r = 0; r <= c; ++r)
+    {
+      a[r][c] = a[c][r] = packedMatrix[PackedIndex(r, c)];
+    }
+    for (unsigned int r = 0; eigenVectors != nullptr && r < VSize; ++r)
+    {
+      eigenVectors[r * VSize + c] = (r == c) ? 1 : 0;
+    }
+  }
+
+  const ValueType epsilon = std::numeric_limits<ValueType>::epsilon();
+  for (unsigned int sweep = 0; sweep < maxSweeps; ++sweep)
+  {
+    ValueType diagonalNorm = 0;
+    ValueType offDiagonalNorm = 0;
+    for (unsigned int p = 0; p < VSize; ++p)
+    {
+      diagonalNorm += a[p][p] * a[p][p];
+      for (unsigned int q = p + 1; q < VSize; ++q)
+      {
+        offDiagonalNorm += a[p][q] * a[p][q];
+      }
+    }
+    if (offDiagonalNorm <= epsilon * epsilon * diagonalNorm || offDiagonalNorm == 0)
+    {
+      break;
+    }
+
+    for (unsigned int p = 0; p < VSize - 1; ++p)
+    {
+      for (unsigned int q = p + 1; q < VSize; ++q)
+      {
+        if (a[p][q] == 0)
+        {
+          continue;
+        }
+        // Rotation in the plane (p,q) that zeroes a[p][q]: A = J^T A J.
+        const ValueType theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+        const ValueType t = (theta >= 0 ? 1 : -1) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+        const ValueType cosine = 1 / std::sqrt(t * t + 1);
+        const ValueType sine = t * cosine;
+        for (unsigned int k = 0; k < VSize; ++k)
+        {
+          const ValueType akp = a[k][p];
+          const ValueType akq = a[k][q];
+          a[k][p] = cosine * akp - sine * akq;
+          a[k][q] = sine * akp + cosine * akq;
+        }
+        for (unsigned int k = 0; k < VSize; ++k)
+        {
+          const ValueType apk = a[p][k];
+          const ValueType aqk = a[q][k];
+          a[p][k] = cosine * apk - sine * aqk;
+          a[q][k] = sine * apk + cosine * aqk;
+        }
+        a[p][q] = a[q][p] = 0;
+        for (unsigned int k = 0; eigenVectors != nullptr && k < VSize; ++k)
+        {
+          ValueType &     vkp = eigenVectors[k * VSize + p];
+          ValueType &     vkq = eigenVectors[k * VSize + q];
+          const ValueType oldVkp = vkp;
+          vkp = cosine * oldVkp - sine * vkq;
+          vkq = sine * oldVkp + cosine * vkq;
+        }
+      }
+    }
+  }
+
+  // Sort in ascending order of the eigenvalues, swapping the columns of the eigenvectors.
+  for (unsigned int k = 0; k < VSize; ++k)
+  {
+    eigenValues[k] = a[k][k];
+  }
+  for (unsigned int k = 1; k < VSize; ++k)
+  {
+    for (unsigned int j = k; j > 0 && eigenValues[j] < eigenValues[j - 1]; --j)
+    {
+      std::swap(eigenValues[j], eigenValues[j - 1]);
+      for (unsigned int r = 0; eigenVectors != nullptr && r < VSize; ++r)
+      {
+        std::swap(eigenVectors[r * VSize + j], eigenVectors[r * VSize + j - 1]);
+      }
+    }
+  }
+}
+} // end namespace itk
+#endif
@@ -19,6 +19,7 @@
 #define itkFrequencyExpandImageFilter_h
 
 #include <itkImageToImageFilter.h>
+#include <vector>
 
 namespace itk
 {
@@ -92,6 +93,12 @@ namespace itk
  * I(N/2) == I((N+1)/2) if N=odd. Nyquist has pos and neg components.
  *
  * Note that this filter doesn't require the input to be hermitian.
+ *
+ * With HalfHermitian on, input and output are in the half-Hermitian layout of
+ * RealToHalfHermitianForwardFFTImageFilter: only the bins 0 to N/2 of the first dimension are stored,
+ * where N is the size of the full spectrum, given by the stored size and ActualXDimensionIsOdd.
+ * The output is the first half of the output of the full spectrum,
+ * the bins not stored in the input are read from their hermitian mirror.
 
  * This code was contributed in the Insight Journal paper:
  * https://hdl.handle.net....
@@ -126,6 +133,7 @@ public:
   using ImageType = typename Superclass::InputImageType;
   using PixelType = typename ImageType::PixelType;
   using ImagePointer = typename ImageType::Pointer;
+  using IndexType = typename ImageType::IndexType;
 
   /** The type of the expand factors representation */
   using ExpandFactorsType = FixedArray<unsigned int, ImageDimension>;
@@ -139,6 +147,25 @@ public:
   /** Get the expand factors. */
   itkGetConstReferenceMacro(ExpandFactors, ExpandFactorsType);
 
+  /** Flag to use input and output in the half-Hermitian layout. Default: false. */
+  itkGetConstReferenceMacro(HalfHermitian, bool);
+  itkSetMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+
+  /** The size of the first dimension of the full spectrum of the input is odd.
+   * Only used with HalfHermitian. The output is odd if the input is odd and ExpandFactors[0] is odd.
+   * Default: false. */
+  itkGetConstReferenceMacro(ActualXDimensionIsOdd, bool);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
+  /** Flag to multiply the output by the product of the ExpandFactors (ScaleFactor^ImageDimension
+   * with the same factor in all dimensions), the upsample correction applied in WaveletFrequencyInverse.
+   * Default: false. */
+  itkGetConstReferenceMacro(ApplyUpsampleCorrection, bool);
+  itkSetMacro(ApplyUpsampleCorrection, bool);
+  itkBooleanMacro(ApplyUpsampleCorrection);
+
   /** FrequencyExpandImageFilter produces an image which is a different resolution and
    * with a different pixel spacing than its input image.  As such,
    * FrequencyExpandImageFilter needs to provide an implementation for
@@ -168,12 +195,23 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  void
+  BeforeThreadedGenerateData() override;
 
+  /** Each output bin reads its input bin, or is set to zero. */
   void
-  GenerateData() override;
+  DynamicThreadedGenerateData(const ImageRegionType & outputRegionForThread) override;
 
 private:
   ExpandFactorsType m_ExpandFactors;
+  bool              m_HalfHermitian{ false };
+  bool              m_ActualXDimensionIsOdd{ false };
+  bool              m_ApplyUpsampleCorrection{ false };
+
+  /** Computed in BeforeThreadedGenerateData. */
+  typename TImageType::SizeType                           m_InputFullSize;
+  FixedArray<std::vector<IndexValueType>, ImageDimension> m_InputIndexPerDimension;
+  double                                                  m_UpsampleCorrectionFactor{ 1.0 };
 };
 } // end namespace itk
 
@@ -19,9 +19,8 @@
 #define itkFrequencyExpandImageFilter_hxx
 
 #include <itkFrequencyExpandImageFilter.h>
-#include <itkProgressReporter.h>
-#include "itkInd2Sub.h"
-#include <itkPasteImageFilter.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include "itkWaveletUtilities.h"
 
 namespace itk
 {
@@ -36,6 +35,7 @@ FrequencyExpandImageFilter<TImageType>::FrequencyExpandImageFilter()
   {
     m_ExpandFactors[j] = 2;
   }
+  this->DynamicMultiThreadingOn();
 }
 
 /**
@@ -54,6 +54,9 @@ FrequencyExpandImageFilter<TImageType>::PrintSelf(std::ostream & os, Indent inde
     os << m_ExpandFactors[j] << ", ";
   }
   os << m_ExpandFactors[j] << "]" << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd << std::endl;
+  os << indent << "ApplyUpsampleCorrection: " << this->m_ApplyUpsampleCorrection << std::endl;
 }
 
 /**
@@ -88,95 +91,104 @@ FrequencyExpandImageFilter<TImageType>::SetExpandFactors(const unsigned int fact
 
 /**
  * Implementation Detail:
- * Assume Expand Factor = 2
- * Input image is pasted 2^ImageDimension times to form the outputImage.
- * The implementation calculate the number of different regions in an image,
- * depending on the dimension:
- * numberOfRegions = 2^dim (positive and negative frequencies per dim)
- * then uses function to convert a linear array of regions [0, ..., numberOfRegions - 1]
- * to binary subindices (only two options: positive or negative region)
- * In 3D: numberOfRegions = Nr = 2^3 = 8
- * sizeOfSubindices = [2,2,2]
- * Region = 0       -----> Ind2Sub(   0, [2,2,2]) = [0,0,0]
- * Region = 1       -----> Ind2Sub(   1, [2,2,2]) = [1,0,0]
- * Region = Nr - 1  -----> Ind2Sub(Nr-1, [2,2,2]) = [1,1,1]
- * So, if the result of Ind2Sub is 0 we paste the positive frequencies, if 1, negative freq
+ * The input is placed at the beginning (positive frequencies) and at the end (negative frequencies)
+ * of each dimension of the output, the bins in between are zero.
+ * Where both overlap (ExpandFactor = 1) the end wins. With an even input size, the Nyquist bin is
+ * copied to both sides, keeping the output hermitian if the input is.
+ * Each output bin reads its input bin from the per dimension tables computed in BeforeThreadedGenerateData.
  */
 template <typename TImageType>
 void
-FrequencyExpandImageFilter<TImageType>::GenerateData()
+FrequencyExpandImageFilter<TImageType>::BeforeThreadedGenerateData()
 {
   const ImageType * inputPtr = this->GetInput();
-  ImagePointer      outputPtr = this->GetOutput();
+  const ImageType * outputPtr = this->GetOutput();
 
-  // complex is initialized to zero directly.
-
-  this->AllocateOutputs();
-  outputPtr->FillBuffer(0);
-  typename TImageType::SizeType  inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
-  typename TImageType::IndexType inputOriginIndex = inputPtr->GetLargestPossibleRegion().GetIndex();
-  typename TImageType::SizeType  outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
-
-  const typename TImageType::IndexType indexRequested = outputPtr->GetLargestPossibleRegion().GetIndex();
+  const auto & inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  this->m_InputFullSize = inputSize;
+  if (this->m_HalfHermitian)
+  {
+    this->m_InputFullSize = utils::ComputeFullSizeFromHalfHermitianSize(inputSize, this->m_ActualXDimensionIsOdd);
+  }
 
-  // Manage ImageDimension array linearly:{{{
-  FixedArray<unsigned int, ImageDimension> nsizes;
-  unsigned int                             numberOfRegions = 1;
+  const auto & outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
+  double       upsampleCorrection = 1.0;
   for (unsigned int dim = 0; dim < ImageDimension; ++dim)
   {
-    nsizes[dim] = 2;
-    numberOfRegions *= nsizes[dim];
+    this->m_InputIndexPerDimension[dim].resize(outputSize[dim]);
+    const SizeValueType negativeStart =
+      this->m_InputFullSize[dim] * this->m_ExpandFactors[dim] - this->m_InputFullSize[dim];
+    for (SizeValueType k = 0; k < outputSize[dim]; ++k)
+    {
+      if (k >= negativeStart)
+      {
+        this->m_InputIndexPerDimension[dim][k] = static_cast<IndexValueType>(k - negativeStart);
+      }
+      else if (k < this->m_InputFullSize[dim])
+      {
+        this->m_InputIndexPerDimension[dim][k] = static_cast<IndexValueType>(k);
+      }
+      else
+      {
+        this->m_InputIndexPerDimension[dim][k] = -1;
+      }
+    }
+    upsampleCorrection *= this->m_ExpandFactors[dim];
   }
-  FixedArray<unsigned int, ImageDimension> subIndices;
-  /// }}}
+  this->m_UpsampleCorrectionFactor = this->m_ApplyUpsampleCorrection ? upsampleCorrection : 1.0;
+}
 
-  // Prepare filter to paste the different regions into output.
-  using PasteFilterType = itk::PasteImageFilter<ImageType>;
-  typename PasteFilterType::Pointer pasteFilter = PasteFilterType::New();
-  pasteFilter->SetSourceImage(inputPtr);
-  pasteFilter->SetDestinationImage(outputPtr);
-  pasteFilter->InPlaceOn();
+template <typename TImageType>
+void
+FrequencyExpandImageFilter<TImageType>::DynamicThreadedGenerateData(const ImageRegionType & outputRegionForThread)
+{
+  using PixelValueType = typename NumericTraits<PixelType>::ValueType;
 
-  using RegionType = typename ImageType::RegionType;
-  ProgressReporter progress(this, 0, numberOfRegions);
-  for (unsigned int n = 0; n < numberOfRegions; ++n)
+  const ImageType * inputPtr = this->GetInput();
+  ImageType *       outputPtr = this->GetOutput();
+
+  const IndexType         outputStartIndex = outputPtr->GetLargestPossibleRegion().GetIndex();
+  const PixelType *       inputBuffer = inputPtr->GetBufferPointer();
+  const OffsetValueType * inputOffsetTable = inputPtr->GetOffsetTable();
+  const SizeValueType     inputHalfSize0 = inputPtr->GetLargestPossibleRegion().GetSize()[0];
+  const bool              halfHermitian = this->m_HalfHermitian;
+  const bool              applyUpsampleCorrection = this->m_ApplyUpsampleCorrection;
+  const auto              upsampleCorrection = static_cast<PixelValueType>(this->m_UpsampleCorrectionFactor);
+
+  IndexValueType  fullIndex[ImageDimension];
+  OffsetValueType inputOffset;
+  for (ImageRegionIteratorWithIndex<ImageType> outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
   {
-    subIndices = Ind2Sub<ImageDimension>(n, nsizes);
-    RegionType                    zoneRegion;
-    typename ImageType::SizeType  zoneSize = inputSize;
-    typename ImageType::IndexType inputIndex = inputOriginIndex;
-    typename ImageType::IndexType outputIndex = indexRequested;
-    // We have to avoid break simmetry and the hermitian property.
-    // So the output of a ComplexInverseFFT will generate complex images with non-zero imaginary part.
+    const IndexType outputIndex = outIt.GetIndex();
+    bool            isZeroBin = false;
+    inputOffset = 0;
     for (unsigned int dim = 0; dim < ImageDimension; ++dim)
     {
-      if (subIndices[dim] == 0) // positive frequencies
-      {
-        outputIndex[dim] = indexRequested[dim];
-      }
-      else // negative frequencies
+      fullIndex[dim] = this->m_InputIndexPerDimension[dim][outputIndex[dim] - outputStartIndex[dim]];
+      if (fullIndex[dim] < 0)
       {
-        outputIndex[dim] = indexRequested[dim] + outputSize[dim] - zoneSize[dim];
+        isZeroBin = true;
+        break;
       }
+      inputOffset += fullIndex[dim] * inputOffsetTable[dim];
     }
-    zoneRegion.SetIndex(inputIndex);
-    zoneRegion.SetSize(zoneSize);
-    itkDebugMacro(<< "n:" << n << " region: " << zoneRegion);
-
-    pasteFilter->SetSourceRegion(zoneRegion);
-    pasteFilter->SetDestinationIndex(outputIndex);
-    if (n == numberOfRegions - 1) // Graft the output.
+    if (isZeroBin)
     {
-      pasteFilter->GraftOutput(outputPtr);
-      pasteFilter->Update();
-      this->GraftOutput(pasteFilter->GetOutput());
+      outIt.Set(NumericTraits<PixelType>::ZeroValue());
+      continue;
     }
-    else // update output
+    PixelType value;
+    // The bins not stored in the half-Hermitian layout are read from their mirror.
+    if (halfHermitian && utils::ComputeHalfHermitianOffset<ImageDimension>(
+                           fullIndex, this->m_InputFullSize, inputHalfSize0, inputOffsetTable, inputOffset))
     {
-      pasteFilter->Update();
-      outputPtr = pasteFilter->GetOutput();
+      value = utils::ComplexConjugate(inputBuffer[inputOffset]);
     }
-    progress.CompletedPixel();
+    else
+    {
+      value = inputBuffer[inputOffset];
+    }
+    outIt.Set(applyUpsampleCorrection ? value * upsampleCorrection : value);
   }
 }
 
@@ -190,39 +202,14 @@ FrequencyExpandImageFilter<TImageType>::GenerateInputRequestedRegion()
   // Call the superclass' implementation of this method
   Superclass::GenerateInputRequestedRegion();
 
-  // Get pointers to the input and output
-  auto *             inputPtr = const_cast<TImageType *>(this->GetInput());
-  const TImageType * outputPtr = this->GetOutput();
+  // Get pointer to the input
+  auto * inputPtr = const_cast<TImageType *>(this->GetInput());
 
   itkAssertInDebugAndIgnoreInReleaseMacro(inputPtr != nullptr);
-  itkAssertInDebugAndIgnoreInReleaseMacro(outputPtr);
 
-  // We need to compute the input requested region (size and start index)
-  unsigned int                           i;
-  const typename TImageType::SizeType &  outputRequestedRegionSize = outputPtr->GetRequestedRegion().GetSize();
-  const typename TImageType::IndexType & outputRequestedRegionStartIndex = outputPtr->GetRequestedRegion().GetIndex();
-
-  typename TImageType::SizeType  inputRequestedRegionSize;
-  typename TImageType::IndexType inputRequestedRegionStartIndex;
-  /**
-   * inputRequestedSize = (outputRequestedSize / ExpandFactor) + 1)
-   * The extra 1 above is to take care of edge effects when streaming.
-   */
-  for (i = 0; i < TImageType::ImageDimension; i++)
-  {
-    inputRequestedRegionSize[i] =
-      (SizeValueType)std::ceil((double)outputRequestedRegionSize[i] / (double)m_ExpandFactors[i]) + 1;
-
-    inputRequestedRegionStartIndex[i] =
-      (SizeValueType)std::floor((double)outputRequestedRegionStartIndex[i] / (double)m_ExpandFactors[i]);
-  }
-
-  typename TImageType::RegionType inputRequestedRegion;
-  inputRequestedRegion.SetSize(inputRequestedRegionSize);
-  inputRequestedRegion.SetIndex(inputRequestedRegionStartIndex);
-
-  // Make sure the requested region is within largest possible.
-  inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion());
+  // The negative frequencies of the output are read from the end of the input,
+  // and with HalfHermitian any bin can be read from its hermitian mirror. Request the whole input.
+  typename TImageType::RegionType inputRequestedRegion = inputPtr->GetLargestPossibleRegion();
 
   // Set the input requested region.
   inputPtr->SetRequestedRegion(inputRequestedRegion);
@@ -267,6 +254,11 @@ FrequencyExpandImageFilter<TImageType>::GenerateOutputInformation()
     // const double fraction = (double)( m_ExpandFactors[i] - 1 ) / (double)m_ExpandFactors[i];
     // inputOriginShift[i] = -( inputSpacing[i] / 2.0 ) * fraction;
   }
+  if (this->m_HalfHermitian)
+  {
+    const SizeValueType inputFullSize0 = 2 * (inputSize[0] - 1) + (this->m_ActualXDimensionIsOdd ? 1 : 0);
+    outputSize[0] = inputFullSize0 * static_cast<SizeValueType>(m_ExpandFactors[0]) / 2 + 1;
+  }
 
   // const typename TImageType::DirectionType inputDirection    = inputPtr->GetDirection();
   // const typename TImageType::SpacingType   outputOriginShift = inputDirection * inputOriginShift;
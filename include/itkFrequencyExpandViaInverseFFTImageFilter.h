@@ -92,6 +92,21 @@ public:
   /** Get the expand factors. */
   itkGetConstReferenceMacro(ExpandFactors, ExpandFactorsType);
 
+  /** Interface of FrequencyExpandImageFilter for the half-Hermitian layout.
+   * Only the full layout is supported by this filter, an exception is thrown if HalfHermitian is on. */
+  itkGetConstReferenceMacro(HalfHermitian, bool);
+  itkSetMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+  itkGetConstReferenceMacro(ActualXDimensionIsOdd, bool);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
+  /** Flag to multiply the output by the product of the ExpandFactors. \sa FrequencyExpandImageFilter
+   * Default: false. */
+  itkGetConstReferenceMacro(ApplyUpsampleCorrection, bool);
+  itkSetMacro(ApplyUpsampleCorrection, bool);
+  itkBooleanMacro(ApplyUpsampleCorrection);
+
   /** FrequencyExpandViaInverseFFTImageFilter produces an image which is a different resolution and
    * with a different pixel spacing than its input image.  As such,
    * FrequencyExpandViaInverseFFTImageFilter needs to provide an implementation for
@@ -131,6 +146,9 @@ private:
   typename ForwardFFTFilterType::Pointer        m_ForwardFFT;
   typename ExpandFilterType::Pointer            m_Expander;
   typename ChangeInformationFilterType::Pointer m_ChangeInformation;
+  bool                                          m_HalfHermitian{ false };
+  bool                                          m_ActualXDimensionIsOdd{ false };
+  bool                                          m_ApplyUpsampleCorrection{ false };
 };
 } // end namespace itk
 
@@ -19,6 +19,7 @@
 #define itkFrequencyExpandViaInverseFFTImageFilter_hxx
 
 #include "itkFrequencyExpandViaInverseFFTImageFilter.h"
+#include <itkImageRegionIterator.h>
 
 namespace itk
 {
@@ -55,6 +56,8 @@ FrequencyExpandViaInverseFFTImageFilter<TImageType>::PrintSelf(std::ostream & os
     os << m_ExpandFactors[j] << ", ";
   }
   os << m_ExpandFactors[j] << "]" << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ApplyUpsampleCorrection: " << this->m_ApplyUpsampleCorrection << std::endl;
 }
 
 /**
@@ -99,6 +102,11 @@ FrequencyExpandViaInverseFFTImageFilter<TImageType>::GenerateData()
   m_Expander->SetExpandFactors(this->m_ExpandFactors);
 
   m_ForwardFFT->SetInput(m_Expander->GetOutput());
+  // The upsample correction is applied in place in the output of the forward FFT, always recompute it.
+  if (this->m_ApplyUpsampleCorrection)
+  {
+    m_ForwardFFT->Modified();
+  }
   // m_ForwardFFT->GraftOutput(outputPtr);
   m_ForwardFFT->Update();
   // this->GraftOutput(m_ForwardFFT->GetOutput());
@@ -113,6 +121,22 @@ FrequencyExpandViaInverseFFTImageFilter<TImageType>::GenerateData()
   m_ChangeInformation->Update();
   this->GraftOutput(m_ChangeInformation->GetOutput());
 
+  if (this->m_ApplyUpsampleCorrection)
+  {
+    using PixelValueType = typename NumericTraits<PixelType>::ValueType;
+    double upsampleCorrection = 1.0;
+    for (unsigned int j = 0; j < ImageDimension; j++)
+    {
+      upsampleCorrection *= m_ExpandFactors[j];
+    }
+    const auto correction = static_cast<PixelValueType>(upsampleCorrection);
+    outputPtr = this->GetOutput();
+    for (ImageRegionIterator<ImageType> outIt(outputPtr, outputPtr->GetBufferedRegion()); !outIt.IsAtEnd(); ++outIt)
+    {
+      outIt.Set(outIt.Get() * correction);
+    }
+  }
+
   // ImageAlgorithm::Copy(m_ForwardFFT->GetOutput(), outputPtr.GetPointer(),
   //   outputPtr->GetRequestedRegion(),
   //   outputPtr->GetRequestedRegion() );
@@ -176,6 +200,11 @@ FrequencyExpandViaInverseFFTImageFilter<TImageType>::GenerateOutputInformation()
   // Call the superclass' implementation of this method
   Superclass::GenerateOutputInformation();
 
+  if (this->m_HalfHermitian)
+  {
+    itkExceptionMacro(<< "HalfHermitian layout is not supported, use FrequencyExpandImageFilter instead.");
+  }
+
   // Get pointers to the input and output
   const TImageType * inputPtr = this->GetInput();
   TImageType *       outputPtr = this->GetOutput();
@@ -21,6 +21,7 @@
 #include <itkShrinkImageFilter.h>
 #include <itkFrequencyBandImageFilter.h>
 #include <itkEnableIf.h>
+#include <vector>
 
 namespace itk
 {
@@ -68,6 +69,12 @@ namespace itk
  * The output image size in each dimension is given by:
  * outputSize[j] = std::floor(inputSize[j]/shrinkFactor[j]);
  *
+ * With HalfHermitian on, input and output are in the half-Hermitian layout of
+ * RealToHalfHermitianForwardFFTImageFilter: only the bins 0 to N/2 of the first dimension are stored,
+ * where N is the size of the full spectrum, given by the stored size and ActualXDimensionIsOdd.
+ * The output is the first half of the output of the full spectrum,
+ * the aliased bins not stored in the input are read from their hermitian mirror.
+ *
  * This code was contributed in the Insight Journal paper:
  * https://hdl.handle.net....
  *
@@ -137,24 +144,71 @@ public:
   /** End concept checking */
 #endif
 
+  /** Flag to stop the input bins not passed by the FrequencyBandFilter before adding them.
+   * The band filter is not executed, its parameters are evaluated for each gathered bin.
+   * Default: false. */
   itkGetConstReferenceMacro(ApplyBandFilter, bool);
   itkSetMacro(ApplyBandFilter, bool);
   itkBooleanMacro(ApplyBandFilter);
 
   itkGetMacro(FrequencyBandFilter, typename FrequencyBandFilterType::Pointer);
 
+  /** Flag to use input and output in the half-Hermitian layout.
+   * Default: false. */
+  itkGetConstReferenceMacro(HalfHermitian, bool);
+  itkSetMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+
+  /** The size of the first dimension of the full spectrum of the input is odd.
+   * Only used with HalfHermitian. The output is odd if floor(N/shrinkFactor[0]) is odd.
+   * Default: false. */
+  itkGetConstReferenceMacro(ActualXDimensionIsOdd, bool);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
 protected:
   FrequencyShrinkImageFilter();
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   void
-  GenerateData() override;
+  BeforeThreadedGenerateData() override;
+
+  /** Each output bin gathers its aliased input bins, masked by the FrequencyBandFilter
+   * if ApplyBandFilter is on. */
+  void
+  DynamicThreadedGenerateData(const ImageRegionType & outputRegionForThread) override;
+
+  /** Parameters of the FrequencyBandFilter, with the thresholds scaled by the spacing. */
+  struct FrequencyBandParametersType
+  {
+    double LowFrequencyThreshold{ 0.0 };
+    double HighFrequencyThreshold{ 0.0 };
+    bool   PassBand{ true };
+    bool   PassLowFrequencyThreshold{ true };
+    bool   PassHighFrequencyThreshold{ true };
+    bool   RadialBand{ true };
+    bool   PassNegativeLowFrequencyThreshold{ true };
+    bool   PassNegativeHighFrequencyThreshold{ true };
+  };
+
+  /** True if the FrequencyBandFilter lets pass the bin of the full spectrum of the input at fullIndex
+   * (relative to the start of the image). */
+  bool
+  FrequencyBinIsInBand(const IndexValueType * fullIndex) const;
 
 private:
   ShrinkFactorsType                         m_ShrinkFactors;
   bool                                      m_ApplyBandFilter{ false };
   typename FrequencyBandFilterType::Pointer m_FrequencyBandFilter;
+  bool                                      m_HalfHermitian{ false };
+  bool                                      m_ActualXDimensionIsOdd{ false };
+
+  /** Computed in BeforeThreadedGenerateData. */
+  typename TImageType::SizeType    m_InputFullSize;
+  typename TImageType::SizeType    m_NegativeShift;
+  std::vector<std::vector<double>> m_InputFrequency;
+  FrequencyBandParametersType      m_FrequencyBandParameters;
 };
 } // end namespace itk
 
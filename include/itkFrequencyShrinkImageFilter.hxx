@@ -19,13 +19,10 @@
 #define itkFrequencyShrinkImageFilter_hxx
 
 #include <itkFrequencyShrinkImageFilter.h>
-#include <itkProgressReporter.h>
-#include <numeric>
-#include <functional>
-#include "itkInd2Sub.h"
-#include <itkPasteImageFilter.h>
-#include <itkAddImageFilter.h>
-#include <itkMultiplyImageFilter.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include <algorithm>
+#include <cmath>
+#include "itkWaveletUtilities.h"
 // #include <itkGaussianSpatialFunction.h>
 // #include <itkFrequencyImageRegionIteratorWithIndex.h>
 
@@ -39,6 +36,7 @@ FrequencyShrinkImageFilter<TImageType>::FrequencyShrinkImageFilter()
   {
     m_ShrinkFactors[j] = 2;
   }
+  this->DynamicMultiThreadingOn();
 
   this->m_FrequencyBandFilter = FrequencyBandFilterType::New();
   // The band filter only let pass half of the frequencies.
@@ -94,36 +92,38 @@ FrequencyShrinkImageFilter<TImageType>::SetShrinkFactor(unsigned int i, unsigned
 
 /**
  * Implementation Detail:
- * The implementation calculate the number of different regions in an image,
- * depending on the dimension:
- * numberOfRegions = 2^dim (positive and negative frequencies per dim)
- * then uses function to convert a linear array of regions [0, ..., numberOfRegions - 1]
- * to binary subindices (only two options: positive or negative region)
- * In 3D: numberOfRegions = Nr = 2^3 = 8
- * sizeOfSubindices = [2,2,2]
- * Region = 0       -----> Ind2Sub(   0, [2,2,2]) = [0,0,0]
- * Region = 1       -----> Ind2Sub(   1, [2,2,2]) = [1,0,0]
- * Region = Nr - 1  -----> Ind2Sub(Nr-1, [2,2,2]) = [1,1,1]
- * So, if the result of Ind2Sub is 0 we paste the positive frequencies, if 1, negative freq
+ * Each output bin k is the sum of the 2^dim input bins that alias into it when shrinking:
+ * one per combination of positive and negative frequencies in each dimension.
+ * The input bin of each dimension is k for the positive frequencies, and k + inputSize - outputSize for the
+ * negative ones. The combination n in [0, 2^dim) takes the negative frequencies of the dimensions with
+ * the bit set in n. In 3D:
+ * n = 0     -----> [pos, pos, pos]
+ * n = 1     -----> [neg, pos, pos]
+ * n = 2^3-1 -----> [neg, neg, neg]
+ * The bins stopped by the FrequencyBandFilter are not added, and the sum is divided by 2^dim.
  */
 template <class TImageType>
 void
-FrequencyShrinkImageFilter<TImageType>::GenerateData()
+FrequencyShrinkImageFilter<TImageType>::BeforeThreadedGenerateData()
 {
-  // Get the input and output pointers
   const ImageType * inputPtr = this->GetInput();
+  const auto &      inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
 
-  typename ImageType::Pointer outputPtr = this->GetOutput();
-  this->AllocateOutputs();
-  // outputPtr->SetBufferedRegion(outputPtr->GetLargestPossibleRegion());
-  outputPtr->FillBuffer(0);
+  this->m_InputFullSize = inputSize;
+  if (this->m_HalfHermitian)
+  {
+    this->m_InputFullSize = utils::ComputeFullSizeFromHalfHermitianSize(inputSize, this->m_ActualXDimensionIsOdd);
+  }
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    this->m_NegativeShift[dim] =
+      this->m_InputFullSize[dim] - this->m_InputFullSize[dim] / this->m_ShrinkFactors[dim];
+  }
 
-  // Output is the sum of the four(2D) or eight(3D) quadrants.
-  // We can do it only because high freqs are removed.
-  // This filter will remove it by default a BandPass Filter.
+  this->m_InputFrequency.clear();
   if (this->m_ApplyBandFilter)
   {
-    typename ImageType::SpacingType                  inputSpacing = this->GetInput()->GetSpacing();
+    typename ImageType::SpacingType                  inputSpacing = inputPtr->GetSpacing();
     const typename ImageType::SpacingType::ValueType spacingValue = inputSpacing[0];
     // Check that the spacing is the same in all directions.
     {
@@ -141,174 +141,137 @@ FrequencyShrinkImageFilter<TImageType>::GenerateData()
       }
     }
 
-    this->m_FrequencyBandFilter->SetInput(this->GetInput());
-    this->m_FrequencyBandFilter->SetFrequencyThresholds(
-      this->m_FrequencyBandFilter->GetLowFrequencyThreshold() * spacingValue,
-      this->m_FrequencyBandFilter->GetHighFrequencyThreshold() * spacingValue);
-    this->m_FrequencyBandFilter->Update();
-    inputPtr = this->m_FrequencyBandFilter->GetOutput();
+    // Frequencies of the bins, as computed by the frequency iterator of the band filter.
+    this->m_InputFrequency =
+      utils::ComputeFrequencyPerDimension<ImageDimension>(this->m_InputFullSize, this->m_InputFullSize, inputSpacing);
+    FrequencyBandParametersType & band = this->m_FrequencyBandParameters;
+    band.LowFrequencyThreshold = this->m_FrequencyBandFilter->GetLowFrequencyThreshold() * spacingValue;
+    band.HighFrequencyThreshold = this->m_FrequencyBandFilter->GetHighFrequencyThreshold() * spacingValue;
+    band.PassBand = this->m_FrequencyBandFilter->GetPassBand();
+    band.PassLowFrequencyThreshold = this->m_FrequencyBandFilter->GetPassLowFrequencyThreshold();
+    band.PassHighFrequencyThreshold = this->m_FrequencyBandFilter->GetPassHighFrequencyThreshold();
+    band.RadialBand = this->m_FrequencyBandFilter->GetRadialBand();
+    band.PassNegativeLowFrequencyThreshold = this->m_FrequencyBandFilter->GetPassNegativeLowFrequencyThreshold();
+    band.PassNegativeHighFrequencyThreshold = this->m_FrequencyBandFilter->GetPassNegativeHighFrequencyThreshold();
   }
+}
+
+template <class TImageType>
+bool
+FrequencyShrinkImageFilter<TImageType>::FrequencyBinIsInBand(const IndexValueType * fullIndex) const
+{
+  const FrequencyBandParametersType & band = this->m_FrequencyBandParameters;
 
-  typename TImageType::SizeType        inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
-  typename TImageType::SizeType        outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
-  const typename TImageType::IndexType indexOrigOut = outputPtr->GetLargestPossibleRegion().GetIndex();
-  // Manage ImageDimension array linearly:{{{
-  FixedArray<unsigned int, ImageDimension> nsizes;
-  unsigned int                             numberOfRegions = 1;
+  // Radial band uses the modulo of the frequency, the box band the maximum absolute frequency.
+  double w = 0;
   for (unsigned int dim = 0; dim < ImageDimension; ++dim)
   {
-    nsizes[dim] = 2;
-    numberOfRegions *= nsizes[dim];
+    const double frequency = this->m_InputFrequency[dim][fullIndex[dim]];
+    if (band.RadialBand)
+    {
+      w += frequency * frequency;
+    }
+    else
+    {
+      w = std::max(w, std::abs(frequency));
+    }
   }
-  FixedArray<unsigned int, ImageDimension> subIndices;
-  /// }}}
-
-  // Prepare filter to paste the different regions into output.
-  using PasteFilterType = itk::PasteImageFilter<ImageType>;
-  typename PasteFilterType::Pointer pasteFilter = PasteFilterType::New();
-  pasteFilter->SetSourceImage(inputPtr);
-  pasteFilter->SetDestinationImage(outputPtr);
-  // pasteFilter->InPlaceOn();
-
-  using RegionType = typename ImageType::RegionType;
-  ProgressReporter progress(this, 0, numberOfRegions);
-  for (unsigned int n = 0; n < numberOfRegions; ++n)
+  if (band.RadialBand)
+  {
+    w = std::sqrt(w);
+  }
+
+  bool isInBand;
+  if (band.PassBand)
+  {
+    isInBand = (band.PassLowFrequencyThreshold ? w >= band.LowFrequencyThreshold : w > band.LowFrequencyThreshold) &&
+               (band.PassHighFrequencyThreshold ? w <= band.HighFrequencyThreshold : w < band.HighFrequencyThreshold);
+  }
+  else
+  {
+    isInBand =
+      !((band.PassLowFrequencyThreshold ? w > band.LowFrequencyThreshold : w >= band.LowFrequencyThreshold) &&
+        (band.PassHighFrequencyThreshold ? w < band.HighFrequencyThreshold : w <= band.HighFrequencyThreshold));
+  }
+
+  // Box band: stop the negative frequencies in the thresholds, if requested.
+  if (isInBand && !band.RadialBand)
   {
-    subIndices = itk::Ind2Sub<ImageDimension>(n, nsizes);
-    RegionType                     zoneRegion;
-    typename ImageType::SizeType   zoneSize;
-    typename TImageType::IndexType inputIndex = indexOrigOut;
-    typename TImageType::IndexType outputIndex = indexOrigOut;
-    // Note that lowFreqsOfInput is inputSize/2 if outputSize is even, (outputSize - 1)/2 if odd.
     for (unsigned int dim = 0; dim < ImageDimension; ++dim)
     {
-      zoneSize[dim] = outputSize[dim];
-      outputIndex[dim] = indexOrigOut[dim];
-      if (subIndices[dim] == 0) // positive frequencies
+      const double frequency = this->m_InputFrequency[dim][fullIndex[dim]];
+      if ((!band.PassNegativeLowFrequencyThreshold && band.PassLowFrequencyThreshold &&
+           itk::Math::FloatAlmostEqual(frequency, -band.LowFrequencyThreshold)) ||
+          (!band.PassNegativeHighFrequencyThreshold && band.PassHighFrequencyThreshold &&
+           itk::Math::FloatAlmostEqual(frequency, -band.HighFrequencyThreshold)))
       {
-        inputIndex[dim] = indexOrigOut[dim];
+        return false;
       }
-      else // negative frequencies
-      {
-        inputIndex[dim] = indexOrigOut[dim] + inputSize[dim] - zoneSize[dim];
-      }
-    }
-    zoneRegion.SetIndex(inputIndex);
-    zoneRegion.SetSize(zoneSize);
-    itkDebugMacro(<< "n:" << n << " region: " << zoneRegion);
-
-    pasteFilter->SetSourceRegion(zoneRegion);
-    pasteFilter->SetDestinationIndex(outputIndex);
-    pasteFilter->Update();
-    // Sum the quadrants.
-    using AddFilterType = itk::AddImageFilter<TImageType, TImageType>;
-    typename AddFilterType::Pointer addFilter = AddFilterType::New();
-    addFilter->SetInput1(outputPtr);
-    addFilter->SetInput2(pasteFilter->GetOutput());
-    addFilter->InPlaceOn();
-    if (n == numberOfRegions - 1) // Graft the output.
-    {
-      addFilter->Update();
-      outputPtr = addFilter->GetOutput();
-      using MultiplyFilterType = itk::MultiplyImageFilter<TImageType, TImageType, TImageType>;
-      typename MultiplyFilterType::Pointer multiplyFilter = MultiplyFilterType::New();
-      multiplyFilter->SetInput(outputPtr);
-      multiplyFilter->SetConstant(static_cast<typename TImageType::PixelType::value_type>(1.0 / numberOfRegions));
-
-      multiplyFilter->GraftOutput(outputPtr);
-      multiplyFilter->Update();
-      this->GraftOutput(multiplyFilter->GetOutput());
-      // addFilter->GraftOutput(outputPtr);
-      // addFilter->Update();
-      // this->GraftOutput(addFilter->GetOutput());
     }
-    else // update
+  }
+  return isInBand;
+}
+
+template <class TImageType>
+void
+FrequencyShrinkImageFilter<TImageType>::DynamicThreadedGenerateData(const ImageRegionType & outputRegionForThread)
+{
+  using PixelValueType = typename NumericTraits<PixelType>::ValueType;
+
+  const ImageType * inputPtr = this->GetInput();
+  ImageType *       outputPtr = this->GetOutput();
+
+  const IndexType         outputStartIndex = outputPtr->GetLargestPossibleRegion().GetIndex();
+  const PixelType *       inputBuffer = inputPtr->GetBufferPointer();
+  const OffsetValueType * inputOffsetTable = inputPtr->GetOffsetTable();
+  const SizeValueType     inputHalfSize0 = inputPtr->GetLargestPossibleRegion().GetSize()[0];
+  const unsigned int      numberOfRegions = 1u << ImageDimension;
+  const auto              normalization = static_cast<PixelValueType>(1.0 / numberOfRegions);
+  const bool              applyBandFilter = this->m_ApplyBandFilter;
+  const bool              halfHermitian = this->m_HalfHermitian;
+
+  IndexValueType  fullIndex[ImageDimension];
+  OffsetValueType inputOffset;
+  for (ImageRegionIteratorWithIndex<ImageType> outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
+  {
+    const IndexType outputIndex = outIt.GetIndex();
+    PixelType       sum = NumericTraits<PixelType>::ZeroValue();
+    for (unsigned int n = 0; n < numberOfRegions; ++n)
     {
-      addFilter->Update();
-      outputPtr = addFilter->GetOutput();
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        fullIndex[dim] = outputIndex[dim] - outputStartIndex[dim];
+        if ((n >> dim) & 1u) // negative frequencies
+        {
+          fullIndex[dim] += static_cast<IndexValueType>(this->m_NegativeShift[dim]);
+        }
+      }
+      if (applyBandFilter && !this->FrequencyBinIsInBand(fullIndex))
+      {
+        continue;
+      }
+      // The bins not stored in the half-Hermitian layout are read from their mirror.
+      if (halfHermitian && utils::ComputeHalfHermitianOffset<ImageDimension>(
+                             fullIndex, this->m_InputFullSize, inputHalfSize0, inputOffsetTable, inputOffset))
+      {
+        sum += utils::ComplexConjugate(inputBuffer[inputOffset]);
+      }
+      else if (halfHermitian)
+      {
+        sum += inputBuffer[inputOffset];
+      }
+      else
+      {
+        inputOffset = 0;
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          inputOffset += fullIndex[dim] * inputOffsetTable[dim];
+        }
+        sum += inputBuffer[inputOffset];
+      }
     }
-    progress.CompletedPixel();
+    outIt.Set(sum * normalization);
   }
-
-  /** Ensure image is hermitian in the Nyquist bands (even)
-   * Example: Image 2D size 8, index = [0,...,7]
-   * Each quadrant is a region pasted from the original image. The index refers to the input image of size 8. The input
-   * image is hermitian, so:
-   *   0
-   * 1 == 7
-   * 2 == 6  <- 6 is Nyq in new image.
-   * 3 == 5
-   *   4  <- Nyq original
-   * Hermitian table, using the equivalences above. (assuming imag part zero to avoid working with conjugates) . Note
-   * that index 6 is the new Nyquist. 0    1  |  6    7 0 0,0  1,0 | 2,0  1,0 1 0,1  1,1 | 2,1  1,1
-   * ---------------------
-   * 6 0,2  1,2 | 2,2  1,2
-   * 7 0,1  1,1 | 2,1  1,1
-   * /
-   */
-  // Fix Nyquist band. Folding results for hermiticity.
-  // {
-  // typename TImageType::IndexType index = indexOrigOut + lowFreqsOfInput;
-  // typename TImageType::IndexType modIndex = indexOrigOut + lowFreqsOfInput;
-  // // typename TImageType::SizeType endSize = outputSize - lowFreqsOfInput;
-  // for(unsigned int dim = 0; dim < ImageDimension; ++dim)
-  //   {
-  //   for(int i = 1; i < (int)lowFreqsOfInput[dim]; ++i)
-  //     {
-  //     index = indexOrigOut + lowFreqsOfInput;
-  //     modIndex = indexOrigOut + lowFreqsOfInput;
-  //     index.SetElement(dim, indexOrigOut[dim] + i );
-  //     modIndex.SetElement(dim, indexOrigOut[dim] + outputSize[dim] - i );
-  //     typename TImageType::PixelType value =
-  //       std::conj(outputPtr->GetPixel(index));
-  //     outputPtr->SetPixel(modIndex, value);
-  //     // The stored nyquiist value corresponds to  the positive side.
-  //     outputPtr->SetPixel(index, value);
-  //     }
-  //     // The stored nyquiist value corresponds to  the positive side.
-  //     index.SetElement(dim, indexOrigOut[dim]);
-  //     outputPtr->SetPixel(index, std::conj(outputPtr->GetPixel(index)));
-  //   }
-  // }
-
-  // // Apply a gaussian window of the size of the output.
-  // using FunctionType = itk::GaussianSpatialFunction<double, ImageDimension>;
-  // typename FunctionType::Pointer gaussian = FunctionType::New();
-  // using ArrayType = FixedArray< double, ImageDimension >;
-  // ArrayType m_Mean;
-  // ArrayType m_Sigma;
-  // double m_Scale = 1.0;
-  // bool m_Normalized = true;
-  // for (unsigned int i = 0; i<ImageDimension; ++i)
-  //   {
-  //   m_Mean[i] = indexOrigOut[i];
-  //   // 6.0 is equivalent to 3sigmas (border values are close to zero)
-  //   // m_Sigma[i] = outputSize[i]/(2*3.0);
-  //   m_Sigma[i] = outputSize[i]/(2.0*2.35);
-  //   }
-  // gaussian->SetSigma(m_Sigma);
-  // gaussian->SetMean(m_Mean);
-  // gaussian->SetScale(m_Scale);
-  // gaussian->SetNormalized(m_Normalized);
-  //
-  // // Create an iterator that will walk the output region
-  // using OutputIterator = itk::FrequencyImageRegionIteratorWithIndex< TImageType >;
-  // OutputIterator outIt = OutputIterator( outputPtr,
-  //     outputPtr->GetRequestedRegion() );
-  // outIt.GoToBegin();
-  // while( !outIt.IsAtEnd() )
-  //   {
-  //   typename TImageType::IndexType ind = outIt.GetFrequencyBin();
-  //   typename FunctionType::InputType f;
-  //   for (unsigned int i = 0; i<ImageDimension; ++i)
-  //     {
-  //     f[i] = static_cast<typename FunctionType::InputType::ValueType>(ind[i]);
-  //     }
-  //   const double value = gaussian->Evaluate(f);
-  //   // Set the pixel value to the function value
-  //   outIt.Set( outIt.Get() * static_cast<typename TImageType::PixelType::value_type>(value) );
-  //   ++outIt;
-  //   }
 }
 
 template <class TImageType>
@@ -378,6 +341,16 @@ FrequencyShrinkImageFilter<TImageType>::GenerateOutputInformation()
       itkExceptionMacro("InputImage is too small! An output pixel does not map to a whole input bin.");
     }
   }
+  if (this->m_HalfHermitian)
+  {
+    const SizeValueType inputFullSize0 = 2 * (inputSize[0] - 1) + (this->m_ActualXDimensionIsOdd ? 1 : 0);
+    const SizeValueType outputFullSize0 = inputFullSize0 / m_ShrinkFactors[0];
+    if (outputFullSize0 < 1)
+    {
+      itkExceptionMacro("InputImage is too small! An output pixel does not map to a whole input bin.");
+    }
+    outputSize[0] = outputFullSize0 / 2 + 1;
+  }
 
   // inputPtr->TransformContinuousIndexToPhysicalPoint(inputIndexOutputOrigin, outputOrigin);
   outputOrigin = inputOrigin;
@@ -406,6 +379,8 @@ FrequencyShrinkImageFilter<TImageType>::PrintSelf(std::ostream & os, Indent inde
   }
   os << std::endl;
   os << "ApplyBandFilter: " << this->m_ApplyBandFilter << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd << std::endl;
 
   itkPrintSelfObjectMacro(FrequencyBandFilter);
 }
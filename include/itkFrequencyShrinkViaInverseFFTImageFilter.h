@@ -91,6 +91,15 @@ public:
   /** Get the shrink factors. */
   itkGetConstReferenceMacro(ShrinkFactors, ShrinkFactorsType);
 
+  /** Interface of FrequencyShrinkImageFilter for the half-Hermitian layout.
+   * Only the full layout is supported by this filter, an exception is thrown if HalfHermitian is on. */
+  itkGetConstReferenceMacro(HalfHermitian, bool);
+  itkSetMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+  itkGetConstReferenceMacro(ActualXDimensionIsOdd, bool);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
   void
   GenerateOutputInformation() override;
 
@@ -122,6 +131,8 @@ private:
   typename ForwardFFTFilterType::Pointer        m_ForwardFFT;
   typename ShrinkFilterType::Pointer            m_Shrinker;
   typename ChangeInformationFilterType::Pointer m_ChangeInformation;
+  bool                                          m_HalfHermitian{ false };
+  bool                                          m_ActualXDimensionIsOdd{ false };
 };
 } // end namespace itk
 
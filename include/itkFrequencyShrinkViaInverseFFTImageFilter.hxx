@@ -47,6 +47,7 @@ FrequencyShrinkViaInverseFFTImageFilter<TImageType>::PrintSelf(std::ostream & os
     os << m_ShrinkFactors[j] << " ";
   }
   os << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
 }
 
 template <class TImageType>
@@ -140,6 +141,11 @@ FrequencyShrinkViaInverseFFTImageFilter<TImageType>::GenerateOutputInformation()
   // Call the superclass' implementation of this method
   Superclass::GenerateOutputInformation();
 
+  if (this->m_HalfHermitian)
+  {
+    itkExceptionMacro(<< "HalfHermitian layout is not supported, use FrequencyShrinkImageFilter instead.");
+  }
+
   // Get pointers to the input and output
   const TImageType * inputPtr = this->GetInput();
   TImageType *       outputPtr = this->GetOutput();
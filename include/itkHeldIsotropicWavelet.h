@@ -79,6 +79,10 @@ public:
   FunctionValueType
   ComputePolynom(const FunctionValueType & freq_norm_in_hz, const unsigned int & order) const;
 
+  /** Append PolynomialOrder to the parameters of the Superclass. */
+  std::vector<double>
+  GetWaveletParameters() const override;
+
 protected:
   HeldIsotropicWavelet();
   ~HeldIsotropicWavelet() override;
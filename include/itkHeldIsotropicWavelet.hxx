@@ -39,6 +39,15 @@ HeldIsotropicWavelet<TFunctionValue, VImageDimension, TInput>::PrintSelf(std::os
   os << indent << "PolynomialOrder: " << this->m_PolynomialOrder << std::endl;
 }
 
+template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+std::vector<double>
+HeldIsotropicWavelet<TFunctionValue, VImageDimension, TInput>::GetWaveletParameters() const
+{
+  std::vector<double> parameters = Superclass::GetWaveletParameters();
+  parameters.push_back(static_cast<double>(this->m_PolynomialOrder));
+  return parameters;
+}
+
 template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
 typename HeldIsotropicWavelet<TFunctionValue, VImageDimension, TInput>::FunctionValueType
 HeldIsotropicWavelet<TFunctionValue, VImageDimension, TInput>::EvaluateMagnitude(
@@ -19,6 +19,7 @@
 #define itkIsotropicWaveletFrequencyFunction_h
 
 #include "itkIsotropicFrequencyFunction.h"
+#include <vector>
 
 namespace itk
 {
@@ -117,6 +118,13 @@ public:
    * Default to 0.25 Hz ( pi/2 rad/s ) but can be changed in child classes. */
   itkGetConstMacro(FreqCutOff, FunctionValueType);
   // itkSetMacro(FreqCutOff, FunctionValueType);
+
+  /** Parameters defining the response of the wavelet, besides HighPassSubBands.
+   * Used to identify equal filter banks, \sa WaveletFilterBankPyramidCache.
+   * Child classes with parameters have to append them to the ones of the Superclass. */
+  virtual std::vector<double>
+  GetWaveletParameters() const;
+
 protected:
   IsotropicWaveletFrequencyFunction();
   ~IsotropicWaveletFrequencyFunction() override;
@@ -54,6 +54,13 @@ IsotropicWaveletFrequencyFunction<TFunctionValue, VImageDimension, TInput>::SetH
   this->m_HighPassSubBands = high_pass_bands;
 }
 
+template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+std::vector<double>
+IsotropicWaveletFrequencyFunction<TFunctionValue, VImageDimension, TInput>::GetWaveletParameters() const
+{
+  return { static_cast<double>(this->m_FreqCutOff) };
+}
+
 template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
 typename IsotropicWaveletFrequencyFunction<TFunctionValue, VImageDimension, TInput>::FunctionValueType
 IsotropicWaveletFrequencyFunction<TFunctionValue, VImageDimension, TInput>::EvaluateForwardLowPassFilter(
@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsotropicWaveletProfileTable_h
+#define itkIsotropicWaveletProfileTable_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+/** \class IsotropicWaveletProfileTable
+ * \brief Tabulated radial profiles of all the sub-bands of an isotropic wavelet.
+ *
+ * The profiles EvaluateForwardSubBand(LevelFactor * w, j) (or EvaluateInverseSubBand if InverseBank is on)
+ * for j = 0 (low pass) to HighPassSubBands (highest band) are sampled at regular intervals of the
+ * frequency modulo square \f$ w^2 \f$, in the range [0, MaximumFrequencyModuloSquare],
+ * and evaluated with cubic (four points Lagrange) interpolation.
+ * Indexing by the square avoids the square root per pixel.
+ *
+ * The number of intervals is doubled, up to MaximumNumberOfIntervals, until the interpolation error,
+ * estimated at the middle point of every interval (where the error of the cubic is maximum), is less than Tolerance.
+ * Smooth profiles (e.g HeldIsotropicWavelet) reach the default tolerance with a few thousand intervals.
+ * Profiles with discontinuities (ShannonIsotropicWavelet) or with singular derivatives at the
+ * edges of their support (VowIsotropicWavelet, SimoncelliIsotropicWavelet) only reach coarse tolerances,
+ * if IsWithinTolerance is false the table should not be used.
+ *
+ * The table is built with the HighPassSubBands of the wavelet function passed to Compute,
+ * and it does not change if the wavelet function is modified after that.
+ *
+ * \sa WaveletFrequencyFilterBankGenerator
+ * \sa IsotropicWaveletFrequencyFunction
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TWaveletFunction>
+class IsotropicWaveletProfileTable : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IsotropicWaveletProfileTable);
+
+  /** Standard type alias */
+  using Self = IsotropicWaveletProfileTable;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(IsotropicWaveletProfileTable, Object);
+
+  /** WaveletFunction types */
+  using WaveletFunctionType = TWaveletFunction;
+  using FunctionValueType = typename WaveletFunctionType::FunctionValueType;
+
+  /** Flag to tabulate the inverse (reconstruction) profiles instead of forward (analysis) */
+  itkGetConstMacro(InverseBank, bool);
+  itkSetMacro(InverseBank, bool);
+  itkBooleanMacro(InverseBank);
+
+  /** Factor multiplying the frequency before evaluating the profiles. \sa
+   * WaveletFrequencyFilterBankGenerator::SetLevel */
+  itkGetConstMacro(LevelFactor, double);
+  itkSetMacro(LevelFactor, double);
+
+  /** Maximum frequency modulo square tabulated. Bigger values are clamped to it, \sa GetIsConstantBeyondMaximum.
+   * Default to 0.75, the corner of the frequency domain in 3D with unit spacing. */
+  itkGetConstMacro(MaximumFrequencyModuloSquare, double);
+  itkSetMacro(MaximumFrequencyModuloSquare, double);
+
+  /** Maximum absolute interpolation error allowed. Default: 1e-6 */
+  itkGetConstMacro(Tolerance, double);
+  itkSetMacro(Tolerance, double);
+
+  /** Maximum number of intervals to reach Tolerance. Default: 2^16 */
+  itkGetConstMacro(MaximumNumberOfIntervals, SizeValueType);
+  itkSetMacro(MaximumNumberOfIntervals, SizeValueType);
+
+  /** Number of high pass sub-bands of the tabulated wavelet function. */
+  itkGetConstMacro(HighPassSubBands, unsigned int);
+
+  /** Number of intervals of the table. Valid after Compute. */
+  itkGetConstMacro(NumberOfIntervals, SizeValueType);
+
+  /** Estimated maximum interpolation error of the table. Valid after Compute. */
+  itkGetConstMacro(MaximumError, double);
+
+  /** True if the estimated error is less than Tolerance. Valid after Compute. */
+  itkGetConstMacro(IsWithinTolerance, bool);
+
+  /** True if the profiles beyond MaximumFrequencyModuloSquare are equal, within Tolerance, to the ones at it,
+   * so the table can be evaluated at any frequency modulo square. This is the case beyond the support of the
+   * wavelet. It is checked at MaximumFrequencyModuloSquare * 2^(k/8), k = 1 to 256. Valid after Compute. */
+  itkGetConstMacro(IsConstantBeyondMaximum, bool);
+
+  /** Sample the profiles of the wavelet function. */
+  void
+  Compute(const WaveletFunctionType * waveletFunction);
+
+  /** Evaluate all the sub-bands, from low pass (0) to the highest (HighPassSubBands), at
+   * the frequency modulo square w2. values has to hold HighPassSubBands + 1 elements. */
+  inline void
+  EvaluateSubBands(const double & w2, FunctionValueType * values) const
+  {
+    const unsigned int        numberOfProfiles = this->m_HighPassSubBands + 1;
+    double                    weights[4];
+    const FunctionValueType * samples = this->ComputeInterpolation(w2, weights);
+    for (unsigned int j = 0; j < numberOfProfiles; ++j)
+    {
+      values[j] = static_cast<FunctionValueType>(
+        weights[0] * samples[j] + weights[1] * samples[j + numberOfProfiles] +
+        weights[2] * samples[j + 2 * numberOfProfiles] + weights[3] * samples[j + 3 * numberOfProfiles]);
+    }
+  }
+
+  /** Evaluate sub-band j at the frequency modulo square w2. */
+  inline FunctionValueType
+  EvaluateSubBand(const double & w2, unsigned int j) const
+  {
+    const unsigned int        numberOfProfiles = this->m_HighPassSubBands + 1;
+    double                    weights[4];
+    const FunctionValueType * samples = this->ComputeInterpolation(w2, weights) + j;
+    return static_cast<FunctionValueType>(weights[0] * samples[0] + weights[1] * samples[numberOfProfiles] +
+                                          weights[2] * samples[2 * numberOfProfiles] +
+                                          weights[3] * samples[3 * numberOfProfiles]);
+  }
+
+protected:
+  IsotropicWaveletProfileTable() = default;
+  ~IsotropicWaveletProfileTable() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Weights of the cubic interpolation at w2. Returns the first of the four samples
+   * around the interval containing w2. */
+  inline const FunctionValueType *
+  ComputeInterpolation(const double & w2, double * weights) const
+  {
+    const double        position = std::min(w2, this->m_MaximumFrequencyModuloSquare) * this->m_InverseIntervalLength;
+    const SizeValueType interval = std::min(static_cast<SizeValueType>(position), this->m_NumberOfIntervals - 1);
+    const double        t = position - static_cast<double>(interval);
+    ComputeCubicWeights(t, weights);
+    // The sample of the interval is stored after the padding sample.
+    return &this->m_Values[interval * (this->m_HighPassSubBands + 1)];
+  }
+
+  /** Lagrange weights of the samples at -1, 0, 1, 2 to interpolate at t. */
+  static inline void
+  ComputeCubicWeights(const double & t, double * weights)
+  {
+    const double tPlusOne = t + 1;
+    const double tMinusOne = t - 1;
+    const double tMinusTwo = t - 2;
+    weights[0] = -t * tMinusOne * tMinusTwo / 6.0;
+    weights[1] = tPlusOne * tMinusOne * tMinusTwo / 2.0;
+    weights[2] = -tPlusOne * t * tMinusTwo / 2.0;
+    weights[3] = tPlusOne * t * tMinusOne / 6.0;
+  }
+
+  /** Evaluate the profiles at the frequency modulo square w2 using the wavelet function. */
+  void
+  EvaluateProfiles(const WaveletFunctionType * waveletFunction, const double & w2, FunctionValueType * values) const;
+
+private:
+  bool          m_InverseBank{ false };
+  double        m_LevelFactor{ 1 };
+  double        m_MaximumFrequencyModuloSquare{ 0.75 };
+  double        m_Tolerance{ 1e-6 };
+  SizeValueType m_MaximumNumberOfIntervals{ 65536 };
+
+  unsigned int  m_HighPassSubBands{ 0 };
+  SizeValueType m_NumberOfIntervals{ 0 };
+  double        m_InverseIntervalLength{ 0 };
+  double        m_MaximumError{ 0 };
+  bool          m_IsWithinTolerance{ false };
+  bool          m_IsConstantBeyondMaximum{ false };
+  /** Profiles stored per sample: all the sub-bands of a sample are contiguous.
+   * Samples go from -1 to NumberOfIntervals + 1, the sample at -1 is the reflection of the sample at 1. */
+  std::vector<FunctionValueType> m_Values;
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkIsotropicWaveletProfileTable.hxx"
+#endif
+
+#endif
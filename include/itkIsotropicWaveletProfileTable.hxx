@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsotropicWaveletProfileTable_hxx
+#define itkIsotropicWaveletProfileTable_hxx
+#include "itkIsotropicWaveletProfileTable.h"
+#include <cmath>
+
+namespace itk
+{
+template <typename TWaveletFunction>
+void
+IsotropicWaveletProfileTable<TWaveletFunction>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "InverseBank: " << (this->m_InverseBank ? "true" : "false") << std::endl;
+  os << indent << "LevelFactor: " << this->m_LevelFactor << std::endl;
+  os << indent << "MaximumFrequencyModuloSquare: " << this->m_MaximumFrequencyModuloSquare << std::endl;
+  os << indent << "Tolerance: " << this->m_Tolerance << std::endl;
+  os << indent << "MaximumNumberOfIntervals: " << this->m_MaximumNumberOfIntervals << std::endl;
+  os << indent << "HighPassSubBands: " << this->m_HighPassSubBands << std::endl;
+  os << indent << "NumberOfIntervals: " << this->m_NumberOfIntervals << std::endl;
+  os << indent << "MaximumError: " << this->m_MaximumError << std::endl;
+  os << indent << "IsWithinTolerance: " << (this->m_IsWithinTolerance ? "true" : "false") << std::endl;
+  os << indent << "IsConstantBeyondMaximum: " << (this->m_IsConstantBeyondMaximum ? "true" : "false") << std::endl;
+}
+
+template <typename TWaveletFunction>
+void
+IsotropicWaveletProfileTable<TWaveletFunction>::EvaluateProfiles(const WaveletFunctionType * waveletFunction,
+                                                                 const double &              w2,
+                                                                 FunctionValueType *         values) const
+{
+  // Negative values are reflected, to pad the table before zero.
+  const auto w = static_cast<FunctionValueType>(this->m_LevelFactor * std::sqrt(std::abs(w2)));
+  for (unsigned int j = 0; j < this->m_HighPassSubBands + 1; ++j)
+  {
+    if (this->m_InverseBank)
+    {
+      values[j] = waveletFunction->EvaluateInverseSubBand(w, j);
+    }
+    else
+    {
+      values[j] = waveletFunction->EvaluateForwardSubBand(w, j);
+    }
+  }
+}
+
+template <typename TWaveletFunction>
+void
+IsotropicWaveletProfileTable<TWaveletFunction>::Compute(const WaveletFunctionType * waveletFunction)
+{
+  if (waveletFunction == nullptr)
+  {
+    itkExceptionMacro(<< "WaveletFunction is null.");
+  }
+  if (!(this->m_MaximumFrequencyModuloSquare > 0) || this->m_MaximumNumberOfIntervals < 1)
+  {
+    itkExceptionMacro(<< "MaximumFrequencyModuloSquare and MaximumNumberOfIntervals must be greater than zero.");
+  }
+
+  this->m_HighPassSubBands = waveletFunction->GetHighPassSubBands();
+  const unsigned int numberOfProfiles = this->m_HighPassSubBands + 1;
+
+  // Start with a coarse table, and refine it reusing the evaluations at the middle points.
+  // Sample k is stored at (k + 1) * numberOfProfiles, from k = -1 to numberOfIntervals + 1.
+  SizeValueType numberOfIntervals = std::min(static_cast<SizeValueType>(256), this->m_MaximumNumberOfIntervals);
+  double        intervalLength = this->m_MaximumFrequencyModuloSquare / numberOfIntervals;
+
+  std::vector<FunctionValueType> values((numberOfIntervals + 3) * numberOfProfiles);
+  for (SizeValueType k = 0; k < numberOfIntervals + 3; ++k)
+  {
+    const double w2 = (static_cast<double>(k) - 1) * intervalLength;
+    this->EvaluateProfiles(waveletFunction, w2, &values[k * numberOfProfiles]);
+  }
+
+  double maximumError = 0;
+  double weights[4];
+  ComputeCubicWeights(0.5, weights);
+  while (true)
+  {
+    std::vector<FunctionValueType> middleValues((numberOfIntervals + 1) * numberOfProfiles);
+    maximumError = 0;
+    for (SizeValueType i = 0; i < numberOfIntervals + 1; ++i)
+    {
+      this->EvaluateProfiles(waveletFunction, (i + 0.5) * intervalLength, &middleValues[i * numberOfProfiles]);
+      if (i == numberOfIntervals)
+      {
+        // Only needed for the refinement.
+        break;
+      }
+      const FunctionValueType * samples = &values[i * numberOfProfiles];
+      for (unsigned int j = 0; j < numberOfProfiles; ++j)
+      {
+        const double interpolated =
+          weights[0] * samples[j] + weights[1] * samples[j + numberOfProfiles] +
+          weights[2] * samples[j + 2 * numberOfProfiles] + weights[3] * samples[j + 3 * numberOfProfiles];
+        maximumError = std::max(maximumError, std::abs(interpolated - middleValues[i * numberOfProfiles + j]));
+      }
+    }
+
+    if (maximumError <= this->m_Tolerance || 2 * numberOfIntervals > this->m_MaximumNumberOfIntervals)
+    {
+      break;
+    }
+
+    // Refined sample 2k is the previous sample k, refined sample 2k + 1 is the previous middle point k.
+    // Refined sample -1 is the reflection of the middle point 0.
+    const SizeValueType            refinedNumberOfIntervals = 2 * numberOfIntervals;
+    std::vector<FunctionValueType> refinedValues((refinedNumberOfIntervals + 3) * numberOfProfiles);
+    std::copy_n(&middleValues[0], numberOfProfiles, &refinedValues[0]);
+    for (SizeValueType k = 0; k < numberOfIntervals + 1; ++k)
+    {
+      std::copy_n(
+        &values[(k + 1) * numberOfProfiles], numberOfProfiles, &refinedValues[(2 * k + 1) * numberOfProfiles]);
+      std::copy_n(
+        &middleValues[k * numberOfProfiles], numberOfProfiles, &refinedValues[(2 * k + 2) * numberOfProfiles]);
+    }
+    values.swap(refinedValues);
+    numberOfIntervals = refinedNumberOfIntervals;
+    intervalLength /= 2;
+  }
+
+  // Clamping bigger frequencies to the maximum is exact if the profiles do not change beyond it.
+  std::vector<FunctionValueType> maximumValues(numberOfProfiles);
+  std::vector<FunctionValueType> beyondValues(numberOfProfiles);
+  this->EvaluateProfiles(waveletFunction, this->m_MaximumFrequencyModuloSquare, maximumValues.data());
+  bool isConstantBeyondMaximum = true;
+  for (unsigned int k = 1; k <= 256 && isConstantBeyondMaximum; ++k)
+  {
+    this->EvaluateProfiles(
+      waveletFunction, this->m_MaximumFrequencyModuloSquare * std::exp2(k / 8.0), beyondValues.data());
+    for (unsigned int j = 0; j < numberOfProfiles; ++j)
+    {
+      isConstantBeyondMaximum &= std::abs(beyondValues[j] - maximumValues[j]) <= this->m_Tolerance;
+    }
+  }
+
+  this->m_Values.swap(values);
+  this->m_NumberOfIntervals = numberOfIntervals;
+  this->m_InverseIntervalLength = 1.0 / intervalLength;
+  this->m_MaximumError = maximumError;
+  this->m_IsWithinTolerance = maximumError <= this->m_Tolerance;
+  this->m_IsConstantBeyondMaximum = isConstantBeyondMaximum;
+  this->Modified();
+}
+} // end namespace itk
+#endif
@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsotropicWaveletProfileTableCache_h
+#define itkIsotropicWaveletProfileTableCache_h
+
+#include <itkIsotropicWaveletProfileTable.h>
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace itk
+{
+/** \class IsotropicWaveletProfileTableCache
+ * \brief Thread-safe cache of the profile tables of the isotropic wavelets, shared by the filter banks.
+ *
+ * The profiles of a filter bank with LevelFactor f are the profiles of level 0 evaluated at f * w,
+ * so one table of level 0 per wavelet function, HighPassSubBands, InverseBank and Tolerance serves all
+ * the levels of all the transforms. WaveletFrequencyFilterBankGenerator evaluates it at f^2 * w^2.
+ *
+ * A process-wide instance is shared by all the filter banks with the same wavelet function type, \sa GetInstance.
+ *
+ * A cached table covering smaller frequency modulo squares than requested is reused if its profiles
+ * are constant beyond its maximum, \sa IsotropicWaveletProfileTable::GetIsConstantBeyondMaximum.
+ * Otherwise it is replaced by a table covering the requested range.
+ * Tables are computed with the cache locked, so concurrent requests of the same table compute it once.
+ * The tables are not modified after they are cached, they can be evaluated concurrently.
+ *
+ * The wavelet function is identified by its class name, HighPassSubBands and
+ * IsotropicWaveletFrequencyFunction::GetWaveletParameters, as in WaveletFilterBankPyramidCache.
+ *
+ * \sa WaveletFrequencyFilterBankGenerator
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TWaveletFunction>
+class IsotropicWaveletProfileTableCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IsotropicWaveletProfileTableCache);
+
+  /** Standard type alias */
+  using Self = IsotropicWaveletProfileTableCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(IsotropicWaveletProfileTableCache, Object);
+
+  /** WaveletFunction and ProfileTable types */
+  using WaveletFunctionType = TWaveletFunction;
+  using ProfileTableType = IsotropicWaveletProfileTable<WaveletFunctionType>;
+  using ProfileTableConstPointer = typename ProfileTableType::ConstPointer;
+
+  /** Wavelet function and parameters identifying a profile table. */
+  struct KeyType
+  {
+    std::string         WaveletName;
+    std::vector<double> WaveletParameters;
+    unsigned int        HighPassSubBands{ 0 };
+    bool                InverseBank{ false };
+    double              Tolerance{ 0 };
+
+    bool
+    operator<(const KeyType & other) const
+    {
+      return std::tie(WaveletName, WaveletParameters, HighPassSubBands, InverseBank, Tolerance) <
+             std::tie(other.WaveletName,
+                      other.WaveletParameters,
+                      other.HighPassSubBands,
+                      other.InverseBank,
+                      other.Tolerance);
+    }
+  };
+
+  /** Process-wide cache, used by default in WaveletFrequencyFilterBankGenerator. */
+  static Self *
+  GetInstance();
+
+  /** Key of the table of waveletFunction with its current HighPassSubBands. */
+  static KeyType
+  ComputeKey(const WaveletFunctionType * waveletFunction, const bool & inverseBank, const double & tolerance);
+
+  /** Table of level 0 (LevelFactor 1) of waveletFunction, valid for frequency modulo squares up to
+   * maximumFrequencyModuloSquare. It is computed only if there is no valid table in the cache. */
+  ProfileTableConstPointer
+  GetProfileTable(const WaveletFunctionType * waveletFunction,
+                  const bool &                inverseBank,
+                  const double &              tolerance,
+                  const double &              maximumFrequencyModuloSquare);
+
+  /** Remove all the tables. */
+  void
+  Clear();
+
+  /** Number of cached tables. */
+  SizeValueType
+  GetNumberOfEntries() const;
+
+  /** Number of tables computed by GetProfileTable. */
+  SizeValueType
+  GetNumberOfComputedTables() const;
+
+protected:
+  IsotropicWaveletProfileTableCache() = default;
+  ~IsotropicWaveletProfileTableCache() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  std::map<KeyType, ProfileTableConstPointer> m_Tables;
+  SizeValueType                               m_NumberOfComputedTables{ 0 };
+  mutable std::mutex                          m_Mutex;
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkIsotropicWaveletProfileTableCache.hxx"
+#endif
+
+#endif
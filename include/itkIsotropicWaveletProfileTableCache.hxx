@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsotropicWaveletProfileTableCache_hxx
+#define itkIsotropicWaveletProfileTableCache_hxx
+#include "itkIsotropicWaveletProfileTableCache.h"
+#include <algorithm>
+
+namespace itk
+{
+template <typename TWaveletFunction>
+void
+IsotropicWaveletProfileTableCache<TWaveletFunction>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  os << indent << "NumberOfEntries: " << this->m_Tables.size() << std::endl;
+  os << indent << "NumberOfComputedTables: " << this->m_NumberOfComputedTables << std::endl;
+}
+
+template <typename TWaveletFunction>
+typename IsotropicWaveletProfileTableCache<TWaveletFunction>::Self *
+IsotropicWaveletProfileTableCache<TWaveletFunction>::GetInstance()
+{
+  // Initialization of local statics is thread safe.
+  static const Pointer instance = Self::New();
+  return instance.GetPointer();
+}
+
+template <typename TWaveletFunction>
+typename IsotropicWaveletProfileTableCache<TWaveletFunction>::KeyType
+IsotropicWaveletProfileTableCache<TWaveletFunction>::ComputeKey(const WaveletFunctionType * waveletFunction,
+                                                                const bool &                inverseBank,
+                                                                const double &              tolerance)
+{
+  KeyType key;
+  key.WaveletName = waveletFunction->GetNameOfClass();
+  key.WaveletParameters = waveletFunction->GetWaveletParameters();
+  key.HighPassSubBands = waveletFunction->GetHighPassSubBands();
+  key.InverseBank = inverseBank;
+  key.Tolerance = tolerance;
+  return key;
+}
+
+template <typename TWaveletFunction>
+typename IsotropicWaveletProfileTableCache<TWaveletFunction>::ProfileTableConstPointer
+IsotropicWaveletProfileTableCache<TWaveletFunction>::GetProfileTable(
+  const WaveletFunctionType * waveletFunction,
+  const bool &                inverseBank,
+  const double &              tolerance,
+  const double &              maximumFrequencyModuloSquare)
+{
+  if (waveletFunction == nullptr)
+  {
+    itkExceptionMacro(<< "WaveletFunction is null.");
+  }
+  const KeyType key = Self::ComputeKey(waveletFunction, inverseBank, tolerance);
+
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  auto                        tableIt = this->m_Tables.find(key);
+  double                      maximum = maximumFrequencyModuloSquare;
+  if (tableIt != this->m_Tables.end())
+  {
+    const ProfileTableType * cachedTable = tableIt->second;
+    if (cachedTable->GetMaximumFrequencyModuloSquare() >= maximumFrequencyModuloSquare ||
+        cachedTable->GetIsConstantBeyondMaximum())
+    {
+      return tableIt->second;
+    }
+    maximum = std::max(maximum, cachedTable->GetMaximumFrequencyModuloSquare());
+  }
+
+  // A table in use by other callers is not modified, it is replaced.
+  auto table = ProfileTableType::New();
+  table->SetInverseBank(inverseBank);
+  table->SetTolerance(tolerance);
+  table->SetMaximumFrequencyModuloSquare(maximum);
+  table->Compute(waveletFunction);
+  ++this->m_NumberOfComputedTables;
+  itkDebugMacro(<< "Computed profile table of " << key.WaveletName << " with " << table->GetNumberOfIntervals()
+                << " intervals, maximum error: " << table->GetMaximumError());
+  this->m_Tables[key] = table.GetPointer();
+  return table.GetPointer();
+}
+
+template <typename TWaveletFunction>
+void
+IsotropicWaveletProfileTableCache<TWaveletFunction>::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  this->m_Tables.clear();
+}
+
+template <typename TWaveletFunction>
+SizeValueType
+IsotropicWaveletProfileTableCache<TWaveletFunction>::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_Tables.size();
+}
+
+template <typename TWaveletFunction>
+SizeValueType
+IsotropicWaveletProfileTableCache<TWaveletFunction>::GetNumberOfComputedTables() const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_NumberOfComputedTables;
+}
+} // end namespace itk
+#endif
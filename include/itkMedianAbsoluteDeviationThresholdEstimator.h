@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMedianAbsoluteDeviationThresholdEstimator_h
+#define itkMedianAbsoluteDeviationThresholdEstimator_h
+
+#include "itkPhaseAnalysisThresholdEstimator.h"
+
+namespace itk
+{
+/** \class MedianAbsoluteDeviationThresholdEstimator
+ * Robust threshold of the amplitude from its median and median absolute deviation (MAD).
+ *
+ * \f[ T = \text{median} + \text{NumOfSigmas} \cdot \text{ScaleFactor} \cdot \text{MAD} \f]
+ *
+ * The default ScaleFactor 1.4826 makes ScaleFactor * MAD a consistent estimator of sigma for Gaussian noise,
+ * as in the noise estimation of Donoho and Johnstone. Unlike mean and sigma, it is not biased by the few
+ * coefficients with large amplitude of each band.
+ * The median and MAD are computed from the quantile sketch of PhaseAnalysisAmplitudeStatistics.
+ *
+ * \sa PhaseAnalysisThresholdEstimator
+ * \ingroup IsotropicWavelets
+ */
+class IsotropicWavelets_EXPORT MedianAbsoluteDeviationThresholdEstimator : public PhaseAnalysisThresholdEstimator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MedianAbsoluteDeviationThresholdEstimator);
+
+  /** Standard class type alias. */
+  using Self = MedianAbsoluteDeviationThresholdEstimator;
+  using Superclass = PhaseAnalysisThresholdEstimator;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(MedianAbsoluteDeviationThresholdEstimator, PhaseAnalysisThresholdEstimator);
+
+  /** Number of robust sigmas over the median. Default: 2.0. */
+  itkSetMacro(NumOfSigmas, double);
+  itkGetConstMacro(NumOfSigmas, double);
+
+  /** Factor from MAD to sigma. Default: 1.4826. */
+  itkSetMacro(ScaleFactor, double);
+  itkGetConstMacro(ScaleFactor, double);
+
+  bool
+  GetRequiresQuantiles() const override
+  {
+    return true;
+  }
+
+  double
+  ComputeThreshold(const PhaseAnalysisAmplitudeStatistics & amplitudeStatistics) const override;
+
+protected:
+  MedianAbsoluteDeviationThresholdEstimator() = default;
+  ~MedianAbsoluteDeviationThresholdEstimator() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  double m_NumOfSigmas{ 2.0 };
+  double m_ScaleFactor{ 1.4826 };
+};
+} // end namespace itk
+
+#endif
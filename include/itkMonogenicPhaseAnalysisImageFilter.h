@@ -0,0 +1,184 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMonogenicPhaseAnalysisImageFilter_h
+#define itkMonogenicPhaseAnalysisImageFilter_h
+
+#include <itkImageToImageFilter.h>
+#include <itkInverseFFTImageFilter.h>
+#include <itkFrequencyFFTLayoutImageRegionConstIteratorWithIndex.h>
+#include "itkRieszFrequencyFunctionFixedOrder.h"
+#include "itkPhaseAnalysisThresholdEstimator.h"
+
+namespace itk
+{
+/** \class MonogenicPhaseAnalysisImageFilter
+ * Phase analysis of the monogenic signal of a complex image in the frequency domain, in one filter.
+ *
+ * It computes the same outputs than the pipeline:
+ * MonogenicSignalFrequencyImageFilter -> VectorInverseFFTImageFilter -> PhaseAnalysisSoftThresholdImageFilter,
+ * without the intermediate VectorImages of ImageDimension + 1 components.
+ * The input and each Riesz component \f$ R_i f \f$ are transformed to the spatial domain one at a time,
+ * reusing the same inverse FFT filter, and only the real part of the input and the sum of squares of the
+ * Riesz components are kept. The amplitude, phase and cosine of the phase are computed in a single pass over
+ * these two buffers.
+ *
+ * The input is a full (not half-Hermitian) complex image, for example a band of WaveletFrequencyForward.
+ * The outputs have the same indices than PhaseAnalysisSoftThresholdImageFilter: phase, amplitude and cos(phase),
+ * with the soft threshold applied to cos(phase) if ApplySoftThreshold is on.
+ * Only the outputs with GeneratePhase, GenerateAmplitude and GenerateCosPhase on are allocated and written,
+ * the others have no buffer.
+ *
+ * \sa MonogenicSignalFrequencyImageFilter
+ * \sa PhaseAnalysisSoftThresholdImageFilter
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TInputImage,
+          typename TOutputImage = Image<typename TInputImage::PixelType::value_type, TInputImage::ImageDimension>,
+          typename TFrequencyImageRegionConstIterator =
+            FrequencyFFTLayoutImageRegionConstIteratorWithIndex<TInputImage>>
+class MonogenicPhaseAnalysisImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MonogenicPhaseAnalysisImageFilter);
+
+  /** Standard class type alias. */
+  using Self = MonogenicPhaseAnalysisImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(MonogenicPhaseAnalysisImageFilter, ImageToImageFilter);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /// This ensure that InputPixelType is complex<float||double>
+  itkConceptMacro(InputPixelTypeIsComplexAndFloatCheck,
+                  (Concept::IsFloatingPoint<typename TInputImage::PixelType::value_type>));
+  itkConceptMacro(OutputPixelTypeIsFloatCheck, (Concept::IsFloatingPoint<typename TOutputImage::PixelType>));
+#endif
+
+  /** Some convenient type alias. */
+  using InputFrequencyImageRegionConstIterator = TFrequencyImageRegionConstIterator;
+  using InputImageType = typename Superclass::InputImageType;
+  using InputImagePointer = typename InputImageType::Pointer;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using OutputImageType = typename Superclass::OutputImageType;
+  using OutputImagePointer = typename OutputImageType::Pointer;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using OutputImagePixelType = typename OutputImageType::PixelType;
+
+  /** RieszFunction type alias. The monogenic signal uses the Riesz transform of order 1. */
+  using RieszFunctionType = RieszFrequencyFunctionFixedOrder<1, typename InputImageType::PixelType, ImageDimension>;
+  using RieszFunctionPointer = typename RieszFunctionType::Pointer;
+  using InverseFFTType = InverseFFTImageFilter<InputImageType, OutputImageType>;
+
+  /** Get the riesz function */
+  itkGetModifiableObjectMacro(Evaluator, RieszFunctionType);
+
+  OutputImageType *
+  GetOutputPhase()
+  {
+    return itkDynamicCastInDebugMode<OutputImageType *>(this->GetOutput(0));
+  }
+
+  OutputImageType *
+  GetOutputAmplitude()
+  {
+    return itkDynamicCastInDebugMode<OutputImageType *>(this->GetOutput(1));
+  }
+
+  OutputImageType *
+  GetOutputCosPhase()
+  {
+    return itkDynamicCastInDebugMode<OutputImageType *>(this->GetOutput(2));
+  }
+
+  /** Flags to generate each output. Default: true. */
+  itkSetMacro(GeneratePhase, bool);
+  itkGetConstMacro(GeneratePhase, bool);
+  itkBooleanMacro(GeneratePhase);
+  itkSetMacro(GenerateAmplitude, bool);
+  itkGetConstMacro(GenerateAmplitude, bool);
+  itkBooleanMacro(GenerateAmplitude);
+  itkSetMacro(GenerateCosPhase, bool);
+  itkGetConstMacro(GenerateCosPhase, bool);
+  itkBooleanMacro(GenerateCosPhase);
+
+  /** Soft threshold of cos(phase), with the same parameters than PhaseAnalysisSoftThresholdImageFilter. */
+  itkSetMacro(ApplySoftThreshold, bool);
+  itkGetConstMacro(ApplySoftThreshold, bool);
+  itkBooleanMacro(ApplySoftThreshold);
+
+  itkSetMacro(NumOfSigmas, OutputImagePixelType);
+  itkGetConstMacro(NumOfSigmas, OutputImagePixelType);
+  itkGetConstMacro(MeanAmp, OutputImagePixelType);
+  itkGetConstMacro(SigmaAmp, OutputImagePixelType);
+  itkGetConstMacro(Threshold, OutputImagePixelType);
+
+  /** Estimator of the soft threshold. If it is not set (default), the threshold is mean + NumOfSigmas * sigma. */
+  itkSetObjectMacro(ThresholdEstimator, PhaseAnalysisThresholdEstimator);
+  itkGetModifiableObjectMacro(ThresholdEstimator, PhaseAnalysisThresholdEstimator);
+
+protected:
+  MonogenicPhaseAnalysisImageFilter();
+  ~MonogenicPhaseAnalysisImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The FFT requires the whole input and generates the whole output. */
+  void
+  GenerateInputRequestedRegion() override;
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  /** rieszComponent = input * R_direction, the Riesz component in the frequency domain. */
+  void
+  ThreadedComputeRieszComponent(const InputImageRegionType & inputRegionForThread,
+                                const unsigned int &          direction,
+                                InputImageType *              rieszComponent) const;
+
+  RieszFunctionPointer m_Evaluator;
+
+  bool                 m_GeneratePhase{ true };
+  bool                 m_GenerateAmplitude{ true };
+  bool                 m_GenerateCosPhase{ true };
+  bool                 m_ApplySoftThreshold{ true };
+  OutputImagePixelType m_NumOfSigmas;
+  OutputImagePixelType m_MeanAmp;
+  OutputImagePixelType m_SigmaAmp;
+  OutputImagePixelType m_Threshold;
+
+  PhaseAnalysisThresholdEstimator::Pointer m_ThresholdEstimator;
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkMonogenicPhaseAnalysisImageFilter.hxx"
+#endif
+
+#endif
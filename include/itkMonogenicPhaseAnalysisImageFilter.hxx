@@ -0,0 +1,344 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMonogenicPhaseAnalysisImageFilter_hxx
+#define itkMonogenicPhaseAnalysisImageFilter_hxx
+#include "itkMonogenicPhaseAnalysisImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkPhaseAnalysisAmplitudeStatistics.h"
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage, typename TFrequencyImageRegionConstIterator>
+MonogenicPhaseAnalysisImageFilter<TInputImage, TOutputImage, TFrequencyImageRegionConstIterator>::
+  MonogenicPhaseAnalysisImageFilter()
+  : m_NumOfSigmas(2.0)
+  , m_MeanAmp(0)
+  , m_SigmaAmp(0)
+  , m_Threshold(0)
+{
+  m_Evaluator = RieszFunctionType::New();
+
+  this->SetNumberOfRequiredInputs(1);
+  this->SetNumberOfRequiredOutputs(3);
+  for (unsigned int n_output = 0; n_output < 3; ++n_output)
+  {
+    this->SetNthOutput(n_output, this->MakeOutput(n_output));
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFrequencyImageRegionConstIterator>
+void
+MonogenicPhaseAnalysisImageFilter<TInputImage, TOutputImage, TFrequencyImageRegionConstIterator>::
+  GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFrequencyImageRegionConstIterator>
+void
+MonogenicPhaseAnalysisImageFilter<TInputImage, TOutputImage, TFrequencyImageRegionConstIterator>::
+  EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFrequencyImageRegionConstIterator>
+void
+MonogenicPhaseAnalysisImageFilter<TInputImage, TOutputImage, TFrequencyImageRegionConstIterator>::GenerateData()
+{
+  const InputImageType * input = this->GetInput();
+  const auto             region = input->GetLargestPossibleRegion();
+
+  // The input in the spatial domain, first component of the monogenic signal.
+  auto inverseFFT = InverseFFTType::New();
+  inverseFFT->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  inverseFFT->SetInput(input);
+  inverseFFT->Update();
+  OutputImagePointer spatialInput = inverseFFT->GetOutput();
+  spatialInput->DisconnectPipeline();
+
+  // Sum of squares of the Riesz components in the spatial domain.
+  // The components are computed and transformed one at a time, reusing the buffer and the inverse FFT.
+  auto featureSquare = OutputImageType::New();
+  featureSquare->CopyInformation(spatialInput);
+  featureSquare->SetRegions(region);
+  featureSquare->Allocate(true);
+  auto rieszComponent = InputImageType::New();
+  rieszComponent->CopyInformation(input);
+  rieszComponent->SetRegions(region);
+  rieszComponent->Allocate();
+  inverseFFT->SetInput(rieszComponent);
+  for (unsigned int direction = 0; direction < ImageDimension; ++direction)
+  {
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      region,
+      [this, direction, &rieszComponent](const InputImageRegionType & inputRegionForThread) {
+        this->ThreadedComputeRieszComponent(inputRegionForThread, direction, rieszComponent);
+      },
+      nullptr);
+    rieszComponent->Modified();
+    inverseFFT->Update();
+
+    const OutputImageType * spatialComponent = inverseFFT->GetOutput();
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      region,
+      [&spatialComponent, &featureSquare](const OutputImageRegionType & outputRegionForThread) {
+        ImageScanlineConstIterator<OutputImageType> componentIt(spatialComponent, outputRegionForThread);
+        ImageScanlineIterator<OutputImageType>      featureIt(featureSquare, outputRegionForThread);
+        while (!componentIt.IsAtEnd())
+        {
+          while (!componentIt.IsAtEndOfLine())
+          {
+            const OutputImagePixelType value = componentIt.Get();
+            featureIt.Set(featureIt.Get() + value * value);
+            ++componentIt, ++featureIt;
+          }
+          componentIt.NextLine(), featureIt.NextLine();
+        }
+      },
+      nullptr);
+  }
+  // Release the frequency domain buffers before allocating the outputs.
+  rieszComponent = nullptr;
+  inverseFFT = nullptr;
+
+  OutputImageType * phasePtr = this->m_GeneratePhase ? this->GetOutputPhase() : nullptr;
+  OutputImageType * amplitudePtr = this->m_GenerateAmplitude ? this->GetOutputAmplitude() : nullptr;
+  OutputImageType * cosPhasePtr = this->m_GenerateCosPhase ? this->GetOutputCosPhase() : nullptr;
+  for (unsigned int n_output = 0; n_output < 3; ++n_output)
+  {
+    OutputImageType * outputPtr = this->GetOutput(n_output);
+    if (outputPtr == phasePtr || outputPtr == amplitudePtr || outputPtr == cosPhasePtr)
+    {
+      outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+      outputPtr->Allocate();
+    }
+    else
+    {
+      outputPtr->ReleaseData();
+    }
+  }
+
+  // Phase, amplitude and cos(phase) in one pass. The amplitude statistics are accumulated for the soft threshold.
+  const bool computeStatistics = this->m_ApplySoftThreshold;
+  const bool useEstimator = computeStatistics && this->m_ThresholdEstimator.IsNotNull();
+  double     quantileRelativeAccuracy = 0.0;
+  if (useEstimator && this->m_ThresholdEstimator->GetRequiresQuantiles())
+  {
+    quantileRelativeAccuracy = this->m_ThresholdEstimator->GetQuantileRelativeAccuracy();
+  }
+  PhaseAnalysisAmplitudeStatistics amplitudeStatistics(quantileRelativeAccuracy);
+  std::mutex                       statisticsMutex;
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [&](const OutputImageRegionType & outputRegionForThread) {
+      using OutputIteratorType = ImageScanlineIterator<OutputImageType>;
+      ImageScanlineConstIterator<OutputImageType> f0It(spatialInput, outputRegionForThread);
+      ImageScanlineConstIterator<OutputImageType> featureIt(featureSquare, outputRegionForThread);
+      OutputIteratorType                          phaseIt;
+      OutputIteratorType                          ampIt;
+      OutputIteratorType                          cosIt;
+      if (phasePtr)
+      {
+        phaseIt = OutputIteratorType(phasePtr, outputRegionForThread);
+      }
+      if (amplitudePtr)
+      {
+        ampIt = OutputIteratorType(amplitudePtr, outputRegionForThread);
+      }
+      if (cosPhasePtr)
+      {
+        cosIt = OutputIteratorType(cosPhasePtr, outputRegionForThread);
+      }
+      PhaseAnalysisAmplitudeStatistics threadStatistics(quantileRelativeAccuracy);
+      while (!f0It.IsAtEnd())
+      {
+        while (!f0It.IsAtEndOfLine())
+        {
+          const double f0 = f0It.Get();
+          const double featureAmpSquare = featureIt.Get();
+          const double amplitude = std::sqrt(f0 * f0 + featureAmpSquare);
+          if (computeStatistics)
+          {
+            threadStatistics.Add(amplitude);
+          }
+          if (phasePtr)
+          {
+            phaseIt.Set(static_cast<OutputImagePixelType>(std::atan2(std::sqrt(featureAmpSquare), f0)));
+            ++phaseIt;
+          }
+          if (amplitudePtr)
+          {
+            ampIt.Set(static_cast<OutputImagePixelType>(amplitude));
+            ++ampIt;
+          }
+          if (cosPhasePtr)
+          {
+            // cos(atan2(A_F, f0)) = f0 / A, and 1 where the amplitude is zero.
+            cosIt.Set(static_cast<OutputImagePixelType>(amplitude > 0.0 ? f0 / amplitude : 1.0));
+            ++cosIt;
+          }
+          ++f0It, ++featureIt;
+        }
+        f0It.NextLine(), featureIt.NextLine();
+        if (phasePtr)
+        {
+          phaseIt.NextLine();
+        }
+        if (amplitudePtr)
+        {
+          ampIt.NextLine();
+        }
+        if (cosPhasePtr)
+        {
+          cosIt.NextLine();
+        }
+      }
+      if (computeStatistics)
+      {
+        const std::lock_guard<std::mutex> lock(statisticsMutex);
+        amplitudeStatistics.Merge(threadStatistics);
+      }
+    },
+    nullptr);
+
+  if (!computeStatistics)
+  {
+    return;
+  }
+  this->m_MeanAmp = static_cast<OutputImagePixelType>(amplitudeStatistics.GetMean());
+  this->m_SigmaAmp = static_cast<OutputImagePixelType>(amplitudeStatistics.GetSigma());
+  if (useEstimator)
+  {
+    this->m_Threshold =
+      static_cast<OutputImagePixelType>(this->m_ThresholdEstimator->ComputeThreshold(amplitudeStatistics));
+  }
+  else
+  {
+    this->m_Threshold = this->m_MeanAmp + this->m_NumOfSigmas * this->m_SigmaAmp;
+  }
+  if (!cosPhasePtr)
+  {
+    return;
+  }
+
+  // Soft threshold: cos(phase) * amplitude / threshold where amplitude < threshold.
+  const OutputImagePixelType threshold = this->m_Threshold;
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [&](const OutputImageRegionType & outputRegionForThread) {
+      ImageScanlineConstIterator<OutputImageType> f0It(spatialInput, outputRegionForThread);
+      ImageScanlineConstIterator<OutputImageType> featureIt(featureSquare, outputRegionForThread);
+      ImageScanlineIterator<OutputImageType>      cosIt(cosPhasePtr, outputRegionForThread);
+      while (!cosIt.IsAtEnd())
+      {
+        while (!cosIt.IsAtEndOfLine())
+        {
+          const double f0 = f0It.Get();
+          const auto   amplitude = static_cast<OutputImagePixelType>(std::sqrt(f0 * f0 + featureIt.Get()));
+          if (amplitude < threshold)
+          {
+            cosIt.Set(cosIt.Get() * amplitude / threshold);
+          }
+          ++f0It, ++featureIt, ++cosIt;
+        }
+        f0It.NextLine(), featureIt.NextLine(), cosIt.NextLine();
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFrequencyImageRegionConstIterator>
+void
+MonogenicPhaseAnalysisImageFilter<TInputImage, TOutputImage, TFrequencyImageRegionConstIterator>::
+  ThreadedComputeRieszComponent(const InputImageRegionType & inputRegionForThread,
+                                const unsigned int &          direction,
+                                InputImageType *              rieszComponent) const
+{
+  using ComponentType = typename RieszFunctionType::OutputComplexType;
+  const SizeValueType lineLength = inputRegionForThread.GetSize(0);
+
+  InputFrequencyImageRegionConstIterator inFreqIt(this->GetInput(), inputRegionForThread);
+  ImageScanlineIterator<InputImageType>  outIt(rieszComponent, inputRegionForThread);
+
+  // Frequencies, input values and Riesz component of a scanline, reused for all the scanlines of the region.
+  std::vector<double>                               frequencyBuffer(ImageDimension * lineLength);
+  typename RieszFunctionType::FrequencyScanlineType frequencyScanline;
+  std::vector<typename InputImageType::PixelType>   inputBuffer(lineLength);
+  std::vector<ComponentType>                        componentBuffer(lineLength);
+  for (unsigned int dir = 0; dir < ImageDimension; ++dir)
+  {
+    frequencyScanline[dir] = &frequencyBuffer[dir * lineLength];
+  }
+
+  inFreqIt.GoToBegin();
+  while (!inFreqIt.IsAtEnd())
+  {
+    for (SizeValueType p = 0; p < lineLength; ++p, ++inFreqIt)
+    {
+      const auto frequency = inFreqIt.GetFrequency();
+      for (unsigned int dir = 0; dir < ImageDimension; ++dir)
+      {
+        frequencyBuffer[dir * lineLength + p] = frequency[dir];
+      }
+      inputBuffer[p] = inFreqIt.Get();
+    }
+
+    // Only the component of this direction, the other ones are computed in their own pass.
+    this->m_Evaluator->EvaluateComponentOnScanline(frequencyScanline, lineLength, direction, componentBuffer.data());
+
+    for (SizeValueType p = 0; p < lineLength; ++p, ++outIt)
+    {
+      // This is a complex number multiplication.
+      outIt.Set(inputBuffer[p] * componentBuffer[p]);
+    }
+    outIt.NextLine();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFrequencyImageRegionConstIterator>
+void
+MonogenicPhaseAnalysisImageFilter<TInputImage, TOutputImage, TFrequencyImageRegionConstIterator>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "GeneratePhase: " << this->m_GeneratePhase << std::endl;
+  os << indent << "GenerateAmplitude: " << this->m_GenerateAmplitude << std::endl;
+  os << indent << "GenerateCosPhase: " << this->m_GenerateCosPhase << std::endl;
+  os << indent << "ApplySoftThreshold: " << this->m_ApplySoftThreshold << std::endl;
+  os << indent << "NumOfSigmas: " << this->m_NumOfSigmas << std::endl;
+  os << indent << "Threshold : " << this->m_Threshold << std::endl;
+  os << indent << "Mean Amplitude : " << this->m_MeanAmp << std::endl;
+  os << indent << "Sigma Amplitude: " << this->m_SigmaAmp << std::endl;
+  itkPrintSelfObjectMacro(Evaluator);
+  itkPrintSelfObjectMacro(ThresholdEstimator);
+}
+} // end namespace itk
+#endif
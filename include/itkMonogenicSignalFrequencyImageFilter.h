@@ -21,7 +21,7 @@
 #include <itkImageToImageFilter.h>
 #include <itkVectorImage.h>
 #include <itkFrequencyFFTLayoutImageRegionConstIteratorWithIndex.h>
-#include "itkRieszFrequencyFunction.h"
+#include "itkRieszFrequencyFunctionFixedOrder.h"
 namespace itk
 {
 /** \class MonogenicSignalFrequencyImageFilter
@@ -76,8 +76,8 @@ public:
   using OutputImagePointer = typename Superclass::OutputImagePointer;
   using OutputImageRegionType = typename Superclass::OutputImageRegionType;
 
-  /** RieszFunction type alias. */
-  using RieszFunctionType = RieszFrequencyFunction<typename InputImageType::PixelType, ImageDimension>;
+  /** RieszFunction type alias. The monogenic signal uses the Riesz transform of order 1. */
+  using RieszFunctionType = RieszFrequencyFunctionFixedOrder<1, typename InputImageType::PixelType, ImageDimension>;
   using RieszFunctionPointer = typename RieszFunctionType::Pointer;
 
   /** Get the riesz function type */
@@ -18,7 +18,7 @@
 #ifndef itkMonogenicSignalFrequencyImageFilter_hxx
 #define itkMonogenicSignalFrequencyImageFilter_hxx
 #include "itkMonogenicSignalFrequencyImageFilter.h"
-#include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 namespace itk
 {
 template <typename TInputImage, typename TFrequencyImageRegionConstIterator>
@@ -46,24 +46,51 @@ void
 MonogenicSignalFrequencyImageFilter<TInputImage, TFrequencyImageRegionConstIterator>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
-  // Allocate the outputs
-  this->AllocateOutputs();
+  using ComponentType = typename RieszFunctionType::OutputComplexType;
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
   InputFrequencyImageRegionConstIterator inFreqIt(this->GetInput(), outputRegionForThread);
-  ImageRegionIterator<OutputImageType>   outIt(this->GetOutput(), outputRegionForThread);
+  ImageScanlineIterator<OutputImageType> outIt(this->GetOutput(), outputRegionForThread);
+
+  // Frequencies, input values and Riesz components of a scanline, reused for all the scanlines of the region.
+  std::vector<double>                               frequencyBuffer(ImageDimension * lineLength);
+  typename RieszFunctionType::FrequencyScanlineType frequencyScanline;
+  std::vector<typename InputImageType::PixelType>   inputBuffer(lineLength);
+  std::vector<ComponentType>                        componentBuffer(ImageDimension * lineLength);
+  typename RieszFunctionType::ComponentBuffersType  componentScanline(ImageDimension);
+  for (unsigned int dir = 0; dir < ImageDimension; ++dir)
+  {
+    frequencyScanline[dir] = &frequencyBuffer[dir * lineLength];
+    componentScanline[dir] = &componentBuffer[dir * lineLength];
+  }
 
-  typename RieszFunctionType::OutputComponentsType evaluatedArray;
-  typename OutputImageType::PixelType              out_value;
-  for (inFreqIt.GoToBegin(), outIt.GoToBegin(); !inFreqIt.IsAtEnd(); ++inFreqIt, ++outIt)
+  typename OutputImageType::PixelType out_value(ImageDimension + 1);
+  inFreqIt.GoToBegin();
+  while (!inFreqIt.IsAtEnd())
   {
-    evaluatedArray = this->m_Evaluator->EvaluateAllComponents(inFreqIt.GetFrequency());
-    out_value = outIt.Get();
-    out_value[0] = inFreqIt.Get();
-    for (unsigned int dir = 0; dir < ImageDimension; ++dir)
+    for (SizeValueType p = 0; p < lineLength; ++p, ++inFreqIt)
+    {
+      const auto frequency = inFreqIt.GetFrequency();
+      for (unsigned int dir = 0; dir < ImageDimension; ++dir)
+      {
+        frequencyBuffer[dir * lineLength + p] = frequency[dir];
+      }
+      inputBuffer[p] = inFreqIt.Get();
+    }
+
+    this->m_Evaluator->EvaluateAllComponentsOnScanline(frequencyScanline, lineLength, componentScanline);
+
+    for (SizeValueType p = 0; p < lineLength; ++p, ++outIt)
     {
-      // This is a complex number multiplication.
-      out_value[dir + 1] = inFreqIt.Get() * evaluatedArray[dir];
+      out_value[0] = inputBuffer[p];
+      for (unsigned int dir = 0; dir < ImageDimension; ++dir)
+      {
+        // This is a complex number multiplication.
+        out_value[dir + 1] = inputBuffer[p] * componentScanline[dir][p];
+      }
+      outIt.Set(out_value);
     }
-    outIt.Set(out_value);
+    outIt.NextLine();
   }
 }
 
@@ -0,0 +1,76 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPercentileThresholdEstimator_h
+#define itkPercentileThresholdEstimator_h
+
+#include "itkPhaseAnalysisThresholdEstimator.h"
+
+namespace itk
+{
+/** \class PercentileThresholdEstimator
+ * Threshold of the amplitude at a percentile of its distribution.
+ *
+ * With Percentile p, the cos(phase) of the (100 - p)% coefficients with the largest amplitude of each band
+ * are kept unmodified by the soft threshold, independently of the contrast of the band.
+ * The percentile is computed from the quantile sketch of PhaseAnalysisAmplitudeStatistics.
+ *
+ * \sa PhaseAnalysisThresholdEstimator
+ * \ingroup IsotropicWavelets
+ */
+class IsotropicWavelets_EXPORT PercentileThresholdEstimator : public PhaseAnalysisThresholdEstimator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PercentileThresholdEstimator);
+
+  /** Standard class type alias. */
+  using Self = PercentileThresholdEstimator;
+  using Superclass = PhaseAnalysisThresholdEstimator;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PercentileThresholdEstimator, PhaseAnalysisThresholdEstimator);
+
+  /** Percentile of the amplitude, in [0, 100]. Default: 90. */
+  itkSetClampMacro(Percentile, double, 0.0, 100.0);
+  itkGetConstMacro(Percentile, double);
+
+  bool
+  GetRequiresQuantiles() const override
+  {
+    return true;
+  }
+
+  double
+  ComputeThreshold(const PhaseAnalysisAmplitudeStatistics & amplitudeStatistics) const override;
+
+protected:
+  PercentileThresholdEstimator() = default;
+  ~PercentileThresholdEstimator() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  double m_Percentile{ 90.0 };
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,249 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPhaseAnalysisAmplitudeStatistics_h
+#define itkPhaseAnalysisAmplitudeStatistics_h
+
+#include <itkIntTypes.h>
+#include <itkNumericTraits.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class PhaseAnalysisAmplitudeStatistics
+ * Running mean and variance of the amplitude of a phase analysis, with Welford's algorithm.
+ *
+ * Each thread accumulates the values of its region with Add, and the partial results are combined
+ * with Merge (Chan et al. parallel update), so the statistics are known at the end of the pass that
+ * computes the amplitude, without storing or reading it again.
+ * GetVariance is the unbiased variance, the same than StatisticsImageFilter.
+ *
+ * If it is constructed with a quantile relative accuracy \f$ \alpha > 0 \f$, it also keeps a mergeable quantile
+ * sketch of the (non-negative) amplitude: logarithmic buckets \f$ (\gamma^{i-1}, \gamma^i] \f$ with
+ * \f$ \gamma = (1 + \alpha) / (1 - \alpha) \f$. GetQuantile returns a value with relative error at most
+ * \f$ \alpha \f$, and its memory depends on the dynamic range of the amplitude, not on the number of pixels.
+ *
+ * \sa PhaseAnalysisSoftThresholdImageFilter
+ * \sa MonogenicPhaseAnalysisImageFilter
+ * \sa PhaseAnalysisThresholdEstimator
+ * \ingroup IsotropicWavelets
+ */
+class PhaseAnalysisAmplitudeStatistics
+{
+public:
+  PhaseAnalysisAmplitudeStatistics() = default;
+
+  /** Keep a quantile sketch with the given relative accuracy, in (0, 1). 0 disables the sketch. */
+  explicit PhaseAnalysisAmplitudeStatistics(const double & quantileRelativeAccuracy)
+    : m_QuantileRelativeAccuracy(quantileRelativeAccuracy)
+  {
+    if (quantileRelativeAccuracy > 0.0)
+    {
+      this->m_LogGamma = std::log((1.0 + quantileRelativeAccuracy) / (1.0 - quantileRelativeAccuracy));
+    }
+  }
+
+  inline void
+  Add(const double & value)
+  {
+    ++this->m_Count;
+    const double delta = value - this->m_Mean;
+    this->m_Mean += delta / static_cast<double>(this->m_Count);
+    this->m_SquaredDifferences += delta * (value - this->m_Mean);
+    if (this->m_LogGamma > 0.0)
+    {
+      this->AddToSketch(value);
+    }
+  }
+
+  /** Both statistics must have been constructed with the same quantile relative accuracy. */
+  inline void
+  Merge(const PhaseAnalysisAmplitudeStatistics & other)
+  {
+    if (other.m_Count == 0)
+    {
+      return;
+    }
+    const SizeValueType count = this->m_Count + other.m_Count;
+    const double        delta = other.m_Mean - this->m_Mean;
+    const double        weight = static_cast<double>(other.m_Count) / static_cast<double>(count);
+    this->m_Mean += delta * weight;
+    this->m_SquaredDifferences += other.m_SquaredDifferences + delta * delta * this->m_Count * weight;
+    this->m_Count = count;
+
+    this->m_ZeroCount += other.m_ZeroCount;
+    if (!other.m_Buckets.empty())
+    {
+      this->ReserveBuckets(other.m_BucketOffset);
+      this->ReserveBuckets(other.m_BucketOffset + static_cast<int>(other.m_Buckets.size()) - 1);
+      for (unsigned int b = 0; b < other.m_Buckets.size(); ++b)
+      {
+        this->m_Buckets[other.m_BucketOffset - this->m_BucketOffset + b] += other.m_Buckets[b];
+      }
+    }
+  }
+
+  inline SizeValueType
+  GetCount() const
+  {
+    return this->m_Count;
+  }
+
+  inline double
+  GetMean() const
+  {
+    return this->m_Mean;
+  }
+
+  inline double
+  GetVariance() const
+  {
+    return this->m_Count > 1 ? this->m_SquaredDifferences / static_cast<double>(this->m_Count - 1) : 0.0;
+  }
+
+  inline double
+  GetSigma() const
+  {
+    return std::sqrt(this->GetVariance());
+  }
+
+  inline const double &
+  GetQuantileRelativeAccuracy() const
+  {
+    return this->m_QuantileRelativeAccuracy;
+  }
+
+  /** Quantile q in [0, 1] of the values, from the sketch. 0 if the sketch is disabled or empty. */
+  inline double
+  GetQuantile(const double & q) const
+  {
+    if (this->m_LogGamma <= 0.0 || this->m_Count == 0)
+    {
+      return 0.0;
+    }
+    const double  rank = std::min(std::max(q, 0.0), 1.0) * static_cast<double>(this->m_Count - 1);
+    SizeValueType cumulative = this->m_ZeroCount;
+    if (static_cast<double>(cumulative) > rank)
+    {
+      return 0.0;
+    }
+    for (unsigned int b = 0; b < this->m_Buckets.size(); ++b)
+    {
+      cumulative += this->m_Buckets[b];
+      if (static_cast<double>(cumulative) > rank)
+      {
+        return this->GetBucketValue(this->m_BucketOffset + static_cast<int>(b));
+      }
+    }
+    return this->GetBucketValue(this->m_BucketOffset + static_cast<int>(this->m_Buckets.size()) - 1);
+  }
+
+  inline double
+  GetMedian() const
+  {
+    return this->GetQuantile(0.5);
+  }
+
+  /** Median of |value - median|, from the sketch. Only the buckets are sorted, not the values. */
+  inline double
+  GetMedianAbsoluteDeviation() const
+  {
+    if (this->m_LogGamma <= 0.0 || this->m_Count == 0)
+    {
+      return 0.0;
+    }
+    const double                                  median = this->GetMedian();
+    std::vector<std::pair<double, SizeValueType>> deviations;
+    deviations.reserve(this->m_Buckets.size() + 1);
+    deviations.emplace_back(median, this->m_ZeroCount);
+    for (unsigned int b = 0; b < this->m_Buckets.size(); ++b)
+    {
+      deviations.emplace_back(std::abs(this->GetBucketValue(this->m_BucketOffset + static_cast<int>(b)) - median),
+                              this->m_Buckets[b]);
+    }
+    std::sort(deviations.begin(), deviations.end());
+
+    const double  rank = 0.5 * static_cast<double>(this->m_Count - 1);
+    SizeValueType cumulative = 0;
+    for (const auto & deviation : deviations)
+    {
+      cumulative += deviation.second;
+      if (static_cast<double>(cumulative) > rank)
+      {
+        return deviation.first;
+      }
+    }
+    return deviations.back().first;
+  }
+
+private:
+  /** Representative value of the bucket (gamma^(key-1), gamma^key], with relative error alpha for all its values. */
+  inline double
+  GetBucketValue(const int & key) const
+  {
+    return 2.0 * std::exp(key * this->m_LogGamma) / (1.0 + std::exp(this->m_LogGamma));
+  }
+
+  inline void
+  AddToSketch(const double & value)
+  {
+    if (!(value > NumericTraits<double>::min()))
+    {
+      ++this->m_ZeroCount;
+      return;
+    }
+    const auto key = static_cast<int>(std::ceil(std::log(value) / this->m_LogGamma));
+    this->ReserveBuckets(key);
+    ++this->m_Buckets[key - this->m_BucketOffset];
+  }
+
+  /** Grow the buckets to include key. */
+  inline void
+  ReserveBuckets(const int & key)
+  {
+    if (this->m_Buckets.empty())
+    {
+      this->m_BucketOffset = key;
+      this->m_Buckets.resize(1, 0);
+    }
+    else if (key < this->m_BucketOffset)
+    {
+      this->m_Buckets.insert(this->m_Buckets.begin(), this->m_BucketOffset - key, 0);
+      this->m_BucketOffset = key;
+    }
+    else if (key >= this->m_BucketOffset + static_cast<int>(this->m_Buckets.size()))
+    {
+      this->m_Buckets.resize(key - this->m_BucketOffset + 1, 0);
+    }
+  }
+
+  SizeValueType m_Count{ 0 };
+  double        m_Mean{ 0.0 };
+  double        m_SquaredDifferences{ 0.0 };
+
+  double                     m_QuantileRelativeAccuracy{ 0.0 };
+  double                     m_LogGamma{ 0.0 };
+  SizeValueType              m_ZeroCount{ 0 };
+  int                        m_BucketOffset{ 0 };
+  std::vector<SizeValueType> m_Buckets;
+};
+} // end namespace itk
+
+#endif
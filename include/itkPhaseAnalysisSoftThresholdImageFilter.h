@@ -19,6 +19,8 @@
 #define itkPhaseAnalysisSoftThresholdImageFilter_h
 
 #include <itkPhaseAnalysisImageFilter.h>
+#include "itkPhaseAnalysisAmplitudeStatistics.h"
+#include "itkPhaseAnalysisThresholdEstimator.h"
 namespace itk
 {
 /** \class PhaseAnalysisSoftThresholdImageFilter
@@ -35,6 +37,11 @@ namespace itk
  * User just have to modify the GetFrequency in a new FrequencyIterator if other FFT library is chosen.
  *
  * The output should be a new real image f', so it can be integrated to an inverse Wavelet pyramid.
+ *
+ * Phase, amplitude, cos(phase) and the mean and variance of the amplitude are computed in one threaded pass,
+ * \sa PhaseAnalysisAmplitudeStatistics. A second pass applies the soft threshold to cos(phase) if ApplySoftThreshold.
+ * The phase and amplitude outputs are only stored if GeneratePhase and GenerateAmplitude are on (default),
+ * otherwise they have no buffer and the amplitude is recomputed from the input for the soft threshold.
  * \sa itkWaveletFrequencyInverse
  * \ingroup IsotropicWavelets
  */
@@ -81,6 +88,14 @@ public:
 
   using OutputImageRegionIterator = typename Superclass::OutputImageRegionIterator;
 
+  /** Flags to store the phase and amplitude outputs. Default: true. cos(phase) is always generated. */
+  itkSetMacro(GeneratePhase, bool);
+  itkGetConstMacro(GeneratePhase, bool);
+  itkBooleanMacro(GeneratePhase);
+  itkSetMacro(GenerateAmplitude, bool);
+  itkGetConstMacro(GenerateAmplitude, bool);
+  itkBooleanMacro(GenerateAmplitude);
+
   itkSetMacro(ApplySoftThreshold, bool);
   itkGetConstMacro(ApplySoftThreshold, bool);
   itkBooleanMacro(ApplySoftThreshold);
@@ -91,6 +106,10 @@ public:
   itkGetConstMacro(SigmaAmp, OutputImagePixelType);
   itkGetConstMacro(Threshold, OutputImagePixelType);
 
+  /** Estimator of the soft threshold. If it is not set (default), the threshold is mean + NumOfSigmas * sigma. */
+  itkSetObjectMacro(ThresholdEstimator, PhaseAnalysisThresholdEstimator);
+  itkGetModifiableObjectMacro(ThresholdEstimator, PhaseAnalysisThresholdEstimator);
+
   OutputImageType *
   GetOutputCosPhase()
   {
@@ -105,12 +124,22 @@ protected:
 
   void
   GenerateData() override;
+  /** Phase, amplitude (if stored) and cos(phase), accumulating the amplitude statistics. */
   void
-  ThreadedComputeCosineOfPhase(const OutputImageRegionType & outputRegionForThread);
+  ThreadedComputePhaseAnalysis(const OutputImageRegionType &      outputRegionForThread,
+                               PhaseAnalysisAmplitudeStatistics & amplitudeStatistics);
+  /** cos(phase) * amplitude / threshold where amplitude < threshold. */
+  void
+  ThreadedApplySoftThreshold(const OutputImageRegionType & outputRegionForThread);
 
 private:
+  bool                 m_GeneratePhase{ true };
+  bool                 m_GenerateAmplitude{ true };
   bool                 m_ApplySoftThreshold{ true };
   OutputImagePixelType m_NumOfSigmas;
+
+  PhaseAnalysisThresholdEstimator::Pointer m_ThresholdEstimator;
+
   OutputImagePixelType m_MeanAmp;
   OutputImagePixelType m_SigmaAmp;
   OutputImagePixelType m_Threshold;
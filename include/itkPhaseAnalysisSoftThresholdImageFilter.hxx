@@ -20,8 +20,7 @@
 #include "itkPhaseAnalysisSoftThresholdImageFilter.h"
 #include "itkImageScanlineConstIterator.h"
 #include "itkImageScanlineIterator.h"
-
-#include "itkStatisticsImageFilter.h"
+#include <mutex>
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage>
@@ -47,72 +46,187 @@ PhaseAnalysisSoftThresholdImageFilter<TInputImage, TOutputImage>::PrintSelf(std:
 {
   Superclass::PrintSelf(os, indent);
 
+  os << indent << "GeneratePhase: " << m_GeneratePhase << std::endl;
+  os << indent << "GenerateAmplitude: " << m_GenerateAmplitude << std::endl;
   os << indent << "Threshold : " << m_Threshold << std::endl;
   os << indent << "Mean Amplitude : " << m_MeanAmp << std::endl;
   os << indent << "Sigma Amplitude: " << m_SigmaAmp << std::endl;
+  itkPrintSelfObjectMacro(ThresholdEstimator);
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
 PhaseAnalysisSoftThresholdImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
-  // Populate and compute outputs from superclass (threaded)
-  Superclass::GenerateData();
-  auto amplitudePtr = this->GetOutputAmplitude();
-  // Compute mean/variance only once.
-  if (this->GetApplySoftThreshold())
+  this->BeforeThreadedGenerateData();
+
+  // Only allocate the outputs that are stored.
+  for (unsigned int n_output = 0; n_output < 3; ++n_output)
+  {
+    OutputImageType * outputPtr = this->GetOutput(n_output);
+    if ((n_output == 0 && !this->m_GeneratePhase) || (n_output == 1 && !this->m_GenerateAmplitude))
+    {
+      outputPtr->ReleaseData();
+    }
+    else
+    {
+      outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+      outputPtr->Allocate();
+    }
+  }
+
+  // Phase, amplitude and cos(phase). The per-thread statistics of the amplitude are merged at the end of each region.
+  const bool useEstimator = this->GetApplySoftThreshold() && this->m_ThresholdEstimator.IsNotNull();
+  double     quantileRelativeAccuracy = 0.0;
+  if (useEstimator && this->m_ThresholdEstimator->GetRequiresQuantiles())
+  {
+    quantileRelativeAccuracy = this->m_ThresholdEstimator->GetQuantileRelativeAccuracy();
+  }
+  PhaseAnalysisAmplitudeStatistics amplitudeStatistics(quantileRelativeAccuracy);
+  std::mutex                       statisticsMutex;
+  this->GetMultiThreader()->template ParallelizeImageRegion<TOutputImage::ImageDimension>(
+    this->GetOutputCosPhase()->GetRequestedRegion(),
+    [this, quantileRelativeAccuracy, &amplitudeStatistics, &statisticsMutex](
+      const OutputImageRegionType & outputRegionForThread) {
+      PhaseAnalysisAmplitudeStatistics threadStatistics(quantileRelativeAccuracy);
+      this->ThreadedComputePhaseAnalysis(outputRegionForThread, threadStatistics);
+      const std::lock_guard<std::mutex> lock(statisticsMutex);
+      amplitudeStatistics.Merge(threadStatistics);
+    },
+    nullptr);
+
+  if (!this->GetApplySoftThreshold())
+  {
+    return;
+  }
+
+  this->m_MeanAmp = static_cast<OutputImagePixelType>(amplitudeStatistics.GetMean());
+  this->m_SigmaAmp = static_cast<OutputImagePixelType>(amplitudeStatistics.GetSigma());
+  if (useEstimator)
+  {
+    this->m_Threshold =
+      static_cast<OutputImagePixelType>(this->m_ThresholdEstimator->ComputeThreshold(amplitudeStatistics));
+  }
+  else
   {
-    using StatisticsImageFilter = itk::StatisticsImageFilter<OutputImageType>;
-    auto statsFilter = StatisticsImageFilter::New();
-    statsFilter->SetInput(amplitudePtr);
-    statsFilter->Update();
-    this->m_MeanAmp = statsFilter->GetMean();
-    this->m_SigmaAmp = sqrt(statsFilter->GetVariance());
     this->m_Threshold = this->m_MeanAmp + this->m_NumOfSigmas * this->m_SigmaAmp;
   }
 
   this->GetMultiThreader()->template ParallelizeImageRegion<TOutputImage::ImageDimension>(
-    this->GetOutput()->GetRequestedRegion(),
+    this->GetOutputCosPhase()->GetRequestedRegion(),
     [this](const OutputImageRegionType & outputRegionForThread) {
-      this->ThreadedComputeCosineOfPhase(outputRegionForThread);
+      this->ThreadedApplySoftThreshold(outputRegionForThread);
     },
     nullptr);
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-PhaseAnalysisSoftThresholdImageFilter<TInputImage, TOutputImage>::ThreadedComputeCosineOfPhase(
-  const OutputImageRegionType & outputRegionForThread)
+PhaseAnalysisSoftThresholdImageFilter<TInputImage, TOutputImage>::ThreadedComputePhaseAnalysis(
+  const OutputImageRegionType &      outputRegionForThread,
+  PhaseAnalysisAmplitudeStatistics & amplitudeStatistics)
 {
+  OutputImageRegionIterator     outIt(this->GetOutputCosPhase(), outputRegionForThread);
+  InputImageRegionConstIterator inputIt(this->GetInput(), outputRegionForThread);
+  OutputImageRegionIterator     phaseIt;
+  OutputImageRegionIterator     ampIt;
+  if (this->m_GeneratePhase)
+  {
+    phaseIt = OutputImageRegionIterator(this->GetOutputPhase(), outputRegionForThread);
+  }
+  if (this->m_GenerateAmplitude)
+  {
+    ampIt = OutputImageRegionIterator(this->GetOutputAmplitude(), outputRegionForThread);
+  }
+
+  InputImagePixelType  vecValue;
+  OutputImagePixelType featureAmpSquare;
+  while (!inputIt.IsAtEnd())
+  {
+    while (!inputIt.IsAtEndOfLine())
+    {
+      vecValue = inputIt.Get();
+      featureAmpSquare = this->ComputeFeatureVectorNormSquare(vecValue);
+      const OutputImagePixelType amplitude = this->ComputeAmplitude(vecValue, featureAmpSquare);
+      const OutputImagePixelType phase = this->ComputePhase(vecValue, featureAmpSquare);
+      if (this->m_GeneratePhase)
+      {
+        phaseIt.Set(phase);
+        ++phaseIt;
+      }
+      if (this->m_GenerateAmplitude)
+      {
+        ampIt.Set(amplitude);
+        ++ampIt;
+      }
+      outIt.Set(cos(phase));
+      amplitudeStatistics.Add(amplitude);
+      ++inputIt, ++outIt;
+    }
 
-  auto phasePtr = this->GetOutputPhase();
-  auto amplitudePtr = this->GetOutputAmplitude();
-  auto outputPtr = this->GetOutputCosPhase();
+    inputIt.NextLine(), outIt.NextLine();
+    if (this->m_GeneratePhase)
+    {
+      phaseIt.NextLine();
+    }
+    if (this->m_GenerateAmplitude)
+    {
+      ampIt.NextLine();
+    }
+  }
+}
 
-  // Set output to cos(phase) applying SoftThreshold if requested.
-  OutputImageRegionIterator outIt(outputPtr, outputRegionForThread);
+template <typename TInputImage, typename TOutputImage>
+void
+PhaseAnalysisSoftThresholdImageFilter<TInputImage, TOutputImage>::ThreadedApplySoftThreshold(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  // The amplitude is read from its output if stored, or recomputed from the input otherwise.
+  OutputImageRegionIterator outIt(this->GetOutputCosPhase(), outputRegionForThread);
   using OutputImageRegionConstIterator = typename itk::ImageScanlineConstIterator<OutputImageType>;
-  OutputImageRegionConstIterator ampIt(amplitudePtr, outputRegionForThread);
-  OutputImageRegionConstIterator phaseIt(phasePtr, outputRegionForThread);
+  OutputImageRegionConstIterator ampIt;
+  InputImageRegionConstIterator  inputIt;
+  if (this->m_GenerateAmplitude)
+  {
+    ampIt = OutputImageRegionConstIterator(this->GetOutputAmplitude(), outputRegionForThread);
+  }
+  else
+  {
+    inputIt = InputImageRegionConstIterator(this->GetInput(), outputRegionForThread);
+  }
 
-  outIt.GoToBegin(), ampIt.GoToBegin(), phaseIt.GoToBegin();
+  OutputImagePixelType amplitude;
   while (!outIt.IsAtEnd())
   {
     while (!outIt.IsAtEndOfLine())
     {
-      OutputImagePixelType out_value = cos(phaseIt.Get());
-      if (this->GetApplySoftThreshold())
+      if (this->m_GenerateAmplitude)
+      {
+        amplitude = ampIt.Get();
+        ++ampIt;
+      }
+      else
+      {
+        const InputImagePixelType vecValue = inputIt.Get();
+        amplitude = this->ComputeAmplitude(vecValue, this->ComputeFeatureVectorNormSquare(vecValue));
+        ++inputIt;
+      }
+      if (amplitude < this->m_Threshold)
       {
-        if (ampIt.Get() < this->m_Threshold)
-        {
-          out_value *= ampIt.Get() / this->m_Threshold;
-        }
+        outIt.Set(outIt.Get() * (amplitude / this->m_Threshold));
       }
-      outIt.Set(out_value);
-      ++outIt, ++ampIt, ++phaseIt;
+      ++outIt;
     }
 
-    outIt.NextLine(), ampIt.NextLine(), phaseIt.NextLine();
+    outIt.NextLine();
+    if (this->m_GenerateAmplitude)
+    {
+      ampIt.NextLine();
+    }
+    else
+    {
+      inputIt.NextLine();
+    }
   }
 }
 } // end namespace itk
@@ -0,0 +1,81 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPhaseAnalysisThresholdEstimator_h
+#define itkPhaseAnalysisThresholdEstimator_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include "itkPhaseAnalysisAmplitudeStatistics.h"
+#include "IsotropicWaveletsExport.h"
+
+namespace itk
+{
+/** \class PhaseAnalysisThresholdEstimator
+ * Base class of the estimators of the soft threshold of a phase analysis.
+ *
+ * The threshold is computed from the PhaseAnalysisAmplitudeStatistics accumulated in the same threaded
+ * pass that computes the amplitude, so the amplitude is never stored, sorted nor read again.
+ * Estimators based on quantiles return true in GetRequiresQuantiles, and the statistics then keep a
+ * quantile sketch with relative accuracy QuantileRelativeAccuracy.
+ *
+ * If no estimator is set in the filters, the threshold is mean + NumOfSigmas * sigma of the amplitude.
+ *
+ * \sa MedianAbsoluteDeviationThresholdEstimator
+ * \sa PercentileThresholdEstimator
+ * \sa PhaseAnalysisSoftThresholdImageFilter
+ * \sa MonogenicPhaseAnalysisImageFilter
+ * \ingroup IsotropicWavelets
+ */
+class IsotropicWavelets_EXPORT PhaseAnalysisThresholdEstimator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PhaseAnalysisThresholdEstimator);
+
+  /** Standard class type alias. */
+  using Self = PhaseAnalysisThresholdEstimator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Runtime information support. */
+  itkTypeMacro(PhaseAnalysisThresholdEstimator, Object);
+
+  /** Relative accuracy of the quantiles, in (0, 0.5]. Default: 0.01. */
+  itkSetClampMacro(QuantileRelativeAccuracy, double, 1e-6, 0.5);
+  itkGetConstMacro(QuantileRelativeAccuracy, double);
+
+  /** True if ComputeThreshold uses the quantiles of the statistics. */
+  virtual bool
+  GetRequiresQuantiles() const = 0;
+
+  /** Threshold of the amplitude. */
+  virtual double
+  ComputeThreshold(const PhaseAnalysisAmplitudeStatistics & amplitudeStatistics) const = 0;
+
+protected:
+  PhaseAnalysisThresholdEstimator() = default;
+  ~PhaseAnalysisThresholdEstimator() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  double m_QuantileRelativeAccuracy{ 0.01 };
+};
+} // end namespace itk
+
+#endif
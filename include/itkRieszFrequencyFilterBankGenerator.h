@@ -32,6 +32,10 @@ namespace itk
  *
  * \f$ M := p(N,d) = \frac{(N+d-1)!}{(d-1)! N!} \f$
  *
+ * If HalfHermitian is on, Size is the size of the half-Hermitian layout of
+ * RealToHalfHermitianForwardFFTImageFilter, and the outputs are the first half of the filter bank of the full
+ * spectrum, whose first dimension is given by ActualXDimensionIsOdd.
+ *
  * \sa RieszFrequencyFunction
  *
  * \ingroup IsotropicWavelets
@@ -111,6 +115,16 @@ public:
   /** Modifiable pointer to the Generalized RieszFunction */
   itkGetModifiableObjectMacro(Evaluator, RieszFunctionType);
 
+  /** Flag to generate the filter bank in the half-Hermitian layout. Default: false. */
+  itkGetConstMacro(HalfHermitian, bool);
+  itkSetMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+
+  /** The size of the first dimension of the full spectrum is odd. Only used with HalfHermitian. Default: false. */
+  itkGetConstMacro(ActualXDimensionIsOdd, bool);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
 protected:
   RieszFrequencyFilterBankGenerator();
   ~RieszFrequencyFilterBankGenerator() override = default;
@@ -126,6 +140,10 @@ protected:
 private:
   unsigned int         m_Order{ 0 };
   RieszFunctionPointer m_Evaluator;
+  bool                 m_HalfHermitian{ false };
+  bool                 m_ActualXDimensionIsOdd{ false };
+  /** Frequency per dimension of the half-Hermitian layout, computed before the threaded section. */
+  std::vector<std::vector<double>> m_HalfHermitianFrequency;
 }; // end of class
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
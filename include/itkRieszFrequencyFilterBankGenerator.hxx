@@ -19,6 +19,8 @@
 #define itkRieszFrequencyFilterBankGenerator_hxx
 #include "itkRieszFrequencyFilterBankGenerator.h"
 #include "itkNumericTraits.h"
+#include "itkImageScanlineIterator.h"
+#include "itkWaveletUtilities.h"
 
 namespace itk
 {
@@ -28,7 +30,8 @@ RieszFrequencyFilterBankGenerator<TOutputImage, TRieszFunction, TFrequencyRegion
 
 {
   this->m_Evaluator = RieszFunctionType::New();
-  this->SetOrder(1);
+  // Order 1, unless the order of the function is fixed at compile time.
+  this->SetOrder(this->m_Evaluator->GetOrder());
 }
 
 template <typename TOutputImage, typename TRieszFunction, typename TFrequencyRegionIterator>
@@ -39,6 +42,8 @@ RieszFrequencyFilterBankGenerator<TOutputImage, TRieszFunction, TFrequencyRegion
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "m_Order: " << this->m_Order << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd << std::endl;
   itkPrintSelfObjectMacro(Evaluator);
 }
 
@@ -68,6 +73,16 @@ RieszFrequencyFilterBankGenerator<TOutputImage, TRieszFunction, TFrequencyRegion
     outputPtr->Allocate();
     outputPtr->FillBuffer(0);
   }
+
+  this->m_HalfHermitianFrequency.clear();
+  if (this->m_HalfHermitian)
+  {
+    const typename OutputImageType::SizeType halfSize = firstOutput->GetLargestPossibleRegion().GetSize();
+    this->m_HalfHermitianFrequency = itk::utils::ComputeFrequencyPerDimension<ImageDimension>(
+      halfSize,
+      itk::utils::ComputeFullSizeFromHalfHermitianSize(halfSize, this->m_ActualXDimensionIsOdd),
+      firstOutput->GetSpacing());
+  }
 }
 
 template <typename TOutputImage, typename TRieszFunction, typename TFrequencyRegionIterator>
@@ -75,32 +90,72 @@ void
 RieszFrequencyFilterBankGenerator<TOutputImage, TRieszFunction, TFrequencyRegionIterator>::DynamicThreadedGenerateData(
   const OutputImageRegionType & threadRegion)
 {
+  using ComponentType = typename RieszFunctionType::OutputComplexType;
+  using OutputScanlineIterator = ImageScanlineIterator<OutputImageType>;
+  const unsigned int  numberOfOutputs = this->GetNumberOfOutputs();
+  const SizeValueType lineLength = threadRegion.GetSize(0);
+
   // Init iterators for all outputs.
-  std::vector<OutputRegionIterator> outputItList;
-  for (unsigned int comp = 0; comp < this->GetNumberOfOutputs(); ++comp)
+  std::vector<OutputScanlineIterator> outputItList;
+  for (unsigned int comp = 0; comp < numberOfOutputs; ++comp)
   {
-    OutputImageType * outputPtr = this->GetOutput(comp);
-    outputItList.push_back(OutputRegionIterator(outputPtr, threadRegion));
-    outputItList.back().GoToBegin();
+    outputItList.emplace_back(this->GetOutput(comp), threadRegion);
+  }
+
+  // Frequencies and evaluated components of a scanline, reused for all the scanlines of the region.
+  std::vector<double>                               frequencyBuffer(ImageDimension * lineLength);
+  typename RieszFunctionType::FrequencyScanlineType frequencyScanline;
+  std::vector<ComponentType>                        componentBuffer(numberOfOutputs * lineLength);
+  typename RieszFunctionType::ComponentBuffersType  componentScanline(numberOfOutputs);
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    frequencyScanline[dim] = &frequencyBuffer[dim * lineLength];
+  }
+  for (unsigned int comp = 0; comp < numberOfOutputs; ++comp)
+  {
+    componentScanline[comp] = &componentBuffer[comp * lineLength];
   }
 
   /***************** Set Outputs *****************/
   OutputImageType *    firstOutput = this->GetOutput(0);
   OutputRegionIterator frequencyIt(firstOutput, threadRegion);
-  for (frequencyIt.GoToBegin(); !frequencyIt.IsAtEnd(); ++frequencyIt)
+  // In the half-Hermitian layout the frequency is computed from the index, not from the iterator.
+  const typename OutputImageType::IndexType startIndex = firstOutput->GetLargestPossibleRegion().GetIndex();
+  frequencyIt.GoToBegin();
+  while (!frequencyIt.IsAtEnd())
   {
-    typename TRieszFunction::OutputComponentsType evaluatedArray =
-      this->m_Evaluator->EvaluateAllComponents(frequencyIt.GetFrequency());
-    for (unsigned int comp = 0; comp < this->GetNumberOfOutputs(); ++comp)
+    for (SizeValueType p = 0; p < lineLength; ++p, ++frequencyIt)
+    {
+      if (this->m_HalfHermitian)
+      {
+        const typename OutputImageType::IndexType index = frequencyIt.GetIndex();
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          frequencyBuffer[dim * lineLength + p] = this->m_HalfHermitianFrequency[dim][index[dim] - startIndex[dim]];
+        }
+      }
+      else
+      {
+        const typename OutputRegionIterator::FrequencyType frequency = frequencyIt.GetFrequency();
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          frequencyBuffer[dim * lineLength + p] = frequency[dim];
+        }
+      }
+    }
+
+    this->m_Evaluator->EvaluateAllComponentsOnScanline(frequencyScanline, lineLength, componentScanline);
+
+    for (unsigned int comp = 0; comp < numberOfOutputs; ++comp)
     {
-      outputItList[comp].Set(static_cast<typename OutputImageType::PixelType>(evaluatedArray[comp]));
-      ++outputItList[comp];
+      OutputScanlineIterator & outputIt = outputItList[comp];
+      const ComponentType *    component = componentScanline[comp];
+      for (SizeValueType p = 0; p < lineLength; ++p, ++outputIt)
+      {
+        outputIt.Set(static_cast<typename OutputImageType::PixelType>(component[p]));
+      }
+      outputIt.NextLine();
     }
-    itkDebugMacro(<< "w_vector: " << frequencyIt.GetFrequency() << " w2: " << frequencyIt.GetFrequencyModuloSquare()
-                  << "  frequencyItIndex: "
-                  << frequencyIt.GetIndex()
-                  // << "  Evaluated Riesz Components: " << evaluatedArray
-                  << " outputIndex: " << outputItList[0].GetIndex());
   }
 }
 } // end namespace itk
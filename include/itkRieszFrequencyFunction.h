@@ -20,6 +20,7 @@
 
 #include "itkFrequencyFunction.h"
 #include <set>
+#include <array>
 #include <complex>
 #include <numeric>
 #include <functional>
@@ -69,6 +70,11 @@ public:
   using SetType = std::set<IndicesArrayType, std::greater<IndicesArrayType>>;
   using OutputComplexArrayType = itk::FixedArray<OutputComplexType, VImageDimension>;
 
+  /** Frequencies of a scanline of points, one contiguous buffer per dimension. */
+  using FrequencyScanlineType = std::array<const double *, VImageDimension>;
+  /** One contiguous output buffer per component, in the order of GetIndices. */
+  using ComponentBuffersType = std::vector<OutputComplexType *>;
+
   /**
    * Compute number of components p(N, d), where N = Order, d = Dimension.
    * p(N,d) = (N + d - 1)!/( (d-1)! N! )
@@ -149,6 +155,38 @@ public:
   virtual OutputComponentsType
   EvaluateAllComponents(const TInput & frequency_point) const;
 
+  /**
+   * Evaluate all the components of the generalized Riesz transform at the numberOfPoints
+   * points of a scanline. Equivalent to EvaluateAllComponents on each point, but the
+   * normalizing factors and exponents are precomputed when setting the Order,
+   * and the loops run over contiguous buffers of points without branches, so they are vectorized by the compiler.
+   *
+   * @param frequency frequency[dim][p] is the frequency of the point p in dimension dim.
+   * @param numberOfPoints length of the scanline.
+   * @param components components[c][p] is set to the component c at the point p.
+   * components must have ComputeNumberOfComponents(Order) buffers of numberOfPoints values.
+   */
+  virtual void
+  EvaluateAllComponentsOnScanline(const FrequencyScanlineType & frequency,
+                                  SizeValueType                 numberOfPoints,
+                                  const ComponentBuffersType &  components) const;
+
+  /**
+   * Evaluate only the component of the generalized Riesz transform, in the order of GetIndices,
+   * at the numberOfPoints points of a scanline. Gives the same values than components[component]
+   * of EvaluateAllComponentsOnScanline, without computing the other components.
+   *
+   * @param frequency frequency[dim][p] is the frequency of the point p in dimension dim.
+   * @param numberOfPoints length of the scanline.
+   * @param component index of the component, lower than ComputeNumberOfComponents(Order).
+   * @param values values[p] is set to the component at the point p.
+   */
+  virtual void
+  EvaluateComponentOnScanline(const FrequencyScanlineType & frequency,
+                              SizeValueType                 numberOfPoints,
+                              unsigned int                  component,
+                              OutputComplexType *           values) const;
+
   /**
    * Compute normalizing factor given an index = (n1,n2,...,nVImageDimension)
    * Also takes into account this->m_Order = N
@@ -188,6 +226,7 @@ public:
       this->m_Order = inputOrder;
       // Calculate all the possible indices.
       this->m_Indices = Self::ComputeAllPossibleIndices(this->m_Order);
+      this->ComputeComponentTables();
       this->Modified();
     }
   }
@@ -207,9 +246,16 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Precompute the exponents and normalizing factors of every component, in the order of m_Indices. */
+  void
+  ComputeComponentTables();
+
 private:
   unsigned int m_Order{ 0 };
   SetType      m_Indices;
+  /** Exponents of the component c: m_ComponentExponents[c * VImageDimension + dim]. */
+  std::vector<unsigned int>      m_ComponentExponents;
+  std::vector<OutputComplexType> m_NormalizingFactors;
 };
 } // end namespace itk
 
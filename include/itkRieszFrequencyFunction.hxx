@@ -21,7 +21,6 @@
 #include <cmath>
 #include <itkMath.h>
 #include "itkRieszFrequencyFunction.h"
-#include "itkRieszFrequencyFunction.h"
 #include <algorithm>
 
 namespace itk
@@ -106,48 +105,181 @@ RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>::ComputeNormaliz
   return powComplex * normalizeFactor;
 }
 
+template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+void
+RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>::ComputeComponentTables()
+{
+  this->m_ComponentExponents.clear();
+  this->m_NormalizingFactors.clear();
+  for (const auto & index : this->m_Indices)
+  {
+    this->m_ComponentExponents.insert(this->m_ComponentExponents.end(), index.begin(), index.end());
+    this->m_NormalizingFactors.push_back(this->ComputeNormalizingFactor(index));
+  }
+}
+
 template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
 typename RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>::OutputComponentsType
 RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>::EvaluateAllComponents(
   const TInput & frequency_point) const
 {
+  const unsigned int   numberOfComponents = this->m_NormalizingFactors.size();
+  OutputComponentsType out(numberOfComponents);
+
   double magn(this->Magnitude(frequency_point));
 
   // Precondition:
   if (itk::Math::FloatAlmostEqual(magn, 0.0))
   {
     // return empty vector of length equal to NumberOfComponents.
-    return OutputComponentsType(RieszFrequencyFunction::ComputeNumberOfComponents(this->m_Order));
+    return out;
   }
 
-  const SetType & allIndices = this->m_Indices;
-
-  OutputComponentsType out;
-  for (auto index : allIndices)
+  const double inverseMagnitudeToOrder = 1.0 / std::pow(magn, static_cast<double>(this->m_Order));
+  for (unsigned int comp = 0; comp < numberOfComponents; ++comp)
   {
-    // freqProduct = w1^n1...wd^nd
-    double freqProduct(1);
+    // freqProduct = w1^n1...wd^nd / ||w||^m_Order
+    const unsigned int * exponents = &this->m_ComponentExponents[comp * VImageDimension];
+    double               freqProduct(inverseMagnitudeToOrder);
     for (unsigned int dim = 0; dim < VImageDimension; ++dim)
     {
-      if (index[dim] > 0)
+      for (unsigned int n = 0; n < exponents[dim]; ++n)
       {
-        freqProduct *= std::pow(static_cast<double>(frequency_point[dim]), static_cast<double>(index[dim]));
+        freqProduct *= frequency_point[dim];
       }
-      // for (unsigned int n = 0; n<index[dim]; ++n)
-      //   {
-      //   freqProduct *= frequency_point[dim];
-      //   }
     }
     // rieszComponent = (-j)^{m_Order} * sqrt(m_Order!/(n1!n2!...nd!)) * w1^n1...wd^nd / ||w||^m_Order
-    OutputComplexType outPerIndex = this->ComputeNormalizingFactor(index);
-    outPerIndex *= static_cast<typename OutputComplexType::value_type>(
-      freqProduct / std::pow(magn, static_cast<double>(this->m_Order)));
-    out.push_back(outPerIndex);
+    out[comp] = this->m_NormalizingFactors[comp] * static_cast<typename OutputComplexType::value_type>(freqProduct);
   }
 
   return out;
 }
 
+template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+void
+RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>::EvaluateAllComponentsOnScanline(
+  const FrequencyScanlineType & frequency,
+  SizeValueType                 numberOfPoints,
+  const ComponentBuffersType &  components) const
+{
+  using ComponentValueType = typename OutputComplexType::value_type;
+  const unsigned int  numberOfComponents = this->m_NormalizingFactors.size();
+  const unsigned int  order = this->m_Order;
+  const SizeValueType n = numberOfPoints;
+  if (components.size() != numberOfComponents)
+  {
+    itkExceptionMacro(<< "components has " << components.size() << " buffers, but the number of components is "
+                      << numberOfComponents);
+  }
+  if (n == 0)
+  {
+    return;
+  }
+
+  // inverseMagnitudeToOrder[p] = 1 / ||w||^m_Order, 0 at the zero frequency.
+  std::vector<double> inverseMagnitudeToOrder(n);
+  for (SizeValueType p = 0; p < n; ++p)
+  {
+    double magnitudeSquare = 0.0;
+    for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+      magnitudeSquare += frequency[dim][p] * frequency[dim][p];
+    }
+    const double inverseMagnitude = magnitudeSquare > 0.0 ? 1.0 / std::sqrt(magnitudeSquare) : 0.0;
+    double       value = 1.0;
+    for (unsigned int k = 0; k < order; ++k)
+    {
+      value *= inverseMagnitude;
+    }
+    inverseMagnitudeToOrder[p] = value;
+  }
+
+  // powers[(dim * (order + 1) + k) * n + p] = w_dim^k at the point p. Shared by all the components.
+  std::vector<double> powers(VImageDimension * (order + 1) * n);
+  for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+  {
+    double * powerZero = &powers[dim * (order + 1) * n];
+    std::fill(powerZero, powerZero + n, 1.0);
+    for (unsigned int k = 1; k <= order; ++k)
+    {
+      const double * previous = powerZero + (k - 1) * n;
+      double *       current = powerZero + k * n;
+      for (SizeValueType p = 0; p < n; ++p)
+      {
+        current[p] = previous[p] * frequency[dim][p];
+      }
+    }
+  }
+
+  std::array<const double *, VImageDimension> powerOfComponent;
+  for (unsigned int comp = 0; comp < numberOfComponents; ++comp)
+  {
+    for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+      const unsigned int exponent = this->m_ComponentExponents[comp * VImageDimension + dim];
+      powerOfComponent[dim] = &powers[(dim * (order + 1) + exponent) * n];
+    }
+    // The normalizing factor is either real or imaginary.
+    const double        realFactor = this->m_NormalizingFactors[comp].real();
+    const double        imagFactor = this->m_NormalizingFactors[comp].imag();
+    OutputComplexType * out = components[comp];
+    for (SizeValueType p = 0; p < n; ++p)
+    {
+      double freqProduct = inverseMagnitudeToOrder[p];
+      for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+      {
+        freqProduct *= powerOfComponent[dim][p];
+      }
+      out[p] = OutputComplexType(static_cast<ComponentValueType>(realFactor * freqProduct),
+                                 static_cast<ComponentValueType>(imagFactor * freqProduct));
+    }
+  }
+}
+
+template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+void
+RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>::EvaluateComponentOnScanline(
+  const FrequencyScanlineType & frequency,
+  SizeValueType                 numberOfPoints,
+  unsigned int                  component,
+  OutputComplexType *           values) const
+{
+  using ComponentValueType = typename OutputComplexType::value_type;
+  const unsigned int numberOfComponents = this->m_NormalizingFactors.size();
+  if (component >= numberOfComponents)
+  {
+    itkExceptionMacro(<< "component " << component << " is not lower than the number of components "
+                      << numberOfComponents);
+  }
+
+  const unsigned int * exponents = &this->m_ComponentExponents[component * VImageDimension];
+  // The normalizing factor is either real or imaginary.
+  const double realFactor = this->m_NormalizingFactors[component].real();
+  const double imagFactor = this->m_NormalizingFactors[component].imag();
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    double magnitudeSquare = 0.0;
+    double monomial = 1.0;
+    for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+      const double w = frequency[dim][p];
+      magnitudeSquare += w * w;
+      for (unsigned int k = 0; k < exponents[dim]; ++k)
+      {
+        monomial *= w;
+      }
+    }
+    const double inverseMagnitude = magnitudeSquare > 0.0 ? 1.0 / std::sqrt(magnitudeSquare) : 0.0;
+    double       freqProduct = monomial;
+    for (unsigned int k = 0; k < this->m_Order; ++k)
+    {
+      freqProduct *= inverseMagnitude;
+    }
+    values[p] = OutputComplexType(static_cast<ComponentValueType>(realFactor * freqProduct),
+                                  static_cast<ComponentValueType>(imagFactor * freqProduct));
+  }
+}
+
 template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
 void
 RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>::PrintSelf(std::ostream & os, Indent indent) const
@@ -0,0 +1,217 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRieszFrequencyFunctionFixedOrder_h
+#define itkRieszFrequencyFunctionFixedOrder_h
+
+#include "itkRieszFrequencyFunction.h"
+#include "itkRieszUtilities.h"
+#include <cmath>
+#include <utility>
+
+namespace itk
+{
+/** \class RieszFrequencyFunctionFixedOrder
+ * RieszFrequencyFunction with the order fixed at compile time.
+ *
+ * The multi-indices of the components, the normalizing factors sqrt(N!/(n1!...nd!))
+ * and the factor (-j)^N are generated at compile time, and the monomials w1^n1...wd^nd of every component
+ * are fully unrolled. EvaluateAllComponents, EvaluateAllComponentsOnScanline and EvaluateComponentOnScanline
+ * give the same results than RieszFrequencyFunction, in the same order of GetIndices, without runtime tables.
+ *
+ * It can be used as the TRieszFunction of RieszFrequencyFilterBankGenerator.
+ * SetOrder only accepts VOrder.
+ *
+ * \sa RieszFrequencyFunction
+ *
+ * \ingroup SpatialFunctions
+ * \ingroup IsotropicWavelets
+ */
+template <unsigned int VOrder,
+          typename TFunctionValue = std::complex<double>,
+          unsigned int VImageDimension = 3,
+          typename TInput = Point<SpacePrecisionType, VImageDimension>>
+class RieszFrequencyFunctionFixedOrder : public RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RieszFrequencyFunctionFixedOrder);
+
+  /** Standard class type alias. */
+  using Self = RieszFrequencyFunctionFixedOrder;
+  using Superclass = RieszFrequencyFunction<TFunctionValue, VImageDimension, TInput>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RieszFrequencyFunctionFixedOrder, RieszFrequencyFunction);
+
+  using typename Superclass::InputType;
+  using typename Superclass::FunctionValueType;
+  using typename Superclass::OutputComplexType;
+  using typename Superclass::OutputComponentsType;
+  using typename Superclass::FrequencyScanlineType;
+  using typename Superclass::ComponentBuffersType;
+
+  /** Order of the Riesz transform and number of components p(N, d). */
+  static constexpr unsigned int Order = VOrder;
+  static constexpr unsigned int NumberOfComponents = utils::RieszNumberOfComponents<VOrder, VImageDimension>::Value;
+
+  /** Exponents and normalizing factors of the components, generated at compile time. */
+  using ComponentTableType = utils::RieszComponentTable<VOrder, VImageDimension>;
+  static constexpr ComponentTableType ComponentTable = utils::MakeRieszComponentTable<VOrder, VImageDimension>();
+
+  /** (-j)^N, real and imaginary parts. */
+  static constexpr double ComplexFactorReal = (VOrder % 4 == 0) ? 1.0 : ((VOrder % 4 == 2) ? -1.0 : 0.0);
+  static constexpr double ComplexFactorImag = (VOrder % 4 == 1) ? -1.0 : ((VOrder % 4 == 3) ? 1.0 : 0.0);
+
+  /** The order is fixed to VOrder. Throws for other orders. */
+  void
+  SetOrder(const unsigned int inputOrder) override
+  {
+    if (inputOrder != VOrder)
+    {
+      itkExceptionMacro(<< "Error: inputOrder = " << inputOrder << ". The order of this function is fixed to "
+                        << VOrder << ".");
+    }
+    this->Superclass::SetOrder(inputOrder);
+  }
+
+  OutputComponentsType
+  EvaluateAllComponents(const TInput & frequency_point) const override;
+
+  void
+  EvaluateAllComponentsOnScanline(const FrequencyScanlineType & frequency,
+                                  SizeValueType                 numberOfPoints,
+                                  const ComponentBuffersType &  components) const override;
+
+  void
+  EvaluateComponentOnScanline(const FrequencyScanlineType & frequency,
+                              SizeValueType                 numberOfPoints,
+                              unsigned int                  component,
+                              OutputComplexType *           values) const override;
+
+protected:
+  RieszFrequencyFunctionFixedOrder();
+  ~RieszFrequencyFunctionFixedOrder() override = default;
+
+  /** Set components[c][p] for all the components c at the frequency w of the point p. */
+  static void
+  EvaluatePoint(const double * w, OutputComplexType * const * components, SizeValueType p)
+  {
+    double magnitudeSquare = 0.0;
+    for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+      magnitudeSquare += w[dim] * w[dim];
+    }
+    const double inverseMagnitude = magnitudeSquare > 0.0 ? 1.0 / std::sqrt(magnitudeSquare) : 0.0;
+    Self::EvaluateComponents(w,
+                             utils::IntegerPower<VOrder>::Compute(inverseMagnitude),
+                             components,
+                             p,
+                             std::make_index_sequence<NumberOfComponents>());
+  }
+
+private:
+  static_assert(VOrder > 0, "The order of the Riesz transform has to be greater than 0.");
+
+  template <std::size_t... VComponents>
+  static void
+  EvaluateComponents(const double *              w,
+                     const double                inverseMagnitudeToOrder,
+                     OutputComplexType * const * components,
+                     SizeValueType               p,
+                     std::index_sequence<VComponents...>)
+  {
+    const int unrolled[] = { Self::SetComponent<VComponents>(
+      w, inverseMagnitudeToOrder, components[VComponents][p])... };
+    (void)unrolled;
+  }
+
+  /** Evaluate the component VComponent at the points of a scanline. */
+  template <std::size_t VComponent>
+  static void
+  EvaluateComponentPoints(const FrequencyScanlineType & frequency,
+                          SizeValueType                 numberOfPoints,
+                          OutputComplexType *           values)
+  {
+    double w[VImageDimension];
+    for (SizeValueType p = 0; p < numberOfPoints; ++p)
+    {
+      double magnitudeSquare = 0.0;
+      for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+      {
+        w[dim] = frequency[dim][p];
+        magnitudeSquare += w[dim] * w[dim];
+      }
+      const double inverseMagnitude = magnitudeSquare > 0.0 ? 1.0 / std::sqrt(magnitudeSquare) : 0.0;
+      Self::SetComponent<VComponent>(w, utils::IntegerPower<VOrder>::Compute(inverseMagnitude), values[p]);
+    }
+  }
+
+  /** Dispatch the run time component to EvaluateComponentPoints. */
+  template <std::size_t... VComponents>
+  static void
+  DispatchComponentOnScanline(const FrequencyScanlineType & frequency,
+                              SizeValueType                 numberOfPoints,
+                              unsigned int                  component,
+                              OutputComplexType *           values,
+                              std::index_sequence<VComponents...>)
+  {
+    using EvaluatorType = void (*)(const FrequencyScanlineType &, SizeValueType, OutputComplexType *);
+    static constexpr EvaluatorType evaluators[] = { &Self::EvaluateComponentPoints<VComponents>... };
+    evaluators[component](frequency, numberOfPoints, values);
+  }
+
+  /** component = (-j)^N * sqrt(N!/(n1!...nd!)) * w1^n1...wd^nd / ||w||^N */
+  template <std::size_t VComponent>
+  static int
+  SetComponent(const double * w, const double inverseMagnitudeToOrder, OutputComplexType & component)
+  {
+    using ComponentValueType = typename OutputComplexType::value_type;
+    const double value = ComponentTable.NormalizingFactors[VComponent] * inverseMagnitudeToOrder *
+                         Self::Monomial<VComponent>(w, std::make_index_sequence<VImageDimension>());
+    component = OutputComplexType(static_cast<ComponentValueType>(ComplexFactorReal * value),
+                                  static_cast<ComponentValueType>(ComplexFactorImag * value));
+    return 0;
+  }
+
+  /** w1^n1...wd^nd of the component VComponent. */
+  template <std::size_t VComponent, std::size_t... VDimensions>
+  static double
+  Monomial(const double * w, std::index_sequence<VDimensions...>)
+  {
+    const double powers[] = { utils::IntegerPower<ComponentTable.Exponents[VComponent][VDimensions]>::Compute(
+      w[VDimensions])... };
+
+    double monomial = 1.0;
+    for (const double power : powers)
+    {
+      monomial *= power;
+    }
+    return monomial;
+  }
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkRieszFrequencyFunctionFixedOrder.hxx"
+#endif
+
+#endif
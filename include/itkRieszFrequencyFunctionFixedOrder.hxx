@@ -0,0 +1,100 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRieszFrequencyFunctionFixedOrder_hxx
+#define itkRieszFrequencyFunctionFixedOrder_hxx
+
+#include "itkRieszFrequencyFunctionFixedOrder.h"
+#include <array>
+
+namespace itk
+{
+// Definition of the table, required by C++14 when it is odr-used.
+template <unsigned int VOrder, typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+constexpr typename RieszFrequencyFunctionFixedOrder<VOrder, TFunctionValue, VImageDimension, TInput>::ComponentTableType
+  RieszFrequencyFunctionFixedOrder<VOrder, TFunctionValue, VImageDimension, TInput>::ComponentTable;
+
+template <unsigned int VOrder, typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+RieszFrequencyFunctionFixedOrder<VOrder, TFunctionValue, VImageDimension, TInput>::RieszFrequencyFunctionFixedOrder()
+{
+  // Keep the indices of the Superclass, used by GetIndices and EvaluateWithIndices.
+  this->Superclass::SetOrder(VOrder);
+}
+
+template <unsigned int VOrder, typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+typename RieszFrequencyFunctionFixedOrder<VOrder, TFunctionValue, VImageDimension, TInput>::OutputComponentsType
+RieszFrequencyFunctionFixedOrder<VOrder, TFunctionValue, VImageDimension, TInput>::EvaluateAllComponents(
+  const TInput & frequency_point) const
+{
+  OutputComponentsType                                out(NumberOfComponents);
+  std::array<OutputComplexType *, NumberOfComponents> components;
+  for (unsigned int comp = 0; comp < NumberOfComponents; ++comp)
+  {
+    components[comp] = &out[comp];
+  }
+  double w[VImageDimension];
+  for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+  {
+    w[dim] = frequency_point[dim];
+  }
+  Self::EvaluatePoint(w, components.data(), 0);
+  return out;
+}
+
+template <unsigned int VOrder, typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+void
+RieszFrequencyFunctionFixedOrder<VOrder, TFunctionValue, VImageDimension, TInput>::EvaluateAllComponentsOnScanline(
+  const FrequencyScanlineType & frequency,
+  SizeValueType                 numberOfPoints,
+  const ComponentBuffersType &  components) const
+{
+  if (components.size() != NumberOfComponents)
+  {
+    itkExceptionMacro(<< "components has " << components.size() << " buffers, but the number of components is "
+                      << NumberOfComponents);
+  }
+
+  double w[VImageDimension];
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+      w[dim] = frequency[dim][p];
+    }
+    Self::EvaluatePoint(w, components.data(), p);
+  }
+}
+
+template <unsigned int VOrder, typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+void
+RieszFrequencyFunctionFixedOrder<VOrder, TFunctionValue, VImageDimension, TInput>::EvaluateComponentOnScanline(
+  const FrequencyScanlineType & frequency,
+  SizeValueType                 numberOfPoints,
+  unsigned int                  component,
+  OutputComplexType *           values) const
+{
+  if (component >= NumberOfComponents)
+  {
+    itkExceptionMacro(<< "component " << component << " is not lower than the number of components "
+                      << NumberOfComponents);
+  }
+  Self::DispatchComponentOnScanline(
+    frequency, numberOfPoints, component, values, std::make_index_sequence<NumberOfComponents>());
+}
+} // end namespace itk
+
+#endif
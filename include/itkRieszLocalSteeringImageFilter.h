@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRieszLocalSteeringImageFilter_h
+#define itkRieszLocalSteeringImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkVariableSizeMatrix.h"
+#include "itkRieszSteeringPolynomials.h"
+#include <vector>
+
+namespace itk
+{
+/** \class RieszLocalSteeringImageFilter
+ * Steer the M components of a Riesz transform of order N with a different rotation at every pixel.
+ *
+ * The inputs are the M = p(N,d) Riesz components, in the order of RieszFrequencyFunction::GetIndices,
+ * set with SetInputs, and the output of a StructureTensor computed from d images, set with SetStructureTensor.
+ * At every pixel the rotation matrix R has the eigenvectors of the structure tensor in its rows,
+ * as StructureTensor::GetRotationMatrixFromOutputMatrix, and the outputs are:
+ * \f[ O_r(x) = \sum_c S_{R(x)}[r][c] I_c(x) \f]
+ * where \f$ S_{R(x)} \f$ is the steerable matrix of RieszRotationMatrix for R(x), evaluated with the
+ * cached closed form of RieszSteeringPolynomials.
+ *
+ * With LargestEigenvectorInFirstRow on (the default) the first row of R is the eigenvector with the largest
+ * eigenvalue, and the first output is the component of order N along the dominant local orientation.
+ *
+ * The sums are accumulated in NumericTraits<InputPixelType>::RealType.
+ *
+ * \sa RieszRotationMatrix
+ * \sa RieszSteeringPolynomials
+ * \sa StructureTensor
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TInputImage,
+          typename TStructureTensorImage = Image<VariableSizeMatrix<double>, TInputImage::ImageDimension>>
+class RieszLocalSteeringImageFilter : public ImageToImageFilter<TInputImage, TInputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RieszLocalSteeringImageFilter);
+
+  /** Standard class type alias. */
+  using Self = RieszLocalSteeringImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TInputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(RieszLocalSteeringImageFilter, ImageToImageFilter);
+
+  /** Some convenient type alias. */
+  using InputImageType = typename Superclass::InputImageType;
+  using InputImagePointer = typename InputImageType::Pointer;
+  using InputImagePixelType = typename InputImageType::PixelType;
+  using OutputImageType = typename Superclass::OutputImageType;
+  using OutputImagePointer = typename OutputImageType::Pointer;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using OutputImagePixelType = typename OutputImageType::PixelType;
+  using StructureTensorImageType = TStructureTensorImage;
+  using AccumulateType = typename NumericTraits<InputImagePixelType>::RealType;
+
+  using SteeringPolynomialsType = RieszSteeringPolynomials<ImageDimension>;
+  using SteeringPolynomialsConstPointer = typename SteeringPolynomialsType::ConstPointer;
+
+  using InputsType = std::vector<InputImagePointer>;
+  using OutputsType = std::vector<OutputImagePointer>;
+
+  /** Set the Riesz components, there must be p(Order, ImageDimension) inputs. */
+  void
+  SetInputs(const InputsType & inputs);
+
+  /** Return vector of images with all the steered components. */
+  OutputsType
+  GetOutputs();
+
+  /** Output of StructureTensor, with d+1 columns: eigenvectors and eigenvalues. Required. */
+  itkSetInputMacro(StructureTensor, StructureTensorImageType);
+  itkGetInputMacro(StructureTensor, StructureTensorImageType);
+
+  /** Order of the Riesz transform of the inputs. Sets the number of outputs. Default: 1. */
+  virtual void
+  SetOrder(const unsigned int inputOrder)
+  {
+    if (inputOrder < 1)
+    {
+      itkExceptionMacro(<< "Error: inputOrder = " << inputOrder << ". It has to be greater than 0.");
+    }
+
+    if (this->m_Order != inputOrder)
+    {
+      this->m_Order = inputOrder;
+      this->SetNumberOfRequiredOutputs(itk::utils::ComputeNumberOfComponents(inputOrder, ImageDimension));
+      for (unsigned int comp = 0; comp < this->GetNumberOfRequiredOutputs(); ++comp)
+      {
+        this->SetNthOutput(comp, this->MakeOutput(comp));
+      }
+      this->Modified();
+    }
+  }
+  itkGetConstReferenceMacro(Order, unsigned int);
+
+  /** Put the eigenvector with the largest eigenvalue in the first row of the rotation. Default: true.
+   * \sa StructureTensor::GetRotationMatrixFromOutputMatrix */
+  itkSetMacro(LargestEigenvectorInFirstRow, bool);
+  itkGetConstMacro(LargestEigenvectorInFirstRow, bool);
+  itkBooleanMacro(LargestEigenvectorInFirstRow);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro(InputPixelTypeIsFloatCheck,
+                  (Concept::IsFloatingPoint<typename NumericTraits<InputImagePixelType>::ValueType>));
+#endif
+
+protected:
+  RieszLocalSteeringImageFilter();
+  ~RieszLocalSteeringImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  BeforeThreadedGenerateData() override;
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  unsigned int                    m_Order{ 0 };
+  bool                            m_LargestEigenvectorInFirstRow{ true };
+  SteeringPolynomialsConstPointer m_SteeringPolynomials;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkRieszLocalSteeringImageFilter.hxx"
+#endif
+
+#endif
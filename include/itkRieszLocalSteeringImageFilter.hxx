@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRieszLocalSteeringImageFilter_hxx
+#define itkRieszLocalSteeringImageFilter_hxx
+
+#include "itkRieszLocalSteeringImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+namespace itk
+{
+template <typename TInputImage, typename TStructureTensorImage>
+RieszLocalSteeringImageFilter<TInputImage, TStructureTensorImage>::RieszLocalSteeringImageFilter()
+{
+  this->AddRequiredInputName("StructureTensor");
+  this->SetOrder(1);
+
+  this->DynamicMultiThreadingOn();
+}
+
+template <typename TInputImage, typename TStructureTensorImage>
+void
+RieszLocalSteeringImageFilter<TInputImage, TStructureTensorImage>::SetInputs(const InputsType & inputs)
+{
+  for (unsigned int nin = 0; nin < inputs.size(); ++nin)
+  {
+    if (this->GetInput(nin) != inputs[nin])
+    {
+      this->SetNthInput(nin, inputs[nin]);
+    }
+  }
+}
+
+template <typename TInputImage, typename TStructureTensorImage>
+typename RieszLocalSteeringImageFilter<TInputImage, TStructureTensorImage>::OutputsType
+RieszLocalSteeringImageFilter<TInputImage, TStructureTensorImage>::GetOutputs()
+{
+  OutputsType outputList;
+  for (unsigned int comp = 0; comp < this->GetNumberOfOutputs(); ++comp)
+  {
+    outputList.push_back(this->GetOutput(comp));
+  }
+  return outputList;
+}
+
+template <typename TInputImage, typename TStructureTensorImage>
+void
+RieszLocalSteeringImageFilter<TInputImage, TStructureTensorImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Order: " << this->m_Order << std::endl;
+  os << indent << "LargestEigenvectorInFirstRow: " << this->m_LargestEigenvectorInFirstRow << std::endl;
+}
+
+template <typename TInputImage, typename TStructureTensorImage>
+void
+RieszLocalSteeringImageFilter<TInputImage, TStructureTensorImage>::BeforeThreadedGenerateData()
+{
+  const unsigned int numberOfComponents = this->GetNumberOfOutputs();
+  if (this->GetNumberOfIndexedInputs() != numberOfComponents)
+  {
+    itkExceptionMacro(<< "A Riesz transform of order " << this->m_Order << " has " << numberOfComponents
+                      << " components, but the number of inputs is " << this->GetNumberOfIndexedInputs()
+                      << ". Use SetInputs.");
+  }
+
+  const StructureTensorImageType * structureTensor = this->GetStructureTensor();
+  const auto & tensorMatrix = structureTensor->GetPixel(structureTensor->GetRequestedRegion().GetIndex());
+  const unsigned int tensorRows = tensorMatrix.GetVnlMatrix().rows();
+  if (tensorRows != ImageDimension || tensorMatrix.GetVnlMatrix().cols() < ImageDimension)
+  {
+    itkExceptionMacro(<< "The StructureTensor must be computed from " << ImageDimension
+                      << " images, its matrices have " << tensorRows << " rows.");
+  }
+
+  this->m_SteeringPolynomials = SteeringPolynomialsType::GetCached(this->m_Order);
+}
+
+template <typename TInputImage, typename TStructureTensorImage>
+void
+RieszLocalSteeringImageFilter<TInputImage, TStructureTensorImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  using InputIteratorType = ImageRegionConstIterator<InputImageType>;
+  using OutputIteratorType = ImageRegionIterator<OutputImageType>;
+  using TensorIteratorType = ImageRegionConstIterator<StructureTensorImageType>;
+
+  const SteeringPolynomialsType & polynomials = *this->m_SteeringPolynomials;
+  const unsigned int              numberOfComponents = polynomials.GetNumberOfComponents();
+
+  std::vector<InputIteratorType>  inputIts;
+  std::vector<OutputIteratorType> outputIts;
+  for (unsigned int comp = 0; comp < numberOfComponents; ++comp)
+  {
+    inputIts.emplace_back(this->GetInput(comp), outputRegionForThread);
+    outputIts.emplace_back(this->GetOutput(comp), outputRegionForThread);
+  }
+  TensorIteratorType tensorIt(this->GetStructureTensor(), outputRegionForThread);
+
+  double                      rotation[ImageDimension * ImageDimension];
+  std::vector<double>         workspace(polynomials.GetWorkspaceSize());
+  std::vector<double>         steerableMatrix(numberOfComponents * numberOfComponents);
+  std::vector<AccumulateType> values(numberOfComponents);
+  for (; !tensorIt.IsAtEnd(); ++tensorIt)
+  {
+    // Rows of the rotation are the eigenvectors, the columns of the output of StructureTensor.
+    const auto & tensorMatrix = tensorIt.Value();
+    for (unsigned int row = 0; row < ImageDimension; ++row)
+    {
+      const unsigned int eigenvector = this->m_LargestEigenvectorInFirstRow ? ImageDimension - 1 - row : row;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        rotation[row * ImageDimension + dim] = tensorMatrix(dim, eigenvector);
+      }
+    }
+    polynomials.Evaluate(rotation, workspace.data(), steerableMatrix.data());
+
+    for (unsigned int comp = 0; comp < numberOfComponents; ++comp)
+    {
+      values[comp] = static_cast<AccumulateType>(inputIts[comp].Get());
+      ++inputIts[comp];
+    }
+    const double * steerableRow = steerableMatrix.data();
+    for (unsigned int comp = 0; comp < numberOfComponents; ++comp, steerableRow += numberOfComponents)
+    {
+      AccumulateType sum = NumericTraits<AccumulateType>::ZeroValue();
+      for (unsigned int c = 0; c < numberOfComponents; ++c)
+      {
+        sum += steerableRow[c] * values[c];
+      }
+      outputIts[comp].Set(static_cast<OutputImagePixelType>(sum));
+      ++outputIts[comp];
+    }
+  }
+}
+} // end namespace itk
+#endif
@@ -59,11 +59,20 @@ public:
   /** Matrix by std::vector<TImage> multiplication.
    * To perform the rotation with the output of
    * \ref RieszFrequencyFilterBankGenerator.
+   * All the components are steered in one multi-threaded pass: at every pixel the matrix multiplies
+   * the vector with the values of all the input images, accumulated in NumericTraits<PixelType>::RealType.
+   * The input images must have the same buffered region. The outputs have the information of vect[0].
    */
   template <typename TImage>
   std::vector<typename TImage::Pointer>
   MultiplyWithVectorOfImages(const std::vector<typename TImage::Pointer> & vect) const;
 
+  /** Same than MultiplyWithVectorOfImages, but the result is written to the buffers of the input images,
+   * without allocating any image. Requires a square matrix. */
+  template <typename TImage>
+  void
+  MultiplyWithVectorOfImagesInPlace(const std::vector<typename TImage::Pointer> & vect) const;
+
   template <typename TInputValue>
   std::vector<TInputValue>
   MultiplyWithVector(const std::vector<TInputValue> & vect) const;
@@ -84,7 +93,9 @@ public:
    * The indices are ordered in descending order:
    * For example, for order = 2:
    * ( 2, 0, 0, )( 1, 1, 0, )( 1, 0, 1, )( 0, 2, 0, )( 0, 1, 1, )( 0, 0, 2, )
-
+   *
+   * The monomials in the entries of the rotation matrix and their coefficients are
+   * generated once per order and cached, \sa RieszSteeringPolynomials.
    */
   const InternalMatrixType &
   ComputeSteerableMatrix();
@@ -228,6 +239,12 @@ public:
 #endif
 
 private:
+  /** outputs[r] = sum_c S(r, c) * inputs[c], pixel by pixel. outputs can be the inputs. */
+  template <typename TImage>
+  void
+  MultiplyImageBuffers(const std::vector<typename TImage::Pointer> & inputs,
+                       const std::vector<typename TImage::Pointer> & outputs) const;
+
   SpatialRotationMatrixType m_SpatialRotationMatrix;
   unsigned int              m_Order{ 0 };
   unsigned int              m_Components{ 0 };
@@ -19,9 +19,10 @@
 #define itkRieszRotationMatrix_hxx
 
 #include "itkRieszRotationMatrix.h"
+#include "itkRieszSteeringPolynomials.h"
 #include "itkNumericTraits.h"
-#include "itkMultiplyImageFilter.h"
-#include "itkAddImageFilter.h"
+#include "itkMultiThreaderBase.h"
+#include "itkImageRegionIndexRange.h"
 
 namespace itk
 {
@@ -120,32 +121,102 @@ RieszRotationMatrix<T, VImageDimension>::MultiplyWithVectorOfImages(
   std::vector<ImagePointer> result(rows);
   for (unsigned int r = 0; r < rows; r++)
   {
-    // Init result image to zero.
-    ImagePointer sum = ImageType::New();
-    sum->SetRegions(vect[r]->GetLargestPossibleRegion());
-    sum->Allocate();
-    sum->FillBuffer(NumericTraits<typename ImageType::PixelType>::ZeroValue());
+    result[r] = ImageType::New();
+    result[r]->CopyInformation(vect[0]);
+    result[r]->SetRegions(vect[0]->GetBufferedRegion());
+    result[r]->Allocate();
+  }
+  this->template MultiplyImageBuffers<ImageType>(vect, result);
+  return result;
+}
 
-    for (unsigned int c = 0; c < cols; c++)
+template <typename T, unsigned int VImageDimension>
+template <typename TImage>
+void
+RieszRotationMatrix<T, VImageDimension>::MultiplyWithVectorOfImagesInPlace(
+  const std::vector<typename TImage::Pointer> & vect) const
+{
+  if (vect.size() != this->Cols() || this->Rows() != this->Cols())
+  {
+    itkGenericExceptionMacro(<< "Matrix of size " << this->Rows() << "x" << this->Cols()
+                             << " cannot be multiplied in place with vector of images of length: " << vect.size());
+  }
+  this->template MultiplyImageBuffers<TImage>(vect, vect);
+}
+
+template <typename T, unsigned int VImageDimension>
+template <typename TImage>
+void
+RieszRotationMatrix<T, VImageDimension>::MultiplyImageBuffers(
+  const std::vector<typename TImage::Pointer> & inputs,
+  const std::vector<typename TImage::Pointer> & outputs) const
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using RegionType = typename ImageType::RegionType;
+  using IndexType = typename ImageType::IndexType;
+  using AccumulateType = typename NumericTraits<PixelType>::RealType;
+  using CoefficientType = typename NumericTraits<AccumulateType>::ValueType;
+  constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  const unsigned int rows = this->Rows();
+  const unsigned int cols = this->Cols();
+  const RegionType   region = inputs[0]->GetBufferedRegion();
+  for (const auto & image : inputs)
+  {
+    if (image->GetBufferedRegion() != region)
     {
-      // sum += this->m_Matrix(r, c) * vect[r];
-      using MultiplyImageFilterType = itk::MultiplyImageFilter<ImageType>;
-      typename MultiplyImageFilterType::Pointer multiplyImageFilter = MultiplyImageFilterType::New();
-      multiplyImageFilter->SetInput(vect[c]);
-      multiplyImageFilter->SetConstant(this->GetVnlMatrix()(r, c));
+      itkGenericExceptionMacro(<< "All the images must have the same buffered region. " << region << " != "
+                               << image->GetBufferedRegion());
+    }
+  }
 
-      using AddImageFilterType = itk::AddImageFilter<ImageType>;
-      typename AddImageFilterType::Pointer addImageFilter = AddImageFilterType::New();
-      // Note that inPlace uses input1
-      addImageFilter->SetInput1(sum);
-      addImageFilter->SetInput2(multiplyImageFilter->GetOutput());
-      addImageFilter->InPlaceOn();
-      addImageFilter->Update();
-      sum = addImageFilter->GetOutput();
+  // Row major copy of the matrix and raw buffers, shared by all the threads.
+  std::vector<CoefficientType> coefficients(rows * cols);
+  for (unsigned int r = 0; r < rows; r++)
+  {
+    for (unsigned int c = 0; c < cols; c++)
+    {
+      coefficients[r * cols + c] = static_cast<CoefficientType>(this->GetVnlMatrix()(r, c));
     }
-    result[r] = sum;
   }
-  return result;
+  std::vector<const PixelType *> inputBuffers(cols);
+  for (unsigned int c = 0; c < cols; c++)
+  {
+    inputBuffers[c] = inputs[c]->GetBufferPointer();
+  }
+  std::vector<PixelType *> outputBuffers(rows);
+  for (unsigned int r = 0; r < rows; r++)
+  {
+    outputBuffers[r] = outputs[r]->GetBufferPointer();
+  }
+
+  const ImageType * referenceImage = inputs[0];
+  MultiThreaderBase::New()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [&](const RegionType & chunk) {
+      // All the values of a pixel are read before writing, so outputs can be the inputs.
+      std::vector<AccumulateType> values(cols);
+      for (const IndexType & index : ImageRegionIndexRange<ImageDimension>(chunk))
+      {
+        const OffsetValueType offset = referenceImage->ComputeOffset(index);
+        for (unsigned int c = 0; c < cols; c++)
+        {
+          values[c] = static_cast<AccumulateType>(inputBuffers[c][offset]);
+        }
+        for (unsigned int r = 0; r < rows; r++)
+        {
+          const CoefficientType * row = &coefficients[r * cols];
+          AccumulateType          sum = NumericTraits<AccumulateType>::ZeroValue();
+          for (unsigned int c = 0; c < cols; c++)
+          {
+            sum += row[c] * values[c];
+          }
+          outputBuffers[r][offset] = static_cast<PixelType>(sum);
+        }
+      }
+    },
+    nullptr);
 }
 
 template <typename T, unsigned int VImageDimension>
@@ -202,138 +273,26 @@ RieszRotationMatrix<T, VImageDimension>::ComputeSteerableMatrix()
     return this->GetVnlMatrix();
   }
 
-  using SetType = std::set<IndicesArrayType, std::greater<IndicesArrayType>>;
+  // The monomials of every entry only depend on the order and dimension, they are generated once.
+  const auto polynomials = RieszSteeringPolynomials<VImageDimension>::GetCached(this->m_Order);
 
-  // Create map between i,j matrix indices and n,m multiindex.
-  IndicesMatrix allIndicesPairs(this->GenerateIndicesMatrix());
-
-  std::vector<SetType> allIndicesOrder(this->m_Order + 1);
-  for (unsigned int ord = 1; ord < this->m_Order + 1; ++ord)
+  double rotation[VImageDimension * VImageDimension];
+  for (unsigned int row = 0; row < VImageDimension; ++row)
   {
-    allIndicesOrder[ord] = itk::utils::ComputeAllPossibleIndices<IndicesArrayType, VImageDimension>(ord);
+    for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+      rotation[row * VImageDimension + dim] = static_cast<double>(this->m_SpatialRotationMatrix[row][dim]);
+    }
   }
+  std::vector<double> workspace(polynomials->GetWorkspaceSize());
+  std::vector<double> steerableMatrix(this->m_Components * this->m_Components);
+  polynomials->Evaluate(rotation, workspace.data(), steerableMatrix.data());
+
   for (unsigned int i = 0; i < this->m_Components; ++i)
   {
     for (unsigned int j = 0; j < this->m_Components; ++j)
     {
-      const IndicesArrayType & n = allIndicesPairs[i][j][0];
-      const IndicesArrayType & m = allIndicesPairs[i][j][1];
-      // Set initial valid indices based on n and m.
-      std::vector<SetType> kValidInitialIndices(VImageDimension);
-      for (unsigned int dim = 0; dim < VImageDimension; ++dim)
-      {
-        const unsigned int & kOrder = n[dim];
-        if (kOrder == 0)
-        {
-          kValidInitialIndices[dim].insert(IndicesArrayType(VImageDimension));
-          continue;
-        }
-        for (auto itN = allIndicesOrder[kOrder].begin(); itN != allIndicesOrder[kOrder].end(); ++itN)
-        {
-          if (itk::utils::LessOrEqualIndiceComparisson<IndicesArrayType, VImageDimension>(*itN, m))
-          {
-            kValidInitialIndices[dim].insert(*itN);
-          }
-        }
-      }
-      // Select those set indices with \sum_i k_i = m among the the combination
-      // of initial valid indices.
-      // First combine indices in dimensions pairs. Example,
-      // k1 combine k2 = k'
-      // and then k' with k3 if exist, etc...
-
-      // Initialize kValidIndices with k0:
-      using ValidIndicesType = std::vector<IndicesVector>;
-      ValidIndicesType kValidIndices;
-      for (const auto & itValid0 : kValidInitialIndices[0])
-      {
-        // IndicesVector tmp;
-        // tmp.push_back(*itValid0);
-        // kValidIndices.push_back( tmp );
-        kValidIndices.push_back(IndicesVector(1, itValid0));
-      }
-
-      unsigned int combineIterations = VImageDimension - 1;
-      for (unsigned int combineIndex = 0; combineIndex < combineIterations; ++combineIndex)
-      {
-        ValidIndicesType tmpValidIndices; // store new valid indices.
-        for (auto & kValidIndex : kValidIndices)
-        {
-          for (const auto & itKIni : kValidInitialIndices[combineIndex + 1])
-          {
-            // ---verbose sum---
-            IndicesArrayType sumKIndices = itKIni;
-            for (auto & kIndex : kValidIndex)
-            {
-              for (unsigned int dim = 0; dim < VImageDimension; ++dim)
-              {
-                sumKIndices[dim] += kIndex[dim];
-              }
-            }
-            // --- end verbose sum:---
-            // if sum is valid: append index to tmpValidIndices.
-            if (itk::utils::LessOrEqualIndiceComparisson<IndicesArrayType, VImageDimension>(sumKIndices, m))
-            {
-              IndicesVector tmp = kValidIndex;
-              tmp.push_back(itKIni);
-              tmpValidIndices.push_back(tmp);
-            }
-          } // end new k indices
-        }   // end partial valid index
-        kValidIndices = tmpValidIndices;
-      } // end combinations
-
-      // kValidIndices at current i,j matrix positions
-      // The vector kValidIndices holds a vector of valid sets of k vectors (k1,k2,k3),(k'1,k'2,k'3) ,...
-      // where k_i is a multiindex: k1 = (k11, k12, ..., k1d)
-      //
-      // we calculate now r11^k11*...*r1d^k1d
-      // matrix R = [r1,...,rd], where r_i are columns of the rotation matrix.
-      // we sum and normalize them.
-      S[i][j] = 0;
-      long double result = 0;
-      long        nFactorial = 1;
-      long        mFactorial = 1;
-      for (unsigned int dim = 0; dim < VImageDimension; ++dim)
-      {
-        nFactorial *= itk::utils::Factorial(n[dim]);
-        mFactorial *= itk::utils::Factorial(m[dim]);
-      }
-      auto nFactorialReal = static_cast<double>(nFactorial);
-      for (auto & kValidIndex : kValidIndices)
-      {
-        long double rotationFactor = 1;
-        long        kFactorialMultiplication = 1;
-        // There are always VImageDimension indices. (k1,k2,...,kd)
-        for (unsigned int kIndex = 0; kIndex < VImageDimension; ++kIndex)
-        {
-          for (unsigned int dim = 0; dim < VImageDimension; ++dim)
-          {
-            const unsigned int & k = kValidIndex[kIndex][dim];
-            // k1! = k11!*k12!*...*k1d!
-            kFactorialMultiplication *= itk::utils::Factorial(k);
-            // r11^k11*...*r1d^k1d
-            // switch to avoid unnecesary calls to std::pow.
-            if (k == 0)
-            {
-              continue;
-            }
-            else if (k == 1)
-            {
-              rotationFactor *= this->m_SpatialRotationMatrix[kIndex][dim];
-            }
-            else
-            {
-              rotationFactor *= std::pow(this->m_SpatialRotationMatrix[kIndex][dim], static_cast<int>(k));
-            }
-          }
-        }
-        result += nFactorialReal / kFactorialMultiplication * rotationFactor;
-      }
-
-      // normalize by sqrt(m!/n!):
-      result *= sqrt(mFactorial / nFactorialReal);
-      S[i][j] = static_cast<ValueType>(result);
+      S[i][j] = static_cast<ValueType>(steerableMatrix[i * this->m_Components + j]);
       // Try to fix close to zero float errors
       if (itk::Math::FloatAlmostEqual(S[i][j],
                                       static_cast<ValueType>(0),
@@ -342,72 +301,16 @@ RieszRotationMatrix<T, VImageDimension>::ComputeSteerableMatrix()
       {
         S[i][j] = 0;
       }
-
-      if (this->GetDebug())
-      {
-        std::cout << "\n" << std::endl;
-        std::cout << "i, j: " << i << ", " << j << std::endl;
-        std::cout << "n, m: ";
-        for (unsigned int p = 0; p < 2; ++p)
-        {
-          std::cout << "( ";
-          for (unsigned int dim = 0; dim < VImageDimension; ++dim)
-          {
-            std::cout << allIndicesPairs[i][j][p][dim] << ", ";
-          }
-          std::cout << ") , ";
-        }
-        std::cout << std::endl;
-
-        std::cout << "kValidIndices.size(): " << kValidIndices.size() << std::endl;
-        for (auto & kValidIndex : kValidIndices)
-        {
-          for (auto & v : kValidIndex)
-          {
-            std::cout << "( ";
-            for (unsigned int dim = 0; dim < VImageDimension; ++dim)
-            {
-              std::cout << v[dim] << ", ";
-            }
-            std::cout << ") , ";
-          }
-          std::cout << "    ";
-        }
-
-        std::cout << "\n InitialValidIndices" << std::endl;
-        for (unsigned int dim = 0; dim < VImageDimension; ++dim)
-        {
-          std::cout << "dim:" << dim << std::endl;
-          for (const auto & it : kValidInitialIndices[dim])
-          {
-            std::cout << "( ";
-            for (unsigned int innerDim = 0; innerDim < VImageDimension; ++innerDim)
-            {
-              std::cout << it[innerDim] << ", ";
-            }
-            std::cout << ")";
-          }
-          std::cout << std::endl;
-        }
-      } // end Debug
-    }   // end j
-  }     // end i
+    }
+  }
 
   // ----- PRINT ---- //
   // Print allIndicesPairs
   if (this->GetDebug())
   {
-    // for(typename SetType::const_iterator it = allIndices.begin(); it != allIndices.end(); ++it)
-    //   {
-    //   std::cout <<"( ";
-    //   for (unsigned int i = 0; i<VImageDimension; ++i)
-    //     {
-    //     std::cout << (*it)[i] << ", ";
-    //     }
-    //   std::cout <<")";
-    //   }
-    //   std::cout << std::endl;;
+    IndicesMatrix allIndicesPairs(this->GenerateIndicesMatrix());
     std::cout << std::endl;
+    std::cout << "Number of monomials: " << polynomials->GetNumberOfTerms() << std::endl;
     std::cout << "All Indices:" << std::endl;
     for (unsigned int i = 0; i < this->m_Components; ++i)
     {
@@ -426,19 +329,6 @@ RieszRotationMatrix<T, VImageDimension>::ComputeSteerableMatrix()
       }
       std::cout << "\n";
     }
-    // for (unsigned int c = 0; c < kValidIndices.size(); ++c)
-    //   {
-    //   for (unsigned int v = 0; v < kValidIndices[c].size(); ++v)
-    //     {
-    //     std::cout <<"( ";
-    //     for (unsigned int dim = 0; dim<VImageDimension; ++dim)
-    //       {
-    //       std::cout << kValidIndices[c][v][dim] << ", ";
-    //       }
-    //     std::cout <<") , ";
-    //     }
-    //   std::cout <<"    ";
-    //   }
   } // end Debug
 
   return this->GetVnlMatrix(); // return S;
@@ -0,0 +1,124 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRieszSteeringPolynomials_h
+#define itkRieszSteeringPolynomials_h
+
+#include "itkRieszUtilities.h"
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+/** \class RieszSteeringPolynomials
+ * Closed form of the steerable matrix \f$ S_r \f$ of a Riesz transform of order N,
+ * as polynomials in the entries of the dxd spatial rotation matrix R.
+ *
+ * Every entry S[n][m] is a sum of monomials of degree N:
+ * \f[ S[n][m] = \sqrt{\frac{m!}{n!}} \sum_{|k_1| = n_1} \cdots \sum_{|k_d| = n_d} \delta_{k_1 + \cdots + k_d, m}
+ *  \frac{n!}{k_1! \cdots k_d!} r_1^{k_1} \cdots r_d^{k_d} \f]
+ * where \f$ r_i \f$ is the row i of R. The monomials and their coefficients only depend on N and d,
+ * they are generated once by the constructor, and Evaluate computes \f$ S_r \f$ for any R without
+ * building any set of indices.
+ *
+ * GetCached returns an instance per order shared by the whole process, it is safe to call it
+ * from multiple threads. Evaluate is const and can be called concurrently with different workspaces.
+ *
+ * The rows and columns follow the order of the multi-indices of ComputeAllPossibleIndices,
+ * the same than RieszFrequencyFunction and RieszRotationMatrix.
+ *
+ * \sa RieszRotationMatrix
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <unsigned int VImageDimension = 3>
+class RieszSteeringPolynomials
+{
+public:
+  /** Standard type alias */
+  using Self = RieszSteeringPolynomials;
+  using ConstPointer = std::shared_ptr<const Self>;
+
+  using IndicesArrayType = std::vector<unsigned int>;
+  using IndicesVectorType = std::vector<IndicesArrayType>;
+
+  /** Number of entries of the rotation matrix. */
+  static constexpr unsigned int NumberOfRotationEntries = VImageDimension * VImageDimension;
+
+  /** Generate the monomials of all the entries of the steerable matrix for the order. */
+  explicit RieszSteeringPolynomials(const unsigned int & order);
+
+  /** Polynomials of the order, generated only in the first call with each order. */
+  static ConstPointer
+  GetCached(const unsigned int & order);
+
+  const unsigned int &
+  GetOrder() const
+  {
+    return this->m_Order;
+  }
+
+  /** Number of components M. The steerable matrix is MxM. */
+  const unsigned int &
+  GetNumberOfComponents() const
+  {
+    return this->m_NumberOfComponents;
+  }
+
+  /** Multi-index of each row and column of the steerable matrix. */
+  const IndicesVectorType &
+  GetIndices() const
+  {
+    return this->m_Indices;
+  }
+
+  /** Number of monomials of all the entries. */
+  unsigned int
+  GetNumberOfTerms() const
+  {
+    return static_cast<unsigned int>(this->m_TermCoefficients.size());
+  }
+
+  /** Size of the workspace required by Evaluate. */
+  unsigned int
+  GetWorkspaceSize() const
+  {
+    return NumberOfRotationEntries * (this->m_Order + 1);
+  }
+
+  /** Compute the MxM steerable matrix, row major, from the dxd rotation matrix, row major.
+   * workspace must hold GetWorkspaceSize() values, it stores the powers of the rotation entries. */
+  void
+  Evaluate(const double * rotation, double * workspace, double * steerableMatrix) const;
+
+private:
+  unsigned int      m_Order;
+  unsigned int      m_NumberOfComponents;
+  IndicesVectorType m_Indices;
+  /** Linear index row * M + column of the entry of each term. */
+  std::vector<unsigned int> m_TermEntries;
+  std::vector<double>       m_TermCoefficients;
+  /** Order factors per term: positions in the workspace of entry^exponent, padded with the position of 1. */
+  std::vector<unsigned int> m_TermFactors;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkRieszSteeringPolynomials.hxx"
+#endif
+
+#endif
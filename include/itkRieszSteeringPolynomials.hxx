@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRieszSteeringPolynomials_hxx
+#define itkRieszSteeringPolynomials_hxx
+
+#include "itkRieszSteeringPolynomials.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace itk
+{
+template <unsigned int VImageDimension>
+RieszSteeringPolynomials<VImageDimension>::RieszSteeringPolynomials(const unsigned int & order)
+  : m_Order(order)
+  , m_NumberOfComponents(itk::utils::ComputeNumberOfComponents(order, VImageDimension))
+{
+  if (order == 0)
+  {
+    itkGenericExceptionMacro(<< "RieszSteeringPolynomials requires an order greater than 0.");
+  }
+
+  // Multi-indices k with |k| = ord, for all the orders up to m_Order. Order 0 is the null index.
+  std::vector<IndicesVectorType> indicesOfOrder(order + 1);
+  indicesOfOrder[0].push_back(IndicesArrayType(VImageDimension));
+  for (unsigned int ord = 1; ord <= order; ++ord)
+  {
+    const auto indices = itk::utils::ComputeAllPossibleIndices<IndicesArrayType, VImageDimension>(ord);
+    indicesOfOrder[ord].assign(indices.begin(), indices.end());
+  }
+  this->m_Indices = indicesOfOrder[order];
+  std::map<IndicesArrayType, unsigned int> columnOfIndex;
+  for (unsigned int column = 0; column < this->m_NumberOfComponents; ++column)
+  {
+    columnOfIndex[this->m_Indices[column]] = column;
+  }
+
+  const unsigned int powerStride = order + 1;
+  for (unsigned int row = 0; row < this->m_NumberOfComponents; ++row)
+  {
+    const IndicesArrayType & n = this->m_Indices[row];
+    double                   nFactorial = 1;
+    for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+      nFactorial *= itk::utils::Factorial(n[dim]);
+    }
+
+    // Visit all the combinations (k_1, ..., k_d) with |k_i| = n_i.
+    std::vector<unsigned int> choice(VImageDimension, 0);
+    bool                      done = false;
+    while (!done)
+    {
+      IndicesArrayType m(VImageDimension, 0);
+      double           kFactorial = 1;
+      for (unsigned int i = 0; i < VImageDimension; ++i)
+      {
+        const IndicesArrayType & k = indicesOfOrder[n[i]][choice[i]];
+        for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+        {
+          m[dim] += k[dim];
+          kFactorial *= itk::utils::Factorial(k[dim]);
+          if (k[dim] > 0)
+          {
+            this->m_TermFactors.push_back((i * VImageDimension + dim) * powerStride + k[dim]);
+          }
+        }
+      }
+      double mFactorial = 1;
+      for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+      {
+        mFactorial *= itk::utils::Factorial(m[dim]);
+      }
+      // Pad the factors of the term to the order with the power 0 of the first entry, which is 1.
+      this->m_TermFactors.resize(this->m_TermCoefficients.size() * order + order, 0);
+      this->m_TermEntries.push_back(row * this->m_NumberOfComponents + columnOfIndex[m]);
+      this->m_TermCoefficients.push_back(nFactorial / kFactorial * std::sqrt(mFactorial / nFactorial));
+
+      // Next combination.
+      done = true;
+      for (unsigned int i = 0; i < VImageDimension; ++i)
+      {
+        if (++choice[i] < indicesOfOrder[n[i]].size())
+        {
+          done = false;
+          break;
+        }
+        choice[i] = 0;
+      }
+    }
+  }
+}
+
+template <unsigned int VImageDimension>
+typename RieszSteeringPolynomials<VImageDimension>::ConstPointer
+RieszSteeringPolynomials<VImageDimension>::GetCached(const unsigned int & order)
+{
+  static std::mutex                           cacheMutex;
+  static std::map<unsigned int, ConstPointer> cache;
+
+  const std::lock_guard<std::mutex> lock(cacheMutex);
+  ConstPointer &                    polynomials = cache[order];
+  if (!polynomials)
+  {
+    polynomials = std::make_shared<Self>(order);
+  }
+  return polynomials;
+}
+
+template <unsigned int VImageDimension>
+void
+RieszSteeringPolynomials<VImageDimension>::Evaluate(const double * rotation,
+                                                    double *       workspace,
+                                                    double *       steerableMatrix) const
+{
+  const unsigned int order = this->m_Order;
+  const unsigned int powerStride = order + 1;
+  for (unsigned int entry = 0; entry < NumberOfRotationEntries; ++entry)
+  {
+    double * powers = workspace + entry * powerStride;
+    powers[0] = 1.0;
+    for (unsigned int exponent = 1; exponent <= order; ++exponent)
+    {
+      powers[exponent] = powers[exponent - 1] * rotation[entry];
+    }
+  }
+
+  std::fill(steerableMatrix, steerableMatrix + this->m_NumberOfComponents * this->m_NumberOfComponents, 0.0);
+  const unsigned int * factors = this->m_TermFactors.data();
+  for (unsigned int term = 0; term < this->m_TermCoefficients.size(); ++term, factors += order)
+  {
+    double value = this->m_TermCoefficients[term];
+    for (unsigned int f = 0; f < order; ++f)
+    {
+      value *= workspace[factors[f]];
+    }
+    steerableMatrix[this->m_TermEntries[term]] += value;
+  }
+}
+} // end namespace itk
+#endif
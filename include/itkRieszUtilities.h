@@ -152,6 +152,105 @@ LessOrEqualIndiceComparisson(const TIndicesArrayType & rhs, const TIndicesArrayT
   }
   return true;
 }
+
+/// Factorial, evaluated at compile time when possible.
+constexpr long
+FactorialConstexpr(const long n)
+{
+  return n < 1 ? 1 : n * FactorialConstexpr(n - 1);
+}
+
+/// Square root by Newton iterations, evaluated at compile time when possible. Precondition: x >= 1.
+constexpr double
+SqrtConstexpr(const double x)
+{
+  double root = x;
+  for (unsigned int iteration = 0; iteration < 64; ++iteration)
+  {
+    root = 0.5 * (root + x / root);
+  }
+  return root;
+}
+
+/** Number of components p(N, d) of the Riesz transform of order N in dimension d, at compile time.
+ * \sa ComputeNumberOfComponents */
+template <unsigned int VOrder, unsigned int VImageDimension>
+struct RieszNumberOfComponents
+{
+  static constexpr unsigned int Value = static_cast<unsigned int>(
+    FactorialConstexpr(VOrder + VImageDimension - 1) /
+    (FactorialConstexpr(VImageDimension - 1) * FactorialConstexpr(VOrder)));
+};
+
+/** Exponents (n1,...,nd) and normalizing factors sqrt(N!/(n1!...nd!)) of all the components of the
+ * Riesz transform of order N, in the same order than ComputeAllPossibleIndices. */
+template <unsigned int VOrder, unsigned int VImageDimension>
+struct RieszComponentTable
+{
+  static constexpr unsigned int NumberOfComponents = RieszNumberOfComponents<VOrder, VImageDimension>::Value;
+
+  unsigned int Exponents[NumberOfComponents][VImageDimension]{};
+  double       NormalizingFactors[NumberOfComponents]{};
+};
+
+/** Generate the RieszComponentTable at compile time.
+ * The indices are generated in descending lexicographic order, as the std::greater set of ComputeAllPossibleIndices.
+ * The next index decrements the last non-zero exponent before the last dimension, and moves the exponents
+ * after it, plus one, to the next dimension. */
+template <unsigned int VOrder, unsigned int VImageDimension>
+constexpr RieszComponentTable<VOrder, VImageDimension>
+MakeRieszComponentTable()
+{
+  using TableType = RieszComponentTable<VOrder, VImageDimension>;
+  TableType    table{};
+  unsigned int exponents[VImageDimension]{};
+  exponents[0] = VOrder;
+  for (unsigned int comp = 0; comp < TableType::NumberOfComponents; ++comp)
+  {
+    double multinomial = FactorialConstexpr(VOrder);
+    for (unsigned int dim = 0; dim < VImageDimension; ++dim)
+    {
+      table.Exponents[comp][dim] = exponents[dim];
+      multinomial /= FactorialConstexpr(exponents[dim]);
+    }
+    table.NormalizingFactors[comp] = SqrtConstexpr(multinomial);
+
+    if (comp + 1 < TableType::NumberOfComponents)
+    {
+      unsigned int position = VImageDimension - 2;
+      while (exponents[position] == 0)
+      {
+        --position;
+      }
+      const unsigned int tail = exponents[VImageDimension - 1];
+      exponents[VImageDimension - 1] = 0;
+      --exponents[position];
+      exponents[position + 1] = tail + 1;
+    }
+  }
+  return table;
+}
+
+/** x^VExponent, unrolled at compile time. */
+template <unsigned int VExponent>
+struct IntegerPower
+{
+  static inline double
+  Compute(const double x)
+  {
+    return x * IntegerPower<VExponent - 1>::Compute(x);
+  }
+};
+
+template <>
+struct IntegerPower<0>
+{
+  static inline double
+  Compute(const double)
+  {
+    return 1.0;
+  }
+};
 } // end namespace utils
 } // end namespace itk
 
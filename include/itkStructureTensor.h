@@ -20,11 +20,18 @@
 
 #include <itkImageToImageFilter.h>
 #include <itkImageScanlineConstIterator.h>
+#include <itkImageScanlineIterator.h>
 #include <itkImageRegionIteratorWithIndex.h>
 #include <itkArray.h>
 #include <itkVariableSizeMatrix.h>
+#include <itkMatrix.h>
 #include <itkSymmetricSecondRankTensor.h>
 #include <itkGaussianImageSource.h>
+#include <itkVectorImage.h>
+#include <array>
+#include "itkFixedSizeSymmetricEigenSolver.h"
+#include "itkStructureTensorProjectionImageFilter.h"
+#include "itkStructureTensorCoherencyImageFilter.h"
 namespace itk
 {
 /** \class StructureTensor
@@ -57,11 +64,33 @@ I_m[\mathbf{x}]I_n[\mathbf{x}]
  * where \f$I_m, I_n \f$ are input images, \f$ m,n \in {0,N-1} \f$ and \f$N\f$ is the total number of inputs.
  * \f$g\f$ is a gaussian kernel of radius SetGaussianWindowRadius()
  *
+ * The window is separable: the products \f$I_m I_n\f$ of each line of the inputs are computed on the fly and
+ * smoothed along the first axis, and then along each of the other axes, in threaded passes over lines that process
+ * all the pairs (m,n). The cost is \f$O(N (2r+1) d)\f$ per pair instead of \f$O(N (2r+1)^d)\f$ of a convolution
+ * with the (2r+1)^d window, with zero flux Neumann boundary conditions.
+ * Only the requested region of the output, padded by the radius of the window, is computed, so the filter can be
+ * streamed (for example with StreamingImageFilter) to bound the memory used by the N(N+1)/2 smoothed products.
+ *
+ * The truncated window costs O(r) per pixel and axis. With UseRecursiveGaussian on, each axis is smoothed instead
+ * with the third order recursive Gaussian filter of Young and van Vliet, whose cost per pixel does not depend on
+ * sigma: it approximates the untruncated Gaussian and ignores GaussianWindowRadius. Its support is the whole
+ * image, so the whole inputs are requested also when the output is streamed.
+ *
  * The solution of the EigenSystem defined by \f$\mathbf{J}\f$ are the N EigenValues and EigenVectors.
  * The output of StructureTensor is a 2D Matrix of size (N,N+1), where the submatrix (N,N) are the EigenVectors, and the
 last column (N+1) are the EigenValues.
  * The orientation that maximixes the response: \f$u\f$ is the EigenVector with largest EigenValue, which is is the Nth
 column of the output matrix.
+ * The output pixel is a VariableSizeMatrix by default. When the number of inputs is known at compile time, the
+ * output pixel can be a fixed size itk::Matrix<double, N, N + 1>, stored without any heap allocation per pixel.
+ * For 2 and 3 inputs the eigen system of each pixel is solved with FixedSizeSymmetricEigenSolver, on the stack,
+ * directly from the lines of the smoothed products. For more inputs vnl_symmetric_eigensystem is used.
+ *
+ * With GenerateCompactTensor on, the second output, GetCompactTensorOutput(), is a VectorImage with the
+ * N(N+1)/2 entries of \f$\mathbf{J}\f$ in the order of LowerTriangleToLinearIndex, followed by its N EigenValues
+ * in ascending order: N(N+3)/2 values per pixel instead of N(N+1) (65 instead of 110 for 10 inputs).
+ * The EigenVectors are computed on demand from the tensor, for example by StructureTensorProjectionImageFilter.
+ * Turn GenerateEigenMatrix off to only store the compact output.
  * We can use the calculated direction \f$u\f$ to get a new image with max response from the inputs at each pixel.
  * \see ComputeProjectionImageWithLargestResponse(),
  * or any other direction from other eigen vectors with \see ComputeProjectionImage(unsigned int eigen_index)
@@ -126,9 +155,13 @@ public:
   itkConceptMacro(InputPixelTypeIsFloatCheck, (Concept::IsFloatingPoint<typename TInputImage::PixelType>));
 #endif
   using EigenMatrixImageType = OutputImageType;
+  using CompactTensorImageType = VectorImage<FloatType, ImageDimension>;
+  using ProjectionFilterType = StructureTensorProjectionImageFilter<InputImageType, CompactTensorImageType>;
+  using CoherencyFilterType = StructureTensorCoherencyImageFilter<CompactTensorImageType, InputImageType>;
   using EigenMatrixType = OutputImagePixelType;
   using EigenValuesType = itk::Array<typename OutputImagePixelType::ValueType>;
   using SymmetricEigenAnalysisType = itk::SymmetricEigenAnalysis<EigenMatrixType, EigenValuesType>;
+  using RotationMatrixType = VariableSizeMatrix<typename OutputImagePixelType::ValueType>;
   using GaussianSourceType = GaussianImageSource<FloatImageType>;
 
   using InputsType = typename std::vector<InputImagePointer>;
@@ -150,15 +183,61 @@ public:
   itkSetMacro(GaussianWindowSigma, FloatType);
   itkGetConstMacro(GaussianWindowSigma, FloatType);
   /**
-   * Pointer to the GaussianSource.
+   * Smooth with the recursive Gaussian filter of Young and van Vliet instead of the truncated window.
+   * Requires GaussianWindowSigma of at least half the spacing of every axis. Default: false.
+   */
+  itkSetMacro(UseRecursiveGaussian, bool);
+  itkGetConstMacro(UseRecursiveGaussian, bool);
+  itkBooleanMacro(UseRecursiveGaussian);
+
+  /**
+   * The (2r+1)^d Gaussian window with the current radius, sigma and spacing of the input, useful for inspection.
+   * It is only built and updated when requested: the smoothing applies the same (normalized) window separably.
    * \sa GaussianImageSource
    */
-  itkGetModifiableObjectMacro(GaussianSource, GaussianSourceType);
+  GaussianSourceType *
+  GetModifiableGaussianSource();
+  const GaussianSourceType *
+  GetGaussianSource()
+  {
+    return this->GetModifiableGaussianSource();
+  }
+
+  /** Generate the first output, the matrix of EigenVectors and EigenValues. Default: true. */
+  itkSetMacro(GenerateEigenMatrix, bool);
+  itkGetConstMacro(GenerateEigenMatrix, bool);
+  itkBooleanMacro(GenerateEigenMatrix);
+
+  /** Generate the second output, the packed tensor and its EigenValues. Default: false. */
+  itkSetMacro(GenerateCompactTensor, bool);
+  itkGetConstMacro(GenerateCompactTensor, bool);
+  itkBooleanMacro(GenerateCompactTensor);
+
+  CompactTensorImageType *
+  GetCompactTensorOutput()
+  {
+    return static_cast<CompactTensorImageType *>(this->ProcessObject::GetOutput(1));
+  }
+
+  const CompactTensorImageType *
+  GetCompactTensorOutput() const
+  {
+    return static_cast<const CompactTensorImageType *>(this->ProcessObject::GetOutput(1));
+  }
+
+  /** Number of values per pixel of the compact output: N(N+1)/2 entries of the tensor and N EigenValues. */
+  static unsigned int
+  GetNumberOfCompactTensorComponents(const unsigned int & nInputs)
+  {
+    return nInputs * (nInputs + 3) / 2;
+  }
 
   /**
    * Compute a new image which is a linear combination of the inputs.
    * The weights of the linear combination are given by the eigenVector
    * associated to the input eigen_number.
+   * It is computed in threads, from the compact output if it is generated, with
+   * StructureTensorProjectionImageFilter, or from the first output otherwise.
    *
    * @param eigen_number column of the eigenVector, note that the largest eigenValue is in Nth column.
    *
@@ -181,6 +260,8 @@ public:
    * meanNonPrincipalEV \f$ = M = \frac{1}{N-1} \sum_{i=1}^{N-1}\lambda_i \f$
    * coherency \f$ = \frac{\lambda_N - M}{\lambda_1 + M} \f$
    * where \f$ \lambda_N \f$ is the largest eigen value.
+   * It is computed in threads, from the compact output if it is generated, with
+   * StructureTensorCoherencyImageFilter, or from the first output otherwise.
    *
    * @return Image filled with the coherency at each pixel.
    */
@@ -200,7 +281,7 @@ public:
    *
    * @return rotationMatrix
    */
-  EigenMatrixType
+  RotationMatrixType
   GetRotationMatrixFromOutputMatrix(const EigenMatrixType & outputMatrix,
                                     bool                    reOrderLargestEigenvectorInFirstRow = false) const;
 
@@ -210,24 +291,109 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** The second output is a CompactTensorImageType. */
+  using Superclass::MakeOutput;
+  DataObject::Pointer
+  MakeOutput(DataObjectPointerArraySizeType idx) override;
+
+  /** Set the number of components of the compact output. */
+  void
+  GenerateOutputInformation() override;
+
+  /** Only allocate the outputs that are generated. */
+  void
+  AllocateOutputs() override;
+
+  /** The inputs are required in the output requested region padded by the radius of the Gaussian window. */
+  void
+  GenerateInputRequestedRegion() override;
+
   void
   BeforeThreadedGenerateData() override;
 
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
-  /** Assuming that row>=column */
+  void
+  AfterThreadedGenerateData() override;
+
+  /** Set the size of a VariableSizeMatrix output pixel to (nInputs, nInputs + 1). Only reallocates if it changes. */
+  template <typename TValue>
+  static bool
+  ResizeOutputMatrix(VariableSizeMatrix<TValue> & outputMatrix, const unsigned int & nInputs)
+  {
+    outputMatrix.SetSize(nInputs, nInputs + 1);
+    return true;
+  }
+
+  /** A fixed size output pixel can not be resized, return if it has the size (nInputs, nInputs + 1). */
+  template <typename TValue, unsigned int VRows, unsigned int VColumns>
+  static bool
+  ResizeOutputMatrix(Matrix<TValue, VRows, VColumns> &, const unsigned int & nInputs)
+  {
+    return VRows == nInputs && VColumns == nInputs + 1;
+  }
+
+  /** Eigen system of each pixel of a line of length pixels, from the lines of the smoothed products, with
+   * FixedSizeSymmetricEigenSolver<VInputs>. eigenMatrixLine and compactTensorLine point to the first pixel of the
+   * line in each output, or are nullptr if the output is not generated. */
+  template <unsigned int VInputs>
+  static void
+  ComputeEigenSystemsOfLine(const std::vector<const FloatType *> & pairLines,
+                            const SizeValueType &                  length,
+                            OutputImagePixelType *                 eigenMatrixLine,
+                            FloatType *                            compactTensorLine);
+
+  /** Same than ComputeEigenSystemsOfLine, for any number of inputs. */
+  static void
+  ComputeEigenSystemsOfLine(const std::vector<const FloatType *> & pairLines,
+                            const unsigned int &                   nInputs,
+                            const SizeValueType &                  length,
+                            OutputImagePixelType *                 eigenMatrixLine,
+                            FloatType *                            compactTensorLine);
+
+  /** Normalized coefficients B, b1/b0, b2/b0 and b3/b0 of the recursive Gaussian filter of Young and van Vliet. */
+  using RecursiveCoefficientsType = std::array<FloatType, 4>;
+
+  /** Coefficients of the recursive Gaussian filter for sigma in pixels, at least 0.5. */
+  static RecursiveCoefficientsType
+  ComputeRecursiveCoefficients(const FloatType & sigma);
+
+  /** Smooth the line stored in line[0, length) with the causal and anti-causal recursive Gaussian filters,
+   * writing the result to output with the given stride. The line is used as buffer. */
+  static void
+  RecursiveSmoothLine(std::vector<FloatType> &          line,
+                      const SizeValueType &             length,
+                      const RecursiveCoefficientsType & coefficients,
+                      FloatType *                       output,
+                      const OffsetValueType &           outputStride);
+
+  /** Linear index of the pair (r,c) of the symmetric tensor, assuming that r <= c */
   static unsigned int
   LowerTriangleToLinearIndex(unsigned int r, unsigned int c)
   {
     return r + (c + 1) * c / 2;
   }
 
+  /** Smooth a line stored in paddedLine[radius, radius + length) with the 1D weights of the window,
+   * writing the result to output with the given stride. */
+  static void
+  SmoothLine(std::vector<FloatType> &       paddedLine,
+             const SizeValueType &          length,
+             const std::vector<FloatType> & weights,
+             FloatType *                    output,
+             const OffsetValueType &        outputStride);
+
 private:
   unsigned int                         m_GaussianWindowRadius{ 2 };
   FloatType                            m_GaussianWindowSigma{ 1.0 };
   typename GaussianSourceType::Pointer m_GaussianSource;
-  InputsType                           m_SquareSmoothedImages;
+  bool                                 m_UseRecursiveGaussian{ false };
+  bool                                 m_GenerateEigenMatrix{ true };
+  bool                                 m_GenerateCompactTensor{ false };
+  /** Smoothed products of the inputs, in double precision also for float inputs.
+   * Indexed by LowerTriangleToLinearIndex, and only kept during the generation of the output. */
+  std::vector<FloatImagePointer> m_SquareSmoothedImages;
 };
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
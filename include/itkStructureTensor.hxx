@@ -20,14 +20,14 @@
 #include "itkStructureTensor.h"
 #include "itkImageScanlineConstIterator.h"
 #include "itkImageScanlineIterator.h"
-#include <itkMultiplyImageFilter.h>
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <cmath>
 #include <numeric>
+#include <algorithm>
 // Eigen Calculations
 #include "itkSymmetricEigenAnalysis.h"
+#include "vnl/algo/vnl_symmetric_eigensystem.h"
 #include "itkImageDuplicator.h"
-// Convolution/Neighborhood Operations
-#include <itkConvolutionImageFilter.h>
-#include <itkConstantBoundaryCondition.h>
 
 namespace itk
 {
@@ -36,7 +36,8 @@ StructureTensor<TInputImage, TOutputImage>::StructureTensor()
 
 
 {
-  this->m_GaussianSource = GaussianSourceType::New();
+  this->SetNumberOfRequiredOutputs(2);
+  this->SetNthOutput(1, this->MakeOutput(1));
 
   this->DynamicMultiThreadingOn();
 }
@@ -66,9 +67,119 @@ StructureTensor<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent
   Superclass::PrintSelf(os, indent);
   os << indent << "GaussianWindowRadius: " << this->m_GaussianWindowRadius << std::endl;
   os << indent << "GaussianWindowSigma: " << this->m_GaussianWindowSigma << std::endl;
+  os << indent << "UseRecursiveGaussian: " << this->m_UseRecursiveGaussian << std::endl;
+  os << indent << "GenerateEigenMatrix: " << this->m_GenerateEigenMatrix << std::endl;
+  os << indent << "GenerateCompactTensor: " << this->m_GenerateCompactTensor << std::endl;
   itkPrintSelfObjectMacro(GaussianSource);
 }
 
+template <typename TInputImage, typename TOutputImage>
+typename StructureTensor<TInputImage, TOutputImage>::GaussianSourceType *
+StructureTensor<TInputImage, TOutputImage>::GetModifiableGaussianSource()
+{
+  if (this->m_GaussianSource.IsNull())
+  {
+    this->m_GaussianSource = GaussianSourceType::New();
+  }
+  typename InputImageType::PointType inputOrigin;
+  SpacingType                        inputSpacing;
+  inputOrigin.Fill(0);
+  inputSpacing.Fill(1);
+  if (this->GetInput() != nullptr)
+  {
+    inputOrigin = this->GetInput()->GetOrigin();
+    inputSpacing = this->GetInput()->GetSpacing();
+  }
+  typename GaussianSourceType::ArrayType sigma;
+  typename GaussianSourceType::ArrayType mean;
+  for (unsigned int i = 0; i < ImageDimension; i++)
+  {
+    sigma[i] = this->GetGaussianWindowSigma();
+    mean[i] = inputSpacing[i] * this->GetGaussianWindowRadius() + inputOrigin[i]; // center pixel pos
+  }
+  Size<ImageDimension> domainKernelSize;
+  domainKernelSize.Fill(2 * this->GetGaussianWindowRadius() + 1);
+
+  // The source is only modified, and updated again, if the parameters have changed.
+  this->m_GaussianSource->SetSize(domainKernelSize);
+  this->m_GaussianSource->SetSpacing(inputSpacing);
+  this->m_GaussianSource->SetOrigin(inputOrigin);
+  this->m_GaussianSource->SetScale(1.0);
+  this->m_GaussianSource->SetNormalized(false);
+  this->m_GaussianSource->SetSigma(sigma);
+  this->m_GaussianSource->SetMean(mean);
+  this->m_GaussianSource->Update();
+  return this->m_GaussianSource;
+}
+
+template <typename TInputImage, typename TOutputImage>
+DataObject::Pointer
+StructureTensor<TInputImage, TOutputImage>::MakeOutput(DataObjectPointerArraySizeType idx)
+{
+  if (idx == 1)
+  {
+    return CompactTensorImageType::New().GetPointer();
+  }
+  return Superclass::MakeOutput(idx);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+StructureTensor<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  this->GetCompactTensorOutput()->SetNumberOfComponentsPerPixel(
+    Self::GetNumberOfCompactTensorComponents(this->GetNumberOfIndexedInputs()));
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+StructureTensor<TInputImage, TOutputImage>::AllocateOutputs()
+{
+  const bool generateOutput[2] = { this->m_GenerateEigenMatrix, this->m_GenerateCompactTensor };
+  for (unsigned int n_output = 0; n_output < 2; ++n_output)
+  {
+    auto * outputPtr = static_cast<ImageBase<ImageDimension> *>(this->ProcessObject::GetOutput(n_output));
+    if (generateOutput[n_output])
+    {
+      outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+      outputPtr->Allocate();
+    }
+    else
+    {
+      outputPtr->ReleaseData();
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+StructureTensor<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  // The smoothing of the requested region requires the neighborhood of the Gaussian window.
+  for (unsigned int nin = 0; nin < this->GetNumberOfIndexedInputs(); ++nin)
+  {
+    InputImageType * inputPtr = const_cast<InputImageType *>(this->GetInput(nin));
+    if (!inputPtr)
+    {
+      continue;
+    }
+    if (this->m_UseRecursiveGaussian)
+    {
+      // The support of the recursive filter is the whole image.
+      inputPtr->SetRequestedRegionToLargestPossibleRegion();
+      continue;
+    }
+    InputImageRegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+    inputRequestedRegion.PadByRadius(this->m_GaussianWindowRadius);
+    inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion());
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 StructureTensor<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
@@ -80,66 +191,238 @@ StructureTensor<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
     itkExceptionMacro(<< "This filter requires more input images, use SetInputs. Current number of inputs: "
                       << nInputs);
   }
+  if (!this->m_GenerateEigenMatrix && !this->m_GenerateCompactTensor)
+  {
+    itkExceptionMacro(<< "At least one of GenerateEigenMatrix and GenerateCompactTensor must be on.");
+  }
+  OutputImagePixelType outputMatrix;
+  if (this->m_GenerateEigenMatrix && !Self::ResizeOutputMatrix(outputMatrix, nInputs))
+  {
+    itkExceptionMacro(<< "The size of the output matrix must be (nInputs, nInputs + 1). nInputs = " << nInputs);
+  }
 
-  const typename InputImageType::PointType inputOrigin = this->GetInput()->GetOrigin();
-  const SpacingType                        inputSpacing = this->GetInput()->GetSpacing();
-  typename GaussianSourceType::ArrayType   sigma;
-  typename GaussianSourceType::ArrayType   mean;
-  for (unsigned int i = 0; i < ImageDimension; i++)
+  // The Gaussian window is separable: the normalized D-dimensional window is the product of
+  // the normalized 1D windows of each axis. The recursive filter does not pad the lines.
+  const SpacingType                      inputSpacing = this->GetInput()->GetSpacing();
+  const bool                             useRecursiveGaussian = this->m_UseRecursiveGaussian;
+  const unsigned int                     radius = useRecursiveGaussian ? 0 : this->m_GaussianWindowRadius;
+  std::vector<std::vector<FloatType>>    windowWeights(ImageDimension, std::vector<FloatType>(2 * radius + 1));
+  std::vector<RecursiveCoefficientsType> recursiveCoefficients(ImageDimension);
+  for (unsigned int axis = 0; axis < ImageDimension; ++axis)
   {
-    sigma[i] = this->GetGaussianWindowSigma();
-    mean[i] = inputSpacing[i] * this->GetGaussianWindowRadius() + inputOrigin[i]; // center pixel pos
+    if (useRecursiveGaussian)
+    {
+      const FloatType sigmaInPixels = this->m_GaussianWindowSigma / inputSpacing[axis];
+      if (sigmaInPixels < 0.5)
+      {
+        itkExceptionMacro(<< "UseRecursiveGaussian requires a GaussianWindowSigma of at least half the spacing. "
+                          << "Sigma: " << this->m_GaussianWindowSigma << ", spacing: " << inputSpacing);
+      }
+      recursiveCoefficients[axis] = Self::ComputeRecursiveCoefficients(sigmaInPixels);
+      continue;
+    }
+    FloatType sum = 0;
+    for (unsigned int k = 0; k < 2 * radius + 1; ++k)
+    {
+      const FloatType x = (static_cast<FloatType>(k) - radius) * inputSpacing[axis] / this->m_GaussianWindowSigma;
+      windowWeights[axis][k] = std::exp(-0.5 * x * x);
+      sum += windowWeights[axis][k];
+    }
+    for (auto & weight : windowWeights[axis])
+    {
+      weight /= sum;
+    }
+  }
+
+  // The products and their weighted sums are computed in double precision,
+  // for the requested region of the inputs: the output requested region padded by the window radius.
+  const InputImageRegionType region = this->GetInput(0)->GetRequestedRegion();
+  const unsigned int         nPairs = nInputs * (nInputs + 1) / 2;
+  this->m_SquareSmoothedImages.resize(nPairs);
+  for (unsigned int pair = 0; pair < nPairs; ++pair)
+  {
+    this->m_SquareSmoothedImages[pair] = FloatImageType::New();
+    this->m_SquareSmoothedImages[pair]->CopyInformation(this->GetInput(0));
+    this->m_SquareSmoothedImages[pair]->SetRegions(region);
+    this->m_SquareSmoothedImages[pair]->Allocate();
+  }
+  const typename FloatImageType::OffsetValueType * pairOffsetTable =
+    this->m_SquareSmoothedImages[0]->GetOffsetTable();
+
+  // First axis: the products of each pair are computed on the fly for each line of the inputs, and smoothed.
+  this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+    0,
+    region,
+    [this, nInputs, radius, useRecursiveGaussian, &windowWeights, &recursiveCoefficients](
+      const InputImageRegionType & lambdaRegion) {
+      const SizeValueType                 length = lambdaRegion.GetSize(0);
+      std::vector<std::vector<FloatType>> inputLines(nInputs, std::vector<FloatType>(length));
+      std::vector<FloatType>              paddedLine(length + 2 * radius);
+      InputImageRegionType                lineStarts = lambdaRegion;
+      lineStarts.SetSize(0, 1);
+      ImageRegionConstIteratorWithIndex<FloatImageType> lineIt(this->m_SquareSmoothedImages[0], lineStarts);
+      for (; !lineIt.IsAtEnd(); ++lineIt)
+      {
+        const typename InputImageType::IndexType & lineStart = lineIt.GetIndex();
+        for (unsigned int m = 0; m < nInputs; ++m)
+        {
+          const InputImageType *      inputPtr = this->GetInput(m);
+          const InputImagePixelType * inputLine = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(lineStart);
+          for (SizeValueType p = 0; p < length; ++p)
+          {
+            inputLines[m][p] = static_cast<FloatType>(inputLine[p]);
+          }
+        }
+        for (unsigned int m = 0; m < nInputs; ++m)
+        {
+          for (unsigned int n = m; n < nInputs; ++n)
+          {
+            for (SizeValueType p = 0; p < length; ++p)
+            {
+              paddedLine[radius + p] = inputLines[m][p] * inputLines[n][p];
+            }
+            FloatImageType * pairImage = this->m_SquareSmoothedImages[this->LowerTriangleToLinearIndex(m, n)];
+            FloatType *      pairLine = pairImage->GetBufferPointer() + pairImage->ComputeOffset(lineStart);
+            if (useRecursiveGaussian)
+            {
+              Self::RecursiveSmoothLine(paddedLine, length, recursiveCoefficients[0], pairLine, 1);
+            }
+            else
+            {
+              Self::SmoothLine(paddedLine, length, windowWeights[0], pairLine, 1);
+            }
+          }
+        }
+      }
+    },
+    nullptr);
+
+  // Other axes: in place, for all the pairs.
+  for (unsigned int axis = 1; axis < ImageDimension; ++axis)
+  {
+    this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+      axis,
+      region,
+      [this, axis, nPairs, radius, pairOffsetTable, useRecursiveGaussian, &windowWeights, &recursiveCoefficients](
+        const InputImageRegionType & lambdaRegion) {
+        const SizeValueType    length = lambdaRegion.GetSize(axis);
+        const auto             stride = pairOffsetTable[axis];
+        std::vector<FloatType> paddedLine(length + 2 * radius);
+        InputImageRegionType   lineStarts = lambdaRegion;
+        lineStarts.SetSize(axis, 1);
+        ImageRegionConstIteratorWithIndex<FloatImageType> lineIt(this->m_SquareSmoothedImages[0], lineStarts);
+        for (; !lineIt.IsAtEnd(); ++lineIt)
+        {
+          const auto lineOffset = this->m_SquareSmoothedImages[0]->ComputeOffset(lineIt.GetIndex());
+          for (unsigned int pair = 0; pair < nPairs; ++pair)
+          {
+            FloatType * line = this->m_SquareSmoothedImages[pair]->GetBufferPointer() + lineOffset;
+            for (SizeValueType p = 0; p < length; ++p)
+            {
+              paddedLine[radius + p] = line[p * stride];
+            }
+            if (useRecursiveGaussian)
+            {
+              Self::RecursiveSmoothLine(paddedLine, length, recursiveCoefficients[axis], line, stride);
+            }
+            else
+            {
+              Self::SmoothLine(paddedLine, length, windowWeights[axis], line, stride);
+            }
+          }
+        }
+      },
+      nullptr);
   }
-  // If sigma and radius have changed, update m_GaussianSource
-  if (this->m_GaussianSource->GetSigma() != sigma || this->m_GaussianSource->GetMean() != mean)
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+StructureTensor<TInputImage, TOutputImage>::SmoothLine(std::vector<FloatType> &       paddedLine,
+                                                       const SizeValueType &          length,
+                                                       const std::vector<FloatType> & weights,
+                                                       FloatType *                    output,
+                                                       const OffsetValueType &        outputStride)
+{
+  // Zero flux Neumann boundary condition: the line is extended with its first and last values.
+  const unsigned int radius = (weights.size() - 1) / 2;
+  for (unsigned int k = 0; k < radius; ++k)
   {
-    /******* Set GaussianImageSource ********/
-    Size<ImageDimension> domainKernelSize;
-    domainKernelSize.Fill(2 * this->GetGaussianWindowRadius() + 1);
-
-    this->m_GaussianSource->SetSize(domainKernelSize);
-    this->m_GaussianSource->SetSpacing(inputSpacing);
-    this->m_GaussianSource->SetOrigin(inputOrigin);
-    this->m_GaussianSource->SetScale(1.0);
-    this->m_GaussianSource->SetNormalized(false); // Normalize in the convolution instead.
-    this->m_GaussianSource->SetSigma(sigma);
-    this->m_GaussianSource->SetMean(mean);
-    this->m_GaussianSource->Update();
+    paddedLine[k] = paddedLine[radius];
+    paddedLine[radius + length + k] = paddedLine[radius + length - 1];
   }
-  using MultiplyFilterType = itk::MultiplyImageFilter<InputImageType>;
-  auto multiply = MultiplyFilterType::New();
-  using ConvolutionFilterType = itk::ConvolutionImageFilter<InputImageType, FloatImageType, InputImageType>;
-  auto convolve = ConvolutionFilterType::New();
-  convolve->SetKernelImage(this->m_GaussianSource->GetOutput());
-  convolve->NormalizeOn();
-  // using BoundaryConditionType = itk::ConstantBoundaryCondition<InputImageType>;
-  // BoundaryConditionType bounds;
-  // bounds.SetConstant(itk::NumericTraits<InputImagePixelType>::ZeroValue());
-  // convolve->SetBoundaryCondition(&bounds);
-  for (unsigned int m = 0; m < nInputs; ++m)
+  for (SizeValueType p = 0; p < length; ++p)
   {
-    for (unsigned int n = m; n < nInputs; ++n)
+    const FloatType * neighborhood = &paddedLine[p];
+    FloatType         value = 0;
+    for (unsigned int k = 0; k < weights.size(); ++k)
     {
-      multiply->SetInput1(this->GetInput(m));
-      multiply->SetInput2(this->GetInput(n));
-      multiply->Update();
-      convolve->SetInput(multiply->GetOutput());
-      convolve->Update();
-      this->m_SquareSmoothedImages.push_back(convolve->GetOutput());
-      this->m_SquareSmoothedImages.back()->DisconnectPipeline();
+      value += weights[k] * neighborhood[k];
     }
+    output[p * outputStride] = value;
   }
 }
 
-/** For each pixel of eigenOut (size of TInput)
- * For each RieszComponent:
- * Use NeighborhoodIterator in RieszComponents using gaussian_radius
- * Weight value of pixels in the neighborhood using the GaussianSource
- *
- * Compute Matrix (2D,Dimension x Dimension) eigenMatrix,
- * which is the weighted contribution of the RieszComponents.
+template <typename TInputImage, typename TOutputImage>
+typename StructureTensor<TInputImage, TOutputImage>::RecursiveCoefficientsType
+StructureTensor<TInputImage, TOutputImage>::ComputeRecursiveCoefficients(const FloatType & sigma)
+{
+  // Young, I. T. and van Vliet, L. J., Recursive implementation of the Gaussian filter,
+  // Signal Processing 44 (1995), 139-151.
+  const FloatType q = sigma >= 2.5 ? 0.98711 * sigma - 0.96330 : 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma);
+  const FloatType q2 = q * q;
+  const FloatType q3 = q2 * q;
+  const FloatType b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+  const FloatType b1 = (2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+  const FloatType b2 = -(1.4281 * q2 + 1.26661 * q3) / b0;
+  const FloatType b3 = 0.422205 * q3 / b0;
+  return { { 1.0 - (b1 + b2 + b3), b1, b2, b3 } };
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+StructureTensor<TInputImage, TOutputImage>::RecursiveSmoothLine(std::vector<FloatType> &          line,
+                                                                const SizeValueType &             length,
+                                                                const RecursiveCoefficientsType & coefficients,
+                                                                FloatType *                       output,
+                                                                const OffsetValueType &           outputStride)
+{
+  // The unit gain keeps constant lines constant: the lines are extended with their first and last values.
+  const FloatType B = coefficients[0];
+  FloatType       previous[3] = { line[0], line[0], line[0] };
+  for (SizeValueType p = 0; p < length; ++p)
+  {
+    const FloatType value =
+      B * line[p] + coefficients[1] * previous[0] + coefficients[2] * previous[1] + coefficients[3] * previous[2];
+    previous[2] = previous[1];
+    previous[1] = previous[0];
+    previous[0] = value;
+    line[p] = value;
+  }
+  FloatType next[3] = { line[length - 1], line[length - 1], line[length - 1] };
+  for (SizeValueType p = length; p-- > 0;)
+  {
+    const FloatType value =
+      B * line[p] + coefficients[1] * next[0] + coefficients[2] * next[1] + coefficients[3] * next[2];
+    next[2] = next[1];
+    next[1] = next[0];
+    next[0] = value;
+    output[p * outputStride] = value;
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+StructureTensor<TInputImage, TOutputImage>::AfterThreadedGenerateData()
+{
+  // Release the smoothed products.
+  this->m_SquareSmoothedImages.clear();
+}
+
+/** For each pixel of the output region, build the symmetric matrix
  * J(x_0)[m][n] =
  * Sum_each_neighbor_pixel_x(gaussian(x) * RieszComponent(x)[m] * RieszComponent(x)[n] )
+ * from the smoothed products computed in BeforeThreadedGenerateData.
  * Compute eigenVectors and eigenValues of the matrix.
  * Store them in the output.
  */
@@ -149,102 +432,167 @@ void
 StructureTensor<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
-  unsigned int nInputs = this->GetNumberOfInputs();
-
-  auto outputPtr = this->GetOutput();
+  const unsigned int nInputs = this->GetNumberOfInputs();
 
-  /******* Iterators ********/
-  using OutputImageIterator = typename itk::ImageScanlineIterator<OutputImageType>;
-  using InputImageConstIterator = typename itk::ImageScanlineConstIterator<InputImageType>;
+  OutputImageType *        eigenMatrixPtr = this->m_GenerateEigenMatrix ? this->GetOutput() : nullptr;
+  CompactTensorImageType * compactTensorPtr = this->m_GenerateCompactTensor ? this->GetCompactTensorOutput() : nullptr;
+  const unsigned int       compactTensorComponents = Self::GetNumberOfCompactTensorComponents(nInputs);
+  const SizeValueType      length = outputRegionForThread.GetSize(0);
 
-  OutputImageIterator outIt(outputPtr, outputRegionForThread);
-  outIt.GoToBegin();
-  std::vector<InputImageConstIterator> inputIts;
-  for (unsigned int m = 0; m < nInputs; ++m)
+  // The smoothed products cover the output requested region, the lines of the region are visited on the first one.
+  ImageScanlineConstIterator<FloatImageType> lineIt(this->m_SquareSmoothedImages[0], outputRegionForThread);
+  std::vector<const FloatType *>             pairLines(this->m_SquareSmoothedImages.size());
+  for (lineIt.GoToBegin(); !lineIt.IsAtEnd(); lineIt.NextLine())
   {
-    for (unsigned int n = m; n < nInputs; ++n)
+    const auto lineIndex = lineIt.GetIndex();
+    for (unsigned int pair = 0; pair < pairLines.size(); ++pair)
     {
-      unsigned int linear_index = this->LowerTriangleToLinearIndex(m, n);
-      inputIts.push_back(InputImageConstIterator(this->m_SquareSmoothedImages[linear_index], outputRegionForThread));
-      inputIts.back().GoToBegin();
+      const FloatImageType * squareSmoothedImage = this->m_SquareSmoothedImages[pair];
+      pairLines[pair] = squareSmoothedImage->GetBufferPointer() + squareSmoothedImage->ComputeOffset(lineIndex);
+    }
+    OutputImagePixelType * eigenMatrixLine = nullptr;
+    if (eigenMatrixPtr)
+    {
+      eigenMatrixLine = eigenMatrixPtr->GetBufferPointer() + eigenMatrixPtr->ComputeOffset(lineIndex);
+    }
+    FloatType * compactTensorLine = nullptr;
+    if (compactTensorPtr)
+    {
+      compactTensorLine =
+        compactTensorPtr->GetBufferPointer() + compactTensorPtr->ComputeOffset(lineIndex) * compactTensorComponents;
+    }
+    switch (nInputs)
+    {
+      case 2:
+        Self::template ComputeEigenSystemsOfLine<2>(pairLines, length, eigenMatrixLine, compactTensorLine);
+        break;
+      case 3:
+        Self::template ComputeEigenSystemsOfLine<3>(pairLines, length, eigenMatrixLine, compactTensorLine);
+        break;
+      default:
+        Self::ComputeEigenSystemsOfLine(pairLines, nInputs, length, eigenMatrixLine, compactTensorLine);
     }
   }
+}
 
-  EigenMatrixType eigenMatrix;
-  eigenMatrix.SetSize(nInputs, nInputs);
-  EigenMatrixType eigenVectors;
-  eigenVectors.SetSize(nInputs, nInputs);
-  EigenValuesType eigenValues;
-  eigenValues.SetSize(nInputs);
-  SymmetricEigenAnalysisType eigenSystem(nInputs);
-
-  // Matrix copied to output per pixel, composed by eigenVectors, plus a row of eigenValues.
-  EigenMatrixType eigenMatrixOut;
-  eigenMatrixOut.SetSize(nInputs, nInputs + 1);
-
-  while (!outIt.IsAtEnd())
+template <typename TInputImage, typename TOutputImage>
+template <unsigned int VInputs>
+void
+StructureTensor<TInputImage, TOutputImage>::ComputeEigenSystemsOfLine(
+  const std::vector<const FloatType *> & pairLines,
+  const SizeValueType &                  length,
+  OutputImagePixelType *                 eigenMatrixLine,
+  FloatType *                            compactTensorLine)
+{
+  using EigenSolverType = FixedSizeSymmetricEigenSolver<VInputs, FloatType>;
+  constexpr unsigned int nPairs = EigenSolverType::NumberOfPackedEntries;
+  FloatType              packedMatrix[nPairs];
+  FloatType              eigenValues[VInputs];
+  FloatType              eigenVectors[VInputs * VInputs];
+  for (SizeValueType i = 0; i < length; ++i)
   {
-    while (!outIt.IsAtEndOfLine())
+    for (unsigned int pair = 0; pair < nPairs; ++pair)
+    {
+      packedMatrix[pair] = pairLines[pair][i];
+    }
+    if (eigenMatrixLine)
     {
-      // Init the matrix
-      eigenMatrix.Fill(0);
-      for (unsigned int m = 0; m < nInputs; ++m)
+      EigenSolverType::Compute(packedMatrix, eigenValues, eigenVectors);
+
+      OutputImagePixelType & outputMatrix = eigenMatrixLine[i];
+      Self::ResizeOutputMatrix(outputMatrix, VInputs);
+      for (unsigned int r = 0; r < VInputs; ++r)
       {
-        for (unsigned int n = m; n < nInputs; ++n)
+        for (unsigned int c = 0; c < VInputs; ++c)
         {
-          unsigned int linear_index = this->LowerTriangleToLinearIndex(m, n);
-          eigenMatrix[m][n] = eigenMatrix[n][m] = inputIts[linear_index].Get();
+          outputMatrix(r, c) = eigenVectors[r * VInputs + c];
         }
+        outputMatrix(r, VInputs) = eigenValues[r];
       }
-      eigenSystem.ComputeEigenValuesAndVectors(eigenMatrix, eigenValues, eigenVectors);
-      itkDebugMacro(<< "matrix input\n"
-                    << eigenMatrix << "\neigenValues: " << eigenValues << "\neigenVectors: " << eigenVectors);
-      for (unsigned int n = 0; n < nInputs; ++n)
+    }
+    else
+    {
+      EigenSolverType::ComputeEigenValues(packedMatrix, eigenValues);
+    }
+
+    if (compactTensorLine)
+    {
+      FloatType * compactTensor = compactTensorLine + i * (nPairs + VInputs);
+      std::copy(packedMatrix, packedMatrix + nPairs, compactTensor);
+      std::copy(eigenValues, eigenValues + VInputs, compactTensor + nPairs);
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+StructureTensor<TInputImage, TOutputImage>::ComputeEigenSystemsOfLine(
+  const std::vector<const FloatType *> & pairLines,
+  const unsigned int &                   nInputs,
+  const SizeValueType &                  length,
+  OutputImagePixelType *                 eigenMatrixLine,
+  FloatType *                            compactTensorLine)
+{
+  const unsigned int    nPairs = pairLines.size();
+  vnl_matrix<FloatType> eigenMatrix(nInputs, nInputs);
+  for (SizeValueType i = 0; i < length; ++i)
+  {
+    for (unsigned int m = 0; m < nInputs; ++m)
+    {
+      for (unsigned int n = m; n < nInputs; ++n)
       {
-        eigenMatrixOut.GetVnlMatrix().set_column(n, eigenVectors.GetVnlMatrix().get_column(n));
+        eigenMatrix(m, n) = eigenMatrix(n, m) = pairLines[Self::LowerTriangleToLinearIndex(m, n)][i];
       }
-      eigenMatrixOut.GetVnlMatrix().set_column(nInputs, eigenValues);
-      // Copy to Output
-      outIt.Set(eigenMatrixOut);
-      ++outIt;
-      for (unsigned int i = 0; i < inputIts.size(); ++i)
+    }
+    // Eigenvalues in ascending order, and eigenvectors in the columns of V.
+    const vnl_symmetric_eigensystem<FloatType> eigenSystem(eigenMatrix);
+
+    if (eigenMatrixLine)
+    {
+      OutputImagePixelType & outputMatrix = eigenMatrixLine[i];
+      Self::ResizeOutputMatrix(outputMatrix, nInputs);
+      for (unsigned int r = 0; r < nInputs; ++r)
       {
-        ++inputIts[i];
+        for (unsigned int c = 0; c < nInputs; ++c)
+        {
+          outputMatrix(r, c) = eigenSystem.V(r, c);
+        }
+        outputMatrix(r, nInputs) = eigenSystem.D(r, r);
       }
-    } // end outIt Line
+    }
 
-    outIt.NextLine();
-    for (unsigned int i = 0; i < inputIts.size(); ++i)
+    if (compactTensorLine)
     {
-      inputIts[i].NextLine();
+      FloatType * compactTensor = compactTensorLine + i * (nPairs + nInputs);
+      for (unsigned int pair = 0; pair < nPairs; ++pair)
+      {
+        compactTensor[pair] = pairLines[pair][i];
+      }
+      for (unsigned int r = 0; r < nInputs; ++r)
+      {
+        compactTensor[nPairs + r] = eigenSystem.D(r, r);
+      }
     }
-  } // end outIt
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
-typename StructureTensor<TInputImage, TOutputImage>::EigenMatrixType
+typename StructureTensor<TInputImage, TOutputImage>::RotationMatrixType
 StructureTensor<TInputImage, TOutputImage>::GetRotationMatrixFromOutputMatrix(
   const EigenMatrixType & outputMatrix,
   bool                    reOrderLargestEigenvectorInFirstRow) const
 {
   unsigned int nInputs = this->GetNumberOfInputs();
   // Pre condition (output matrix is populated)
-  assert(outputMatrix.Rows() == nInputs);
-  EigenMatrixType rotationMatrix(nInputs, nInputs);
-  // transpose at copy
-  if (!reOrderLargestEigenvectorInFirstRow)
-  {
-    for (unsigned int n = 0; n < nInputs; ++n)
-    {
-      rotationMatrix.GetVnlMatrix().set_row(n, outputMatrix.GetVnlMatrix().get_column(n));
-    }
-  }
-  // reOrder and transpose at copy
-  else
+  assert(outputMatrix.GetVnlMatrix().rows() == nInputs);
+  RotationMatrixType rotationMatrix(nInputs, nInputs);
+  // transpose at copy, and reOrder if requested
+  for (unsigned int n = 0; n < nInputs; ++n)
   {
-    for (unsigned int n = 0; n < nInputs; ++n)
+    const unsigned int row = reOrderLargestEigenvectorInFirstRow ? nInputs - 1 - n : n;
+    for (unsigned int c = 0; c < nInputs; ++c)
     {
-      rotationMatrix.GetVnlMatrix().set_row(nInputs - 1 - n, outputMatrix.GetVnlMatrix().get_column(n));
+      rotationMatrix(row, c) = outputMatrix(c, n);
     }
   }
   return rotationMatrix;
@@ -262,6 +610,23 @@ StructureTensor<TInputImage, TOutputImage>::ComputeProjectionImage(unsigned int
                       << " . nInputs = " << nInputs);
   }
 
+  if (this->m_GenerateCompactTensor)
+  {
+    auto projectionFilter = ProjectionFilterType::New();
+    for (unsigned int n = 0; n < nInputs; ++n)
+    {
+      projectionFilter->SetInput(n, this->GetInput(n));
+    }
+    projectionFilter->SetCompactTensor(this->GetCompactTensorOutput());
+    projectionFilter->LargestResponseOff();
+    projectionFilter->SetEigenNumber(eigen_number);
+    projectionFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    projectionFilter->Update();
+    InputImagePointer projectImage = projectionFilter->GetOutput();
+    projectImage->DisconnectPipeline();
+    return projectImage;
+  }
+
   const OutputImageType * outputPtr = this->GetOutput();
   // Allocate output of this method:
   // Use duplicator to copy metadata as well.
@@ -272,41 +637,42 @@ StructureTensor<TInputImage, TOutputImage>::ComputeProjectionImage(unsigned int
   InputImagePointer projectImage = duplicator->GetOutput();
   projectImage->FillBuffer(0);
 
-  itk::ImageScanlineConstIterator<OutputImageType> outIt(outputPtr, outputPtr->GetLargestPossibleRegion());
-  outIt.GoToBegin();
-  itk::ImageScanlineIterator<InputImageType> projectIt(projectImage, projectImage->GetLargestPossibleRegion());
-  projectIt.GoToBegin();
-
-  std::vector<ImageScanlineConstIterator<InputImageType>> inputIts;
-  for (unsigned int n = 0; n < nInputs; ++n)
-  {
-    inputIts.push_back(itk::ImageScanlineConstIterator<InputImageType>(this->GetInput(n),
-                                                                       this->GetInput(n)->GetLargestPossibleRegion()));
-    inputIts.back().GoToBegin();
-  }
-  while (!outIt.IsAtEnd())
-  {
-    while (!outIt.IsAtEndOfLine())
-    {
-      InputImagePixelType value = 0;
-      auto                outputMatrix = outIt.Get();
-      for (unsigned int r = 0; r < nInputs; r++)
+  MultiThreaderBase::New()->template ParallelizeImageRegion<ImageDimension>(
+    outputPtr->GetBufferedRegion(),
+    [this, nInputs, eigen_number, outputPtr, &projectImage](const OutputImageRegionType & region) {
+      ImageScanlineConstIterator<OutputImageType>             outIt(outputPtr, region);
+      ImageScanlineIterator<InputImageType>                   projectIt(projectImage, region);
+      std::vector<ImageScanlineConstIterator<InputImageType>> inputIts;
+      for (unsigned int n = 0; n < nInputs; ++n)
       {
-        value += outputMatrix[r][eigen_number] * inputIts[r].Get();
-        ++inputIts[r];
+        inputIts.emplace_back(this->GetInput(n), region);
       }
-      projectIt.Set(value);
-      ++outIt;
-      ++projectIt;
-    }
+      while (!outIt.IsAtEnd())
+      {
+        while (!outIt.IsAtEndOfLine())
+        {
+          FloatType    value = 0;
+          const auto & outputMatrix = outIt.Value();
+          for (unsigned int r = 0; r < nInputs; r++)
+          {
+            value +=
+              static_cast<FloatType>(outputMatrix[r][eigen_number]) * static_cast<FloatType>(inputIts[r].Get());
+            ++inputIts[r];
+          }
+          projectIt.Set(static_cast<InputImagePixelType>(value));
+          ++outIt;
+          ++projectIt;
+        }
 
-    outIt.NextLine();
-    projectIt.NextLine();
-    for (unsigned int r = 0; r < nInputs; r++)
-    {
-      inputIts[r].NextLine();
-    }
-  }
+        outIt.NextLine();
+        projectIt.NextLine();
+        for (unsigned int r = 0; r < nInputs; r++)
+        {
+          inputIts[r].NextLine();
+        }
+      }
+    },
+    nullptr);
 
   return projectImage;
 }
@@ -324,6 +690,17 @@ StructureTensor<TInputImage, TOutputImage>::ComputeCoherencyImage() const
 {
   const unsigned int nInputs = this->GetNumberOfInputs();
 
+  if (this->m_GenerateCompactTensor)
+  {
+    auto coherencyFilter = CoherencyFilterType::New();
+    coherencyFilter->SetInput(this->GetCompactTensorOutput());
+    coherencyFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    coherencyFilter->Update();
+    InputImagePointer coherencyImage = coherencyFilter->GetOutput();
+    coherencyImage->DisconnectPipeline();
+    return coherencyImage;
+  }
+
   const OutputImageType * outputPtr = this->GetOutput();
   // Allocate output of this method:
   InputImagePointer coherencyImage = InputImageType::New();
@@ -331,35 +708,39 @@ StructureTensor<TInputImage, TOutputImage>::ComputeCoherencyImage() const
   coherencyImage->SetRegions(outputPtr->GetLargestPossibleRegion());
   coherencyImage->Allocate();
 
-  itk::ImageScanlineConstIterator<OutputImageType> outIt(outputPtr, outputPtr->GetLargestPossibleRegion());
-  outIt.GoToBegin();
-  itk::ImageScanlineIterator<InputImageType> coherencyIt(coherencyImage, coherencyImage->GetLargestPossibleRegion());
-  coherencyIt.GoToBegin();
+  MultiThreaderBase::New()->template ParallelizeImageRegion<ImageDimension>(
+    outputPtr->GetBufferedRegion(),
+    [nInputs, outputPtr, &coherencyImage](const OutputImageRegionType & region) {
+      ImageScanlineConstIterator<OutputImageType> outIt(outputPtr, region);
+      ImageScanlineIterator<InputImageType>       coherencyIt(coherencyImage, region);
 
-  unsigned int largestEigenValueIndex = nInputs - 1;
-  while (!outIt.IsAtEnd())
-  {
-    while (!outIt.IsAtEndOfLine())
-    {
-      FloatType coherency = 0;
-      for (unsigned int r = 0; r < nInputs; r++)
+      const unsigned int largestEigenValueIndex = nInputs - 1;
+      while (!outIt.IsAtEnd())
       {
-        // Store mean of eigenValues other than principal in coherency.
-        if (r != largestEigenValueIndex)
+        while (!outIt.IsAtEndOfLine())
         {
-          coherency += outIt.Get()[r][nInputs] / static_cast<FloatType>(nInputs - 1);
+          const auto & outputMatrix = outIt.Value();
+          FloatType    coherency = 0;
+          for (unsigned int r = 0; r < nInputs; r++)
+          {
+            // Store mean of eigenValues other than principal in coherency.
+            if (r != largestEigenValueIndex)
+            {
+              coherency += outputMatrix[r][nInputs] / static_cast<FloatType>(nInputs - 1);
+            }
+          }
+          FloatType largestEigenValue = outputMatrix[largestEigenValueIndex][nInputs];
+          coherency = (largestEigenValue - coherency) / (largestEigenValue + coherency);
+          coherencyIt.Set(static_cast<InputImagePixelType>(coherency));
+          ++outIt;
+          ++coherencyIt;
         }
-      }
-      FloatType largestEigenValue = outIt.Get()[largestEigenValueIndex][nInputs];
-      coherency = (largestEigenValue - coherency) / (largestEigenValue + coherency);
-      coherencyIt.Set(static_cast<InputImagePixelType>(coherency));
-      ++outIt;
-      ++coherencyIt;
-    }
 
-    outIt.NextLine();
-    coherencyIt.NextLine();
-  }
+        outIt.NextLine();
+        coherencyIt.NextLine();
+      }
+    },
+    nullptr);
 
   return coherencyImage;
 }
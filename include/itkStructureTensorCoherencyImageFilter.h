@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStructureTensorCoherencyImageFilter_h
+#define itkStructureTensorCoherencyImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkVectorImage.h"
+
+namespace itk
+{
+/** \class StructureTensorCoherencyImageFilter
+ * Coherency of a StructureTensor at every pixel, from its N eigenvalues:
+ * \f[ \chi = \frac{\lambda_N - M}{\lambda_N + M} \f]
+ * where \f$ \lambda_N \f$ is the largest eigenvalue and \f$ M \f$ is the mean of the other N - 1 eigenvalues.
+ *
+ * The input is the compact output of StructureTensor (StructureTensor::GetCompactTensorOutput), with
+ * N(N+1)/2 entries of the tensor followed by its N eigenvalues in ascending order, so only the eigenvalues
+ * are read, and N is deduced from the number of components.
+ *
+ * \sa StructureTensor
+ * \sa StructureTensorProjectionImageFilter
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TCompactTensorImage,
+          typename TOutputImage =
+            Image<typename TCompactTensorImage::InternalPixelType, TCompactTensorImage::ImageDimension>>
+class StructureTensorCoherencyImageFilter : public ImageToImageFilter<TCompactTensorImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(StructureTensorCoherencyImageFilter);
+
+  /** Standard class type alias. */
+  using Self = StructureTensorCoherencyImageFilter;
+  using Superclass = ImageToImageFilter<TCompactTensorImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TCompactTensorImage::ImageDimension;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(StructureTensorCoherencyImageFilter, ImageToImageFilter);
+
+  /** Some convenient type alias. */
+  using InputImageType = typename Superclass::InputImageType;
+  using OutputImageType = typename Superclass::OutputImageType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using OutputImagePixelType = typename OutputImageType::PixelType;
+  using FloatType = typename InputImageType::InternalPixelType;
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro(OutputPixelTypeIsFloatCheck, (Concept::IsFloatingPoint<OutputImagePixelType>));
+#endif
+
+protected:
+  StructureTensorCoherencyImageFilter();
+  ~StructureTensorCoherencyImageFilter() override = default;
+
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  unsigned int m_NumberOfTensorInputs{ 0 };
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkStructureTensorCoherencyImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,82 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStructureTensorCoherencyImageFilter_hxx
+#define itkStructureTensorCoherencyImageFilter_hxx
+
+#include "itkStructureTensorCoherencyImageFilter.h"
+#include "itkImageScanlineIterator.h"
+
+namespace itk
+{
+template <typename TCompactTensorImage, typename TOutputImage>
+StructureTensorCoherencyImageFilter<TCompactTensorImage, TOutputImage>::StructureTensorCoherencyImageFilter()
+{
+  this->DynamicMultiThreadingOn();
+}
+
+template <typename TCompactTensorImage, typename TOutputImage>
+void
+StructureTensorCoherencyImageFilter<TCompactTensorImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  // Number of inputs N of the tensor, from the N(N+3)/2 components.
+  const unsigned int compactTensorComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  unsigned int       nInputs = 1;
+  while (nInputs * (nInputs + 3) / 2 < compactTensorComponents)
+  {
+    ++nInputs;
+  }
+  if (nInputs < 2 || nInputs * (nInputs + 3) / 2 != compactTensorComponents)
+  {
+    itkExceptionMacro(<< "The input must be the compact output of a StructureTensor, with N(N+3)/2 components. "
+                      << "Number of components: " << compactTensorComponents);
+  }
+  this->m_NumberOfTensorInputs = nInputs;
+}
+
+template <typename TCompactTensorImage, typename TOutputImage>
+void
+StructureTensorCoherencyImageFilter<TCompactTensorImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * inputPtr = this->GetInput();
+  const unsigned int     nInputs = this->m_NumberOfTensorInputs;
+  const unsigned int     compactTensorComponents = inputPtr->GetNumberOfComponentsPerPixel();
+  // The eigenvalues are the last nInputs components, in ascending order.
+  const unsigned int largestEigenValueComponent = compactTensorComponents - 1;
+  const unsigned int firstEigenValueComponent = compactTensorComponents - nInputs;
+
+  ImageScanlineIterator<OutputImageType> outIt(this->GetOutput(), outputRegionForThread);
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); outIt.NextLine())
+  {
+    const FloatType * compactTensor =
+      inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(outIt.GetIndex()) * compactTensorComponents;
+    for (; !outIt.IsAtEndOfLine(); ++outIt, compactTensor += compactTensorComponents)
+    {
+      FloatType meanNonPrincipal = 0;
+      for (unsigned int c = firstEigenValueComponent; c < largestEigenValueComponent; ++c)
+      {
+        meanNonPrincipal += compactTensor[c] / static_cast<FloatType>(nInputs - 1);
+      }
+      const FloatType largestEigenValue = compactTensor[largestEigenValueComponent];
+      outIt.Set(static_cast<OutputImagePixelType>((largestEigenValue - meanNonPrincipal) /
+                                                  (largestEigenValue + meanNonPrincipal)));
+    }
+  }
+}
+} // end namespace itk
+#endif
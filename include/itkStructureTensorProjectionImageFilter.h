@@ -0,0 +1,140 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStructureTensorProjectionImageFilter_h
+#define itkStructureTensorProjectionImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkVectorImage.h"
+#include <vector>
+
+namespace itk
+{
+/** \class StructureTensorProjectionImageFilter
+ * Linear combination of the N inputs of a StructureTensor, weighted by one of the eigenvectors of the tensor.
+ *
+ * The inputs are the images used to compute the tensor, set with SetInputs, and the compact output of
+ * StructureTensor (StructureTensor::GetCompactTensorOutput), set with SetCompactTensor: at every pixel the
+ * N(N+1)/2 entries of the tensor, packed in the order of FixedSizeSymmetricEigenSolver::PackedIndex,
+ * followed by its N eigenvalues.
+ *
+ * The eigenvector is computed at every pixel from the packed tensor, without storing any eigenvector:
+ * with FixedSizeSymmetricEigenSolver for 2 and 3 inputs, and with vnl_symmetric_eigensystem otherwise.
+ *
+ * With LargestResponse on (the default) the eigenvector is the one with the largest eigenvalue,
+ * otherwise the eigenvectors are sorted in ascending order of their eigenvalues and EigenNumber selects one.
+ *
+ * \sa StructureTensor
+ * \sa StructureTensorCoherencyImageFilter
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TInputImage,
+          typename TCompactTensorImage = VectorImage<double, TInputImage::ImageDimension>>
+class StructureTensorProjectionImageFilter : public ImageToImageFilter<TInputImage, TInputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(StructureTensorProjectionImageFilter);
+
+  /** Standard class type alias. */
+  using Self = StructureTensorProjectionImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TInputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(StructureTensorProjectionImageFilter, ImageToImageFilter);
+
+  /** Some convenient type alias. */
+  using InputImageType = typename Superclass::InputImageType;
+  using InputImagePointer = typename InputImageType::Pointer;
+  using InputImagePixelType = typename InputImageType::PixelType;
+  using OutputImageType = typename Superclass::OutputImageType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using OutputImagePixelType = typename OutputImageType::PixelType;
+  using CompactTensorImageType = TCompactTensorImage;
+  using FloatType = typename CompactTensorImageType::InternalPixelType;
+  using InputsType = std::vector<InputImagePointer>;
+
+  /** Set the N inputs of the StructureTensor. */
+  void
+  SetInputs(const InputsType & inputs);
+
+  /** Compact output of StructureTensor, with N(N+3)/2 components. Required. */
+  itkSetInputMacro(CompactTensor, CompactTensorImageType);
+  itkGetInputMacro(CompactTensor, CompactTensorImageType);
+
+  /** Project along the eigenvector with the largest eigenvalue. Default: true. */
+  itkSetMacro(LargestResponse, bool);
+  itkGetConstMacro(LargestResponse, bool);
+  itkBooleanMacro(LargestResponse);
+
+  /** Position of the eigenvector, in ascending order of the eigenvalues, used if LargestResponse is off. Default: 0 */
+  itkSetMacro(EigenNumber, unsigned int);
+  itkGetConstMacro(EigenNumber, unsigned int);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  itkConceptMacro(InputPixelTypeIsFloatCheck, (Concept::IsFloatingPoint<InputImagePixelType>));
+#endif
+
+protected:
+  StructureTensorProjectionImageFilter();
+  ~StructureTensorProjectionImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  using InputIteratorsType = std::vector<ImageScanlineConstIterator<InputImageType>>;
+
+  /** Project the pixels of the line of outIt, with FixedSizeSymmetricEigenSolver<VInputs>. */
+  template <unsigned int VInputs>
+  static void
+  ProjectLine(const FloatType *                        compactTensorLine,
+              const unsigned int &                     eigenNumber,
+              InputIteratorsType &                     inputIts,
+              ImageScanlineIterator<OutputImageType> & outIt);
+
+  /** Same than ProjectLine, for any number of inputs. */
+  static void
+  ProjectLine(const FloatType *                        compactTensorLine,
+              const unsigned int &                     nInputs,
+              const unsigned int &                     eigenNumber,
+              InputIteratorsType &                     inputIts,
+              ImageScanlineIterator<OutputImageType> & outIt);
+
+  bool         m_LargestResponse{ true };
+  unsigned int m_EigenNumber{ 0 };
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkStructureTensorProjectionImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStructureTensorProjectionImageFilter_hxx
+#define itkStructureTensorProjectionImageFilter_hxx
+
+#include "itkStructureTensorProjectionImageFilter.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkFixedSizeSymmetricEigenSolver.h"
+#include "vnl/algo/vnl_symmetric_eigensystem.h"
+
+namespace itk
+{
+template <typename TInputImage, typename TCompactTensorImage>
+StructureTensorProjectionImageFilter<TInputImage, TCompactTensorImage>::StructureTensorProjectionImageFilter()
+{
+  this->AddRequiredInputName("CompactTensor");
+
+  this->DynamicMultiThreadingOn();
+}
+
+template <typename TInputImage, typename TCompactTensorImage>
+void
+StructureTensorProjectionImageFilter<TInputImage, TCompactTensorImage>::SetInputs(const InputsType & inputs)
+{
+  for (unsigned int nin = 0; nin < inputs.size(); ++nin)
+  {
+    if (this->GetInput(nin) != inputs[nin])
+    {
+      this->SetNthInput(nin, inputs[nin]);
+    }
+  }
+}
+
+template <typename TInputImage, typename TCompactTensorImage>
+void
+StructureTensorProjectionImageFilter<TInputImage, TCompactTensorImage>::PrintSelf(std::ostream & os,
+                                                                                  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "LargestResponse: " << this->m_LargestResponse << std::endl;
+  os << indent << "EigenNumber: " << this->m_EigenNumber << std::endl;
+}
+
+template <typename TInputImage, typename TCompactTensorImage>
+void
+StructureTensorProjectionImageFilter<TInputImage, TCompactTensorImage>::BeforeThreadedGenerateData()
+{
+  const unsigned int nInputs = this->GetNumberOfIndexedInputs();
+  if (nInputs <= 1)
+  {
+    itkExceptionMacro(<< "This filter requires at least 2 inputs, use SetInputs. Current number of inputs: "
+                      << nInputs);
+  }
+  const unsigned int compactTensorComponents = this->GetCompactTensor()->GetNumberOfComponentsPerPixel();
+  if (compactTensorComponents != nInputs * (nInputs + 3) / 2)
+  {
+    itkExceptionMacro(<< "The CompactTensor of " << nInputs << " inputs must have " << nInputs * (nInputs + 3) / 2
+                      << " components, but it has " << compactTensorComponents);
+  }
+  if (!this->m_LargestResponse && this->m_EigenNumber >= nInputs)
+  {
+    itkExceptionMacro(<< "The eigen number must be between [0, numberInputs). EigenNumber = " << this->m_EigenNumber
+                      << " . nInputs = " << nInputs);
+  }
+}
+
+template <typename TInputImage, typename TCompactTensorImage>
+void
+StructureTensorProjectionImageFilter<TInputImage, TCompactTensorImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const unsigned int             nInputs = this->GetNumberOfIndexedInputs();
+  const unsigned int             eigenNumber = this->m_LargestResponse ? nInputs - 1 : this->m_EigenNumber;
+  const CompactTensorImageType * compactTensor = this->GetCompactTensor();
+  const unsigned int             compactTensorComponents = compactTensor->GetNumberOfComponentsPerPixel();
+
+  ImageScanlineIterator<OutputImageType> outIt(this->GetOutput(), outputRegionForThread);
+  InputIteratorsType                     inputIts;
+  for (unsigned int n = 0; n < nInputs; ++n)
+  {
+    inputIts.emplace_back(this->GetInput(n), outputRegionForThread);
+  }
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); outIt.NextLine())
+  {
+    const FloatType * compactTensorLine =
+      compactTensor->GetBufferPointer() + compactTensor->ComputeOffset(outIt.GetIndex()) * compactTensorComponents;
+    switch (nInputs)
+    {
+      case 2:
+        Self::template ProjectLine<2>(compactTensorLine, eigenNumber, inputIts, outIt);
+        break;
+      case 3:
+        Self::template ProjectLine<3>(compactTensorLine, eigenNumber, inputIts, outIt);
+        break;
+      default:
+        Self::ProjectLine(compactTensorLine, nInputs, eigenNumber, inputIts, outIt);
+    }
+    for (auto & inputIt : inputIts)
+    {
+      inputIt.NextLine();
+    }
+  }
+}
+
+template <typename TInputImage, typename TCompactTensorImage>
+template <unsigned int VInputs>
+void
+StructureTensorProjectionImageFilter<TInputImage, TCompactTensorImage>::ProjectLine(
+  const FloatType *                        compactTensorLine,
+  const unsigned int &                     eigenNumber,
+  InputIteratorsType &                     inputIts,
+  ImageScanlineIterator<OutputImageType> & outIt)
+{
+  using EigenSolverType = FixedSizeSymmetricEigenSolver<VInputs, FloatType>;
+  constexpr unsigned int compactTensorComponents = EigenSolverType::NumberOfPackedEntries + VInputs;
+  FloatType              eigenValues[VInputs];
+  FloatType              eigenVectors[VInputs * VInputs];
+  for (const FloatType * packedMatrix = compactTensorLine; !outIt.IsAtEndOfLine();
+       ++outIt, packedMatrix += compactTensorComponents)
+  {
+    EigenSolverType::Compute(packedMatrix, eigenValues, eigenVectors);
+    FloatType value = 0;
+    for (unsigned int r = 0; r < VInputs; ++r)
+    {
+      value += eigenVectors[r * VInputs + eigenNumber] * static_cast<FloatType>(inputIts[r].Get());
+      ++inputIts[r];
+    }
+    outIt.Set(static_cast<OutputImagePixelType>(value));
+  }
+}
+
+template <typename TInputImage, typename TCompactTensorImage>
+void
+StructureTensorProjectionImageFilter<TInputImage, TCompactTensorImage>::ProjectLine(
+  const FloatType *                        compactTensorLine,
+  const unsigned int &                     nInputs,
+  const unsigned int &                     eigenNumber,
+  InputIteratorsType &                     inputIts,
+  ImageScanlineIterator<OutputImageType> & outIt)
+{
+  const unsigned int    compactTensorComponents = nInputs * (nInputs + 3) / 2;
+  vnl_matrix<FloatType> eigenMatrix(nInputs, nInputs);
+  for (const FloatType * packedMatrix = compactTensorLine; !outIt.IsAtEndOfLine();
+       ++outIt, packedMatrix += compactTensorComponents)
+  {
+    for (unsigned int n = 0; n < nInputs; ++n)
+    {
+      for (unsigned int m = 0; m <= n; ++m)
+      {
+        eigenMatrix(m, n) = eigenMatrix(n, m) = packedMatrix[m + (n + 1) * n / 2];
+      }
+    }
+    const vnl_symmetric_eigensystem<FloatType> eigenSystem(eigenMatrix);
+    FloatType                                  value = 0;
+    for (unsigned int r = 0; r < nInputs; ++r)
+    {
+      value += eigenSystem.V(r, eigenNumber) * static_cast<FloatType>(inputIts[r].Get());
+      ++inputIts[r];
+    }
+    outIt.Set(static_cast<OutputImagePixelType>(value));
+  }
+}
+} // end namespace itk
+#endif
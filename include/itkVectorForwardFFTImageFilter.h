@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVectorForwardFFTImageFilter_h
+#define itkVectorForwardFFTImageFilter_h
+
+#include "itkVectorImage.h"
+#include "itkForwardFFTImageFilter.h"
+#include <complex>
+
+namespace itk
+{
+/** \class VectorForwardFFTImageFilter
+ *
+ * Applies ForwardFFT to each index of a vector image.
+ *
+ * This class transforms a real vector image into its full complex frequency domain representation,
+ * it is the counterpart of VectorInverseFFTImageFilter.
+ *
+ * Per-component transform without intermediate copies: the components are transformed one after the
+ * other with the same ForwardFFTImageFilter, gathered from the strided input buffer into a single scalar
+ * scratch image and written directly into their interleaved position of the output VectorImage, with no
+ * per-component output images nor a final compose step.
+ * The cost is the one of N scalar transforms, each component is a separate Update of the scalar
+ * ForwardFFTImageFilter and its plan is managed by the FFT backend selected by the object factory.
+ *
+ * The default output is vector<complex<T>>, where T is the component type of the input vector<T>.
+ *
+ * \ingroup FourierTransform
+ *
+ * \sa ForwardFFTImageFilter, VectorInverseFFTImageFilter
+ * \ingroup ITKFFT
+ * \ingroup IsotropicWavelets
+ */
+template <typename TInputImage,
+          typename TOutputImage =
+            VectorImage<std::complex<typename TInputImage::PixelType::ComponentType>, TInputImage::ImageDimension>>
+class VectorForwardFFTImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(VectorForwardFFTImageFilter);
+
+  /** Standard class type alias. */
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  using Self = VectorForwardFFTImageFilter;
+  using Superclass = ImageToImageFilter<InputImageType, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(VectorForwardFFTImageFilter, ImageToImageFilter);
+
+  /** ImageDimension enumeration. */
+  static constexpr unsigned int ImageDimension = InputImageType::ImageDimension;
+
+  /** Scalar images and filter used to transform each component. */
+  using InputSingleImageType = Image<typename InputImageType::PixelType::ComponentType, ImageDimension>;
+  using FFTForwardFilterType = ForwardFFTImageFilter<InputSingleImageType>;
+  using OutputSingleImageType = typename FFTForwardFilterType::OutputImageType;
+
+protected:
+  VectorForwardFFTImageFilter() = default;
+  ~VectorForwardFFTImageFilter() override = default;
+
+  /** The FFT requires the whole input and generates the whole output. */
+  void
+  GenerateInputRequestedRegion() override;
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkVectorForwardFFTImageFilter.hxx"
+#endif
+
+#endif
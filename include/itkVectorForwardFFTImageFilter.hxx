@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVectorForwardFFTImageFilter_hxx
+#define itkVectorForwardFFTImageFilter_hxx
+#include "itkVectorForwardFFTImageFilter.h"
+#include <itkImageScanlineIterator.h>
+#include <itkProgressAccumulator.h>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage>
+void
+VectorForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType * inputPtr = const_cast<InputImageType *>(this->GetInput());
+  if (inputPtr)
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VectorForwardFFTImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VectorForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  // Create a process accumulator for tracking the progress of this minipipeline
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  const InputImageType *            inputPtr = this->GetInput();
+  typename OutputImageType::Pointer outputPtr = this->GetOutput();
+  const unsigned int                numberOfComponents = inputPtr->GetNumberOfComponentsPerPixel();
+
+  outputPtr->SetNumberOfComponentsPerPixel(numberOfComponents);
+  this->AllocateOutputs();
+
+  // Per-component transform: one scalar scratch image and one forward FFT filter are reused for every
+  // component, the result is scattered straight into the interleaved output buffer.
+  auto componentImage = InputSingleImageType::New();
+  componentImage->CopyInformation(inputPtr);
+  componentImage->SetRegions(inputPtr->GetBufferedRegion());
+  componentImage->Allocate();
+
+  auto fftForwardFilter = FFTForwardFilterType::New();
+  fftForwardFilter->SetInput(componentImage);
+  progress->RegisterInternalFilter(fftForwardFilter, 1.0 / numberOfComponents);
+
+  const typename InputImageType::RegionType region = inputPtr->GetBufferedRegion();
+  for (unsigned int c = 0; c < numberOfComponents; ++c)
+  {
+    const typename InputImageType::InternalPixelType * inputBuffer = inputPtr->GetBufferPointer();
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      region,
+      [componentImage, inputBuffer, numberOfComponents, c](const typename InputImageType::RegionType & lambdaRegion) {
+        ImageScanlineIterator<InputSingleImageType> it(componentImage, lambdaRegion);
+        while (!it.IsAtEnd())
+        {
+          const typename InputImageType::InternalPixelType * in =
+            inputBuffer + componentImage->ComputeOffset(it.GetIndex()) * numberOfComponents + c;
+          while (!it.IsAtEndOfLine())
+          {
+            it.Set(*in);
+            in += numberOfComponents;
+            ++it;
+          }
+          it.NextLine();
+        }
+      },
+      nullptr);
+    componentImage->Modified();
+    fftForwardFilter->Update();
+    progress->ResetFilterProgressAndKeepAccumulatedProgress();
+
+    const OutputSingleImageType *                       fftOutput = fftForwardFilter->GetOutput();
+    typename OutputImageType::InternalPixelType * const outputBuffer = outputPtr->GetBufferPointer();
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      region,
+      [fftOutput, outputBuffer, numberOfComponents, c](const typename InputImageType::RegionType & lambdaRegion) {
+        ImageScanlineConstIterator<OutputSingleImageType> it(fftOutput, lambdaRegion);
+        while (!it.IsAtEnd())
+        {
+          typename OutputImageType::InternalPixelType * out =
+            outputBuffer + fftOutput->ComputeOffset(it.GetIndex()) * numberOfComponents + c;
+          while (!it.IsAtEndOfLine())
+          {
+            *out = it.Get();
+            out += numberOfComponents;
+            ++it;
+          }
+          it.NextLine();
+        }
+      },
+      nullptr);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VectorForwardFFTImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+
+} // end namespace itk
+
+#endif
@@ -27,6 +27,13 @@ namespace itk
  *
  * Applies InverseFFT to each index of a vector image.
  *
+ * Per-component transform without intermediate copies: the components are transformed one after the
+ * other with the same InverseFFTImageFilter, gathered from the strided input buffer into a single scalar
+ * scratch image and written directly into their interleaved position of the output VectorImage, with no
+ * per-component output images nor a final compose step.
+ * The cost is the one of N scalar transforms, each component is a separate Update of the scalar
+ * InverseFFTImageFilter and its plan is managed by the FFT backend selected by the object factory.
+ *
  * This class transforms a full complex image with Hermitian symmetry into
  * its real spatial domain representation.  If the input does not have
  * Hermitian symmetry, the imaginary component is discarded.
@@ -67,10 +74,21 @@ public:
   /** ImageDimension enumeration. */
   static constexpr unsigned int ImageDimension = InputImageType::ImageDimension;
 
+  /** Scalar images and filter used to transform each component. */
+  using InputSingleImageType = Image<typename InputImageType::PixelType::ComponentType, ImageDimension>;
+  using FFTInverseFilterType = InverseFFTImageFilter<InputSingleImageType>;
+  using OutputSingleImageType = typename FFTInverseFilterType::OutputImageType;
+
 protected:
   VectorInverseFFTImageFilter() = default;
   ~VectorInverseFFTImageFilter() override = default;
 
+  /** The FFT requires the whole input and generates the whole output. */
+  void
+  GenerateInputRequestedRegion() override;
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
   void
   GenerateData() override;
 
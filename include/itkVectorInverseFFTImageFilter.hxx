@@ -18,13 +18,33 @@
 #ifndef itkVectorInverseFFTImageFilter_hxx
 #define itkVectorInverseFFTImageFilter_hxx
 #include "itkVectorInverseFFTImageFilter.h"
-#include <itkVectorIndexSelectionCastImageFilter.h>
-#include <itkComposeImageFilter.h>
+#include <itkImageScanlineIterator.h>
 #include <itkProgressAccumulator.h>
 
 namespace itk
 {
 
+template <typename TInputImage, typename TOutputImage>
+void
+VectorInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType * inputPtr = const_cast<InputImageType *>(this->GetInput());
+  if (inputPtr)
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+VectorInverseFFTImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 VectorInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
@@ -33,37 +53,71 @@ VectorInverseFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
 
+  const InputImageType *            inputPtr = this->GetInput();
   typename OutputImageType::Pointer outputPtr = this->GetOutput();
+  const unsigned int                numberOfComponents = inputPtr->GetNumberOfComponentsPerPixel();
 
+  outputPtr->SetNumberOfComponentsPerPixel(numberOfComponents);
   this->AllocateOutputs();
 
-  using InputSingleImageType = Image<typename InputImageType::PixelType::ComponentType, ImageDimension>;
-  using VectorCastFilterType = VectorIndexSelectionCastImageFilter<InputImageType, InputSingleImageType>;
-  using FFTInverseFilterType = InverseFFTImageFilter<InputSingleImageType>;
-  using OutputSingleImageType = typename FFTInverseFilterType::OutputImageType;
-  using ComposeFilterType = ComposeImageFilter<OutputSingleImageType, OutputImageType>;
+  // Per-component transform: one scalar scratch image and one inverse FFT filter are reused for every
+  // component, the result is scattered straight into the interleaved output buffer.
+  auto componentImage = InputSingleImageType::New();
+  componentImage->CopyInformation(inputPtr);
+  componentImage->SetRegions(inputPtr->GetBufferedRegion());
+  componentImage->Allocate();
 
-  auto vectorCastFilter = VectorCastFilterType::New();
-  vectorCastFilter->SetInput(this->GetInput());
-  progress->RegisterInternalFilter(vectorCastFilter, 1.0 / this->GetInput()->GetNumberOfComponentsPerPixel());
   auto fftInverseFilter = FFTInverseFilterType::New();
-  auto composeFilter = ComposeFilterType::New();
+  fftInverseFilter->SetInput(componentImage);
+  progress->RegisterInternalFilter(fftInverseFilter, 1.0 / numberOfComponents);
 
-  std::vector<typename OutputSingleImageType::Pointer> inverseFFToutputs;
-  for (unsigned int c = 0; c < this->GetInput()->GetNumberOfComponentsPerPixel(); c++)
+  const typename InputImageType::RegionType region = inputPtr->GetBufferedRegion();
+  for (unsigned int c = 0; c < numberOfComponents; ++c)
   {
-    vectorCastFilter->SetIndex(c);
-    vectorCastFilter->Update();
-    fftInverseFilter->SetInput(vectorCastFilter->GetOutput());
+    const typename InputImageType::InternalPixelType * inputBuffer = inputPtr->GetBufferPointer();
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      region,
+      [componentImage, inputBuffer, numberOfComponents, c](const typename InputImageType::RegionType & lambdaRegion) {
+        ImageScanlineIterator<InputSingleImageType> it(componentImage, lambdaRegion);
+        while (!it.IsAtEnd())
+        {
+          const typename InputImageType::InternalPixelType * in =
+            inputBuffer + componentImage->ComputeOffset(it.GetIndex()) * numberOfComponents + c;
+          while (!it.IsAtEndOfLine())
+          {
+            it.Set(*in);
+            in += numberOfComponents;
+            ++it;
+          }
+          it.NextLine();
+        }
+      },
+      nullptr);
+    componentImage->Modified();
     fftInverseFilter->Update();
-    inverseFFToutputs.push_back(fftInverseFilter->GetOutput());
-    inverseFFToutputs.back()->DisconnectPipeline();
-    composeFilter->SetInput(c, inverseFFToutputs.back());
-  }
-  composeFilter->GraftOutput(outputPtr);
-  composeFilter->Update();
+    progress->ResetFilterProgressAndKeepAccumulatedProgress();
 
-  this->GraftOutput(composeFilter->GetOutput());
+    const OutputSingleImageType *                       fftOutput = fftInverseFilter->GetOutput();
+    typename OutputImageType::InternalPixelType * const outputBuffer = outputPtr->GetBufferPointer();
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      region,
+      [fftOutput, outputBuffer, numberOfComponents, c](const typename InputImageType::RegionType & lambdaRegion) {
+        ImageScanlineConstIterator<OutputSingleImageType> it(fftOutput, lambdaRegion);
+        while (!it.IsAtEnd())
+        {
+          typename OutputImageType::InternalPixelType * out =
+            outputBuffer + fftOutput->ComputeOffset(it.GetIndex()) * numberOfComponents + c;
+          while (!it.IsAtEndOfLine())
+          {
+            *out = it.Get();
+            out += numberOfComponents;
+            ++it;
+          }
+          it.NextLine();
+        }
+      },
+      nullptr);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
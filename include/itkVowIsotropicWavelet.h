@@ -80,6 +80,10 @@ public:
   itkSetMacro(Kappa, TFunctionValue);
   itkGetConstMacro(Kappa, TFunctionValue);
 
+  /** Append Kappa to the parameters of the Superclass. */
+  std::vector<double>
+  GetWaveletParameters() const override;
+
 protected:
   VowIsotropicWavelet();
   ~VowIsotropicWavelet() override;
@@ -41,6 +41,15 @@ VowIsotropicWavelet<TFunctionValue, VImageDimension, TInput>::PrintSelf(std::ost
   os << indent << "Kappa: " << this->m_Kappa << std::endl;
 }
 
+template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
+std::vector<double>
+VowIsotropicWavelet<TFunctionValue, VImageDimension, TInput>::GetWaveletParameters() const
+{
+  std::vector<double> parameters = Superclass::GetWaveletParameters();
+  parameters.push_back(static_cast<double>(this->m_Kappa));
+  return parameters;
+}
+
 template <typename TFunctionValue, unsigned int VImageDimension, typename TInput>
 typename VowIsotropicWavelet<TFunctionValue, VImageDimension, TInput>::FunctionValueType
 VowIsotropicWavelet<TFunctionValue, VImageDimension, TInput>::EvaluateMagnitude(
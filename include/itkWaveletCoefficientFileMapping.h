@@ -0,0 +1,93 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletCoefficientFileMapping_h
+#define itkWaveletCoefficientFileMapping_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include "IsotropicWaveletsExport.h"
+#include <string>
+
+namespace itk
+{
+/** \class WaveletCoefficientFileMapping
+ * \brief Read-only view of a whole file mapped in memory.
+ *
+ * The file is mapped copy-on-write: the pages are read from the file when they are first accessed,
+ * and the modifications of the mapped memory are private to the process, they are never written to the file.
+ * The memory is unmapped when the object is destroyed, images sharing it have to keep a pointer to it.
+ *
+ * \sa WaveletCoefficientStore
+ * \ingroup IsotropicWavelets
+ */
+class IsotropicWavelets_EXPORT WaveletCoefficientFileMapping : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WaveletCoefficientFileMapping);
+
+  /** Standard class type alias. */
+  using Self = WaveletCoefficientFileMapping;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(WaveletCoefficientFileMapping, Object);
+
+  /** Map the whole file, unmapping the previous one. Throws an exception if the file cannot be mapped. */
+  void
+  Open(const std::string & fileName);
+
+  /** Unmap the file. */
+  void
+  Close();
+
+  /** First byte of the mapped file, nullptr if no file is mapped. */
+  char *
+  GetData() const
+  {
+    return m_Data;
+  }
+
+  /** Size in bytes of the mapped file. */
+  itkGetConstMacro(Size, SizeValueType);
+
+  itkGetConstReferenceMacro(FileName, std::string);
+
+protected:
+  WaveletCoefficientFileMapping() = default;
+  ~WaveletCoefficientFileMapping() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  std::string   m_FileName;
+  char *        m_Data{ nullptr };
+  SizeValueType m_Size{ 0 };
+#if defined(_WIN32)
+  /** HANDLEs of the file and of the mapping, windows.h is only included in the implementation. */
+  void * m_FileHandle{ nullptr };
+  void * m_MappingHandle{ nullptr };
+#endif
+};
+} // end namespace itk
+
+#endif
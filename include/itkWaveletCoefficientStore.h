@@ -0,0 +1,247 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletCoefficientStore_h
+#define itkWaveletCoefficientStore_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include <itkImportImageContainer.h>
+#include "itkWaveletCoefficientFileMapping.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyForwardUndecimated.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkWaveletFrequencyInverseUndecimated.h"
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class WaveletCoefficientStore
+ * \brief Coefficients of a wavelet pyramid and their metadata, stored in a file that is mapped in memory to be read.
+ *
+ * The coefficients have the layout of the outputs of WaveletFrequencyForward and
+ * WaveletFrequencyForwardUndecimated: the high pass bands of every level, and the low pass residual.
+ * The metadata needed to reconstruct the image is kept with them: Levels, HighPassSubBands, ScaleFactor,
+ * the kind of transform, the wavelet function and the information of the input of the forward transform,
+ * which the transform does not keep.
+ *
+ * Write stores everything in one file: a header with the metadata and an index of the bands,
+ * followed by one chunk per band, aligned to ChunkAlignment bytes.
+ * Read maps the file in memory, \sa WaveletCoefficientFileMapping, and the coefficient images use the mapped
+ * chunks as buffers, without copying them. The pixels of a band are only read from disk when they are accessed,
+ * so SetupWaveletInverse reconstructs pyramids bigger than the memory, reading each band when it is used.
+ * The mapping is copy-on-write: filters modifying the coefficients do not modify the file.
+ *
+ * The file is written with the byte order and the pixel type of the machine, Read throws an exception
+ * if they do not match.
+ *
+ * \sa WaveletFrequencyForward
+ * \sa WaveletFrequencyInverse
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TImage>
+class WaveletCoefficientStore : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WaveletCoefficientStore);
+
+  /** Standard class type alias. */
+  using Self = WaveletCoefficientStore;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(WaveletCoefficientStore, Object);
+
+  /** Image type alias. */
+  using ImageType = TImage;
+  using ImagePointer = typename ImageType::Pointer;
+  using PixelType = typename ImageType::PixelType;
+  using RegionType = typename ImageType::RegionType;
+  using PointType = typename ImageType::PointType;
+  using SpacingType = typename ImageType::SpacingType;
+  using DirectionType = typename ImageType::DirectionType;
+  using CoefficientsType = std::vector<ImagePointer>;
+
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  /** First bytes of the files written by Write: "ITKWCOEF". */
+  static constexpr uint64_t FileSignature = 0x46454f43574b5449;
+  /** Version of the file format written by Write. */
+  static constexpr uint32_t FormatVersion = 1;
+  /** Written in the byte order of the machine, to detect files written with a different one. */
+  static constexpr uint32_t ByteOrderMark = 0x01020304;
+
+  /** \class MappedPixelContainer
+   * Pixel container of the coefficients created by Read. It does not own the pixels, they are the memory
+   * of a chunk of the mapped file, and it keeps the mapping alive while an image uses it.
+   * \ingroup IsotropicWavelets
+   */
+  class MappedPixelContainer : public ImportImageContainer<SizeValueType, PixelType>
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(MappedPixelContainer);
+
+    using Self = MappedPixelContainer;
+    using Superclass = ImportImageContainer<SizeValueType, PixelType>;
+    using Pointer = SmartPointer<Self>;
+    using ConstPointer = SmartPointer<const Self>;
+
+    itkNewMacro(Self);
+    itkTypeMacro(MappedPixelContainer, ImportImageContainer);
+
+    itkSetConstObjectMacro(FileMapping, WaveletCoefficientFileMapping);
+    itkGetConstObjectMacro(FileMapping, WaveletCoefficientFileMapping);
+
+  protected:
+    MappedPixelContainer() = default;
+    ~MappedPixelContainer() override = default;
+
+  private:
+    WaveletCoefficientFileMapping::ConstPointer m_FileMapping;
+  };
+
+  /** Number of levels of the pyramid. */
+  itkSetMacro(Levels, unsigned int);
+  itkGetConstReferenceMacro(Levels, unsigned int);
+  /** Number of high pass bands per level. */
+  itkSetMacro(HighPassSubBands, unsigned int);
+  itkGetConstReferenceMacro(HighPassSubBands, unsigned int);
+  /** Scale factor between levels. */
+  itkSetMacro(ScaleFactor, unsigned int);
+  itkGetConstReferenceMacro(ScaleFactor, unsigned int);
+  /** The coefficients are the outputs of WaveletFrequencyForwardUndecimated. */
+  itkSetMacro(Undecimated, bool);
+  itkGetConstReferenceMacro(Undecimated, bool);
+  itkBooleanMacro(Undecimated);
+  /** The coefficients have the half-Hermitian layout, \sa WaveletFrequencyForward::SetHalfHermitian. */
+  itkSetMacro(HalfHermitian, bool);
+  itkGetConstReferenceMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkGetConstReferenceMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
+  /** Class name and parameters of the wavelet function, \sa IsotropicWaveletFrequencyFunction. */
+  itkSetMacro(WaveletName, std::string);
+  itkGetConstReferenceMacro(WaveletName, std::string);
+  void
+  SetWaveletParameters(const std::vector<double> & waveletParameters);
+  const std::vector<double> &
+  GetWaveletParameters() const
+  {
+    return m_WaveletParameters;
+  }
+
+  /** Information of the input of the forward transform, to restore it after the reconstruction. */
+  itkSetMacro(InputOrigin, PointType);
+  itkGetConstReferenceMacro(InputOrigin, PointType);
+  itkSetMacro(InputSpacing, SpacingType);
+  itkGetConstReferenceMacro(InputSpacing, SpacingType);
+  itkSetMacro(InputDirection, DirectionType);
+  itkGetConstReferenceMacro(InputDirection, DirectionType);
+
+  /** Alignment in bytes of the chunk of each band in the file. Default: 4096, the usual page size. */
+  itkSetClampMacro(ChunkAlignment, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(ChunkAlignment, SizeValueType);
+
+  /** Coefficients, with the layout of the outputs of the forward transforms. */
+  void
+  SetCoefficients(const CoefficientsType & coefficients);
+  const CoefficientsType &
+  GetCoefficients() const
+  {
+    return m_Coefficients;
+  }
+  ImageType *
+  GetCoefficient(unsigned int n) const;
+
+  /** Mapping of the file of the coefficients, nullptr if they were not read from a file. */
+  itkGetConstObjectMacro(FileMapping, WaveletCoefficientFileMapping);
+
+  /** Take the metadata and the outputs of an updated forward transform. */
+  template <typename TInputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilter>
+  void
+  SetWaveletForward(
+    WaveletFrequencyForward<TInputImage, ImageType, TWaveletFilterBank, TFrequencyShrinkFilter> * forward);
+  template <typename TInputImage, typename TWaveletFilterBank>
+  void
+  SetWaveletForward(WaveletFrequencyForwardUndecimated<TInputImage, ImageType, TWaveletFilterBank> * forward);
+
+  /** Set the Levels, HighPassSubBands, HalfHermitian, ActualXDimensionIsOdd and the coefficients as inputs of an
+   * inverse transform.
+   * Throws an exception if the kind of transform or the wavelet function do not match the coefficients. */
+  template <typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilter>
+  void
+  SetupWaveletInverse(
+    WaveletFrequencyInverse<ImageType, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilter> * inverse) const;
+  template <typename TOutputImage, typename TWaveletFilterBank>
+  void
+  SetupWaveletInverse(WaveletFrequencyInverseUndecimated<ImageType, TOutputImage, TWaveletFilterBank> * inverse) const;
+
+  /** Write the metadata and the coefficients to fileName. */
+  void
+  Write(const std::string & fileName) const;
+
+  /** Map fileName in memory and read the metadata. The coefficients use the mapped memory as buffers. */
+  void
+  Read(const std::string & fileName);
+
+protected:
+  WaveletCoefficientStore();
+  ~WaveletCoefficientStore() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Number of coefficient images of the pyramid: Levels * HighPassSubBands + 1. */
+  SizeValueType
+  ComputeNumberOfCoefficients() const;
+
+  /** Throw an exception if the wavelet function of the filter bank is not the one of the coefficients. */
+  template <typename TWaveletFilterBank>
+  void
+  VerifyWaveletFunction() const;
+
+private:
+  unsigned int        m_Levels{ 1 };
+  unsigned int        m_HighPassSubBands{ 1 };
+  unsigned int        m_ScaleFactor{ 2 };
+  bool                m_Undecimated{ false };
+  bool                m_HalfHermitian{ false };
+  bool                m_ActualXDimensionIsOdd{ false };
+  std::string         m_WaveletName;
+  std::vector<double> m_WaveletParameters;
+  PointType           m_InputOrigin;
+  SpacingType         m_InputSpacing;
+  DirectionType       m_InputDirection;
+  SizeValueType       m_ChunkAlignment{ 4096 };
+  CoefficientsType    m_Coefficients;
+
+  WaveletCoefficientFileMapping::ConstPointer m_FileMapping;
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkWaveletCoefficientStore.hxx"
+#endif
+
+#endif
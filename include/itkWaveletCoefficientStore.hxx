@@ -0,0 +1,525 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletCoefficientStore_hxx
+#define itkWaveletCoefficientStore_hxx
+
+#include "itkWaveletCoefficientStore.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace itk
+{
+template <typename TImage>
+WaveletCoefficientStore<TImage>::WaveletCoefficientStore()
+{
+  m_InputOrigin.Fill(0);
+  m_InputSpacing.Fill(1);
+  m_InputDirection.SetIdentity();
+}
+
+template <typename TImage>
+void
+WaveletCoefficientStore<TImage>::SetWaveletParameters(const std::vector<double> & waveletParameters)
+{
+  if (m_WaveletParameters != waveletParameters)
+  {
+    m_WaveletParameters = waveletParameters;
+    this->Modified();
+  }
+}
+
+template <typename TImage>
+void
+WaveletCoefficientStore<TImage>::SetCoefficients(const CoefficientsType & coefficients)
+{
+  m_Coefficients = coefficients;
+  m_FileMapping = nullptr;
+  this->Modified();
+}
+
+template <typename TImage>
+auto
+WaveletCoefficientStore<TImage>::GetCoefficient(unsigned int n) const -> ImageType *
+{
+  if (n >= m_Coefficients.size())
+  {
+    itkExceptionMacro(<< "Coefficient " << n << " requested, but there are " << m_Coefficients.size()
+                      << " coefficient images.");
+  }
+  return m_Coefficients[n];
+}
+
+template <typename TImage>
+SizeValueType
+WaveletCoefficientStore<TImage>::ComputeNumberOfCoefficients() const
+{
+  return static_cast<SizeValueType>(m_Levels) * m_HighPassSubBands + 1;
+}
+
+template <typename TImage>
+template <typename TInputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilter>
+void
+WaveletCoefficientStore<TImage>::SetWaveletForward(
+  WaveletFrequencyForward<TInputImage, ImageType, TWaveletFilterBank, TFrequencyShrinkFilter> * forward)
+{
+  const TInputImage * input = forward->GetInput();
+  if (input == nullptr)
+  {
+    itkExceptionMacro(<< "The forward transform has no input.");
+  }
+  this->SetLevels(forward->GetLevels());
+  this->SetHighPassSubBands(forward->GetHighPassSubBands());
+  this->SetScaleFactor(forward->GetScaleFactor());
+  this->SetUndecimated(false);
+  this->SetHalfHermitian(forward->GetHalfHermitian());
+  this->SetActualXDimensionIsOdd(forward->GetActualXDimensionIsOdd());
+  this->SetWaveletName(forward->GetModifiableWaveletFunction()->GetNameOfClass());
+  this->SetWaveletParameters(forward->GetModifiableWaveletFunction()->GetWaveletParameters());
+  this->SetInputOrigin(input->GetOrigin());
+  this->SetInputSpacing(input->GetSpacing());
+  this->SetInputDirection(input->GetDirection());
+  this->SetCoefficients(forward->GetOutputs());
+}
+
+template <typename TImage>
+template <typename TInputImage, typename TWaveletFilterBank>
+void
+WaveletCoefficientStore<TImage>::SetWaveletForward(
+  WaveletFrequencyForwardUndecimated<TInputImage, ImageType, TWaveletFilterBank> * forward)
+{
+  const TInputImage * input = forward->GetInput();
+  if (input == nullptr)
+  {
+    itkExceptionMacro(<< "The forward transform has no input.");
+  }
+  this->SetLevels(forward->GetLevels());
+  this->SetHighPassSubBands(forward->GetHighPassSubBands());
+  this->SetScaleFactor(forward->GetScaleFactor());
+  this->SetUndecimated(true);
+  this->SetHalfHermitian(false);
+  this->SetActualXDimensionIsOdd(false);
+  this->SetWaveletName(forward->GetModifiableWaveletFunction()->GetNameOfClass());
+  this->SetWaveletParameters(forward->GetModifiableWaveletFunction()->GetWaveletParameters());
+  this->SetInputOrigin(input->GetOrigin());
+  this->SetInputSpacing(input->GetSpacing());
+  this->SetInputDirection(input->GetDirection());
+  this->SetCoefficients(forward->GetOutputs());
+}
+
+template <typename TImage>
+template <typename TWaveletFilterBank>
+void
+WaveletCoefficientStore<TImage>::VerifyWaveletFunction() const
+{
+  // Coefficients set without SetWaveletForward have no wavelet name.
+  if (m_WaveletName.empty())
+  {
+    return;
+  }
+  const auto waveletFunction = TWaveletFilterBank::WaveletFunctionType::New();
+  if (m_WaveletName != waveletFunction->GetNameOfClass())
+  {
+    itkExceptionMacro(<< "The coefficients were computed with the wavelet " << m_WaveletName
+                      << ", the inverse transform uses " << waveletFunction->GetNameOfClass());
+  }
+}
+
+template <typename TImage>
+template <typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilter>
+void
+WaveletCoefficientStore<TImage>::SetupWaveletInverse(
+  WaveletFrequencyInverse<ImageType, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilter> * inverse) const
+{
+  if (m_Undecimated)
+  {
+    itkExceptionMacro(<< "The coefficients are undecimated, use WaveletFrequencyInverseUndecimated.");
+  }
+  if (m_ScaleFactor != inverse->GetScaleFactor())
+  {
+    itkExceptionMacro(<< "The coefficients have ScaleFactor " << m_ScaleFactor << ", the inverse transform "
+                      << inverse->GetScaleFactor());
+  }
+  this->template VerifyWaveletFunction<TWaveletFilterBank>();
+  if (m_Coefficients.size() != this->ComputeNumberOfCoefficients())
+  {
+    itkExceptionMacro(<< "Expected " << this->ComputeNumberOfCoefficients() << " coefficient images, but there are "
+                      << m_Coefficients.size());
+  }
+  inverse->SetLevels(m_Levels);
+  inverse->SetHighPassSubBands(m_HighPassSubBands);
+  inverse->SetHalfHermitian(m_HalfHermitian);
+  inverse->SetActualXDimensionIsOdd(m_ActualXDimensionIsOdd);
+  inverse->SetInputs(m_Coefficients);
+}
+
+template <typename TImage>
+template <typename TOutputImage, typename TWaveletFilterBank>
+void
+WaveletCoefficientStore<TImage>::SetupWaveletInverse(
+  WaveletFrequencyInverseUndecimated<ImageType, TOutputImage, TWaveletFilterBank> * inverse) const
+{
+  if (!m_Undecimated)
+  {
+    itkExceptionMacro(<< "The coefficients are decimated, use WaveletFrequencyInverse.");
+  }
+  if (m_ScaleFactor != inverse->GetScaleFactor())
+  {
+    itkExceptionMacro(<< "The coefficients have ScaleFactor " << m_ScaleFactor << ", the inverse transform "
+                      << inverse->GetScaleFactor());
+  }
+  this->template VerifyWaveletFunction<TWaveletFilterBank>();
+  if (m_Coefficients.size() != this->ComputeNumberOfCoefficients())
+  {
+    itkExceptionMacro(<< "Expected " << this->ComputeNumberOfCoefficients() << " coefficient images, but there are "
+                      << m_Coefficients.size());
+  }
+  inverse->SetLevels(m_Levels);
+  inverse->SetHighPassSubBands(m_HighPassSubBands);
+  inverse->SetInputs(m_Coefficients);
+}
+
+template <typename TImage>
+void
+WaveletCoefficientStore<TImage>::Write(const std::string & fileName) const
+{
+  const SizeValueType numberOfCoefficients = this->ComputeNumberOfCoefficients();
+  if (m_Coefficients.size() != numberOfCoefficients)
+  {
+    itkExceptionMacro(<< "Expected " << numberOfCoefficients << " coefficient images for " << m_Levels
+                      << " levels and " << m_HighPassSubBands << " high pass sub-bands, but there are "
+                      << m_Coefficients.size());
+  }
+  if (m_ChunkAlignment % alignof(PixelType) != 0)
+  {
+    itkExceptionMacro(<< "ChunkAlignment " << m_ChunkAlignment << " is not a multiple of the alignment of the pixels "
+                      << alignof(PixelType));
+  }
+  for (SizeValueType n = 0; n < numberOfCoefficients; ++n)
+  {
+    const ImageType * coefficient = m_Coefficients[n];
+    if (coefficient == nullptr || coefficient->GetBufferPointer() == nullptr ||
+        coefficient->GetBufferedRegion() != coefficient->GetLargestPossibleRegion())
+    {
+      itkExceptionMacro(<< "Coefficient " << n << " is not generated, or it is not buffered entirely.");
+    }
+  }
+
+  // Header: metadata, and index of the bands. The offsets of the chunks are filled once its size is known.
+  std::vector<char> header;
+  const auto        appendValue = [&header](const auto value) {
+    const auto * first = reinterpret_cast<const char *>(&value);
+    header.insert(header.end(), first, first + sizeof(value));
+  };
+  const auto appendGeometry = [&appendValue](const PointType &     origin,
+                                             const SpacingType &   spacing,
+                                             const DirectionType & direction) {
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      appendValue(static_cast<double>(origin[i]));
+    }
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      appendValue(static_cast<double>(spacing[i]));
+    }
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      for (unsigned int j = 0; j < ImageDimension; ++j)
+      {
+        appendValue(static_cast<double>(direction[i][j]));
+      }
+    }
+  };
+
+  appendValue(FileSignature);
+  appendValue(FormatVersion);
+  appendValue(ByteOrderMark);
+  appendValue(static_cast<uint32_t>(ImageDimension));
+  appendValue(static_cast<uint32_t>(sizeof(PixelType)));
+  appendValue(static_cast<uint32_t>(m_Levels));
+  appendValue(static_cast<uint32_t>(m_HighPassSubBands));
+  appendValue(static_cast<uint32_t>(m_ScaleFactor));
+  appendValue(static_cast<uint32_t>((m_Undecimated ? 1u : 0u) | (m_HalfHermitian ? 2u : 0u) |
+                                    (m_ActualXDimensionIsOdd ? 4u : 0u)));
+  appendValue(static_cast<uint64_t>(m_WaveletName.size()));
+  header.insert(header.end(), m_WaveletName.begin(), m_WaveletName.end());
+  appendValue(static_cast<uint64_t>(m_WaveletParameters.size()));
+  for (const double parameter : m_WaveletParameters)
+  {
+    appendValue(parameter);
+  }
+  appendGeometry(m_InputOrigin, m_InputSpacing, m_InputDirection);
+  appendValue(static_cast<uint64_t>(numberOfCoefficients));
+  std::vector<size_t> offsetPositions(numberOfCoefficients);
+  for (SizeValueType n = 0; n < numberOfCoefficients; ++n)
+  {
+    const ImageType *  coefficient = m_Coefficients[n];
+    const RegionType & region = coefficient->GetLargestPossibleRegion();
+    offsetPositions[n] = header.size();
+    appendValue(uint64_t{ 0 });
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      appendValue(static_cast<int64_t>(region.GetIndex()[i]));
+    }
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      appendValue(static_cast<uint64_t>(region.GetSize()[i]));
+    }
+    appendGeometry(coefficient->GetOrigin(), coefficient->GetSpacing(), coefficient->GetDirection());
+  }
+
+  // Chunks: one per band, aligned to ChunkAlignment.
+  std::vector<SizeValueType> offsets(numberOfCoefficients);
+  SizeValueType              position = header.size();
+  for (SizeValueType n = 0; n < numberOfCoefficients; ++n)
+  {
+    offsets[n] = (position + m_ChunkAlignment - 1) / m_ChunkAlignment * m_ChunkAlignment;
+    position = offsets[n] + m_Coefficients[n]->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(PixelType);
+    const auto offset = static_cast<uint64_t>(offsets[n]);
+    std::memcpy(header.data() + offsetPositions[n], &offset, sizeof(offset));
+  }
+
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  if (!file)
+  {
+    itkExceptionMacro(<< "Cannot open the file " << fileName << " for writing.");
+  }
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+  const char    zeros[4096] = {};
+  SizeValueType written = header.size();
+  for (SizeValueType n = 0; n < numberOfCoefficients && file; ++n)
+  {
+    while (written < offsets[n])
+    {
+      const SizeValueType padding = std::min<SizeValueType>(offsets[n] - written, sizeof(zeros));
+      file.write(zeros, static_cast<std::streamsize>(padding));
+      written += padding;
+    }
+    const SizeValueType bytes = m_Coefficients[n]->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(PixelType);
+    file.write(reinterpret_cast<const char *>(m_Coefficients[n]->GetBufferPointer()),
+               static_cast<std::streamsize>(bytes));
+    written += bytes;
+  }
+  file.close();
+  if (!file)
+  {
+    itkExceptionMacro(<< "Cannot write the coefficients to the file " << fileName);
+  }
+}
+
+template <typename TImage>
+void
+WaveletCoefficientStore<TImage>::Read(const std::string & fileName)
+{
+  auto fileMapping = WaveletCoefficientFileMapping::New();
+  fileMapping->Open(fileName);
+  char * const        data = fileMapping->GetData();
+  const SizeValueType size = fileMapping->GetSize();
+
+  // The header is copied out of the mapping, checking that every field is inside the file.
+  SizeValueType position = 0;
+  const auto    checkAvailable = [&](const SizeValueType count, const SizeValueType elementBytes) {
+    if (count > (size - position) / elementBytes)
+    {
+      itkExceptionMacro(<< "The file " << fileName << " is truncated, or it is not a file of wavelet coefficients.");
+    }
+  };
+  const auto readValue = [&](auto & value) {
+    checkAvailable(sizeof(value), 1);
+    std::memcpy(&value, data + position, sizeof(value));
+    position += sizeof(value);
+  };
+  const auto readGeometry = [&](PointType & origin, SpacingType & spacing, DirectionType & direction) {
+    double value;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      readValue(value);
+      origin[i] = value;
+    }
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      readValue(value);
+      spacing[i] = value;
+    }
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      for (unsigned int j = 0; j < ImageDimension; ++j)
+      {
+        readValue(value);
+        direction[i][j] = value;
+      }
+    }
+  };
+
+  uint64_t signature = 0;
+  readValue(signature);
+  if (signature != FileSignature)
+  {
+    itkExceptionMacro(<< "The file " << fileName << " is not a file of wavelet coefficients.");
+  }
+  uint32_t version = 0;
+  uint32_t byteOrderMark = 0;
+  uint32_t dimension = 0;
+  uint32_t pixelBytes = 0;
+  readValue(version);
+  readValue(byteOrderMark);
+  readValue(dimension);
+  readValue(pixelBytes);
+  if (version != FormatVersion)
+  {
+    itkExceptionMacro(<< "The file " << fileName << " has the format version " << version << ", expected "
+                      << FormatVersion);
+  }
+  if (byteOrderMark != ByteOrderMark)
+  {
+    itkExceptionMacro(<< "The file " << fileName << " was written with a different byte order.");
+  }
+  if (dimension != ImageDimension || pixelBytes != sizeof(PixelType))
+  {
+    itkExceptionMacro(<< "The file " << fileName << " has images of dimension " << dimension << " and pixels of "
+                      << pixelBytes << " bytes, expected dimension " << ImageDimension << " and pixels of "
+                      << sizeof(PixelType) << " bytes.");
+  }
+
+  uint32_t levels = 0;
+  uint32_t highPassSubBands = 0;
+  uint32_t scaleFactor = 0;
+  uint32_t flags = 0;
+  readValue(levels);
+  readValue(highPassSubBands);
+  readValue(scaleFactor);
+  readValue(flags);
+  uint64_t nameLength = 0;
+  readValue(nameLength);
+  checkAvailable(nameLength, 1);
+  const std::string waveletName(data + position, nameLength);
+  position += nameLength;
+  uint64_t numberOfParameters = 0;
+  readValue(numberOfParameters);
+  checkAvailable(numberOfParameters, sizeof(double));
+  std::vector<double> waveletParameters(numberOfParameters);
+  for (double & parameter : waveletParameters)
+  {
+    readValue(parameter);
+  }
+  PointType     inputOrigin;
+  SpacingType   inputSpacing;
+  DirectionType inputDirection;
+  readGeometry(inputOrigin, inputSpacing, inputDirection);
+
+  uint64_t numberOfCoefficients = 0;
+  readValue(numberOfCoefficients);
+  if (numberOfCoefficients != static_cast<uint64_t>(levels) * highPassSubBands + 1)
+  {
+    itkExceptionMacro(<< "The file " << fileName << " has " << numberOfCoefficients << " coefficient images, expected "
+                      << static_cast<uint64_t>(levels) * highPassSubBands + 1);
+  }
+
+  // The bands are not read: their images use the chunks of the mapping as buffers.
+  const SizeValueType maximumNumberOfPixels = size / sizeof(PixelType);
+  CoefficientsType    coefficients;
+  for (uint64_t n = 0; n < numberOfCoefficients; ++n)
+  {
+    uint64_t                       offset = 0;
+    typename RegionType::IndexType index;
+    typename RegionType::SizeType  regionSize;
+    SizeValueType                  numberOfPixels = 1;
+    readValue(offset);
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      int64_t value = 0;
+      readValue(value);
+      index[i] = static_cast<IndexValueType>(value);
+    }
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      uint64_t value = 0;
+      readValue(value);
+      if (value == 0 || value > maximumNumberOfPixels / numberOfPixels)
+      {
+        itkExceptionMacro(<< "Coefficient " << n << " of the file " << fileName << " has an invalid size.");
+      }
+      regionSize[i] = static_cast<SizeValueType>(value);
+      numberOfPixels *= regionSize[i];
+    }
+    PointType     origin;
+    SpacingType   spacing;
+    DirectionType direction;
+    readGeometry(origin, spacing, direction);
+
+    const SizeValueType bytes = numberOfPixels * sizeof(PixelType);
+    if (offset > size - bytes || offset % alignof(PixelType) != 0)
+    {
+      itkExceptionMacro(<< "Coefficient " << n << " of the file " << fileName << " is outside of the file.");
+    }
+    auto pixelContainer = MappedPixelContainer::New();
+    pixelContainer->SetImportPointer(reinterpret_cast<PixelType *>(data + offset), numberOfPixels, false);
+    pixelContainer->SetFileMapping(fileMapping);
+    auto coefficient = ImageType::New();
+    coefficient->SetRegions(RegionType(index, regionSize));
+    coefficient->SetOrigin(origin);
+    coefficient->SetSpacing(spacing);
+    coefficient->SetDirection(direction);
+    coefficient->SetPixelContainer(pixelContainer);
+    coefficients.push_back(coefficient);
+  }
+
+  m_Levels = levels;
+  m_HighPassSubBands = highPassSubBands;
+  m_ScaleFactor = scaleFactor;
+  m_Undecimated = (flags & 1u) != 0;
+  m_HalfHermitian = (flags & 2u) != 0;
+  m_ActualXDimensionIsOdd = (flags & 4u) != 0;
+  m_WaveletName = waveletName;
+  m_WaveletParameters = waveletParameters;
+  m_InputOrigin = inputOrigin;
+  m_InputSpacing = inputSpacing;
+  m_InputDirection = inputDirection;
+  m_Coefficients = coefficients;
+  m_FileMapping = fileMapping;
+  this->Modified();
+}
+
+template <typename TImage>
+void
+WaveletCoefficientStore<TImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Levels: " << m_Levels << std::endl;
+  os << indent << "HighPassSubBands: " << m_HighPassSubBands << std::endl;
+  os << indent << "ScaleFactor: " << m_ScaleFactor << std::endl;
+  os << indent << "Undecimated: " << (m_Undecimated ? "On" : "Off") << std::endl;
+  os << indent << "HalfHermitian: " << (m_HalfHermitian ? "On" : "Off") << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << (m_ActualXDimensionIsOdd ? "On" : "Off") << std::endl;
+  os << indent << "WaveletName: " << m_WaveletName << std::endl;
+  os << indent << "WaveletParameters:";
+  for (const double parameter : m_WaveletParameters)
+  {
+    os << " " << parameter;
+  }
+  os << std::endl;
+  os << indent << "InputOrigin: " << m_InputOrigin << std::endl;
+  os << indent << "InputSpacing: " << m_InputSpacing << std::endl;
+  os << indent << "InputDirection: " << m_InputDirection << std::endl;
+  os << indent << "ChunkAlignment: " << m_ChunkAlignment << std::endl;
+  os << indent << "NumberOfCoefficients: " << m_Coefficients.size() << std::endl;
+  itkPrintSelfObjectMacro(FileMapping);
+}
+} // end namespace itk
+
+#endif
@@ -33,6 +33,7 @@
 #include "itkMonogenicSignalFrequencyImageFilter.h"
 #include "itkVectorInverseFFTImageFilter.h"
 #include "itkPhaseAnalysisSoftThresholdImageFilter.h"
+#include "itkMonogenicPhaseAnalysisImageFilter.h"
 #include "itkZeroDCImageFilter.h"
 #include "itkImage.h"
 #include "itkCastImageFilter.h"
@@ -91,6 +92,10 @@ public:
   itkSetMacro(ApplySoftThreshold, bool);
   itkGetMacro(ThresholdNumOfSigmas, double);
   itkSetMacro(ThresholdNumOfSigmas, double);
+  /** Estimator of the soft threshold of each band, \sa PhaseAnalysisThresholdEstimator.
+   * If it is not set (default), the threshold is mean + ThresholdNumOfSigmas * sigma. */
+  itkSetObjectMacro(ThresholdEstimator, PhaseAnalysisThresholdEstimator);
+  itkGetModifiableObjectMacro(ThresholdEstimator, PhaseAnalysisThresholdEstimator);
 
 protected:
   WaveletCoeffsPhaseAnalyzisImageFilter();
@@ -109,6 +114,7 @@ protected:
   using VectorMonoOutputType = typename MonogenicSignalFrequencyType::OutputImageType;
   using VectorInverseFFTType = VectorInverseFFTImageFilter<VectorMonoOutputType>;
   using PhaseAnalysisType = PhaseAnalysisSoftThresholdImageFilter<typename VectorInverseFFTType::OutputImageType>;
+  using MonogenicPhaseAnalysisType = MonogenicPhaseAnalysisImageFilter<ComplexImageType>;
 
   using InverseWaveletType = WaveletFrequencyInverse<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
   using InverseFFTType = InverseFFTImageFilter<ComplexImageType, ImageType>;
@@ -128,10 +134,8 @@ private:
   typename FFTForwardType::Pointer     m_ForwardFFTFilter;
   typename ForwardWaveletType::Pointer m_ForwardWaveletFilter;
 
-  typename MonogenicSignalFrequencyType::Pointer m_MonogenicSignalFrequencyFilter;
-  typename VectorInverseFFTType::Pointer         m_VectorInverseFFTFilter;
-  typename PhaseAnalysisType::Pointer            m_PhaseAnalysisFilter;
-  typename FFTForwardType::Pointer               m_FFTForwardPhaseFilter;
+  typename MonogenicPhaseAnalysisType::Pointer m_MonogenicPhaseAnalysisFilter;
+  typename FFTForwardType::Pointer             m_FFTForwardPhaseFilter;
 
   typename InverseWaveletType::Pointer m_InverseWaveletFilter;
   typename InverseFFTType::Pointer     m_InverseFFTFilter;
@@ -144,6 +148,8 @@ private:
   unsigned int m_OutputIndex;
   bool         m_ApplySoftThreshold;
   double       m_ThresholdNumOfSigmas;
+
+  PhaseAnalysisThresholdEstimator::Pointer m_ThresholdEstimator;
 };
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
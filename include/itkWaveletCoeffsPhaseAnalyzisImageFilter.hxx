@@ -33,6 +33,7 @@
 #include "itkMonogenicSignalFrequencyImageFilter.h"
 #include "itkVectorInverseFFTImageFilter.h"
 #include "itkPhaseAnalysisSoftThresholdImageFilter.h"
+#include "itkMonogenicPhaseAnalysisImageFilter.h"
 #include "itkZeroDCImageFilter.h"
 #include "itkImage.h"
 #include "itkCastImageFilter.h"
@@ -55,9 +56,9 @@ WaveletCoeffsPhaseAnalyzisImageFilter<TImageType, TWaveletFunction>::WaveletCoef
   m_ForwardFFTFilter = FFTForwardType::New();
   m_ForwardWaveletFilter = ForwardWaveletType::New();
 
-  m_MonogenicSignalFrequencyFilter = MonogenicSignalFrequencyType::New();
-  m_VectorInverseFFTFilter = VectorInverseFFTType::New();
-  m_PhaseAnalysisFilter = PhaseAnalysisType::New();
+  m_MonogenicPhaseAnalysisFilter = MonogenicPhaseAnalysisType::New();
+  m_MonogenicPhaseAnalysisFilter->GeneratePhaseOff();
+  m_MonogenicPhaseAnalysisFilter->GenerateAmplitudeOff();
   m_FFTForwardPhaseFilter = FFTForwardType::New();
 
   m_InverseWaveletFilter = InverseWaveletType::New();
@@ -91,17 +92,17 @@ WaveletCoeffsPhaseAnalyzisImageFilter<TImageType, TWaveletFunction>::GenerateDat
   typename ForwardWaveletType::OutputsType modifiedWavelets;
   for (unsigned int i = 0; i < m_ForwardWaveletFilter->GetNumberOfOutputs(); ++i)
   {
-    m_MonogenicSignalFrequencyFilter->SetInput(m_ForwardWaveletFilter->GetOutput(i)); // This API is strange.
-    m_VectorInverseFFTFilter->SetInput(m_MonogenicSignalFrequencyFilter->GetOutput());
-    m_PhaseAnalysisFilter->SetInput(m_VectorInverseFFTFilter->GetOutput());
+    // Monogenic signal, inverse FFT and phase analysis of the band in one filter, only cos(phase) is generated.
+    m_MonogenicPhaseAnalysisFilter->SetInput(m_ForwardWaveletFilter->GetOutput(i));
 
-    m_PhaseAnalysisFilter->SetApplySoftThreshold(this->m_ApplySoftThreshold);
+    m_MonogenicPhaseAnalysisFilter->SetApplySoftThreshold(this->m_ApplySoftThreshold);
     if (this->m_ApplySoftThreshold)
     {
-      m_PhaseAnalysisFilter->SetNumOfSigmas(this->m_ThresholdNumOfSigmas);
+      m_MonogenicPhaseAnalysisFilter->SetNumOfSigmas(this->m_ThresholdNumOfSigmas);
+      m_MonogenicPhaseAnalysisFilter->SetThresholdEstimator(this->m_ThresholdEstimator);
     }
 
-    m_FFTForwardPhaseFilter->SetInput(m_PhaseAnalysisFilter->GetOutputCosPhase());
+    m_FFTForwardPhaseFilter->SetInput(m_MonogenicPhaseAnalysisFilter->GetOutputCosPhase());
 
     m_FFTForwardPhaseFilter->Update();
     modifiedWavelets.push_back(m_FFTForwardPhaseFilter->GetOutput());
@@ -140,6 +141,7 @@ WaveletCoeffsPhaseAnalyzisImageFilter<TImageType, TWaveletFunction>::PrintSelf(s
   os << indent << " OutputIndex: " << this->m_OutputIndex << std::endl;
   os << indent << " ApplySoftThreshold: " << m_ApplySoftThreshold << std::endl;
   os << indent << " ThresholdNumOfSigmas: " << m_ThresholdNumOfSigmas << std::endl;
+  itkPrintSelfObjectMacro(ThresholdEstimator);
 }
 } // end namespace itk
 #endif
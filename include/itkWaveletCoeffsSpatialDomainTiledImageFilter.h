@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletCoeffsSpatialDomainTiledImageFilter_h
+#define itkWaveletCoeffsSpatialDomainTiledImageFilter_h
+
+#include "itkForwardFFTImageFilter.h"
+#include "itkInverseFFTImageFilter.h"
+#include "itkImageBoundaryCondition.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
+#include "itkWaveletFrequencyForwardUndecimated.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkImageToImageFilter.h"
+#include "itkImage.h"
+
+namespace itk
+{
+/** \class WaveletCoeffsSpatialDomainTiledImageFilter
+ * @brief IsotropicWavelet multiscale coefficients, in the spatial domain, of a large input image processed by tiles.
+ *
+ * The FFT of WaveletFrequencyForward requires the whole image. This filter splits the requested region
+ * in tiles of TileSize, pads every tile with an Apron read from the input, and computes the
+ * Forward FFT, WaveletFrequencyForwardUndecimated and InverseFFT of each padded tile independently.
+ * Only the tile without the apron is copied to the outputs. The input requested region is only the
+ * requested region of the outputs plus the aprons, so the filter can be driven by a StreamingImageFilter
+ * to process images that do not fit in memory.
+ *
+ * The FFT of a tile is periodic, the coefficients near the border of a padded tile mix both sides of the tile.
+ * The error at the border of a tile is bounded by the decay of the wavelet kernels at the distance Apron.
+ * The spatial support of the kernels of level l grows as ScaleFactor^l, use an Apron of a few times
+ * 2^Levels to make the error negligible. Out of the input, the aprons are read with the BoundaryCondition,
+ * ZeroFluxNeumannBoundaryCondition by default. Use a PeriodicBoundaryCondition and a single tile to get the
+ * transform of the whole image.
+ *
+ * The tiles are aligned with the largest possible region, independently of the requested region,
+ * so every pixel is always computed from the same padded tile, and the output does not depend on the
+ * number of stream divisions. The padded tiles of all the tiles have the same size,
+ * the size of the tile plus two aprons, enlarged to a size supported by the FFT, see GetPaddedTileSize.
+ * Their filter bank pyramid is generated only once, \sa WaveletFilterBankPyramidCache.
+ *
+ * The coefficients are the ones of the undecimated transform, all the outputs have the
+ * size and information of the input, as in WaveletCoeffsSpatialDomainImageFilter.
+ * Output Layout:
+ * [N - 1]: Low pass residual, also called approximation.
+ * [0,..,HighPassBands): Wavelet coef of first level.
+ * [HighPassBands,..,l*HighPassBands]: Wavelet coef of l level.
+ *
+ * \sa WaveletCoeffsSpatialDomainImageFilter
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+class WaveletCoeffsSpatialDomainTiledImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WaveletCoeffsSpatialDomainTiledImageFilter);
+
+  /** Standard typenames type alias. */
+  using Self = WaveletCoeffsSpatialDomainTiledImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(WaveletCoeffsSpatialDomainTiledImageFilter, ImageToImageFilter);
+
+  /** Inherit types from Superclass. */
+  using InputImageType = typename Superclass::InputImageType;
+  using OutputImageType = typename Superclass::OutputImageType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using RegionType = typename OutputImageType::RegionType;
+  using SizeType = typename OutputImageType::SizeType;
+  using IndexType = typename OutputImageType::IndexType;
+  using OffsetType = typename OutputImageType::OffsetType;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Types of the internal pipeline applied to every padded tile. */
+  using RealType = typename NumericTraits<OutputPixelType>::RealType;
+  using RealImageType = Image<RealType, ImageDimension>;
+  using FFTForwardType = ForwardFFTImageFilter<RealImageType>;
+  using ComplexImageType = typename FFTForwardType::OutputImageType;
+  using WaveletFunctionType = TWaveletFunction;
+  using WaveletFilterBankType = WaveletFrequencyFilterBankGenerator<ComplexImageType, WaveletFunctionType>;
+  using ForwardWaveletType =
+    WaveletFrequencyForwardUndecimated<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+  using InverseFFTType = InverseFFTImageFilter<ComplexImageType, RealImageType>;
+
+  /** Boundary condition used to read the aprons out of the input. */
+  using BoundaryConditionType = ImageBoundaryCondition<InputImageType, RealImageType>;
+  using BoundaryConditionPointerType = BoundaryConditionType *;
+  using DefaultBoundaryConditionType = ZeroFluxNeumannBoundaryCondition<InputImageType, RealImageType>;
+
+  virtual void
+  SetLevels(unsigned int n);
+  itkGetConstReferenceMacro(Levels, unsigned int);
+  virtual void
+  SetHighPassSubBands(unsigned int n);
+  itkGetConstReferenceMacro(HighPassSubBands, unsigned int);
+  itkGetConstReferenceMacro(TotalOutputs, unsigned int);
+
+  /** Size of the tiles, without the apron. Default: 256 per dimension. */
+  itkSetMacro(TileSize, SizeType);
+  itkGetConstReferenceMacro(TileSize, SizeType);
+
+  /** Number of pixels read around each tile, on both sides. Default: 32 per dimension. */
+  itkSetMacro(Apron, SizeType);
+  itkGetConstReferenceMacro(Apron, SizeType);
+
+  /** Boundary condition used to read the aprons out of the largest possible region of the input.
+   * The filter does not take ownership of it. Default: ZeroFluxNeumannBoundaryCondition. */
+  itkSetMacro(BoundaryCondition, BoundaryConditionPointerType);
+  itkGetConstMacro(BoundaryCondition, BoundaryConditionPointerType);
+
+  /** Forward wavelet applied to every padded tile. Use it to set the parameters of the wavelet function
+   * or the filter bank pyramid cache. Levels and HighPassSubBands are set from this filter. */
+  itkGetModifiableObjectMacro(ForwardWaveletFilter, ForwardWaveletType);
+
+  /** Return modifiable pointer to the wavelet function. */
+  virtual WaveletFunctionType *
+  GetModifiableWaveletFunction()
+  {
+    return this->m_ForwardWaveletFilter->GetModifiableWaveletFunction();
+  }
+
+  /** Size of the padded tiles: TileSize + 2 * Apron, enlarged in the upper side to a size
+   * whose prime factors are supported by the FFT. */
+  SizeType
+  GetPaddedTileSize() const;
+
+protected:
+  WaveletCoeffsSpatialDomainTiledImageFilter();
+  ~WaveletCoeffsSpatialDomainTiledImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Request the padded tiles covering the output requested region. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Process the tiles sequentially, the internal filters are multi-threaded. */
+  void
+  GenerateData() override;
+
+  /** Index of the first tile and number of tiles covering region. */
+  void
+  ComputeTiles(const RegionType & region, IndexType & firstTile, SizeType & numberOfTiles) const;
+
+  /** Copy paddedRegion of the input, read with the boundary condition out of the input,
+   * to an image with the same size and a zero start index. */
+  typename RealImageType::Pointer
+  ExtractPaddedTile(const RegionType & paddedRegion) const;
+
+private:
+  unsigned int m_Levels{ 1 };
+  unsigned int m_HighPassSubBands{ 1 };
+  unsigned int m_TotalOutputs{ 2 };
+  SizeType     m_TileSize;
+  SizeType     m_Apron;
+
+  DefaultBoundaryConditionType m_DefaultBoundaryCondition;
+  BoundaryConditionPointerType m_BoundaryCondition{ &m_DefaultBoundaryCondition };
+
+  typename FFTForwardType::Pointer     m_ForwardFFTFilter;
+  typename ForwardWaveletType::Pointer m_ForwardWaveletFilter;
+  typename InverseFFTType::Pointer     m_InverseFFTFilter;
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkWaveletCoeffsSpatialDomainTiledImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,300 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletCoeffsSpatialDomainTiledImageFilter_hxx
+#define itkWaveletCoeffsSpatialDomainTiledImageFilter_hxx
+#include "itkWaveletCoeffsSpatialDomainTiledImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::
+  WaveletCoeffsSpatialDomainTiledImageFilter()
+{
+  m_TileSize.Fill(256);
+  m_Apron.Fill(32);
+
+  m_ForwardFFTFilter = FFTForwardType::New();
+  m_ForwardWaveletFilter = ForwardWaveletType::New();
+  m_InverseFFTFilter = InverseFFTType::New();
+
+  this->SetNumberOfRequiredOutputs(m_TotalOutputs);
+  for (unsigned int n_output = 0; n_output < m_TotalOutputs; ++n_output)
+  {
+    this->SetNthOutput(n_output, this->MakeOutput(n_output));
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+void
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::SetLevels(
+  unsigned int inputLevels)
+{
+  if (this->m_Levels == inputLevels)
+  {
+    return;
+  }
+
+  this->m_Levels = inputLevels;
+  this->m_TotalOutputs = 1 + inputLevels * this->m_HighPassSubBands;
+
+  this->SetNumberOfRequiredOutputs(this->m_TotalOutputs);
+  this->Modified();
+  for (unsigned int n_output = 0; n_output < this->m_TotalOutputs; ++n_output)
+  {
+    this->SetNthOutput(n_output, this->MakeOutput(n_output));
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+void
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::SetHighPassSubBands(
+  unsigned int k)
+{
+  if (this->m_HighPassSubBands == k)
+  {
+    return;
+  }
+  this->m_HighPassSubBands = k;
+  // Trigger setting new outputs via SetLevels
+  const unsigned int levels = this->m_Levels;
+  this->m_Levels = 0;
+  this->SetLevels(levels);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+auto
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::GetPaddedTileSize() const
+  -> SizeType
+{
+  // Same rule as FFTPadImageFilter.
+  const SizeValueType greatestPrimeFactor = m_ForwardFFTFilter->GetSizeGreatestPrimeFactor();
+  SizeType            paddedTileSize;
+  for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+  {
+    SizeValueType size = m_TileSize[axis] + 2 * m_Apron[axis];
+    if (greatestPrimeFactor > 1)
+    {
+      while (Math::GreatestPrimeFactor(size) > greatestPrimeFactor)
+      {
+        ++size;
+      }
+    }
+    else if (greatestPrimeFactor == 1)
+    {
+      size += size % 2;
+    }
+    paddedTileSize[axis] = size;
+  }
+  return paddedTileSize;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+void
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::ComputeTiles(
+  const RegionType & region,
+  IndexType &        firstTile,
+  SizeType &         numberOfTiles) const
+{
+  firstTile.Fill(0);
+  numberOfTiles.Fill(0);
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // The tiles are aligned with the largest possible region.
+  const IndexType largestIndex = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+  for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+  {
+    if (m_TileSize[axis] == 0)
+    {
+      itkExceptionMacro(<< "TileSize must be greater than zero: " << m_TileSize);
+    }
+    const auto            tileSize = static_cast<OffsetValueType>(m_TileSize[axis]);
+    const OffsetValueType start = region.GetIndex(axis) - largestIndex[axis];
+    const OffsetValueType end = start + static_cast<OffsetValueType>(region.GetSize(axis)) - 1;
+    firstTile[axis] = start / tileSize;
+    numberOfTiles[axis] = static_cast<SizeValueType>(end / tileSize - firstTile[axis] + 1);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+void
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+  if (!inputPtr)
+  {
+    itkExceptionMacro(<< "Input has not been set.");
+  }
+
+  IndexType firstTile;
+  SizeType  numberOfTiles;
+  this->ComputeTiles(this->GetOutput()->GetRequestedRegion(), firstTile, numberOfTiles);
+  if (numberOfTiles[0] == 0)
+  {
+    return;
+  }
+
+  // Union of the padded tiles.
+  const SizeType  paddedTileSize = this->GetPaddedTileSize();
+  const IndexType largestIndex = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+  RegionType      paddedTilesRegion;
+  for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+  {
+    paddedTilesRegion.SetIndex(axis,
+                               largestIndex[axis] +
+                                 firstTile[axis] * static_cast<OffsetValueType>(m_TileSize[axis]) -
+                                 static_cast<OffsetValueType>(m_Apron[axis]));
+    paddedTilesRegion.SetSize(axis, (numberOfTiles[axis] - 1) * m_TileSize[axis] + paddedTileSize[axis]);
+  }
+
+  inputPtr->SetRequestedRegion(
+    m_BoundaryCondition->GetInputRequestedRegion(inputPtr->GetLargestPossibleRegion(), paddedTilesRegion));
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+auto
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::ExtractPaddedTile(
+  const RegionType & paddedRegion) const -> typename RealImageType::Pointer
+{
+  const InputImageType * input = this->GetInput();
+
+  auto tile = RealImageType::New();
+  tile->SetRegions(paddedRegion.GetSize());
+  tile->SetSpacing(input->GetSpacing());
+  tile->SetDirection(input->GetDirection());
+  tile->Allocate();
+
+  if (input->GetBufferedRegion().IsInside(paddedRegion))
+  {
+    ImageRegionConstIterator<InputImageType> inputIt(input, paddedRegion);
+    ImageRegionIterator<RealImageType>       tileIt(tile, tile->GetLargestPossibleRegion());
+    for (; !tileIt.IsAtEnd(); ++inputIt, ++tileIt)
+    {
+      tileIt.Set(static_cast<RealType>(inputIt.Get()));
+    }
+  }
+  else
+  {
+    const OffsetType tileOffset = paddedRegion.GetIndex() - IndexType::Filled(0);
+
+    ImageRegionIteratorWithIndex<RealImageType> tileIt(tile, tile->GetLargestPossibleRegion());
+    for (; !tileIt.IsAtEnd(); ++tileIt)
+    {
+      tileIt.Set(m_BoundaryCondition->GetPixel(tileIt.GetIndex() + tileOffset, input));
+    }
+  }
+  return tile;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+void
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const RegionType outputRegion = this->GetOutput()->GetRequestedRegion();
+  IndexType        firstTile;
+  SizeType         numberOfTiles;
+  this->ComputeTiles(outputRegion, firstTile, numberOfTiles);
+
+  const SizeType  paddedTileSize = this->GetPaddedTileSize();
+  const IndexType largestIndex = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+  OffsetType      apronOffset;
+  for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+  {
+    apronOffset[axis] = static_cast<OffsetValueType>(m_Apron[axis]);
+  }
+
+  m_ForwardWaveletFilter->SetHighPassSubBands(this->m_HighPassSubBands);
+  m_ForwardWaveletFilter->SetLevels(this->m_Levels);
+  m_ForwardWaveletFilter->SetInput(m_ForwardFFTFilter->GetOutput());
+
+  SizeValueType totalTiles = 1;
+  for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+  {
+    totalTiles *= numberOfTiles[axis];
+  }
+
+  for (SizeValueType nTile = 0; nTile < totalTiles; ++nTile)
+  {
+    // Start of the tile from its linear index, first axis varying fastest.
+    IndexType     tileStart;
+    SizeValueType remainder = nTile;
+    for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+    {
+      const OffsetValueType tile = firstTile[axis] + static_cast<OffsetValueType>(remainder % numberOfTiles[axis]);
+      remainder /= numberOfTiles[axis];
+      tileStart[axis] = largestIndex[axis] + tile * static_cast<OffsetValueType>(m_TileSize[axis]);
+    }
+    RegionType coreRegion(tileStart, m_TileSize);
+    coreRegion.Crop(outputRegion);
+    const RegionType paddedRegion(tileStart - apronOffset, paddedTileSize);
+    // The padded tile starts at zero.
+    const RegionType coreInTileRegion(IndexType::Filled(0) + (coreRegion.GetIndex() - paddedRegion.GetIndex()),
+                                      coreRegion.GetSize());
+
+    m_ForwardFFTFilter->SetInput(this->ExtractPaddedTile(paddedRegion));
+    for (unsigned int nOutput = 0; nOutput < this->m_TotalOutputs; ++nOutput)
+    {
+      m_InverseFFTFilter->SetInput(m_ForwardWaveletFilter->GetOutput(nOutput));
+      m_InverseFFTFilter->Update();
+
+      ImageRegionConstIterator<RealImageType> tileIt(m_InverseFFTFilter->GetOutput(), coreInTileRegion);
+      ImageRegionIterator<OutputImageType>    outputIt(this->GetOutput(nOutput), coreRegion);
+      for (; !outputIt.IsAtEnd(); ++tileIt, ++outputIt)
+      {
+        outputIt.Set(static_cast<OutputPixelType>(tileIt.Get()));
+      }
+    }
+    this->UpdateProgress(static_cast<float>(nTile + 1) / static_cast<float>(totalTiles));
+  }
+
+  // Do not keep the transform of the last tile.
+  m_ForwardFFTFilter->GetOutput()->ReleaseData();
+  for (unsigned int nOutput = 0; nOutput < this->m_TotalOutputs; ++nOutput)
+  {
+    m_ForwardWaveletFilter->GetOutput(nOutput)->ReleaseData();
+  }
+  m_InverseFFTFilter->GetOutput()->ReleaseData();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFunction>
+void
+WaveletCoeffsSpatialDomainTiledImageFilter<TInputImage, TOutputImage, TWaveletFunction>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << " Levels: " << this->m_Levels << " HighPassSubBands: " << this->m_HighPassSubBands
+     << " TotalOutputs: " << this->m_TotalOutputs << std::endl;
+  os << indent << " TileSize: " << this->m_TileSize << std::endl;
+  os << indent << " Apron: " << this->m_Apron << std::endl;
+  os << indent << " BoundaryCondition: " << this->m_BoundaryCondition->GetNameOfClass() << std::endl;
+  itkPrintSelfObjectMacro(ForwardWaveletFilter);
+}
+} // end namespace itk
+#endif
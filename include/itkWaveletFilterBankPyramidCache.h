@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletFilterBankPyramidCache_h
+#define itkWaveletFilterBankPyramidCache_h
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class WaveletFilterBankPyramidCache
+ * \brief Thread-safe, least recently used cache of the filter bank pyramids of the wavelet transforms.
+ *
+ * The filter bank images of every level of a transform depend only on the size of the input,
+ * the wavelet function and the parameters of the transform. WaveletFrequencyForward, WaveletFrequencyInverse,
+ * WaveletFrequencyForwardUndecimated and WaveletFrequencyInverseUndecimated look up their pyramid in
+ * the cache before generating it, so transforms of many images with the same size generate it only once.
+ *
+ * A process-wide instance is shared by all the transforms with the same filter bank type, \sa GetInstance.
+ * It is the default cache of the filters, set a different cache or nullptr to disable it per filter.
+ *
+ * The pyramids are stored with the layout of WaveletFrequencyForward::GetWaveletFilterBankPyramid,
+ * [low pass, high pass bands...] per level. Find returns new images sharing the buffers of the cached ones,
+ * the pixels must not be modified.
+ *
+ * The least recently used pyramids are removed when there are more than MaximumNumberOfEntries pyramids,
+ * or when they use more than MaximumNumberOfBytes. Pyramids bigger than MaximumNumberOfBytes are not cached.
+ *
+ * The wavelet function is identified by its class name, HighPassSubBands and
+ * IsotropicWaveletFrequencyFunction::GetWaveletParameters.
+ *
+ * \sa WaveletFrequencyFilterBankGenerator
+ *
+ * \ingroup IsotropicWavelets
+ */
+template <typename TWaveletFilterBank>
+class WaveletFilterBankPyramidCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WaveletFilterBankPyramidCache);
+
+  /** Standard type alias */
+  using Self = WaveletFilterBankPyramidCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(WaveletFilterBankPyramidCache, Object);
+
+  /** Filter bank types */
+  using WaveletFilterBankType = TWaveletFilterBank;
+  using ImageType = typename WaveletFilterBankType::OutputImageType;
+  using ImagePointer = typename ImageType::Pointer;
+  using SizeType = typename ImageType::SizeType;
+  using PyramidType = std::vector<ImagePointer>;
+
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  /** Geometry and parameters identifying a filter bank pyramid. */
+  struct KeyType
+  {
+    /** Sizes of the images defining the pyramid, one after the other:
+     * the input of a forward transform, or the input of every level of an inverse transform. */
+    std::vector<SizeValueType> Sizes;
+    std::string                WaveletName;
+    std::vector<double>        WaveletParameters;
+    unsigned int               HighPassSubBands{ 0 };
+    unsigned int               Levels{ 0 };
+    unsigned int               ScaleFactor{ 0 };
+    bool                       InverseBank{ false };
+    bool                       Undecimated{ false };
+    bool                       HalfHermitian{ false };
+    bool                       ActualXDimensionIsOdd{ false };
+    bool                       UseProfileTable{ false };
+    double                     ProfileTableTolerance{ 0 };
+
+    bool
+    operator<(const KeyType & other) const
+    {
+      return std::tie(Sizes,
+                      WaveletName,
+                      WaveletParameters,
+                      HighPassSubBands,
+                      Levels,
+                      ScaleFactor,
+                      InverseBank,
+                      Undecimated,
+                      HalfHermitian,
+                      ActualXDimensionIsOdd,
+                      UseProfileTable,
+                      ProfileTableTolerance) < std::tie(other.Sizes,
+                                                        other.WaveletName,
+                                                        other.WaveletParameters,
+                                                        other.HighPassSubBands,
+                                                        other.Levels,
+                                                        other.ScaleFactor,
+                                                        other.InverseBank,
+                                                        other.Undecimated,
+                                                        other.HalfHermitian,
+                                                        other.ActualXDimensionIsOdd,
+                                                        other.UseProfileTable,
+                                                        other.ProfileTableTolerance);
+    }
+  };
+
+  /** Process-wide cache, used by default in the wavelet transforms. */
+  static Self *
+  GetInstance();
+
+  /** Key of the pyramid generated with the current parameters of filterBank (HighPassSubBands, InverseBank,
+   * HalfHermitian, ActualXDimensionIsOdd, profile table and wavelet function) for a transform of
+   * the given levels and scaleFactor, on images of the given sizes. */
+  static KeyType
+  ComputeKey(WaveletFilterBankType *       filterBank,
+             const std::vector<SizeType> & sizes,
+             const unsigned int &          levels,
+             const unsigned int &          scaleFactor,
+             const bool &                  undecimated);
+
+  /** Get the cached pyramid of key, as new images sharing the buffers of the cached ones.
+   * Return false, leaving pyramid unchanged, if the key is not cached. */
+  bool
+  Find(const KeyType & key, PyramidType & pyramid);
+
+  /** Cache the pyramid with the key, replacing any pyramid with the same key.
+   * The cache keeps its own images, sharing the buffers of the ones in pyramid. */
+  void
+  Insert(const KeyType & key, const PyramidType & pyramid);
+
+  /** True if Insert would keep a pyramid of numberOfBytes. The transforms check it before keeping the filter banks
+   * of all the levels on a miss, so pyramids that cannot be cached are generated one level at a time. */
+  bool
+  CanInsert(const SizeValueType & numberOfBytes) const;
+
+  /** Remove all the pyramids. */
+  void
+  Clear();
+
+  /** Maximum number of cached pyramids. 0 disables the cache. Default: 16 */
+  SizeValueType
+  GetMaximumNumberOfEntries() const;
+  void
+  SetMaximumNumberOfEntries(const SizeValueType & maximumNumberOfEntries);
+
+  /** Maximum memory used by the cached pyramids. Default: 256 MiB */
+  SizeValueType
+  GetMaximumNumberOfBytes() const;
+  void
+  SetMaximumNumberOfBytes(const SizeValueType & maximumNumberOfBytes);
+
+  /** Number of cached pyramids. */
+  SizeValueType
+  GetNumberOfEntries() const;
+
+  /** Memory used by the cached pyramids. */
+  SizeValueType
+  GetNumberOfBytes() const;
+
+  /** Number of calls to Find that found / did not find the key. */
+  SizeValueType
+  GetNumberOfHits() const;
+  SizeValueType
+  GetNumberOfMisses() const;
+
+protected:
+  WaveletFilterBankPyramidCache() = default;
+  ~WaveletFilterBankPyramidCache() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Image sharing the buffer and information of image. */
+  static ImagePointer
+  ShallowCopy(const ImageType * image);
+
+  /** Remove the least recently used pyramids until the bounds are met. The mutex has to be locked. */
+  void
+  Evict();
+
+private:
+  struct EntryType
+  {
+    KeyType       Key;
+    PyramidType   Pyramid;
+    SizeValueType NumberOfBytes;
+  };
+  using EntriesType = std::list<EntryType>;
+
+  SizeValueType m_MaximumNumberOfEntries{ 16 };
+  SizeValueType m_MaximumNumberOfBytes{ 256 * 1024 * 1024 };
+  SizeValueType m_NumberOfBytes{ 0 };
+  SizeValueType m_NumberOfHits{ 0 };
+  SizeValueType m_NumberOfMisses{ 0 };
+  /** Most recently used first. */
+  EntriesType                                       m_Entries;
+  std::map<KeyType, typename EntriesType::iterator> m_EntryIndex;
+  mutable std::mutex                                m_Mutex;
+};
+} // end namespace itk
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkWaveletFilterBankPyramidCache.hxx"
+#endif
+
+#endif
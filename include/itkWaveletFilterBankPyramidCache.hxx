@@ -0,0 +1,256 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWaveletFilterBankPyramidCache_hxx
+#define itkWaveletFilterBankPyramidCache_hxx
+#include "itkWaveletFilterBankPyramidCache.h"
+
+namespace itk
+{
+template <typename TWaveletFilterBank>
+void
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  os << indent << "MaximumNumberOfEntries: " << this->m_MaximumNumberOfEntries << std::endl;
+  os << indent << "MaximumNumberOfBytes: " << this->m_MaximumNumberOfBytes << std::endl;
+  os << indent << "NumberOfEntries: " << this->m_Entries.size() << std::endl;
+  os << indent << "NumberOfBytes: " << this->m_NumberOfBytes << std::endl;
+  os << indent << "NumberOfHits: " << this->m_NumberOfHits << std::endl;
+  os << indent << "NumberOfMisses: " << this->m_NumberOfMisses << std::endl;
+}
+
+template <typename TWaveletFilterBank>
+typename WaveletFilterBankPyramidCache<TWaveletFilterBank>::Self *
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::GetInstance()
+{
+  // Initialization of local statics is thread safe.
+  static const Pointer instance = Self::New();
+  return instance.GetPointer();
+}
+
+template <typename TWaveletFilterBank>
+typename WaveletFilterBankPyramidCache<TWaveletFilterBank>::KeyType
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::ComputeKey(WaveletFilterBankType *       filterBank,
+                                                              const std::vector<SizeType> & sizes,
+                                                              const unsigned int &          levels,
+                                                              const unsigned int &          scaleFactor,
+                                                              const bool &                  undecimated)
+{
+  KeyType key;
+  for (const auto & size : sizes)
+  {
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      key.Sizes.push_back(size[dim]);
+    }
+  }
+  const auto * waveletFunction = filterBank->GetWaveletFunction();
+  key.WaveletName = waveletFunction->GetNameOfClass();
+  key.WaveletParameters = waveletFunction->GetWaveletParameters();
+  key.HighPassSubBands = filterBank->GetHighPassSubBands();
+  key.Levels = levels;
+  key.ScaleFactor = scaleFactor;
+  key.InverseBank = filterBank->GetInverseBank();
+  key.Undecimated = undecimated;
+  key.HalfHermitian = filterBank->GetHalfHermitian();
+  key.ActualXDimensionIsOdd = key.HalfHermitian && filterBank->GetActualXDimensionIsOdd();
+  key.UseProfileTable = filterBank->GetUseProfileTable();
+  key.ProfileTableTolerance = key.UseProfileTable ? filterBank->GetProfileTableTolerance() : 0.0;
+  return key;
+}
+
+template <typename TWaveletFilterBank>
+typename WaveletFilterBankPyramidCache<TWaveletFilterBank>::ImagePointer
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::ShallowCopy(const ImageType * image)
+{
+  ImagePointer copy = ImageType::New();
+  copy->Graft(image);
+  return copy;
+}
+
+template <typename TWaveletFilterBank>
+bool
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::Find(const KeyType & key, PyramidType & pyramid)
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  auto                        indexIt = this->m_EntryIndex.find(key);
+  if (indexIt == this->m_EntryIndex.end())
+  {
+    ++this->m_NumberOfMisses;
+    return false;
+  }
+  ++this->m_NumberOfHits;
+  // Move the entry to the front, the iterators of the list remain valid.
+  this->m_Entries.splice(this->m_Entries.begin(), this->m_Entries, indexIt->second);
+
+  pyramid.clear();
+  pyramid.reserve(indexIt->second->Pyramid.size());
+  for (const auto & image : indexIt->second->Pyramid)
+  {
+    pyramid.push_back(Self::ShallowCopy(image));
+  }
+  return true;
+}
+
+template <typename TWaveletFilterBank>
+void
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::Insert(const KeyType & key, const PyramidType & pyramid)
+{
+  EntryType entry;
+  entry.Key = key;
+  entry.NumberOfBytes = 0;
+  entry.Pyramid.reserve(pyramid.size());
+  for (const auto & image : pyramid)
+  {
+    entry.Pyramid.push_back(Self::ShallowCopy(image));
+    entry.NumberOfBytes += image->GetPixelContainer()->Size() * sizeof(typename ImageType::PixelType);
+  }
+
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  auto                        indexIt = this->m_EntryIndex.find(key);
+  if (indexIt != this->m_EntryIndex.end())
+  {
+    this->m_NumberOfBytes -= indexIt->second->NumberOfBytes;
+    this->m_Entries.erase(indexIt->second);
+    this->m_EntryIndex.erase(indexIt);
+  }
+  if (this->m_MaximumNumberOfEntries == 0 || entry.NumberOfBytes > this->m_MaximumNumberOfBytes)
+  {
+    return;
+  }
+  this->m_NumberOfBytes += entry.NumberOfBytes;
+  this->m_Entries.push_front(std::move(entry));
+  this->m_EntryIndex[key] = this->m_Entries.begin();
+  this->Evict();
+}
+
+template <typename TWaveletFilterBank>
+bool
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::CanInsert(const SizeValueType & numberOfBytes) const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_MaximumNumberOfEntries > 0 && numberOfBytes <= this->m_MaximumNumberOfBytes;
+}
+
+template <typename TWaveletFilterBank>
+void
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::Evict()
+{
+  while (!this->m_Entries.empty() && (this->m_Entries.size() > this->m_MaximumNumberOfEntries ||
+                                      this->m_NumberOfBytes > this->m_MaximumNumberOfBytes))
+  {
+    this->m_NumberOfBytes -= this->m_Entries.back().NumberOfBytes;
+    this->m_EntryIndex.erase(this->m_Entries.back().Key);
+    this->m_Entries.pop_back();
+  }
+}
+
+template <typename TWaveletFilterBank>
+void
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  this->m_Entries.clear();
+  this->m_EntryIndex.clear();
+  this->m_NumberOfBytes = 0;
+}
+
+template <typename TWaveletFilterBank>
+SizeValueType
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::GetMaximumNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_MaximumNumberOfEntries;
+}
+
+template <typename TWaveletFilterBank>
+void
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::SetMaximumNumberOfEntries(
+  const SizeValueType & maximumNumberOfEntries)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->m_Mutex);
+    if (this->m_MaximumNumberOfEntries == maximumNumberOfEntries)
+    {
+      return;
+    }
+    this->m_MaximumNumberOfEntries = maximumNumberOfEntries;
+    this->Evict();
+  }
+  this->Modified();
+}
+
+template <typename TWaveletFilterBank>
+SizeValueType
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::GetMaximumNumberOfBytes() const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_MaximumNumberOfBytes;
+}
+
+template <typename TWaveletFilterBank>
+void
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::SetMaximumNumberOfBytes(const SizeValueType & maximumNumberOfBytes)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->m_Mutex);
+    if (this->m_MaximumNumberOfBytes == maximumNumberOfBytes)
+    {
+      return;
+    }
+    this->m_MaximumNumberOfBytes = maximumNumberOfBytes;
+    this->Evict();
+  }
+  this->Modified();
+}
+
+template <typename TWaveletFilterBank>
+SizeValueType
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return static_cast<SizeValueType>(this->m_Entries.size());
+}
+
+template <typename TWaveletFilterBank>
+SizeValueType
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::GetNumberOfBytes() const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_NumberOfBytes;
+}
+
+template <typename TWaveletFilterBank>
+SizeValueType
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::GetNumberOfHits() const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_NumberOfHits;
+}
+
+template <typename TWaveletFilterBank>
+SizeValueType
+WaveletFilterBankPyramidCache<TWaveletFilterBank>::GetNumberOfMisses() const
+{
+  std::lock_guard<std::mutex> lock(this->m_Mutex);
+  return this->m_NumberOfMisses;
+}
+} // end namespace itk
+#endif
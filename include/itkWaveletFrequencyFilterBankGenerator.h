@@ -22,6 +22,7 @@
 #include <complex>
 #include <itkGenerateImageSource.h>
 #include <itkFrequencyFFTLayoutImageRegionIteratorWithIndex.h>
+#include <itkIsotropicWaveletProfileTableCache.h>
 
 namespace itk
 {
@@ -40,6 +41,16 @@ namespace itk
  * where SubBand can be: LowPass, HighPass, or any HighPassSubBand.
  * Also accepts a template FrequencyIterator, to generate images with different frequency layouts.
  *
+ * If UseProfileTable is on, the sub-bands are interpolated from a table of the radial profiles
+ * of the wavelet function, \sa IsotropicWaveletProfileTable. The table of level 0 is evaluated at
+ * LevelFactor^2 * w^2 for every level, and it is shared with the other filter banks through
+ * a thread-safe cache, \sa IsotropicWaveletProfileTableCache.
+ *
+ * If HalfHermitian is on, Size is the size of the half-Hermitian layout of
+ * RealToHalfHermitianForwardFFTImageFilter, and the outputs are the first half of the filter bank of the full
+ * spectrum, whose first dimension is given by ActualXDimensionIsOdd. The frequency iterator is only used to walk
+ * the outputs in this case.
+ *
  * \sa WaveletFrequencyForward
  * \sa FrequencyFunction
  * \sa IsotropicWaveletFrequencyFunction
@@ -77,6 +88,11 @@ public:
   using WaveletFunctionType = TWaveletFunction;
   using WaveletFunctionPointer = typename WaveletFunctionType::Pointer;
   using FunctionValueType = typename WaveletFunctionType::FunctionValueType;
+  /** ProfileTable types */
+  using ProfileTableType = IsotropicWaveletProfileTable<WaveletFunctionType>;
+  using ProfileTablePointer = typename ProfileTableType::Pointer;
+  using ProfileTableConstPointer = typename ProfileTableType::ConstPointer;
+  using ProfileTableCacheType = IsotropicWaveletProfileTableCache<WaveletFunctionType>;
 
   using OutputsType = typename std::vector<OutputImagePointer>;
   // using OutputsType = typename itk::VectorContainer<int, OutputImagePointer>;
@@ -106,6 +122,46 @@ public:
     this->Modified();
   }
 
+  /** ScaleFactor^Level, the wavelet function is evaluated at LevelFactor * w. */
+  itkGetConstMacro(LevelFactor, double);
+
+  /** Flag to evaluate the sub-bands from a table of the radial profiles of the wavelet function,
+   * instead of evaluating the wavelet function per pixel.
+   * If the table does not reach ProfileTableTolerance (i.e for discontinuous profiles) the
+   * wavelet function is evaluated directly.
+   * Default: false. */
+  itkGetConstMacro(UseProfileTable, bool);
+  itkSetMacro(UseProfileTable, bool);
+  itkBooleanMacro(UseProfileTable);
+
+  /** Maximum interpolation error of the profile table. Default: 1e-6 */
+  itkGetConstMacro(ProfileTableTolerance, double);
+  itkSetMacro(ProfileTableTolerance, double);
+
+  /** Cache of the profile tables.
+   * Default: the process-wide cache \sa IsotropicWaveletProfileTableCache::GetInstance.
+   * Set to nullptr to compute the table in every update. */
+  itkSetObjectMacro(ProfileTableCache, ProfileTableCacheType);
+  itkGetModifiableObjectMacro(ProfileTableCache, ProfileTableCacheType);
+
+  /** Profile table of level 0 of the current InverseBank and HighPassSubBands, to be evaluated at
+   * LevelFactor^2 * w^2 for frequency modulo squares w^2 up to maximumFrequencyModuloSquare.
+   * It is computed only if there is no valid table in the cache.
+   * Returns nullptr if the table does not reach ProfileTableTolerance.
+   * The table is valid until the next call. Not thread safe, call it before any threaded section. */
+  const ProfileTableType *
+  GetProfileTable(const double & maximumFrequencyModuloSquare);
+
+  /** Flag to generate the filter bank in the half-Hermitian layout. Default: false. */
+  itkGetConstMacro(HalfHermitian, bool);
+  itkSetMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+
+  /** The size of the first dimension of the full spectrum is odd. Only used with HalfHermitian. Default: false. */
+  itkGetConstMacro(ActualXDimensionIsOdd, bool);
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
   /** Get pointer to the instance of the wavelet function in order to access and change wavelet parameters */
   itkGetModifiableObjectMacro(WaveletFunction, WaveletFunctionType);
 
@@ -153,6 +209,20 @@ private:
   unsigned int m_ScaleFactor{ 2 };
   /** m_ScaleFactor^m_Level */
   double m_LevelFactor{ 1 };
+
+  bool   m_UseProfileTable{ false };
+  double m_ProfileTableTolerance{ 1e-6 };
+
+  typename ProfileTableCacheType::Pointer m_ProfileTableCache;
+  /** Table returned by the last call to GetProfileTable, kept alive if the cache replaces it */
+  ProfileTableConstPointer m_ProfileTable;
+  /** Profile table used in the current update, nullptr if the wavelet function is evaluated directly */
+  const ProfileTableType * m_CurrentProfileTable{ nullptr };
+
+  bool m_HalfHermitian{ false };
+  bool m_ActualXDimensionIsOdd{ false };
+  /** Frequency modulo square per dimension of the half-Hermitian layout, computed before the threaded section. */
+  std::vector<std::vector<double>> m_HalfHermitianFrequencyModuloSquare;
 }; // end of class
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
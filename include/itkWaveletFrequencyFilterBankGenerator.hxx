@@ -19,6 +19,7 @@
 #define itkWaveletFrequencyFilterBankGenerator_hxx
 #include "itkWaveletFrequencyFilterBankGenerator.h"
 #include "itkNumericTraits.h"
+#include "itkWaveletUtilities.h"
 
 namespace itk
 {
@@ -30,6 +31,7 @@ WaveletFrequencyFilterBankGenerator<TOutputImage, TWaveletFunction, TFrequencyRe
 {
   this->SetHighPassSubBands(1);
   m_WaveletFunction = TWaveletFunction::New();
+  m_ProfileTableCache = ProfileTableCacheType::GetInstance();
 }
 
 template <typename TOutputImage, typename TWaveletFunction, typename TFrequencyRegionIterator>
@@ -62,6 +64,44 @@ WaveletFrequencyFilterBankGenerator<TOutputImage, TWaveletFunction, TFrequencyRe
   os << indent << "HighPassSubBands: " << this->m_HighPassSubBands << indent
      << "InverseBank: " << (this->m_InverseBank ? "true" : "false") << indent << "Level: " << this->m_Level << indent
      << "LevelFactor: " << this->m_LevelFactor << std::endl;
+  os << indent << "UseProfileTable: " << (this->m_UseProfileTable ? "true" : "false") << std::endl;
+  os << indent << "ProfileTableTolerance: " << this->m_ProfileTableTolerance << std::endl;
+  itkPrintSelfObjectMacro(ProfileTableCache);
+  os << indent << "HalfHermitian: " << (this->m_HalfHermitian ? "true" : "false") << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << (this->m_ActualXDimensionIsOdd ? "true" : "false") << std::endl;
+}
+
+template <typename TOutputImage, typename TWaveletFunction, typename TFrequencyRegionIterator>
+const typename WaveletFrequencyFilterBankGenerator<TOutputImage, TWaveletFunction, TFrequencyRegionIterator>::
+  ProfileTableType *
+  WaveletFrequencyFilterBankGenerator<TOutputImage, TWaveletFunction, TFrequencyRegionIterator>::GetProfileTable(
+    const double & maximumFrequencyModuloSquare)
+{
+  this->m_WaveletFunction->SetHighPassSubBands(this->m_HighPassSubBands);
+
+  // The profiles of the level are the ones of level 0 at LevelFactor * w.
+  const double levelMaximumFrequencyModuloSquare =
+    this->m_LevelFactor * this->m_LevelFactor * maximumFrequencyModuloSquare;
+  if (this->m_ProfileTableCache.IsNotNull())
+  {
+    this->m_ProfileTable = this->m_ProfileTableCache->GetProfileTable(
+      this->m_WaveletFunction, this->m_InverseBank, this->m_ProfileTableTolerance, levelMaximumFrequencyModuloSquare);
+  }
+  else
+  {
+    auto table = ProfileTableType::New();
+    table->SetInverseBank(this->m_InverseBank);
+    table->SetTolerance(this->m_ProfileTableTolerance);
+    table->SetMaximumFrequencyModuloSquare(levelMaximumFrequencyModuloSquare);
+    table->Compute(this->m_WaveletFunction);
+    this->m_ProfileTable = table.GetPointer();
+  }
+
+  if (!this->m_ProfileTable->GetIsWithinTolerance())
+  {
+    return nullptr;
+  }
+  return this->m_ProfileTable.GetPointer();
 }
 
 /* ******* Get Outputs *****/
@@ -136,6 +176,38 @@ WaveletFrequencyFilterBankGenerator<TOutputImage, TWaveletFunction, TFrequencyRe
     outputPtr->Allocate();
     outputPtr->FillBuffer(0);
   }
+
+  this->m_WaveletFunction->SetHighPassSubBands(this->m_HighPassSubBands);
+
+  this->m_CurrentProfileTable = nullptr;
+  if (this->m_UseProfileTable)
+  {
+    // The highest frequency per dimension is 1/(2*spacing).
+    double maximumFrequencyModuloSquare = 0;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const double maximumFrequency = 0.5 / firstOutput->GetSpacing()[dim];
+      maximumFrequencyModuloSquare += maximumFrequency * maximumFrequency;
+    }
+    this->m_CurrentProfileTable = this->GetProfileTable(maximumFrequencyModuloSquare);
+  }
+
+  this->m_HalfHermitianFrequencyModuloSquare.clear();
+  if (this->m_HalfHermitian)
+  {
+    const typename OutputImageType::SizeType halfSize = firstOutput->GetLargestPossibleRegion().GetSize();
+    this->m_HalfHermitianFrequencyModuloSquare = itk::utils::ComputeFrequencyPerDimension<ImageDimension>(
+      halfSize,
+      itk::utils::ComputeFullSizeFromHalfHermitianSize(halfSize, this->m_ActualXDimensionIsOdd),
+      firstOutput->GetSpacing());
+    for (auto & frequencyPerDimension : this->m_HalfHermitianFrequencyModuloSquare)
+    {
+      for (auto & frequency : frequencyPerDimension)
+      {
+        frequency *= frequency;
+      }
+    }
+  }
 }
 
 template <typename TOutputImage, typename TWaveletFunction, typename TFrequencyRegionIterator>
@@ -143,8 +215,6 @@ void
 WaveletFrequencyFilterBankGenerator<TOutputImage, TWaveletFunction, TFrequencyRegionIterator>::
   DynamicThreadedGenerateData(const OutputImageRegionType & threadRegion)
 {
-  this->m_WaveletFunction->SetHighPassSubBands(this->m_HighPassSubBands);
-
   // Init iterators for all outputs.
   std::vector<OutputRegionIterator> outputItList;
   for (unsigned int comp = 0; comp < this->GetNumberOfOutputs(); ++comp)
@@ -159,9 +229,45 @@ WaveletFrequencyFilterBankGenerator<TOutputImage, TWaveletFunction, TFrequencyRe
   FunctionValueType w(0);
   // Iterator to calculate frequency modulo only once (optimization)
   OutputRegionIterator frequencyIt(firstOutput, threadRegion);
+  // In the half-Hermitian layout the frequency is computed from the index, not from the iterator.
+  const std::vector<std::vector<double>> &  halfHermitianW2 = this->m_HalfHermitianFrequencyModuloSquare;
+  const typename OutputImageType::IndexType startIndex = firstOutput->GetLargestPossibleRegion().GetIndex();
+
+  const auto computeFrequencyModuloSquare = [&halfHermitianW2, &startIndex](const OutputRegionIterator & it) {
+    if (halfHermitianW2.empty())
+    {
+      return static_cast<double>(it.GetFrequencyModuloSquare());
+    }
+    const typename OutputImageType::IndexType index = it.GetIndex();
+    double                                    w2 = 0;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      w2 += halfHermitianW2[dim][index[dim] - startIndex[dim]];
+    }
+    return w2;
+  };
+
+  if (this->m_CurrentProfileTable)
+  {
+    const double                   levelFactorSquare = this->m_LevelFactor * this->m_LevelFactor;
+    std::vector<FunctionValueType> evaluatedSubBands(m_HighPassSubBands + 1);
+    for (frequencyIt.GoToBegin(); !frequencyIt.IsAtEnd(); ++frequencyIt)
+    {
+      this->m_CurrentProfileTable->EvaluateSubBands(levelFactorSquare * computeFrequencyModuloSquare(frequencyIt),
+                                                    evaluatedSubBands.data());
+      for (unsigned int l = 0; l < m_HighPassSubBands + 1; ++l)
+      {
+        outputItList[l].Set(outputItList[l].Get() +
+                            static_cast<typename OutputImageType::PixelType::value_type>(evaluatedSubBands[l]));
+        ++outputItList[l];
+      }
+    }
+    return;
+  }
+
   for (frequencyIt.GoToBegin(); !frequencyIt.IsAtEnd(); ++frequencyIt)
   {
-    w = static_cast<FunctionValueType>(sqrt(frequencyIt.GetFrequencyModuloSquare()));
+    w = static_cast<FunctionValueType>(sqrt(computeFrequencyModuloSquare(frequencyIt)));
 
     FunctionValueType evaluatedSubBand;
     // l = 0 is low pass filter, l = m_HighPassSubBands is high-pass filter.
@@ -26,6 +26,7 @@
 #include <itkImageToImageFilter.h>
 #include <itkFrequencyShrinkImageFilter.h>
 #include <itkFrequencyShrinkViaInverseFFTImageFilter.h>
+#include <itkWaveletFilterBankPyramidCache.h>
 
 namespace itk
 {
@@ -37,6 +38,8 @@ namespace itk
  * [0,..,HighPassBands): Wavelet coef of first level.
  * [HighPassBands,..,l*HighPassBands]: Wavelet coef of l level.
  *
+ * The input can be in the half-Hermitian layout of RealToHalfHermitianForwardFFTImageFilter, \sa HalfHermitian.
+ *
  * @note The information/metadata of input image is ignored.
  * It can be restored after reconstruction @sa WaveletFrequencyInverse
  * with a @sa ChangeInformationFilter using the input image as a reference.
@@ -80,6 +83,8 @@ public:
 
   using FrequencyShrinkFilterType = TFrequencyShrinkFilterType;
 
+  using WaveletFilterBankPyramidCacheType = WaveletFilterBankPyramidCache<WaveletFilterBankType>;
+
   /** ImageDimension constants */
   static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
 
@@ -120,6 +125,116 @@ public:
 
   itkGetMacro(WaveletFilterBankPyramid, OutputsType);
 
+  /** Cache of filter bank pyramids, looked up before generating the filter banks of the levels, and
+   * filled with them on a miss if the pyramid fits in the cache, \sa WaveletFilterBankPyramidCache::CanInsert.
+   * Otherwise the filter bank of each level is generated when it is used and released after it.
+   * The images of a cached pyramid share their buffers with the cache.
+   * Default: the process-wide cache \sa WaveletFilterBankPyramidCache::GetInstance.
+   * Set to nullptr to always generate the filter banks. Not used with UseVirtualFilterBank. */
+  itkSetObjectMacro(WaveletFilterBankPyramidCache, WaveletFilterBankPyramidCacheType);
+  itkGetModifiableObjectMacro(WaveletFilterBankPyramidCache, WaveletFilterBankPyramidCacheType);
+
+  /** Flag to use the fused engine in GenerateData.
+   * Each level is computed with one multi-threaded sweep over the input of the level:
+   * the high pass outputs are written directly, and the low pass is accumulated
+   * into the shrunk image of the next level, avoiding the intermediate images of
+   * the multiply and frequency shrink filters.
+   * The result is the same than the default pipeline, that uses FrequencyShrinkImageFilter.
+   * Default: false. */
+  itkSetMacro(UseFusedKernel, bool);
+  itkGetConstReferenceMacro(UseFusedKernel, bool);
+  itkBooleanMacro(UseFusedKernel);
+
+  /** Flag to use a virtual filter bank: the masks are evaluated on the fly from the
+   * frequency modulo of each bin inside the fused engine, so the HighPassSubBands + 1
+   * images of the WaveletFilterBank are never allocated.
+   * Implies the fused engine \sa UseFusedKernel. Not compatible with StoreWaveletFilterBankPyramid.
+   * If the WaveletFilterBank has UseProfileTable on, the masks are interpolated from its profile table.
+   * Default: false. */
+  itkSetMacro(UseVirtualFilterBank, bool);
+  itkGetConstReferenceMacro(UseVirtualFilterBank, bool);
+  itkBooleanMacro(UseVirtualFilterBank);
+
+  /** Flag to use the half-Hermitian layout of RealToHalfHermitianForwardFFTImageFilter,
+   * for the spectrum of real images. The input and all the outputs store only the
+   * bins 0 to N/2 of the first dimension, halving memory and time.
+   * The outputs are the first half of the outputs computed with the full spectrum,
+   * use ActualXDimensionIsOdd if the first dimension of the full spectrum of the input is odd.
+   * The filter bank is generated per level in this layout, instead of decimated, it is equal to
+   * the decimated one when the sizes are divisible by the scale factor at every level.
+   * Default: false. */
+  itkSetMacro(HalfHermitian, bool);
+  itkGetConstReferenceMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+
+  /** The size of the first dimension of the full spectrum of the input is odd. Only used with HalfHermitian.
+   * Default: false. */
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkGetConstReferenceMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
+  /** Flag to generate only the outputs that are requested downstream, for example with
+   * GetOutput(k)->Update(). Only the low pass chain up to the level of the requested outputs is computed,
+   * the outputs not requested are left without buffer. The outputs generated in previous updates are kept
+   * while neither the filter nor its input are modified.
+   * With StoreWaveletFilterBankPyramid, only the filter banks up to the last computed level are stored,
+   * and the pyramid is not inserted in the WaveletFilterBankPyramidCache if it is incomplete.
+   * Note that Update() on the filter updates only its first output.
+   * Default: false. */
+  itkSetMacro(GenerateOnlyRequestedOutputs, bool);
+  itkGetConstReferenceMacro(GenerateOnlyRequestedOutputs, bool);
+  itkBooleanMacro(GenerateOnlyRequestedOutputs);
+
+  /** Strategies of GenerateData, ordered from the fastest to the one with the lowest peak memory.
+   * FilterBankPipeline: multiply and frequency shrink filters with the filter bank images.
+   * FusedKernel: fused engine with the filter bank images, \sa UseFusedKernel.
+   * FusedKernelWithoutCache: fused engine, the filter bank of each level is released after use
+   * instead of being kept in the WaveletFilterBankPyramidCache.
+   * VirtualFilterBank: fused engine without filter bank images, \sa UseVirtualFilterBank. */
+  enum class ExecutionStrategy : uint8_t
+  {
+    FilterBankPipeline,
+    FusedKernel,
+    FusedKernelWithoutCache,
+    VirtualFilterBank
+  };
+
+  /** Memory budget in bytes for GenerateData. If it is not zero, the strategy requested with UseFusedKernel and
+   * UseVirtualFilterBank is replaced with the first leaner strategy whose predicted peak fits in the budget,
+   * and an exception is thrown before allocating the outputs if none fits.
+   * Default: 0, no budget. \sa PlanExecution */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstReferenceMacro(MemoryBudget, SizeValueType);
+
+  /** Strategy and predicted peak bytes chosen by the last PlanExecution. */
+  itkGetConstReferenceMacro(ExecutionStrategy, ExecutionStrategy);
+  itkGetConstReferenceMacro(PredictedPeakBytes, SizeValueType);
+
+  /** Peak bytes of the distinct image buffers held by the filter in the last GenerateData: outputs, input of
+   * the level, shrunk low pass, filter bank images and stored or cached pyramid. It is sampled after each level
+   * and after the filter bank of each level is generated. */
+  itkGetConstReferenceMacro(MeasuredPeakBytes, SizeValueType);
+
+  /** Upper bound of the bytes of the image buffers held at the same time by GenerateData with the strategy.
+   * Requires the output information, \sa UpdateOutputInformation. */
+  SizeValueType
+  ComputePredictedPeakBytes(ExecutionStrategy strategy) const;
+
+  /** Bytes of the filter bank pyramid of all the levels, [low pass, high pass bands...] per level.
+   * Requires the output information. */
+  SizeValueType
+  ComputeWaveletFilterBankPyramidBytes() const;
+
+  /** Choose the ExecutionStrategy for the MemoryBudget and set PredictedPeakBytes. Called by GenerateData,
+   * it can be called after UpdateOutputInformation to query the plan before running the filter. */
+  void
+  PlanExecution();
+
+  /** Size of the full spectrum of the input of the level. With HalfHermitian it is computed
+   * from the size of the input and ActualXDimensionIsOdd. */
+  typename InputImageType::SizeType
+  ComputeFullSizePerLevel(unsigned int level) const;
+
   /** Compute max number of levels depending on the size of the image.
    * Return J: $ J = \text{min_element}\{J_0,\ldots, J_d\} $;
    * where each $J_i$ is the  number of integer divisions that can be done with the $i$ size and the scale factor.
@@ -192,6 +307,31 @@ protected:
   void
   GenerateInputRequestedRegion() override;
 
+  /** With GenerateOnlyRequestedOutputs, prepare only the outputs that are requested, or that are not up to date.
+   * \sa ProcessObject::PrepareOutputs() */
+  void
+  PrepareOutputs() override;
+
+  /** Fused analysis of one level, used when UseFusedKernel or UseVirtualFilterBank are on.
+   * Write the high pass outputs of the level and return the shrunk low pass, input of the next level.
+   * In the last level the low pass output is returned.
+   * Only the requested high pass outputs of the level are written, and the low pass is not computed
+   * (nullptr is returned) if computeLowPass is false.
+   * The filter bank images are not used (and can be null) with UseVirtualFilterBank.
+   * With HalfHermitian, the high pass outputs are computed in a first sweep, and the shrunk low pass
+   * gathers its aliased bins in a second sweep, reading the bins not stored from their hermitian mirror. */
+  OutputImagePointer
+  FusedAnalysisPerLevel(unsigned int            level,
+                        const OutputImageType * inputPerLevel,
+                        const OutputImageType * lowPassWavelet,
+                        const OutputsType &     highPassWavelets,
+                        bool                    computeLowPass);
+
+  /** Add the bytes of the distinct buffers of the outputs, the stored pyramid, the outputs of the
+   * WaveletFilterBank and the images to update MeasuredPeakBytes. */
+  void
+  SampleMemoryUsage(const OutputsType & images);
+
 private:
   unsigned int             m_Levels{ 1 };
   unsigned int             m_HighPassSubBands{ 1 };
@@ -200,6 +340,20 @@ private:
   WaveletFilterBankPointer m_WaveletFilterBank;
   bool                     m_StoreWaveletFilterBankPyramid{ false };
   OutputsType              m_WaveletFilterBankPyramid;
+  bool                     m_UseFusedKernel{ false };
+  bool                     m_UseVirtualFilterBank{ false };
+  bool                     m_HalfHermitian{ false };
+  bool                     m_ActualXDimensionIsOdd{ false };
+  SizeValueType            m_MemoryBudget{ 0 };
+  ExecutionStrategy        m_ExecutionStrategy{ ExecutionStrategy::FilterBankPipeline };
+  SizeValueType            m_PredictedPeakBytes{ 0 };
+  SizeValueType            m_MeasuredPeakBytes{ 0 };
+  bool                     m_GenerateOnlyRequestedOutputs{ false };
+  /** Outputs to compute in the next GenerateData. */
+  std::vector<bool> m_RequestedOutputs;
+  ModifiedTimeType  m_GeneratedOutputsMTime{ 0 };
+
+  typename WaveletFilterBankPyramidCacheType::Pointer m_WaveletFilterBankPyramidCache;
 };
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
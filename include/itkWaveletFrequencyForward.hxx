@@ -21,10 +21,12 @@
 #include <itkCastImageFilter.h>
 #include <itkImage.h>
 #include <algorithm>
+#include <set>
 #include <itkMultiplyImageFilter.h>
 #include <itkShrinkDecimateImageFilter.h>
 #include <itkChangeInformationImageFilter.h>
 #include <itkWaveletUtilities.h>
+#include <itkImageRegionIndexRange.h>
 
 namespace itk
 {
@@ -36,6 +38,7 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
 {
   this->SetNumberOfRequiredInputs(1);
   m_WaveletFilterBank = WaveletFilterBankType::New();
+  m_WaveletFilterBankPyramidCache = WaveletFilterBankPyramidCacheType::GetInstance();
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
@@ -70,6 +73,35 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   return outputPtrs;
 }
 
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
+void
+WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::PrepareOutputs()
+{
+  if (!this->m_GenerateOnlyRequestedOutputs)
+  {
+    Superclass::PrepareOutputs();
+    return;
+  }
+
+  // The outputs generated in a previous update are kept if neither the filter nor its input have changed since then.
+  const InputImageType * input = this->GetInput();
+  const ModifiedTimeType outputsMTime = std::max({ this->GetMTime(), input->GetMTime(), input->GetUpdateMTime() });
+  const bool             keepOutputs = outputsMTime == this->m_GeneratedOutputsMTime;
+  this->m_GeneratedOutputsMTime = outputsMTime;
+  this->m_RequestedOutputs.resize(this->m_TotalOutputs, false);
+  for (unsigned int nOutput = 0; nOutput < this->m_TotalOutputs; ++nOutput)
+  {
+    OutputImageType * outputPtr = this->GetOutput(nOutput);
+    if (keepOutputs && outputPtr->GetBufferedRegion().GetNumberOfPixels() > 0 &&
+        !outputPtr->RequestedRegionIsOutsideOfTheBufferedRegion())
+    {
+      this->m_RequestedOutputs[nOutput] = false;
+      continue;
+    }
+    outputPtr->PrepareForNewData();
+  }
+}
+
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
 typename WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::
   OutputImagePointer
@@ -151,6 +183,179 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   Superclass::PrintSelf(os, indent);
   os << indent << " Levels: " << this->m_Levels << " HighPassSubBands: " << this->m_HighPassSubBands
      << " TotalOutputs: " << this->m_TotalOutputs << std::endl;
+  os << indent << "UseFusedKernel: " << this->m_UseFusedKernel << std::endl;
+  os << indent << "UseVirtualFilterBank: " << this->m_UseVirtualFilterBank << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd << std::endl;
+  os << indent << "GenerateOnlyRequestedOutputs: " << this->m_GenerateOnlyRequestedOutputs << std::endl;
+  os << indent << "MemoryBudget: " << this->m_MemoryBudget << std::endl;
+  os << indent << "ExecutionStrategy: " << static_cast<int>(this->m_ExecutionStrategy) << std::endl;
+  os << indent << "PredictedPeakBytes: " << this->m_PredictedPeakBytes << std::endl;
+  os << indent << "MeasuredPeakBytes: " << this->m_MeasuredPeakBytes << std::endl;
+  itkPrintSelfObjectMacro(WaveletFilterBankPyramidCache);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
+SizeValueType
+WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::
+  ComputePredictedPeakBytes(ExecutionStrategy strategy) const
+{
+  const unsigned int levels = this->m_Levels;
+  const unsigned int highPassSubBands = this->m_HighPassSubBands;
+  // Pixels of the input of each level, and of the low pass output after the last level.
+  std::vector<SizeValueType> levelPixels(levels + 1);
+  SizeValueType              sumLevelPixels = 0;
+  for (unsigned int level = 0; level < levels; ++level)
+  {
+    levelPixels[level] = this->GetOutput(level * highPassSubBands)->GetLargestPossibleRegion().GetNumberOfPixels();
+    sumLevelPixels += levelPixels[level];
+  }
+  levelPixels[levels] = this->GetOutput(this->m_TotalOutputs - 1)->GetLargestPossibleRegion().GetNumberOfPixels();
+
+  const SizeValueType outputPixels = highPassSubBands * sumLevelPixels + levelPixels[levels];
+  const bool          useFilterBankImages = strategy != ExecutionStrategy::VirtualFilterBank;
+  // On a cache miss, the pyramid is only kept if the cache can hold it.
+  const bool retainPyramid =
+    useFilterBankImages &&
+    (this->m_StoreWaveletFilterBankPyramid ||
+     (this->m_WaveletFilterBankPyramidCache.IsNotNull() && strategy != ExecutionStrategy::FusedKernelWithoutCache &&
+      this->m_WaveletFilterBankPyramidCache->CanInsert(this->ComputeWaveletFilterBankPyramidBytes())));
+
+  SizeValueType peakPixels = 0;
+  for (unsigned int level = 0; level < levels; ++level)
+  {
+    // The shrunk low pass of the last level is the low pass output.
+    const SizeValueType nextLevelPixels = level + 1 < levels ? levelPixels[level + 1] : 0;
+    SizeValueType       levelPeakPixels = levelPixels[level] + nextLevelPixels;
+    if (strategy == ExecutionStrategy::FilterBankPipeline)
+    {
+      // Product of the input with the low pass wavelet, before shrinking it.
+      levelPeakPixels += levelPixels[level];
+    }
+    if (retainPyramid)
+    {
+      levelPeakPixels += (highPassSubBands + 1) * sumLevelPixels;
+    }
+    else if (useFilterBankImages)
+    {
+      // The filter bank of the level and the one of the next level, while it is generated.
+      levelPeakPixels += (highPassSubBands + 1) * (levelPixels[level] + nextLevelPixels);
+    }
+    peakPixels = std::max(peakPixels, levelPeakPixels);
+  }
+  return (outputPixels + peakPixels) * sizeof(typename OutputImageType::PixelType);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
+SizeValueType
+WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::
+  ComputeWaveletFilterBankPyramidBytes() const
+{
+  // The filter bank of a level has the size of the input of the level, the size of its first high pass output.
+  SizeValueType levelPixels = 0;
+  for (unsigned int level = 0; level < this->m_Levels; ++level)
+  {
+    levelPixels += this->GetOutput(level * this->m_HighPassSubBands)->GetLargestPossibleRegion().GetNumberOfPixels();
+  }
+  return (this->m_HighPassSubBands + 1) * levelPixels * sizeof(typename OutputImageType::PixelType);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
+void
+WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::PlanExecution()
+{
+  ExecutionStrategy requested = ExecutionStrategy::FilterBankPipeline;
+  if (this->m_UseVirtualFilterBank)
+  {
+    requested = ExecutionStrategy::VirtualFilterBank;
+  }
+  else if (this->m_UseFusedKernel)
+  {
+    requested = ExecutionStrategy::FusedKernel;
+  }
+  this->m_ExecutionStrategy = requested;
+  this->m_PredictedPeakBytes = this->ComputePredictedPeakBytes(requested);
+  if (this->m_MemoryBudget == 0 || this->m_PredictedPeakBytes <= this->m_MemoryBudget)
+  {
+    return;
+  }
+
+  // The virtual filter bank cannot store the filter bank pyramid.
+  const auto leanest = static_cast<unsigned int>(this->m_StoreWaveletFilterBankPyramid
+                                                   ? ExecutionStrategy::FusedKernelWithoutCache
+                                                   : ExecutionStrategy::VirtualFilterBank);
+  SizeValueType minimumPeakBytes = this->m_PredictedPeakBytes;
+  for (auto candidate = static_cast<unsigned int>(requested) + 1; candidate <= leanest; ++candidate)
+  {
+    const auto          strategy = static_cast<ExecutionStrategy>(candidate);
+    const SizeValueType peakBytes = this->ComputePredictedPeakBytes(strategy);
+    minimumPeakBytes = std::min(minimumPeakBytes, peakBytes);
+    if (peakBytes <= this->m_MemoryBudget)
+    {
+      itkDebugMacro(<< "Execution strategy " << candidate << " chosen for the MemoryBudget, predicted peak bytes: "
+                    << peakBytes);
+      this->m_ExecutionStrategy = strategy;
+      this->m_PredictedPeakBytes = peakBytes;
+      return;
+    }
+  }
+  itkExceptionMacro(<< "The predicted peak memory of the forward wavelet transform, " << minimumPeakBytes
+                    << " bytes with the leanest strategy, exceeds the MemoryBudget of " << this->m_MemoryBudget
+                    << " bytes. Reduce the Levels, the HighPassSubBands or the size of the input.");
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
+void
+WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::SampleMemoryUsage(
+  const OutputsType & images)
+{
+  using PixelType = typename OutputImageType::PixelType;
+  std::set<const PixelType *> buffers;
+  SizeValueType               bytes = 0;
+  const auto                  addImage = [&buffers, &bytes](const OutputImageType * image) {
+    if (image && image->GetPixelContainer() && buffers.insert(image->GetBufferPointer()).second)
+    {
+      bytes += image->GetPixelContainer()->Size() * sizeof(PixelType);
+    }
+  };
+  for (unsigned int nOutput = 0; nOutput < this->m_TotalOutputs; ++nOutput)
+  {
+    addImage(this->GetOutput(nOutput));
+  }
+  for (const auto & image : this->m_WaveletFilterBankPyramid)
+  {
+    addImage(image);
+  }
+  for (const auto & image : this->m_WaveletFilterBank->GetOutputsAll())
+  {
+    addImage(image);
+  }
+  for (const auto & image : images)
+  {
+    addImage(image);
+  }
+  this->m_MeasuredPeakBytes = std::max(this->m_MeasuredPeakBytes, bytes);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
+typename WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::
+  InputImageType::SizeType
+  WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::
+    ComputeFullSizePerLevel(unsigned int level) const
+{
+  typename InputImageType::SizeType fullSize = this->GetInput()->GetLargestPossibleRegion().GetSize();
+  if (this->m_HalfHermitian)
+  {
+    fullSize = itk::utils::ComputeFullSizeFromHalfHermitianSize(fullSize, this->m_ActualXDimensionIsOdd);
+  }
+  for (unsigned int l = 0; l < level; ++l)
+  {
+    for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+    {
+      fullSize[idim] = std::max(fullSize[idim] / this->m_ScaleFactor, static_cast<SizeValueType>(1));
+    }
+  }
+  return fullSize;
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
@@ -177,6 +382,16 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   typename OutputImageType::SpacingType inputModifiedSpacing(1);
   // typename OutputImageType::DirectionType outputDirection = inputDirection;
 
+  // With HalfHermitian, the sizes per level are the sizes of the full spectrum,
+  // and the outputs have the size of their half-Hermitian layout.
+  if (this->m_HalfHermitian)
+  {
+    inputSize = itk::utils::ComputeFullSizeFromHalfHermitianSize(inputSize, this->m_ActualXDimensionIsOdd);
+  }
+  const auto layoutSize = [this](const typename OutputImageType::SizeType & fullSize) {
+    return this->m_HalfHermitian ? itk::utils::ComputeHalfHermitianSize(fullSize) : fullSize;
+  };
+
   OutputImagePointer                    outputPtr;
   typename OutputImageType::SizeType    inputSizePerLevel = inputSize;
   typename OutputImageType::IndexType   inputStartIndexPerLevel = inputStartIndex;
@@ -197,7 +412,7 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
         continue;
       }
       typename OutputImageType::RegionType largestPossibleRegion;
-      largestPossibleRegion.SetSize(inputSizePerLevel);
+      largestPossibleRegion.SetSize(layoutSize(inputSizePerLevel));
       largestPossibleRegion.SetIndex(inputStartIndexPerLevel);
       outputPtr->SetLargestPossibleRegion(largestPossibleRegion);
       outputPtr->SetOrigin(inputOriginPerLevel);
@@ -233,7 +448,7 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
         continue;
       }
       typename OutputImageType::RegionType largestPossibleRegion;
-      largestPossibleRegion.SetSize(inputSizePerLevel);
+      largestPossibleRegion.SetSize(layoutSize(inputSizePerLevel));
       largestPossibleRegion.SetIndex(inputStartIndexPerLevel);
       outputPtr->SetLargestPossibleRegion(largestPossibleRegion);
       outputPtr->SetOrigin(inputOriginPerLevel);
@@ -248,11 +463,23 @@ void
 WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::
   GenerateOutputRequestedRegion(DataObject * refOutput)
 {
+  // find the index for this output
+  auto refIndex = static_cast<unsigned int>(refOutput->GetSourceOutputIndex());
+
+  if (this->m_GenerateOnlyRequestedOutputs)
+  {
+    // Only the reference output is generated, the requested regions of the other outputs are not modified.
+    if (this->m_RequestedOutputs.size() != this->m_TotalOutputs)
+    {
+      this->m_RequestedOutputs.assign(this->m_TotalOutputs, false);
+    }
+    this->m_RequestedOutputs[refIndex] = true;
+    return;
+  }
+
   // call the superclass's implementation of this method
   Superclass::GenerateOutputRequestedRegion(refOutput);
 
-  // find the index for this output
-  auto                                  refIndex = static_cast<unsigned int>(refOutput->GetSourceOutputIndex());
   std::pair<unsigned int, unsigned int> pairRef = this->OutputIndexToLevelBand(refIndex);
   unsigned int                          refLevel = pairRef.first;
   // unsigned int refBand  = pairRef.second;
@@ -367,6 +594,13 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
     itkExceptionMacro(<< "Input has not been set.");
   }
 
+  if (this->m_GenerateOnlyRequestedOutputs)
+  {
+    // The requested outputs can be of any level, all of them require the whole input.
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+    return;
+  }
+
   // compute baseIndex and baseSize
   using SizeType = typename OutputImageType::SizeType;
   using IndexType = typename OutputImageType::IndexType;
@@ -389,13 +623,394 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   inputPtr->SetRequestedRegion(baseRegion);
 }
 
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
+typename WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::
+  OutputImagePointer
+  WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::
+    FusedAnalysisPerLevel(unsigned int            level,
+                          const OutputImageType * inputPerLevel,
+                          const OutputImageType * lowPassWavelet,
+                          const OutputsType &     highPassWavelets,
+                          bool                    computeLowPass)
+{
+  using RegionType = typename OutputImageType::RegionType;
+  using SizeType = typename OutputImageType::SizeType;
+  using IndexType = typename OutputImageType::IndexType;
+  using PixelType = typename OutputImageType::PixelType;
+  using PixelValueType = typename NumericTraits<PixelType>::ValueType;
+
+  const RegionType inputRegion = inputPerLevel->GetLargestPossibleRegion();
+  const SizeType   inputSize = inputRegion.GetSize();
+  // Size of the full spectrum, equal to inputSize if not HalfHermitian.
+  const bool     halfHermitian = this->m_HalfHermitian;
+  const SizeType fullSize = this->ComputeFullSizePerLevel(level);
+
+  // The shrunk low pass has the same geometry than the output of FrequencyShrinkImageFilter.
+  // Each shrunk bin k gathers the aliased bins: k (positive freqs) and k + inputSize - shrunkSize (negative freqs).
+  // The sweep region adds to the shrunk size the bins not aliased to any shrunk bin (central bin of odd sizes),
+  // so every input bin is visited exactly once, and every shrunk bin is written by only one thread.
+  SizeType                              shrunkSize;
+  SizeType                              sweepSize;
+  typename OutputImageType::SpacingType shrunkSpacing = inputPerLevel->GetSpacing();
+  for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+  {
+    shrunkSize[idim] = fullSize[idim] / this->m_ScaleFactor;
+    if (shrunkSize[idim] < 1)
+    {
+      itkExceptionMacro(<< "Failure at level: " << level
+                        << " in forward wavelet, going to zero image size. Too many levels for input image size.");
+    }
+    sweepSize[idim] = inputSize[idim] - shrunkSize[idim];
+    shrunkSpacing[idim] *= this->m_ScaleFactor;
+  }
+  // The aliases of the shrunk bins of the full spectrum, before taking its half-Hermitian layout.
+  const SizeType shrunkFullSize = shrunkSize;
+  if (halfHermitian)
+  {
+    shrunkSize = itk::utils::ComputeHalfHermitianSize(shrunkFullSize);
+  }
+  const RegionType shrunkRegion(inputRegion.GetIndex(), shrunkSize);
+
+  // If the low pass is not computed, the image is not allocated, but provides the offset table of the shrunk region.
+  OutputImagePointer lowPass;
+  if (level == this->m_Levels - 1 && computeLowPass)
+  {
+    lowPass = this->GetOutput(this->m_TotalOutputs - 1);
+  }
+  else
+  {
+    lowPass = OutputImageType::New();
+  }
+  lowPass->SetOrigin(inputPerLevel->GetOrigin());
+  lowPass->SetSpacing(shrunkSpacing);
+  lowPass->SetDirection(inputPerLevel->GetDirection());
+  lowPass->SetRegions(shrunkRegion);
+  if (computeLowPass)
+  {
+    lowPass->Allocate();
+  }
+
+  const bool useVirtualFilterBank = this->m_ExecutionStrategy == ExecutionStrategy::VirtualFilterBank;
+
+  // High pass outputs share the geometry of the input of the level. Only the requested bands are written.
+  std::vector<PixelType *>       highPassBuffers(this->m_HighPassSubBands);
+  std::vector<const PixelType *> highPassWaveletBuffers(this->m_HighPassSubBands);
+  std::vector<PixelValueType>    analysisBandFactors(this->m_HighPassSubBands);
+  std::vector<unsigned int>      generatedBands;
+  const auto                     scaleFactor = static_cast<double>(this->m_ScaleFactor);
+  for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+  {
+    if (!this->m_RequestedOutputs[level * this->m_HighPassSubBands + band])
+    {
+      continue;
+    }
+    generatedBands.push_back(band);
+    OutputImageType * outputPtr = this->GetOutput(level * this->m_HighPassSubBands + band);
+    outputPtr->SetOrigin(inputPerLevel->GetOrigin());
+    outputPtr->SetSpacing(inputPerLevel->GetSpacing());
+    outputPtr->SetDirection(inputPerLevel->GetDirection());
+    outputPtr->SetRegions(inputRegion);
+    outputPtr->Allocate();
+    highPassBuffers[band] = outputPtr->GetBufferPointer();
+    if (!useVirtualFilterBank)
+    {
+      highPassWaveletBuffers[band] = highPassWavelets[band]->GetBufferPointer();
+    }
+    const double expBandFactor =
+      (-static_cast<double>(level) + band / static_cast<double>(this->m_HighPassSubBands)) * ImageDimension / 2.0;
+    analysisBandFactors[band] = static_cast<PixelValueType>(std::pow(scaleFactor, expBandFactor));
+  }
+
+  // Virtual filter bank: the masks are evaluated from the frequency modulo of each bin,
+  // with the frequencies of the filter bank of the first level, decimated at this level.
+  const WaveletFunctionType *      waveletFunction = this->m_WaveletFilterBank->GetModifiableWaveletFunction();
+  std::vector<std::vector<double>> frequencyModuloSquare;
+  const PixelType *                lowPassWaveletBuffer = nullptr;
+  if (useVirtualFilterBank)
+  {
+    frequencyModuloSquare = itk::utils::ComputeFrequencyModuloSquarePerDimension<ImageDimension>(
+      inputSize,
+      this->ComputeFullSizePerLevel(0),
+      static_cast<SizeValueType>(std::pow(scaleFactor, static_cast<double>(level))));
+  }
+  else
+  {
+    lowPassWaveletBuffer = lowPassWavelet->GetBufferPointer();
+  }
+  // Profiles interpolated from the table of the filter bank, if requested. Unit spacing: maximum frequency is 1/2.
+  const typename WaveletFilterBankType::ProfileTableType * profileTable = nullptr;
+  if (useVirtualFilterBank && this->m_WaveletFilterBank->GetUseProfileTable())
+  {
+    profileTable = this->m_WaveletFilterBank->GetProfileTable(0.25 * ImageDimension);
+  }
+
+  const PixelType *       inputBuffer = inputPerLevel->GetBufferPointer();
+  PixelType *             lowPassBuffer = lowPass->GetBufferPointer();
+  const OffsetValueType * inputOffsetTable = inputPerLevel->GetOffsetTable();
+  const OffsetValueType * shrunkOffsetTable = lowPass->GetOffsetTable();
+  const unsigned int      numberOfAliases = 1u << ImageDimension;
+  const auto              shrinkNormalization = static_cast<PixelValueType>(1.0 / numberOfAliases);
+  const unsigned int      highPassSubBands = this->m_HighPassSubBands;
+
+  if (halfHermitian)
+  {
+    // First sweep: the high pass outputs, pointwise in the half-Hermitian layout.
+    RegionType highPassRegion;
+    highPassRegion.SetSize(inputSize);
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      highPassRegion,
+      [&](const RegionType & region) {
+        std::vector<FunctionValueType> subBands(highPassSubBands + 1);
+        for (const IndexType & index : ImageRegionIndexRange<ImageDimension>(region))
+        {
+          OffsetValueType offset = 0;
+          double          w2 = 0;
+          for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+          {
+            offset += index[idim] * inputOffsetTable[idim];
+            if (useVirtualFilterBank)
+            {
+              w2 += frequencyModuloSquare[idim][index[idim]];
+            }
+          }
+          const PixelType inputValue = inputBuffer[offset];
+          if (useVirtualFilterBank)
+          {
+            if (profileTable)
+            {
+              profileTable->EvaluateSubBands(w2, subBands.data());
+            }
+            else
+            {
+              const auto w = static_cast<FunctionValueType>(std::sqrt(w2));
+              for (unsigned int j = 1; j < highPassSubBands + 1; ++j)
+              {
+                subBands[j] = waveletFunction->EvaluateForwardSubBand(w, j);
+              }
+            }
+            for (const unsigned int band : generatedBands)
+            {
+              const auto mask = static_cast<PixelValueType>(subBands[band + 1]);
+              highPassBuffers[band][offset] = mask * analysisBandFactors[band] * inputValue;
+            }
+          }
+          else
+          {
+            for (const unsigned int band : generatedBands)
+            {
+              highPassBuffers[band][offset] =
+                highPassWaveletBuffers[band][offset] * analysisBandFactors[band] * inputValue;
+            }
+          }
+        }
+      },
+      nullptr);
+
+    if (!computeLowPass)
+    {
+      return nullptr;
+    }
+
+    // Second sweep: every shrunk bin gathers its aliased bins of the full spectrum,
+    // the bins not stored are the conjugate of their mirror. The masks are real and symmetric.
+    RegionType lowPassRegion;
+    lowPassRegion.SetSize(shrunkSize);
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      lowPassRegion,
+      [&](const RegionType & region) {
+        IndexValueType aliasIndex[ImageDimension];
+        for (const IndexType & shrunkIndex : ImageRegionIndexRange<ImageDimension>(region))
+        {
+          OffsetValueType shrunkOffset = 0;
+          for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+          {
+            shrunkOffset += shrunkIndex[idim] * shrunkOffsetTable[idim];
+          }
+          // Same summation order than the quadrants of FrequencyShrinkImageFilter.
+          PixelType lowPassSum = NumericTraits<PixelType>::ZeroValue();
+          for (unsigned int n = 0; n < numberOfAliases; ++n)
+          {
+            for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+            {
+              aliasIndex[idim] = shrunkIndex[idim];
+              if ((n >> idim) & 1u)
+              {
+                aliasIndex[idim] += static_cast<IndexValueType>(fullSize[idim] - shrunkFullSize[idim]);
+              }
+            }
+            OffsetValueType offset;
+            const bool      isMirrored = itk::utils::ComputeHalfHermitianOffset<ImageDimension>(
+              aliasIndex, fullSize, inputSize[0], inputOffsetTable, offset);
+            PixelType value;
+            if (useVirtualFilterBank)
+            {
+              double w2 = 0;
+              for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+              {
+                const IndexValueType k = (isMirrored && aliasIndex[idim] != 0)
+                                           ? static_cast<IndexValueType>(fullSize[idim]) - aliasIndex[idim]
+                                           : aliasIndex[idim];
+                w2 += frequencyModuloSquare[idim][k];
+              }
+              const auto              w = static_cast<FunctionValueType>(std::sqrt(w2));
+              const FunctionValueType lowPassProfile =
+                profileTable ? profileTable->EvaluateSubBand(w2, 0) : waveletFunction->EvaluateForwardSubBand(w, 0);
+              value = static_cast<PixelValueType>(lowPassProfile) * inputBuffer[offset];
+            }
+            else
+            {
+              value = lowPassWaveletBuffer[offset] * inputBuffer[offset];
+            }
+            lowPassSum += isMirrored ? itk::utils::ComplexConjugate(value) : value;
+          }
+          lowPassBuffer[shrunkOffset] = lowPassSum * shrinkNormalization;
+        }
+      },
+      nullptr);
+    return lowPass;
+  }
+
+  RegionType sweepRegion;
+  sweepRegion.SetSize(sweepSize);
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    sweepRegion,
+    [&](const RegionType & region) {
+      OffsetValueType                aliasOffsets[ImageDimension][2];
+      SizeValueType                  aliasIndices[ImageDimension][2];
+      unsigned int                   numberOfAliasesPerDim[ImageDimension];
+      std::vector<FunctionValueType> subBands(highPassSubBands + 1);
+      for (const IndexType & sweepIndex : ImageRegionIndexRange<ImageDimension>(region))
+      {
+        bool            isAliasedToShrunk = true;
+        OffsetValueType shrunkOffset = 0;
+        for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+        {
+          const auto k = static_cast<SizeValueType>(sweepIndex[idim]);
+          aliasIndices[idim][0] = k;
+          aliasOffsets[idim][0] = sweepIndex[idim] * inputOffsetTable[idim];
+          if (k < shrunkSize[idim])
+          {
+            aliasIndices[idim][1] = k + inputSize[idim] - shrunkSize[idim];
+            aliasOffsets[idim][1] = static_cast<OffsetValueType>(aliasIndices[idim][1]) * inputOffsetTable[idim];
+            numberOfAliasesPerDim[idim] = 2;
+            shrunkOffset += sweepIndex[idim] * shrunkOffsetTable[idim];
+          }
+          else
+          {
+            numberOfAliasesPerDim[idim] = 1;
+            isAliasedToShrunk = false;
+          }
+        }
+
+        // Same summation order than the quadrants of FrequencyShrinkImageFilter.
+        PixelType lowPassSum = NumericTraits<PixelType>::ZeroValue();
+        for (unsigned int n = 0; n < numberOfAliases; ++n)
+        {
+          OffsetValueType offset = 0;
+          double          w2 = 0;
+          bool            validAlias = true;
+          for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+          {
+            const unsigned int side = (n >> idim) & 1u;
+            if (side >= numberOfAliasesPerDim[idim])
+            {
+              validAlias = false;
+              break;
+            }
+            offset += aliasOffsets[idim][side];
+            if (useVirtualFilterBank)
+            {
+              w2 += frequencyModuloSquare[idim][aliasIndices[idim][side]];
+            }
+          }
+          if (!validAlias)
+          {
+            continue;
+          }
+
+          const PixelType inputValue = inputBuffer[offset];
+          if (useVirtualFilterBank)
+          {
+            // SubBand 0 is the low pass, HighPassSubBands is the highest.
+            if (profileTable)
+            {
+              profileTable->EvaluateSubBands(w2, subBands.data());
+            }
+            else
+            {
+              const auto w = static_cast<FunctionValueType>(std::sqrt(w2));
+              for (unsigned int j = 0; j < highPassSubBands + 1; ++j)
+              {
+                subBands[j] = waveletFunction->EvaluateForwardSubBand(w, j);
+              }
+            }
+            for (const unsigned int band : generatedBands)
+            {
+              const auto mask = static_cast<PixelValueType>(subBands[band + 1]);
+              highPassBuffers[band][offset] = mask * analysisBandFactors[band] * inputValue;
+            }
+            lowPassSum += static_cast<PixelValueType>(subBands[0]) * inputValue;
+          }
+          else
+          {
+            for (const unsigned int band : generatedBands)
+            {
+              highPassBuffers[band][offset] =
+                highPassWaveletBuffers[band][offset] * analysisBandFactors[band] * inputValue;
+            }
+            lowPassSum += lowPassWaveletBuffer[offset] * inputValue;
+          }
+        }
+        if (isAliasedToShrunk && computeLowPass)
+        {
+          lowPassBuffer[shrunkOffset] = lowPassSum * shrinkNormalization;
+        }
+      }
+    },
+    nullptr);
+
+  return computeLowPass ? lowPass : nullptr;
+}
+
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyShrinkFilterType>
 void
 WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyShrinkFilterType>::GenerateData()
 {
   InputImageConstPointer input = this->GetInput();
 
-  this->AllocateOutputs();
+  // Outputs to compute, and the last level to analyze to reach them.
+  if (!this->m_GenerateOnlyRequestedOutputs)
+  {
+    this->m_RequestedOutputs.assign(this->m_TotalOutputs, true);
+  }
+  const bool   lowPassIsRequested = this->m_RequestedOutputs[this->m_TotalOutputs - 1];
+  bool         anyOutputIsRequested = lowPassIsRequested;
+  unsigned int lastLevel = lowPassIsRequested ? this->m_Levels - 1 : 0;
+  for (unsigned int nOutput = 0; nOutput < this->m_TotalOutputs - 1; ++nOutput)
+  {
+    if (this->m_RequestedOutputs[nOutput])
+    {
+      anyOutputIsRequested = true;
+      lastLevel = std::max(lastLevel, nOutput / this->m_HighPassSubBands);
+    }
+  }
+  if (!anyOutputIsRequested)
+  {
+    // The requested outputs are up to date.
+    return;
+  }
+
+  // Choose the strategy before allocating the outputs, it throws if the MemoryBudget cannot be met.
+  this->PlanExecution();
+  const bool useFusedKernel = this->m_ExecutionStrategy != ExecutionStrategy::FilterBankPipeline;
+  const bool useVirtualFilterBank = this->m_ExecutionStrategy == ExecutionStrategy::VirtualFilterBank;
+  this->m_MeasuredPeakBytes = 0;
+
+  // With GenerateOnlyRequestedOutputs, the engines allocate only the requested outputs.
+  if (!this->m_GenerateOnlyRequestedOutputs)
+  {
+    this->AllocateOutputs();
+  }
 
   // note: clear reduces size to zero, but doesn't change capacity.
   m_WaveletFilterBankPyramid.clear();
@@ -404,19 +1019,18 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   auto castFilter = CastFilterType::New();
   castFilter->SetInput(input);
   castFilter->Update();
-  OutputImagePointer inputPerLevel = castFilter->GetOutput();
   using ChangeInformationFilterType = itk::ChangeInformationImageFilter<OutputImageType>;
   auto                                   changeInputInfoFilter = ChangeInformationFilterType::New();
-  typename InputImageType::PointType     origin_old = inputPerLevel->GetOrigin();
-  typename InputImageType::SpacingType   spacing_old = inputPerLevel->GetSpacing();
-  typename InputImageType::DirectionType direction_old = inputPerLevel->GetDirection();
+  typename InputImageType::PointType     origin_old = castFilter->GetOutput()->GetOrigin();
+  typename InputImageType::SpacingType   spacing_old = castFilter->GetOutput()->GetSpacing();
+  typename InputImageType::DirectionType direction_old = castFilter->GetOutput()->GetDirection();
   typename InputImageType::PointType     origin_new = origin_old;
   origin_new.Fill(0);
   typename InputImageType::SpacingType spacing_new = spacing_old;
   spacing_new.Fill(1);
   typename InputImageType::DirectionType direction_new = direction_old;
   direction_new.SetIdentity();
-  changeInputInfoFilter->SetInput(inputPerLevel);
+  changeInputInfoFilter->SetInput(castFilter->GetOutput());
   changeInputInfoFilter->ChangeRegionOff();
   changeInputInfoFilter->ChangeDirectionOn();
   changeInputInfoFilter->ChangeSpacingOn();
@@ -426,87 +1040,227 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   changeInputInfoFilter->SetOutputSpacing(spacing_new);
   changeInputInfoFilter->SetOutputDirection(direction_new);
   changeInputInfoFilter->Update();
+  // The input of the first level shares its buffer with the output of the cast filter.
+  // Release it from the filters, so it is freed when the first level is computed.
+  OutputImagePointer inputPerLevel = changeInputInfoFilter->GetOutput();
+  inputPerLevel->DisconnectPipeline();
+  castFilter->GetOutput()->ReleaseData();
+
+  OutputsType        highPassWavelets;
+  OutputImagePointer lowPassWavelet;
+  if (useVirtualFilterBank)
+  {
+    if (this->m_StoreWaveletFilterBankPyramid)
+    {
+      itkExceptionMacro(<< "StoreWaveletFilterBankPyramid requires the filter bank images, "
+                        << "it cannot be used with UseVirtualFilterBank.");
+    }
+    // The wavelet function is evaluated in the fused kernel. The filter bank images are not generated.
+    this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
+    this->m_WaveletFilterBank->GetModifiableWaveletFunction()->SetHighPassSubBands(this->m_HighPassSubBands);
+  }
+  else
+  {
+    this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
+    this->m_WaveletFilterBank->SetHalfHermitian(this->m_HalfHermitian);
+    this->m_WaveletFilterBank->SetActualXDimensionIsOdd(this->m_ActualXDimensionIsOdd);
+    this->m_WaveletFilterBank->SetSize(inputPerLevel->GetLargestPossibleRegion().GetSize());
+  }
 
-  // Generate WaveletFilterBank.
-  this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
-  this->m_WaveletFilterBank->SetSize(changeInputInfoFilter->GetOutput()->GetLargestPossibleRegion().GetSize());
-  this->m_WaveletFilterBank->Update();
-  OutputsType        highPassWavelets = this->m_WaveletFilterBank->GetOutputsHighPassBands();
-  OutputImagePointer lowPassWavelet = this->m_WaveletFilterBank->GetOutputLowPass();
+  // Look up the filter bank pyramid in the cache, on a miss it is generated and inserted at the end.
+  // FusedKernelWithoutCache and VirtualFilterBank do not keep the pyramid in the cache.
+  const bool useCache = this->m_WaveletFilterBankPyramidCache.IsNotNull() && !useVirtualFilterBank &&
+                        this->m_ExecutionStrategy != ExecutionStrategy::FusedKernelWithoutCache;
+  typename WaveletFilterBankPyramidCacheType::KeyType cacheKey;
+  OutputsType                                         cachedPyramid;
+  bool                                                cacheHit = false;
+  if (useCache)
+  {
+    cacheKey = WaveletFilterBankPyramidCacheType::ComputeKey(
+      this->m_WaveletFilterBank,
+      { inputPerLevel->GetLargestPossibleRegion().GetSize() },
+      this->m_Levels,
+      this->m_ScaleFactor,
+      false);
+    cacheHit = this->m_WaveletFilterBankPyramidCache->Find(cacheKey, cachedPyramid);
+  }
+  // On a miss, keep the filter banks of all the levels only if the complete pyramid can be inserted.
+  // Otherwise the filter bank of each level is released once the next one is generated.
+  const bool insertPyramid =
+    useCache && !cacheHit && lastLevel == this->m_Levels - 1 &&
+    this->m_WaveletFilterBankPyramidCache->CanInsert(this->ComputeWaveletFilterBankPyramidBytes());
+  const bool storePyramid = this->m_StoreWaveletFilterBankPyramid || insertPyramid;
+
+  if (cacheHit)
+  {
+    lowPassWavelet = cachedPyramid[0];
+    highPassWavelets.assign(cachedPyramid.begin() + 1, cachedPyramid.begin() + 1 + this->m_HighPassSubBands);
+  }
+  else if (!useVirtualFilterBank)
+  {
+    // Generate WaveletFilterBank.
+    this->m_WaveletFilterBank->Update();
+    highPassWavelets = this->m_WaveletFilterBank->GetOutputsHighPassBands();
+    lowPassWavelet = this->m_WaveletFilterBank->GetOutputLowPass();
+    if (this->m_HalfHermitian || insertPyramid)
+    {
+      // The filter bank is generated again in the next levels (or cached), keep the images of this level.
+      lowPassWavelet->DisconnectPipeline();
+      for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+      {
+        highPassWavelets[band]->DisconnectPipeline();
+      }
+    }
+  }
 
-  if (this->m_StoreWaveletFilterBankPyramid)
+  if (storePyramid)
   {
-    for (unsigned int bankOutput = 0; bankOutput < this->m_HighPassSubBands + 1; ++bankOutput)
+    this->m_WaveletFilterBankPyramid.push_back(lowPassWavelet);
+    for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
     {
-      this->m_WaveletFilterBankPyramid.push_back(this->m_WaveletFilterBank->GetOutput(bankOutput));
+      this->m_WaveletFilterBankPyramid.push_back(highPassWavelets[band]);
     }
   }
 
+  // Sample the buffers held by the filter: the ones of the level, the filter bank of the level and the cached pyramid.
+  const auto sampleMemoryUsage = [&](const OutputsType & levelImages) {
+    OutputsType images(levelImages);
+    images.push_back(lowPassWavelet);
+    images.insert(images.end(), highPassWavelets.begin(), highPassWavelets.end());
+    images.insert(images.end(), cachedPyramid.begin(), cachedPyramid.end());
+    this->SampleMemoryUsage(images);
+  };
+  sampleMemoryUsage({ inputPerLevel });
+
   // TODO think about passing the FrequencyShrinker as template parameter to work with different FFT layout, or
   // regular images directly in frequency domain.
   // using LocalFrequencyShrinkFilterType = itk::FrequencyShrinkViaInverseFFTImageFilter<OutputImageType>;
   using LocalFrequencyShrinkFilterType = itk::FrequencyShrinkImageFilter<OutputImageType>;
   using ShrinkDecimateFilterType = itk::ShrinkDecimateImageFilter<OutputImageType, OutputImageType>;
   using MultiplyFilterType = itk::MultiplyImageFilter<OutputImageType>;
-  inputPerLevel = changeInputInfoFilter->GetOutput();
   auto scaleFactor = static_cast<double>(this->m_ScaleFactor);
-  for (unsigned int level = 0; level < this->m_Levels; ++level)
+  for (unsigned int level = 0; level <= lastLevel; ++level)
   {
-    /******* Set HighPass bands *****/
-    itkDebugMacro(<< "Number of FilterBank high pass bands: " << highPassWavelets.size());
-    for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+    // The low pass of the last level analyzed is only needed for the low pass output.
+    const bool computeLowPass = level < lastLevel || lowPassIsRequested;
+    if (useFusedKernel)
     {
-      unsigned int n_output = level * this->m_HighPassSubBands + band;
-      /******* Band dilation factor for HighPass bands *****/
-      //  2^(1/#bands) instead of Dyadic dilations.
-      auto multiplyByAnalysisBandFactor = MultiplyFilterType::New();
-      multiplyByAnalysisBandFactor->SetInput1(highPassWavelets[band]);
-      // double expBandFactor = 0;
-      // double expBandFactor = - static_cast<double>(level*ImageDimension)/2.0;
-      double expBandFactor =
-        (-static_cast<double>(level) + band / static_cast<double>(this->m_HighPassSubBands)) * ImageDimension / 2.0;
-      multiplyByAnalysisBandFactor->SetConstant(std::pow(scaleFactor, expBandFactor));
-      // TODO Warning: InPlace here deletes buffered region of input.
-      // http://public.kitware.com/pipermail/community/2015-April/008819.html
-      // multiplyByAnalysisBandFactor->InPlaceOn();
-      multiplyByAnalysisBandFactor->Update();
-
-      auto multiplyHighBandFilter = MultiplyFilterType::New();
-      multiplyHighBandFilter->SetInput1(multiplyByAnalysisBandFactor->GetOutput());
-      multiplyHighBandFilter->SetInput2(inputPerLevel);
-      multiplyHighBandFilter->InPlaceOn();
-      multiplyHighBandFilter->GraftOutput(this->GetOutput(n_output));
-      multiplyHighBandFilter->Update();
-
-      this->UpdateProgress(static_cast<float>(n_output - 1) / static_cast<float>(m_TotalOutputs));
-      this->GraftNthOutput(n_output, multiplyHighBandFilter->GetOutput());
+      OutputImagePointer shrunkLowPass =
+        this->FusedAnalysisPerLevel(level, inputPerLevel, lowPassWavelet, highPassWavelets, computeLowPass);
+      sampleMemoryUsage({ inputPerLevel, shrunkLowPass });
+      inputPerLevel = shrunkLowPass;
+      if (level == lastLevel)
+      {
+        this->UpdateProgress(static_cast<float>(this->m_TotalOutputs - 1) / static_cast<float>(this->m_TotalOutputs));
+        continue;
+      }
+      this->UpdateProgress(static_cast<float>((level + 1) * this->m_HighPassSubBands) /
+                           static_cast<float>(this->m_TotalOutputs));
     }
-    /******* Calculate LowPass band *****/
-    auto multiplyLowFilter = MultiplyFilterType::New();
-    multiplyLowFilter->SetInput1(lowPassWavelet);
-    multiplyLowFilter->SetInput2(inputPerLevel);
-    // multiplyLowFilter->InPlaceOn();
-    multiplyLowFilter->Update();
-    inputPerLevel = multiplyLowFilter->GetOutput();
-
-    // Shrink in the frequency domain the stored low band for the next level.
-    auto freqShrinkFilter = LocalFrequencyShrinkFilterType::New();
-    freqShrinkFilter->SetInput(inputPerLevel);
-    freqShrinkFilter->SetShrinkFactors(this->m_ScaleFactor);
-
-    if (level == this->m_Levels - 1) // Set low_pass output (index=this->m_TotalOutputs - 1)
+    else
+    {
+      /******* Set HighPass bands *****/
+      itkDebugMacro(<< "Number of FilterBank high pass bands: " << highPassWavelets.size());
+      const OutputImagePointer levelInput = inputPerLevel;
+      for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+      {
+        unsigned int n_output = level * this->m_HighPassSubBands + band;
+        if (!this->m_RequestedOutputs[n_output])
+        {
+          continue;
+        }
+        /******* Band dilation factor for HighPass bands *****/
+        //  2^(1/#bands) instead of Dyadic dilations.
+        auto multiplyByAnalysisBandFactor = MultiplyFilterType::New();
+        multiplyByAnalysisBandFactor->SetInput1(highPassWavelets[band]);
+        // double expBandFactor = 0;
+        // double expBandFactor = - static_cast<double>(level*ImageDimension)/2.0;
+        double expBandFactor =
+          (-static_cast<double>(level) + band / static_cast<double>(this->m_HighPassSubBands)) * ImageDimension / 2.0;
+        multiplyByAnalysisBandFactor->SetConstant(std::pow(scaleFactor, expBandFactor));
+        // TODO Warning: InPlace here deletes buffered region of input.
+        // http://public.kitware.com/pipermail/community/2015-April/008819.html
+        // multiplyByAnalysisBandFactor->InPlaceOn();
+        multiplyByAnalysisBandFactor->Update();
+
+        auto multiplyHighBandFilter = MultiplyFilterType::New();
+        multiplyHighBandFilter->SetInput1(multiplyByAnalysisBandFactor->GetOutput());
+        multiplyHighBandFilter->SetInput2(inputPerLevel);
+        multiplyHighBandFilter->InPlaceOn();
+        multiplyHighBandFilter->GraftOutput(this->GetOutput(n_output));
+        multiplyHighBandFilter->Update();
+
+        this->UpdateProgress(static_cast<float>(n_output - 1) / static_cast<float>(m_TotalOutputs));
+        this->GraftNthOutput(n_output, multiplyHighBandFilter->GetOutput());
+      }
+      if (!computeLowPass)
+      {
+        continue;
+      }
+      /******* Calculate LowPass band *****/
+      auto multiplyLowFilter = MultiplyFilterType::New();
+      multiplyLowFilter->SetInput1(lowPassWavelet);
+      multiplyLowFilter->SetInput2(inputPerLevel);
+      // multiplyLowFilter->InPlaceOn();
+      multiplyLowFilter->Update();
+      inputPerLevel = multiplyLowFilter->GetOutput();
+
+      // Shrink in the frequency domain the stored low band for the next level.
+      auto freqShrinkFilter = LocalFrequencyShrinkFilterType::New();
+      freqShrinkFilter->SetInput(inputPerLevel);
+      freqShrinkFilter->SetShrinkFactors(this->m_ScaleFactor);
+      freqShrinkFilter->SetHalfHermitian(this->m_HalfHermitian);
+      freqShrinkFilter->SetActualXDimensionIsOdd(this->ComputeFullSizePerLevel(level)[0] % 2 == 1);
+
+      if (level == this->m_Levels - 1) // Set low_pass output (index=this->m_TotalOutputs - 1)
+      {
+        freqShrinkFilter->GraftOutput(this->GetOutput(this->m_TotalOutputs - 1));
+        freqShrinkFilter->Update();
+        this->GraftNthOutput(this->m_TotalOutputs - 1, freqShrinkFilter->GetOutput());
+        sampleMemoryUsage({ levelInput, inputPerLevel });
+        this->UpdateProgress(static_cast<float>(this->m_TotalOutputs - 1) / static_cast<float>(this->m_TotalOutputs));
+        continue;
+      }
+      else // update inputPerLevel
+      {
+        freqShrinkFilter->Update();
+        sampleMemoryUsage({ levelInput, inputPerLevel, freqShrinkFilter->GetOutput() });
+        inputPerLevel = freqShrinkFilter->GetOutput();
+      }
+    }
+
+    if (useVirtualFilterBank)
     {
-      freqShrinkFilter->GraftOutput(this->GetOutput(this->m_TotalOutputs - 1));
-      freqShrinkFilter->Update();
-      this->GraftNthOutput(this->m_TotalOutputs - 1, freqShrinkFilter->GetOutput());
-      this->UpdateProgress(static_cast<float>(this->m_TotalOutputs - 1) / static_cast<float>(this->m_TotalOutputs));
       continue;
     }
-    else // update inputPerLevel
+
+    /******* DownSample wavelets *****/
+    if (cacheHit)
+    {
+      const unsigned int firstBankOutput = (level + 1) * (1 + this->m_HighPassSubBands);
+      lowPassWavelet = cachedPyramid[firstBankOutput];
+      highPassWavelets.assign(cachedPyramid.begin() + firstBankOutput + 1,
+                              cachedPyramid.begin() + firstBankOutput + 1 + this->m_HighPassSubBands);
+    }
+    else if (this->m_HalfHermitian)
+    {
+      // The decimation of the half-Hermitian filter bank would miss the last bin of the first dimension,
+      // generate the filter bank with the size of the next level instead.
+      this->m_WaveletFilterBank->SetActualXDimensionIsOdd(this->ComputeFullSizePerLevel(level + 1)[0] % 2 == 1);
+      this->m_WaveletFilterBank->SetSize(inputPerLevel->GetLargestPossibleRegion().GetSize());
+      this->m_WaveletFilterBank->Update();
+      lowPassWavelet = this->m_WaveletFilterBank->GetOutputLowPass();
+      lowPassWavelet->DisconnectPipeline();
+      lowPassWavelet->CopyInformation(inputPerLevel);
+      highPassWavelets = this->m_WaveletFilterBank->GetOutputsHighPassBands();
+      for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+      {
+        highPassWavelets[band]->DisconnectPipeline();
+        highPassWavelets[band]->CopyInformation(inputPerLevel);
+      }
+    }
+    else
     {
-      freqShrinkFilter->Update();
-      inputPerLevel = freqShrinkFilter->GetOutput();
-      /******* DownSample wavelets *****/
       auto decimateWaveletFilter = ShrinkDecimateFilterType::New();
       decimateWaveletFilter->SetInput(lowPassWavelet);
       decimateWaveletFilter->SetShrinkFactors(this->m_ScaleFactor);
@@ -534,17 +1288,37 @@ WaveletFrequencyForward<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
         highPassWavelets[band] = changeHPDecimateInfoFilter->GetOutput();
         highPassWavelets[band]->DisconnectPipeline();
       }
+    }
+    sampleMemoryUsage({ inputPerLevel });
 
-      if (this->m_StoreWaveletFilterBankPyramid)
+    if (level == 0 && !storePyramid && !cacheHit && !this->m_HalfHermitian)
+    {
+      // The images of the filter bank of the first level are only held by the filter bank generator.
+      for (const auto & filterBankImage : this->m_WaveletFilterBank->GetOutputsAll())
       {
-        m_WaveletFilterBankPyramid.push_back(lowPassWavelet);
-        for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
-        {
-          m_WaveletFilterBankPyramid.push_back(highPassWavelets[band]);
-        }
+        filterBankImage->ReleaseData();
       }
-    } // end update inputPerLevel
-  }   // end level
+    }
+
+    if (storePyramid)
+    {
+      m_WaveletFilterBankPyramid.push_back(lowPassWavelet);
+      for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+      {
+        m_WaveletFilterBankPyramid.push_back(highPassWavelets[band]);
+      }
+    }
+  } // end level
+
+  if (insertPyramid)
+  {
+    this->m_WaveletFilterBankPyramidCache->Insert(cacheKey, this->m_WaveletFilterBankPyramid);
+    if (!this->m_StoreWaveletFilterBankPyramid)
+    {
+      this->m_WaveletFilterBankPyramid.clear();
+    }
+  }
+  this->m_RequestedOutputs.assign(this->m_TotalOutputs, false);
 }
 } // end namespace itk
 #endif
@@ -24,6 +24,7 @@
 #include <complex>
 #include <itkFixedArray.h>
 #include <itkImageToImageFilter.h>
+#include <itkWaveletFilterBankPyramidCache.h>
 
 namespace itk
 {
@@ -72,6 +73,8 @@ public:
   using WaveletFunctionType = typename WaveletFilterBankType::WaveletFunctionType;
   using FunctionValueType = typename WaveletFilterBankType::FunctionValueType;
 
+  using WaveletFilterBankPyramidCacheType = WaveletFilterBankPyramidCache<WaveletFilterBankType>;
+
   /** ImageDimension constants */
   static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
 
@@ -112,6 +115,15 @@ public:
 
   itkGetMacro(WaveletFilterBankPyramid, OutputsType);
 
+  /** Cache of filter bank pyramids, looked up before generating the filter banks of the levels, and
+   * filled with them on a miss if the pyramid fits in the cache, \sa WaveletFilterBankPyramidCache::CanInsert.
+   * Otherwise the filter bank of each level is generated when it is used and released after it.
+   * The images of a cached pyramid share their buffers with the cache.
+   * Default: the process-wide cache \sa WaveletFilterBankPyramidCache::GetInstance.
+   * Set to nullptr to always generate the filter banks. */
+  itkSetObjectMacro(WaveletFilterBankPyramidCache, WaveletFilterBankPyramidCacheType);
+  itkGetModifiableObjectMacro(WaveletFilterBankPyramidCache, WaveletFilterBankPyramidCacheType);
+
   /** Compute max number of levels depending on the size of the image.
    * Return J: $ J = \text{min_element}\{J_0,\ldots, J_d\} $;
    * where each $J_i$ is the  number of integer divisions that can be done with the $i$ size and the scale factor.
@@ -192,6 +204,8 @@ private:
   WaveletFilterBankPointer m_WaveletFilterBank;
   bool                     m_StoreWaveletFilterBankPyramid{ false };
   OutputsType              m_WaveletFilterBankPyramid;
+
+  typename WaveletFilterBankPyramidCacheType::Pointer m_WaveletFilterBankPyramidCache;
 };
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -34,6 +34,7 @@ WaveletFrequencyForwardUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
 {
   this->SetNumberOfRequiredInputs(1);
   m_WaveletFilterBank = WaveletFilterBankType::New();
+  m_WaveletFilterBankPyramidCache = WaveletFilterBankPyramidCacheType::GetInstance();
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank>
@@ -146,6 +147,7 @@ WaveletFrequencyForwardUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
   Superclass::PrintSelf(os, indent);
   os << indent << " Levels: " << this->m_Levels << " HighPassSubBands: " << this->m_HighPassSubBands
      << " TotalOutputs: " << this->m_TotalOutputs << std::endl;
+  itkPrintSelfObjectMacro(WaveletFilterBankPyramidCache);
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank>
@@ -286,18 +288,63 @@ WaveletFrequencyForwardUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
   changeInputInfoFilter->SetOutputDirection(direction_new);
   changeInputInfoFilter->Update();
 
-  // Generate WaveletFilterBank.
   this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
   this->m_WaveletFilterBank->SetSize(changeInputInfoFilter->GetOutput()->GetLargestPossibleRegion().GetSize());
-  this->m_WaveletFilterBank->Update();
-  OutputsType        highPassWavelets = this->m_WaveletFilterBank->GetOutputsHighPassBands();
-  OutputImagePointer lowPassWavelet = this->m_WaveletFilterBank->GetOutputLowPass();
+  this->m_WaveletFilterBank->SetLevel(0);
+
+  // Look up the filter bank pyramid in the cache, on a miss it is generated and inserted at the end.
+  const bool                                          useCache = this->m_WaveletFilterBankPyramidCache.IsNotNull();
+  typename WaveletFilterBankPyramidCacheType::KeyType cacheKey;
+  OutputsType                                         cachedPyramid;
+  bool                                                cacheHit = false;
+  if (useCache)
+  {
+    cacheKey = WaveletFilterBankPyramidCacheType::ComputeKey(
+      this->m_WaveletFilterBank,
+      { changeInputInfoFilter->GetOutput()->GetLargestPossibleRegion().GetSize() },
+      this->m_Levels,
+      this->m_ScaleFactor,
+      true);
+    cacheHit = this->m_WaveletFilterBankPyramidCache->Find(cacheKey, cachedPyramid);
+  }
+  const SizeValueType pyramidBytes = static_cast<SizeValueType>(this->m_Levels) * (this->m_HighPassSubBands + 1) *
+                                     inputPerLevel->GetLargestPossibleRegion().GetNumberOfPixels() *
+                                     sizeof(typename OutputImageType::PixelType);
+  // On a miss, keep the filter banks of all the levels only if the pyramid can be inserted.
+  // Otherwise the filter bank of each level is released once the next one is generated.
+  const bool insertPyramid = useCache && !cacheHit && this->m_WaveletFilterBankPyramidCache->CanInsert(pyramidBytes);
+  const bool storePyramid = this->m_StoreWaveletFilterBankPyramid || insertPyramid;
+
+  OutputsType        highPassWavelets;
+  OutputImagePointer lowPassWavelet;
+  if (cacheHit)
+  {
+    lowPassWavelet = cachedPyramid[0];
+    highPassWavelets.assign(cachedPyramid.begin() + 1, cachedPyramid.begin() + 1 + this->m_HighPassSubBands);
+  }
+  else
+  {
+    // Generate WaveletFilterBank.
+    this->m_WaveletFilterBank->Update();
+    highPassWavelets = this->m_WaveletFilterBank->GetOutputsHighPassBands();
+    lowPassWavelet = this->m_WaveletFilterBank->GetOutputLowPass();
+    if (storePyramid)
+    {
+      // The filter bank is generated again in the next levels, keep the images of this level.
+      lowPassWavelet->DisconnectPipeline();
+      for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+      {
+        highPassWavelets[band]->DisconnectPipeline();
+      }
+    }
+  }
 
-  if (this->m_StoreWaveletFilterBankPyramid)
+  if (storePyramid)
   {
-    for (unsigned int bankOutput = 0; bankOutput < this->m_HighPassSubBands + 1; ++bankOutput)
+    this->m_WaveletFilterBankPyramid.push_back(lowPassWavelet);
+    for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
     {
-      this->m_WaveletFilterBankPyramid.push_back(this->m_WaveletFilterBank->GetOutput(bankOutput));
+      this->m_WaveletFilterBankPyramid.push_back(highPassWavelets[band]);
     }
   }
 
@@ -357,17 +404,27 @@ WaveletFrequencyForwardUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
     {
       inputPerLevel = multiplyLowFilter->GetOutput();
       /******* Downsample (scale) wavelets *****/
-      m_WaveletFilterBank->SetLevel(level + 1);
-      m_WaveletFilterBank->Update();
-      lowPassWavelet = m_WaveletFilterBank->GetOutputLowPass();
-      lowPassWavelet->DisconnectPipeline();
-      highPassWavelets = m_WaveletFilterBank->GetOutputsHighPassBands();
-      for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+      if (cacheHit)
       {
-        highPassWavelets[band]->DisconnectPipeline();
+        const unsigned int firstBankOutput = (level + 1) * (1 + this->m_HighPassSubBands);
+        lowPassWavelet = cachedPyramid[firstBankOutput];
+        highPassWavelets.assign(cachedPyramid.begin() + firstBankOutput + 1,
+                                cachedPyramid.begin() + firstBankOutput + 1 + this->m_HighPassSubBands);
+      }
+      else
+      {
+        m_WaveletFilterBank->SetLevel(level + 1);
+        m_WaveletFilterBank->Update();
+        lowPassWavelet = m_WaveletFilterBank->GetOutputLowPass();
+        lowPassWavelet->DisconnectPipeline();
+        highPassWavelets = m_WaveletFilterBank->GetOutputsHighPassBands();
+        for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+        {
+          highPassWavelets[band]->DisconnectPipeline();
+        }
       }
 
-      if (this->m_StoreWaveletFilterBankPyramid)
+      if (storePyramid)
       {
         m_WaveletFilterBankPyramid.push_back(lowPassWavelet);
         for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
@@ -377,6 +434,15 @@ WaveletFrequencyForwardUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
       }
     } // end update inputPerLevel
   }   // end level
+
+  if (insertPyramid)
+  {
+    this->m_WaveletFilterBankPyramidCache->Insert(cacheKey, this->m_WaveletFilterBankPyramid);
+    if (!this->m_StoreWaveletFilterBankPyramid)
+    {
+      this->m_WaveletFilterBankPyramid.clear();
+    }
+  }
 }
 } // end namespace itk
 #endif
@@ -26,6 +26,7 @@
 #include <itkImageToImageFilter.h>
 #include <itkFrequencyExpandViaInverseFFTImageFilter.h>
 #include <itkFrequencyExpandImageFilter.h>
+#include <itkWaveletFilterBankPyramidCache.h>
 
 namespace itk
 {
@@ -68,6 +69,8 @@ public:
 
   using FrequencyExpandFilterType = TFrequencyExpandFilterType;
 
+  using WaveletFilterBankPyramidCacheType = WaveletFilterBankPyramidCache<WaveletFilterBankType>;
+
   /** ImageDimension constants */
   static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
 
@@ -117,6 +120,57 @@ public:
     this->m_WaveletFilterBankPyramid = filterBankPyramid;
   }
 
+  /** Cache of filter bank pyramids, looked up before generating the filter banks of the levels, and
+   * filled with them on a miss if the pyramid fits in the cache, \sa WaveletFilterBankPyramidCache::CanInsert.
+   * Otherwise the filter bank of each level is generated when it is used and released after it.
+   * The images of a cached pyramid share their buffers with the cache.
+   * Default: the process-wide cache \sa WaveletFilterBankPyramidCache::GetInstance.
+   * Set to nullptr to always generate the filter banks.
+   * Not used with UseWaveletFilterBankPyramid or UseVirtualFilterBank. */
+  itkSetObjectMacro(WaveletFilterBankPyramidCache, WaveletFilterBankPyramidCacheType);
+  itkGetModifiableObjectMacro(WaveletFilterBankPyramidCache, WaveletFilterBankPyramidCacheType);
+
+  /** Flag to use the fused engine in GenerateData.
+   * Each level is reconstructed with one multi-threaded sweep that expands the low pass,
+   * and accumulates mask * coefficient * reconstruction factor of all the bands into a
+   * preallocated accumulator. Two accumulators are reused between levels, and the last level
+   * is written directly into the output.
+   * The sum of each bin is accumulated in double precision, also with float pixels, as in the default engine.
+   * Default: false. */
+  itkSetMacro(UseFusedKernel, bool);
+  itkGetConstReferenceMacro(UseFusedKernel, bool);
+  itkBooleanMacro(UseFusedKernel);
+
+  /** Flag to use a virtual filter bank: the reconstruction masks are evaluated on the fly
+   * from the frequency modulo of each bin inside the fused engine, instead of generating
+   * the filter bank images for each level.
+   * Implies the fused engine \sa UseFusedKernel. Not compatible with UseWaveletFilterBankPyramid.
+   * If the WaveletFilterBank has UseProfileTable on, the masks are interpolated from its profile table.
+   * Default: false. */
+  itkSetMacro(UseVirtualFilterBank, bool);
+  itkGetConstReferenceMacro(UseVirtualFilterBank, bool);
+  itkBooleanMacro(UseVirtualFilterBank);
+
+  /** Flag to use the half-Hermitian layout of RealToHalfHermitianForwardFFTImageFilter, as in the outputs of
+   * WaveletFrequencyForward with HalfHermitian on. The inputs and the output store only the bins 0 to N/2
+   * of the first dimension. The sizes of the full spectrum of the levels are computed from the size of
+   * the first input and ActualXDimensionIsOdd, as in the forward. As with the full spectrum, the first
+   * dimension of each level has to be the one of the next level times the scale factor,
+   * an exception is thrown otherwise. The first dimension of the low pass input can be odd.
+   * Use HalfHermitianToRealInverseFFTImageFilter with the same ActualXDimensionIsOdd to get the real image.
+   * Default: false. */
+  itkSetMacro(HalfHermitian, bool);
+  itkGetConstReferenceMacro(HalfHermitian, bool);
+  itkBooleanMacro(HalfHermitian);
+
+  /** The size of the first dimension of the full spectrum of the output is odd, as set in the forward.
+   * Only used with HalfHermitian. An odd size is not divisible by the scale factor, these inputs cannot be
+   * reconstructed and an exception is thrown.
+   * Default: false. */
+  itkSetMacro(ActualXDimensionIsOdd, bool);
+  itkGetConstReferenceMacro(ActualXDimensionIsOdd, bool);
+  itkBooleanMacro(ActualXDimensionIsOdd);
+
   using IndexPairType = std::pair<unsigned int, unsigned int>;
   /** Get the (Level,Band) from a linear index input */
   IndexPairType
@@ -177,6 +231,57 @@ protected:
   void
   VerifyInputInformation() ITKv5_CONST override{};
 
+  /** Get the low pass and high pass masks of the level, from the filter bank pyramid
+   * if UseWaveletFilterBankPyramid is On, from the pyramid of the cache if there is one,
+   * or generating the filter bank with the input size otherwise. The generated masks are kept
+   * for the cache if FindWaveletFilterBankPyramidInCache decided to insert the pyramid. */
+  void
+  ComputeWaveletFilterBankPerLevel(unsigned int                              level,
+                                   const typename InputImageType::SizeType & size,
+                                   InputImagePointer &                       lowPassMask,
+                                   InputsType &                              highPassMasks);
+
+  /** Get the pyramid of the sizes of the inputs from the WaveletFilterBankPyramidCache.
+   * On a miss, if the cache can hold the pyramid, the masks generated for each level while reconstructing
+   * are kept and inserted by InsertWaveletFilterBankPyramidInCache. Nothing is done if the cache is not used. */
+  void
+  FindWaveletFilterBankPyramidInCache();
+
+  /** Insert the pyramid generated level by level on a miss, and release the pyramids used by GenerateData. */
+  void
+  InsertWaveletFilterBankPyramidInCache();
+
+  /** Size of the full spectrum of the inputs of the level, level == Levels for the low pass input.
+   * With HalfHermitian it is computed from the size of the first input and ActualXDimensionIsOdd. */
+  typename InputImageType::SizeType
+  ComputeFullSizePerLevel(unsigned int level) const;
+
+  /** Fused reconstruction of one level, used when UseFusedKernel or UseVirtualFilterBank are on.
+   * accumulator = lowPassMask * expand(lowPassPerLevel) * ScaleFactor^ImageDimension
+   *               + sum_band(highPassMask * input * reconstructionFactor).
+   * The accumulator has to be allocated with the region of the inputs of the level.
+   * The masks are not used (and can be null) with UseVirtualFilterBank. */
+  template <typename TAccumulatorImage>
+  void
+  FusedSynthesisPerLevel(unsigned int           level,
+                         const InputImageType * lowPassPerLevel,
+                         const InputImageType * lowPassMask,
+                         const InputsType &     highPassMasks,
+                         TAccumulatorImage *    accumulator);
+
+  /** Sum of the bands of one level in the pipeline engine, once the low pass has been expanded.
+   * accumulator = lowPassMask * expandedLowPass + sum_band(highPassMask * input * reconstructionFactor).
+   * The sum of each bin is accumulated in NumericTraits<PixelType>::RealType and stored once.
+   * All the images have to be buffered with the size of the level, the bins are matched by their
+   * position in the buffers. */
+  template <typename TAccumulatorImage>
+  void
+  SumBandsPerLevel(unsigned int           level,
+                   const InputImageType * expandedLowPass,
+                   const InputImageType * lowPassMask,
+                   const InputsType &     highPassMasks,
+                   TAccumulatorImage *    accumulator);
+
 private:
   unsigned int             m_Levels{ 1 };
   unsigned int             m_HighPassSubBands{ 1 };
@@ -186,6 +291,17 @@ private:
   bool                     m_UseWaveletFilterBankPyramid{ false };
   WaveletFilterBankPointer m_WaveletFilterBank;
   InputsType               m_WaveletFilterBankPyramid;
+  bool                     m_UseFusedKernel{ false };
+  bool                     m_UseVirtualFilterBank{ false };
+  bool                     m_HalfHermitian{ false };
+  bool                     m_ActualXDimensionIsOdd{ false };
+
+  typename WaveletFilterBankPyramidCacheType::Pointer m_WaveletFilterBankPyramidCache;
+  /** Pyramid of the cache used in the current GenerateData. */
+  InputsType m_CachedWaveletFilterBankPyramid;
+  /** On a miss, masks generated for each level to insert in the cache, and the key of the pyramid. */
+  InputsType                                          m_GeneratedWaveletFilterBankPyramid;
+  typename WaveletFilterBankPyramidCacheType::KeyType m_GeneratedWaveletFilterBankPyramidKey;
 };
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -18,14 +18,11 @@
 #ifndef itkWaveletFrequencyInverse_hxx
 #define itkWaveletFrequencyInverse_hxx
 #include <itkWaveletFrequencyInverse.h>
-#include <itkCastImageFilter.h>
 #include <itkImage.h>
 #include <algorithm>
-#include <itkMultiplyImageFilter.h>
-#include <itkAddImageFilter.h>
-#include <itkImageDuplicator.h>
 #include <itkChangeInformationImageFilter.h>
 #include <itkWaveletUtilities.h>
+#include <itkImageRegionIndexRange.h>
 
 namespace itk
 {
@@ -37,6 +34,7 @@ WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
 {
   this->SetNumberOfRequiredOutputs(1);
   this->m_WaveletFilterBank = WaveletFilterBankType::New();
+  this->m_WaveletFilterBankPyramidCache = WaveletFilterBankPyramidCacheType::GetInstance();
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
@@ -138,7 +136,12 @@ WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   os << indent << "ScaleFactor: " << this->m_ScaleFactor << std::endl;
   os << indent << "ApplyReconstructionFactors: " << this->m_ApplyReconstructionFactors << std::endl;
   os << indent << "UseWaveletFilterBankPyramid: " << this->m_UseWaveletFilterBankPyramid << std::endl;
+  os << indent << "UseFusedKernel: " << this->m_UseFusedKernel << std::endl;
+  os << indent << "UseVirtualFilterBank: " << this->m_UseVirtualFilterBank << std::endl;
+  os << indent << "HalfHermitian: " << this->m_HalfHermitian << std::endl;
+  os << indent << "ActualXDimensionIsOdd: " << this->m_ActualXDimensionIsOdd << std::endl;
   itkPrintSelfObjectMacro(WaveletFilterBank);
+  itkPrintSelfObjectMacro(WaveletFilterBankPyramidCache);
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
@@ -176,6 +179,28 @@ WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   outputPtr->SetOrigin(inputOrigin);
   outputPtr->SetSpacing(inputSpacing);
   outputPtr->SetDirection(inputDirection);
+
+  // The sizes of the full spectrum are not given by the half-Hermitian inputs, check that they can be reconstructed.
+  if (this->m_HalfHermitian)
+  {
+    for (unsigned int level = 0; level < this->m_Levels + 1; ++level)
+    {
+      const unsigned int nInput = std::min(level * this->m_HighPassSubBands, this->m_TotalInputs - 1);
+      const auto         levelFullSize = this->ComputeFullSizePerLevel(level);
+      if (itk::utils::ComputeHalfHermitianSize<ImageDimension>(levelFullSize) !=
+          this->GetInput(nInput)->GetLargestPossibleRegion().GetSize())
+      {
+        itkExceptionMacro(<< "Input: " << nInput << " does not have the half-Hermitian size of the full spectrum "
+                          << levelFullSize << ". Check ActualXDimensionIsOdd.");
+      }
+      if (level > 0 && this->ComputeFullSizePerLevel(level - 1)[0] != levelFullSize[0] * this->m_ScaleFactor)
+      {
+        itkExceptionMacro(<< "The first dimension of the full spectrum of level: " << level - 1 << " is "
+                          << this->ComputeFullSizePerLevel(level - 1)[0]
+                          << ", it is not divisible by the scale factor and cannot be reconstructed.");
+      }
+    }
+  }
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
@@ -195,6 +220,22 @@ WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   // call the superclass' implementation of this method
   Superclass::GenerateInputRequestedRegion();
 
+  // The stored half of the first dimension does not scale with the levels, and the bins not stored
+  // are read from their mirror. Request the whole inputs.
+  if (this->m_HalfHermitian)
+  {
+    for (unsigned int nInput = 0; nInput < this->m_TotalInputs; ++nInput)
+    {
+      InputImagePointer inputPtr = const_cast<InputImageType *>(this->GetInput(nInput));
+      if (!inputPtr)
+      {
+        itkExceptionMacro(<< "Input ptr does not exist: " << nInput);
+      }
+      inputPtr->SetRequestedRegionToLargestPossibleRegion();
+    }
+    return;
+  }
+
   // compute baseIndex and baseSize
   using SizeType = typename OutputImageType::SizeType;
   using IndexType = typename OutputImageType::IndexType;
@@ -263,6 +304,431 @@ WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
   inputPtr->SetRequestedRegion(inputRegion);
 }
 
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
+typename WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilterType>::
+  InputImageType::SizeType
+  WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilterType>::
+    ComputeFullSizePerLevel(unsigned int level) const
+{
+  if (!this->m_HalfHermitian)
+  {
+    const unsigned int nInput = std::min(level * this->m_HighPassSubBands, this->m_TotalInputs - 1);
+    return this->GetInput(nInput)->GetLargestPossibleRegion().GetSize();
+  }
+  typename InputImageType::SizeType fullSize = itk::utils::ComputeFullSizeFromHalfHermitianSize<ImageDimension>(
+    this->GetInput(0)->GetLargestPossibleRegion().GetSize(), this->m_ActualXDimensionIsOdd);
+  for (unsigned int l = 0; l < level; ++l)
+  {
+    for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+    {
+      fullSize[idim] = std::max(fullSize[idim] / this->m_ScaleFactor, static_cast<SizeValueType>(1));
+    }
+  }
+  return fullSize;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
+void
+WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilterType>::
+  ComputeWaveletFilterBankPerLevel(unsigned int                              level,
+                                   const typename InputImageType::SizeType & size,
+                                   InputImagePointer &                       lowPassMask,
+                                   InputsType &                              highPassMasks)
+{
+  highPassMasks.clear();
+  const InputsType * pyramid = nullptr;
+  if (this->m_UseWaveletFilterBankPyramid)
+  {
+    pyramid = &this->m_WaveletFilterBankPyramid;
+  }
+  else if (!this->m_CachedWaveletFilterBankPyramid.empty())
+  {
+    pyramid = &this->m_CachedWaveletFilterBankPyramid;
+  }
+
+  if (pyramid == nullptr)
+  {
+    this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
+    this->m_WaveletFilterBank->SetSize(size);
+    this->m_WaveletFilterBank->SetInverseBank(true);
+    this->m_WaveletFilterBank->SetHalfHermitian(this->m_HalfHermitian);
+    this->m_WaveletFilterBank->SetActualXDimensionIsOdd(this->m_HalfHermitian &&
+                                                        this->ComputeFullSizePerLevel(level)[0] % 2 == 1);
+    this->m_WaveletFilterBank->Modified();
+    this->m_WaveletFilterBank->UpdateLargestPossibleRegion();
+    lowPassMask = this->m_WaveletFilterBank->GetOutputLowPass();
+    highPassMasks = this->m_WaveletFilterBank->GetOutputsHighPassBands();
+    if (!this->m_GeneratedWaveletFilterBankPyramid.empty())
+    {
+      // The filter bank is generated again in the next levels, keep the images of this level for the cache.
+      const unsigned int firstBankOutput = level * (1 + this->m_HighPassSubBands);
+      lowPassMask->DisconnectPipeline();
+      this->m_GeneratedWaveletFilterBankPyramid[firstBankOutput] = lowPassMask;
+      for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+      {
+        highPassMasks[band]->DisconnectPipeline();
+        this->m_GeneratedWaveletFilterBankPyramid[firstBankOutput + 1 + band] = highPassMasks[band];
+      }
+    }
+  }
+  else
+  {
+    lowPassMask = (*pyramid)[level * (1 + this->m_HighPassSubBands)];
+    highPassMasks.insert(highPassMasks.begin(),
+                         pyramid->begin() + 1 + level * (1 + this->m_HighPassSubBands),
+                         pyramid->begin() + this->m_HighPassSubBands + 1 + level * (1 + this->m_HighPassSubBands));
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
+void
+WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilterType>::
+  FindWaveletFilterBankPyramidInCache()
+{
+  this->m_CachedWaveletFilterBankPyramid.clear();
+  this->m_GeneratedWaveletFilterBankPyramid.clear();
+  if (this->m_WaveletFilterBankPyramidCache.IsNull() || this->m_UseWaveletFilterBankPyramid ||
+      this->m_UseVirtualFilterBank)
+  {
+    return;
+  }
+
+  std::vector<typename InputImageType::SizeType> sizes;
+  SizeValueType                                  pyramidPixels = 0;
+  for (unsigned int level = 0; level < this->m_Levels; ++level)
+  {
+    const auto & levelRegion = this->GetInput(level * this->m_HighPassSubBands)->GetLargestPossibleRegion();
+    sizes.push_back(levelRegion.GetSize());
+    pyramidPixels += (1 + this->m_HighPassSubBands) * levelRegion.GetNumberOfPixels();
+  }
+  this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
+  this->m_WaveletFilterBank->SetInverseBank(true);
+  this->m_WaveletFilterBank->SetHalfHermitian(this->m_HalfHermitian);
+  this->m_WaveletFilterBank->SetActualXDimensionIsOdd(this->m_ActualXDimensionIsOdd);
+  const auto key = WaveletFilterBankPyramidCacheType::ComputeKey(
+    this->m_WaveletFilterBank, sizes, this->m_Levels, this->m_ScaleFactor, false);
+  if (this->m_WaveletFilterBankPyramidCache->Find(key, this->m_CachedWaveletFilterBankPyramid))
+  {
+    return;
+  }
+  // The masks are generated level by level while reconstructing, keep them only if the pyramid can be inserted.
+  if (this->m_WaveletFilterBankPyramidCache->CanInsert(pyramidPixels * sizeof(typename InputImageType::PixelType)))
+  {
+    this->m_GeneratedWaveletFilterBankPyramid.resize(this->m_Levels * (1 + this->m_HighPassSubBands));
+    this->m_GeneratedWaveletFilterBankPyramidKey = key;
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
+void
+WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilterType>::
+  InsertWaveletFilterBankPyramidInCache()
+{
+  if (!this->m_GeneratedWaveletFilterBankPyramid.empty())
+  {
+    this->m_WaveletFilterBankPyramidCache->Insert(this->m_GeneratedWaveletFilterBankPyramidKey,
+                                                  this->m_GeneratedWaveletFilterBankPyramid);
+  }
+  this->m_GeneratedWaveletFilterBankPyramid.clear();
+  this->m_CachedWaveletFilterBankPyramid.clear();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
+template <typename TAccumulatorImage>
+void
+WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilterType>::
+  FusedSynthesisPerLevel(unsigned int           level,
+                         const InputImageType * lowPassPerLevel,
+                         const InputImageType * lowPassMask,
+                         const InputsType &     highPassMasks,
+                         TAccumulatorImage *    accumulator)
+{
+  using RegionType = typename InputImageType::RegionType;
+  using SizeType = typename InputImageType::SizeType;
+  using IndexType = typename InputImageType::IndexType;
+  using PixelType = typename InputImageType::PixelType;
+  using AccumulatorPixelType = typename TAccumulatorImage::PixelType;
+  // The sum of the bands of each bin is accumulated in double precision, also for float pixels.
+  using SumPixelType = typename NumericTraits<PixelType>::RealType;
+  using SumValueType = typename NumericTraits<SumPixelType>::ValueType;
+
+  const RegionType levelRegion = this->GetInput(level * this->m_HighPassSubBands)->GetLargestPossibleRegion();
+  const SizeType   levelSize = levelRegion.GetSize();
+  const SizeType   lowPassSize = lowPassPerLevel->GetLargestPossibleRegion().GetSize();
+  // Sizes of the full spectrum. With HalfHermitian, the first dimension of the one of the low pass can be odd.
+  const SizeType levelFullSize = this->ComputeFullSizePerLevel(level);
+  const SizeType lowPassFullSize = this->m_HalfHermitian ? this->ComputeFullSizePerLevel(level + 1) : lowPassSize;
+  const bool     lowPassSizeIsValid =
+    !this->m_HalfHermitian || itk::utils::ComputeHalfHermitianSize<ImageDimension>(lowPassFullSize) == lowPassSize;
+  for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+  {
+    if (!lowPassSizeIsValid || lowPassFullSize[idim] * this->m_ScaleFactor != levelFullSize[idim])
+    {
+      itkExceptionMacro(<< "Level: " << level << " has size " << levelSize << ", but the expanded low pass of size "
+                        << lowPassSize << " does not match it.");
+    }
+  }
+  const bool useVirtualFilterBank = this->m_UseVirtualFilterBank;
+  if ((!useVirtualFilterBank && lowPassMask->GetBufferedRegion().GetSize() != levelSize) ||
+      accumulator->GetBufferedRegion().GetSize() != levelSize ||
+      lowPassPerLevel->GetBufferedRegion() != lowPassPerLevel->GetLargestPossibleRegion())
+  {
+    itkExceptionMacro(<< "Buffered regions of level: " << level << " are not the expected ones.");
+  }
+
+  // Index in the full spectrum of the low pass of the expanded bins, per dimension, as in FrequencyExpandImageFilter:
+  // positive frequencies at the beginning, negative at the end. Negative index for the zero padded bins.
+  const OffsetValueType *                  lowPassOffsetTable = lowPassPerLevel->GetOffsetTable();
+  std::vector<std::vector<IndexValueType>> expandIndices(ImageDimension);
+  for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+  {
+    expandIndices[idim].resize(levelSize[idim]);
+    const SizeValueType negativeStart = levelFullSize[idim] - lowPassFullSize[idim];
+    for (SizeValueType k = 0; k < levelSize[idim]; ++k)
+    {
+      if (k >= negativeStart)
+      {
+        expandIndices[idim][k] = static_cast<IndexValueType>(k - negativeStart);
+      }
+      else if (k < lowPassFullSize[idim])
+      {
+        expandIndices[idim][k] = static_cast<IndexValueType>(k);
+      }
+      else
+      {
+        expandIndices[idim][k] = -1;
+      }
+    }
+  }
+
+  const auto                     scaleFactor = static_cast<double>(this->m_ScaleFactor);
+  std::vector<const PixelType *> bandInputBuffers(this->m_HighPassSubBands);
+  std::vector<const PixelType *> highPassMaskBuffers(this->m_HighPassSubBands);
+  std::vector<SumValueType>      reconstructionBandFactors(this->m_HighPassSubBands);
+  for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+  {
+    const InputImageType * bandInputImage = this->GetInput(level * this->m_HighPassSubBands + band);
+    if (bandInputImage->GetBufferedRegion() != levelRegion ||
+        (!useVirtualFilterBank && highPassMasks[band]->GetBufferedRegion().GetSize() != levelSize))
+    {
+      itkExceptionMacro(<< "Band: " << band << " of level: " << level << " does not have the expected region.");
+    }
+    bandInputBuffers[band] = bandInputImage->GetBufferPointer();
+    if (!useVirtualFilterBank)
+    {
+      highPassMaskBuffers[band] = highPassMasks[band]->GetBufferPointer();
+    }
+    double expBandFactor = 0;
+    if (this->GetApplyReconstructionFactors())
+    {
+      expBandFactor =
+        (static_cast<double>(level) - band / static_cast<double>(this->m_HighPassSubBands)) * ImageDimension / 2.0;
+    }
+    reconstructionBandFactors[band] = static_cast<SumValueType>(std::pow(scaleFactor, expBandFactor));
+  }
+
+  const auto upsampleCorrection =
+    static_cast<SumValueType>(std::pow(scaleFactor, static_cast<double>(ImageDimension)));
+  // Virtual filter bank: the masks are evaluated from the frequency modulo of each bin,
+  // as the filter bank generated with the size of the level.
+  const WaveletFunctionType *      waveletFunction = this->m_WaveletFilterBank->GetModifiableWaveletFunction();
+  std::vector<std::vector<double>> frequencyModuloSquare;
+  const PixelType *                lowPassMaskBuffer = nullptr;
+  if (useVirtualFilterBank)
+  {
+    frequencyModuloSquare =
+      itk::utils::ComputeFrequencyModuloSquarePerDimension<ImageDimension>(levelSize, levelFullSize);
+  }
+  else
+  {
+    lowPassMaskBuffer = lowPassMask->GetBufferPointer();
+  }
+  // Profiles interpolated from the table of the filter bank, if requested. Unit spacing: maximum frequency is 1/2.
+  const typename WaveletFilterBankType::ProfileTableType * profileTable = nullptr;
+  if (useVirtualFilterBank && this->m_WaveletFilterBank->GetUseProfileTable())
+  {
+    profileTable = this->m_WaveletFilterBank->GetProfileTable(0.25 * ImageDimension);
+  }
+
+  const PixelType *       lowPassBuffer = lowPassPerLevel->GetBufferPointer();
+  AccumulatorPixelType *  accumulatorBuffer = accumulator->GetBufferPointer();
+  const OffsetValueType * levelOffsetTable = accumulator->GetOffsetTable();
+  const IndexType         levelStartIndex = levelRegion.GetIndex();
+  const unsigned int      highPassSubBands = this->m_HighPassSubBands;
+  const bool              halfHermitian = this->m_HalfHermitian;
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    levelRegion,
+    [&](const RegionType & region) {
+      std::vector<FunctionValueType> subBands(highPassSubBands + 1);
+      for (const IndexType & index : ImageRegionIndexRange<ImageDimension>(region))
+      {
+        OffsetValueType offset = 0;
+        OffsetValueType lowPassOffset = 0;
+        IndexValueType  lowPassIndex[ImageDimension];
+        double          w2 = 0;
+        bool            isExpandedBin = true;
+        for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+        {
+          const OffsetValueType k = index[idim] - levelStartIndex[idim];
+          offset += k * levelOffsetTable[idim];
+          if (useVirtualFilterBank)
+          {
+            w2 += frequencyModuloSquare[idim][k];
+          }
+          lowPassIndex[idim] = expandIndices[idim][k];
+          if (lowPassIndex[idim] < 0)
+          {
+            isExpandedBin = false;
+          }
+          else
+          {
+            lowPassOffset += lowPassIndex[idim] * lowPassOffsetTable[idim];
+          }
+        }
+        // Expanded low pass, read from the hermitian mirror if the bin is not stored.
+        SumPixelType lowPassValue = NumericTraits<SumPixelType>::ZeroValue();
+        if (isExpandedBin)
+        {
+          if (halfHermitian && itk::utils::ComputeHalfHermitianOffset<ImageDimension>(
+                                 lowPassIndex, lowPassFullSize, lowPassSize[0], lowPassOffsetTable, lowPassOffset))
+          {
+            lowPassValue = static_cast<SumPixelType>(itk::utils::ComplexConjugate(lowPassBuffer[lowPassOffset])) *
+                           upsampleCorrection;
+          }
+          else
+          {
+            lowPassValue = static_cast<SumPixelType>(lowPassBuffer[lowPassOffset]) * upsampleCorrection;
+          }
+        }
+
+        SumPixelType value = NumericTraits<SumPixelType>::ZeroValue();
+        if (useVirtualFilterBank)
+        {
+          // SubBand 0 is the low pass, HighPassSubBands is the highest.
+          if (profileTable)
+          {
+            profileTable->EvaluateSubBands(w2, subBands.data());
+          }
+          else
+          {
+            const auto w = static_cast<FunctionValueType>(std::sqrt(w2));
+            for (unsigned int j = 0; j < highPassSubBands + 1; ++j)
+            {
+              subBands[j] = waveletFunction->EvaluateInverseSubBand(w, j);
+            }
+          }
+          for (unsigned int band = 0; band < highPassSubBands; ++band)
+          {
+            const auto mask = static_cast<SumValueType>(subBands[band + 1]);
+            value += mask * static_cast<SumPixelType>(bandInputBuffers[band][offset]) * reconstructionBandFactors[band];
+          }
+          if (isExpandedBin)
+          {
+            const auto mask = static_cast<SumValueType>(subBands[0]);
+            value += mask * lowPassValue;
+          }
+        }
+        else
+        {
+          for (unsigned int band = 0; band < highPassSubBands; ++band)
+          {
+            value += static_cast<SumPixelType>(highPassMaskBuffers[band][offset]) *
+                     static_cast<SumPixelType>(bandInputBuffers[band][offset]) * reconstructionBandFactors[band];
+          }
+          if (isExpandedBin)
+          {
+            value += static_cast<SumPixelType>(lowPassMaskBuffer[offset]) * lowPassValue;
+          }
+        }
+        accumulatorBuffer[offset] = static_cast<AccumulatorPixelType>(value);
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank, typename TFrequencyExpandFilterType>
+template <typename TAccumulatorImage>
+void
+WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilterType>::SumBandsPerLevel(
+  unsigned int           level,
+  const InputImageType * expandedLowPass,
+  const InputImageType * lowPassMask,
+  const InputsType &     highPassMasks,
+  TAccumulatorImage *    accumulator)
+{
+  using RegionType = typename InputImageType::RegionType;
+  using SizeType = typename InputImageType::SizeType;
+  using IndexType = typename InputImageType::IndexType;
+  using PixelType = typename InputImageType::PixelType;
+  using AccumulatorPixelType = typename TAccumulatorImage::PixelType;
+  // The sum of the bands of each bin is accumulated in double precision, also for float pixels.
+  using SumPixelType = typename NumericTraits<PixelType>::RealType;
+  using SumValueType = typename NumericTraits<SumPixelType>::ValueType;
+
+  const RegionType levelRegion = accumulator->GetBufferedRegion();
+  const SizeType   levelSize = levelRegion.GetSize();
+  if (expandedLowPass->GetBufferedRegion().GetSize() != levelSize ||
+      lowPassMask->GetBufferedRegion().GetSize() != levelSize)
+  {
+    itkExceptionMacro(<< "Buffered regions of level: " << level << " are not the expected ones.");
+  }
+
+  const auto                     scaleFactor = static_cast<double>(this->m_ScaleFactor);
+  std::vector<const PixelType *> bandInputBuffers(this->m_HighPassSubBands);
+  std::vector<const PixelType *> highPassMaskBuffers(this->m_HighPassSubBands);
+  std::vector<SumValueType>      reconstructionBandFactors(this->m_HighPassSubBands);
+  for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+  {
+    const InputImageType * bandInputImage = this->GetInput(level * this->m_HighPassSubBands + band);
+    if (bandInputImage->GetBufferedRegion().GetSize() != levelSize ||
+        highPassMasks[band]->GetBufferedRegion().GetSize() != levelSize)
+    {
+      itkExceptionMacro(<< "Band: " << band << " of level: " << level << " does not have the expected region.");
+    }
+    bandInputBuffers[band] = bandInputImage->GetBufferPointer();
+    highPassMaskBuffers[band] = highPassMasks[band]->GetBufferPointer();
+    //  2^(1/#bands) instead of Dyadic dilations.
+    double expBandFactor = 0;
+    if (this->GetApplyReconstructionFactors())
+    {
+      expBandFactor =
+        (static_cast<double>(level) - band / static_cast<double>(this->m_HighPassSubBands)) * ImageDimension / 2.0;
+    }
+    reconstructionBandFactors[band] = static_cast<SumValueType>(std::pow(scaleFactor, expBandFactor));
+  }
+
+  const PixelType *       expandedLowPassBuffer = expandedLowPass->GetBufferPointer();
+  const PixelType *       lowPassMaskBuffer = lowPassMask->GetBufferPointer();
+  AccumulatorPixelType *  accumulatorBuffer = accumulator->GetBufferPointer();
+  const OffsetValueType * levelOffsetTable = accumulator->GetOffsetTable();
+  const IndexType         levelStartIndex = levelRegion.GetIndex();
+  const unsigned int      highPassSubBands = this->m_HighPassSubBands;
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    levelRegion,
+    [&](const RegionType & region) {
+      for (const IndexType & index : ImageRegionIndexRange<ImageDimension>(region))
+      {
+        // Position of the bin in the buffers, the same for all the images of the level.
+        OffsetValueType offset = 0;
+        for (unsigned int idim = 0; idim < ImageDimension; ++idim)
+        {
+          offset += (index[idim] - levelStartIndex[idim]) * levelOffsetTable[idim];
+        }
+        SumPixelType value = static_cast<SumPixelType>(lowPassMaskBuffer[offset]) *
+                             static_cast<SumPixelType>(expandedLowPassBuffer[offset]);
+        for (unsigned int band = 0; band < highPassSubBands; ++band)
+        {
+          value += static_cast<SumPixelType>(highPassMaskBuffers[band][offset]) *
+                   static_cast<SumPixelType>(bandInputBuffers[band][offset]) * reconstructionBandFactors[band];
+        }
+        accumulatorBuffer[offset] = static_cast<AccumulatorPixelType>(value);
+      }
+    },
+    nullptr);
+}
+
 // ITK forward implementation: Freq Domain
 //    - HPs (lv1 wavelet coef)
 // I -             - HPs (lv2 wavelet coef)
@@ -274,18 +740,72 @@ void
 WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequencyExpandFilterType>::GenerateData()
 {
   this->AllocateOutputs();
-  // Start with the approximation image (the smallest).
-  InputImageConstPointer low_pass = this->GetInput(this->m_TotalInputs - 1);
+  this->FindWaveletFilterBankPyramidInCache();
+
+  if (this->m_UseFusedKernel || this->m_UseVirtualFilterBank)
+  {
+    if (this->m_UseVirtualFilterBank)
+    {
+      if (this->m_UseWaveletFilterBankPyramid)
+      {
+        itkExceptionMacro(<< "UseWaveletFilterBankPyramid cannot be used with UseVirtualFilterBank.");
+      }
+      this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
+      this->m_WaveletFilterBank->SetInverseBank(true);
+      this->m_WaveletFilterBank->SetHalfHermitian(this->m_HalfHermitian);
+      this->m_WaveletFilterBank->GetModifiableWaveletFunction()->SetHighPassSubBands(this->m_HighPassSubBands);
+    }
+    // Accumulators are used in turns, the input low pass of each level is the accumulator of the previous one.
+    // Allocate them first with the biggest size required (levels 1 and 2), so they are not reallocated later.
+    InputImagePointer accumulators[2] = { InputImageType::New(), InputImageType::New() };
+    for (unsigned int level = 1; level < 3 && level < this->m_Levels; ++level)
+    {
+      accumulators[level % 2]->SetRegions(
+        this->GetInput(level * this->m_HighPassSubBands)->GetLargestPossibleRegion());
+      accumulators[level % 2]->Allocate();
+    }
 
-  using DuplicatorType = itk::ImageDuplicator<InputImageType>;
-  auto duplicator = DuplicatorType::New();
-  duplicator->SetInputImage(low_pass);
-  duplicator->Update();
-  InputImagePointer low_pass_per_level = duplicator->GetOutput();
+    InputImageConstPointer lowPassPerLevel = this->GetInput(this->m_TotalInputs - 1);
+    for (int level = this->m_Levels - 1; level > -1; --level)
+    {
+      itkDebugMacro(<< "LEVEL: " << level);
+      const InputImageType * bandInputImage = this->GetInput(level * this->m_HighPassSubBands);
+      InputImagePointer      waveletLow;
+      InputsType             highPassMasks;
+      if (!this->m_UseVirtualFilterBank)
+      {
+        this->ComputeWaveletFilterBankPerLevel(
+          level, bandInputImage->GetLargestPossibleRegion().GetSize(), waveletLow, highPassMasks);
+      }
+
+      if (level == 0 /* Last level to compute */)
+      {
+        OutputImageType * outputPtr = this->GetOutput();
+        outputPtr->SetBufferedRegion(outputPtr->GetLargestPossibleRegion());
+        outputPtr->Allocate();
+        this->FusedSynthesisPerLevel(level, lowPassPerLevel, waveletLow, highPassMasks, outputPtr);
+      }
+      else
+      {
+        InputImagePointer & accumulator = accumulators[level % 2];
+        accumulator->SetOrigin(bandInputImage->GetOrigin());
+        accumulator->SetSpacing(bandInputImage->GetSpacing());
+        accumulator->SetDirection(bandInputImage->GetDirection());
+        accumulator->SetRegions(bandInputImage->GetLargestPossibleRegion());
+        accumulator->Allocate();
+        this->FusedSynthesisPerLevel(level, lowPassPerLevel, waveletLow, highPassMasks, accumulator.GetPointer());
+        lowPassPerLevel = accumulator;
+      }
+      this->UpdateProgress(static_cast<float>(this->m_Levels - level) / static_cast<float>(this->m_Levels));
+    }
+    this->InsertWaveletFilterBankPyramidInCache();
+    return;
+  }
 
-  using MultiplyFilterType = itk::MultiplyImageFilter<InputImageType>;
+  // Start with the approximation image (the smallest).
+  // The expand filter does not modify its input and every level is summed into a new image, no copy is needed.
+  InputImageConstPointer low_pass_per_level = this->GetInput(this->m_TotalInputs - 1);
 
-  auto scaleFactor = static_cast<double>(this->m_ScaleFactor);
   for (int level = this->m_Levels - 1; level > -1; --level)
   {
     itkDebugMacro(<< "LEVEL: " << level);
@@ -293,149 +813,50 @@ WaveletFrequencyInverse<TInputImage, TOutputImage, TWaveletFilterBank, TFrequenc
     auto expandFilter = FrequencyExpandFilterType::New();
     expandFilter->SetInput(low_pass_per_level);
     expandFilter->SetExpandFactors(this->m_ScaleFactor);
+    // Upsample correction: ScaleFactor^ImageDimension.
+    expandFilter->SetApplyUpsampleCorrection(true);
+    if (this->m_HalfHermitian)
+    {
+      // The expanded low pass has the size of the level, the first dimension of the low pass can be odd.
+      expandFilter->SetHalfHermitian(true);
+      expandFilter->SetActualXDimensionIsOdd(this->ComputeFullSizePerLevel(level + 1)[0] % 2 == 1);
+    }
     expandFilter->Update();
     itkDebugMacro(<< "Low_pass_per_level: " << level << " Region:" << low_pass_per_level->GetLargestPossibleRegion());
-
-    auto multiplyUpsampleCorrection = MultiplyFilterType::New();
-    multiplyUpsampleCorrection->SetInput1(expandFilter->GetOutput());
-    auto expUpsampleCorrection = static_cast<double>(ImageDimension);
-    multiplyUpsampleCorrection->SetConstant(std::pow(scaleFactor, expUpsampleCorrection));
-    multiplyUpsampleCorrection->InPlaceOn();
-    multiplyUpsampleCorrection->Update();
-    low_pass_per_level = multiplyUpsampleCorrection->GetOutput();
+    InputImagePointer expandedLowPass = expandFilter->GetOutput();
 
     /******* Calculate FilterBank with the right size per level. *****/
     // Save the FilterBank vector created in the forward wavelet and load it here to save compute it again.
     // TODO perform regression test between two approaches.
 
     InputImagePointer waveletLow;
-    if (!this->m_UseWaveletFilterBankPyramid)
-    {
-      this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
-      this->m_WaveletFilterBank->SetSize(low_pass_per_level->GetLargestPossibleRegion().GetSize());
-      this->m_WaveletFilterBank->SetInverseBank(true);
-      this->m_WaveletFilterBank->Modified();
-      this->m_WaveletFilterBank->UpdateLargestPossibleRegion();
-      // this->m_WaveletFilterBank->Update();
-      waveletLow = this->m_WaveletFilterBank->GetOutputLowPass();
-    }
-    else
-    {
-      waveletLow = this->m_WaveletFilterBankPyramid[level * (1 + this->m_HighPassSubBands)];
-    }
+    InputsType        highPassMasks;
+    this->ComputeWaveletFilterBankPerLevel(
+      level, expandedLowPass->GetLargestPossibleRegion().GetSize(), waveletLow, highPassMasks);
     itkDebugMacro(<< "waveletLow: " << level << " Region:" << waveletLow->GetLargestPossibleRegion());
 
-    using ChangeInformationFilterType = itk::ChangeInformationImageFilter<InputImageType>;
-    auto changeWaveletInfoFilter = ChangeInformationFilterType::New();
-    // changeWaveletInfoFilter->SetInput(upsampleFilter->GetOutput());
-    changeWaveletInfoFilter->SetInput(waveletLow);
-    changeWaveletInfoFilter->UseReferenceImageOn();
-    changeWaveletInfoFilter->SetReferenceImage(low_pass_per_level);
-    changeWaveletInfoFilter->ChangeRegionOn();
-    changeWaveletInfoFilter->ChangeDirectionOn();
-    changeWaveletInfoFilter->ChangeSpacingOn();
-    changeWaveletInfoFilter->ChangeOriginOn();
-    changeWaveletInfoFilter->Update();
-
-    /******* LowPass band *****/
-    auto multiplyLowPass = MultiplyFilterType::New();
-    multiplyLowPass->SetInput1(changeWaveletInfoFilter->GetOutput());
-    multiplyLowPass->SetInput2(low_pass_per_level);
-    multiplyLowPass->Update();
-    low_pass_per_level = multiplyLowPass->GetOutput();
-
-    /******* HighPass sub-bands *****/
-    InputsType highPassMasks;
-    if (!this->m_UseWaveletFilterBankPyramid)
-    {
-      highPassMasks = this->m_WaveletFilterBank->GetOutputsHighPassBands();
-    }
-    else
-    {
-      highPassMasks.insert(highPassMasks.begin(),
-                           this->m_WaveletFilterBankPyramid.begin() + 1 + level * (1 + this->m_HighPassSubBands),
-                           this->m_WaveletFilterBankPyramid.begin() + this->m_HighPassSubBands + 1 +
-                             level * (1 + this->m_HighPassSubBands));
-    }
-    // Store HighBands steps into high_pass_reconstruction image:
-    InputImagePointer reconstructed = InputImageType::New();
-    reconstructed->SetRegions(low_pass_per_level->GetLargestPossibleRegion());
-    reconstructed->Allocate();
-    reconstructed->FillBuffer(0);
-    InputImagePointer bandInputImage;
-    for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
-    {
-      unsigned int nInput = level * this->m_HighPassSubBands + band;
-      bandInputImage = const_cast<InputImageType *>(this->GetInput(nInput));
-      reconstructed->SetSpacing(bandInputImage->GetSpacing());
-      reconstructed->SetOrigin(bandInputImage->GetOrigin());
-
-      auto changeWaveletHighInfoFilter = ChangeInformationFilterType::New();
-      changeWaveletHighInfoFilter->SetInput(highPassMasks[band]);
-      changeWaveletHighInfoFilter->UseReferenceImageOn();
-      changeWaveletHighInfoFilter->SetReferenceImage(bandInputImage);
-      changeWaveletHighInfoFilter->ChangeRegionOff();
-      changeWaveletHighInfoFilter->ChangeDirectionOn();
-      changeWaveletHighInfoFilter->ChangeSpacingOn();
-      changeWaveletHighInfoFilter->ChangeOriginOn();
-      changeWaveletHighInfoFilter->UpdateLargestPossibleRegion();
-      highPassMasks[band] = changeWaveletHighInfoFilter->GetOutput();
-      highPassMasks[band]->DisconnectPipeline();
-
-      auto multiplyHighBandFilter = MultiplyFilterType::New();
-      multiplyHighBandFilter->SetInput1(highPassMasks[band]);
-      multiplyHighBandFilter->SetInput2(bandInputImage);
-      multiplyHighBandFilter->UpdateLargestPossibleRegion();
-
-      /******* Band dilation factor for HighPass bands *****/
-      //  2^(1/#bands) instead of Dyadic dilations.
-      auto multiplyByReconstructionBandFactor = MultiplyFilterType::New();
-      multiplyByReconstructionBandFactor->SetInput1(multiplyHighBandFilter->GetOutput());
-      double expBandFactor = 0;
-      if (this->GetApplyReconstructionFactors())
-      {
-        expBandFactor =
-          (static_cast<double>(level) - band / static_cast<double>(this->m_HighPassSubBands)) * ImageDimension / 2.0;
-      }
-      multiplyByReconstructionBandFactor->SetConstant(std::pow(scaleFactor, expBandFactor));
-      multiplyByReconstructionBandFactor->InPlaceOn();
-      multiplyByReconstructionBandFactor->Update();
-
-      /******* Add high bands *****/
-      using AddFilterType = itk::AddImageFilter<InputImageType>;
-      auto addFilter = AddFilterType::New();
-      addFilter->SetInput1(reconstructed);
-      addFilter->SetInput2(multiplyByReconstructionBandFactor->GetOutput());
-      addFilter->InPlaceOn();
-      addFilter->Update();
-      reconstructed = addFilter->GetOutput();
-
-      this->UpdateProgress(static_cast<float>(m_TotalInputs - nInput - 1) / static_cast<float>(m_TotalInputs));
-    }
-
-    /******* Add low pass to the sum of high pass bands. *****/
-    using AddFilterType = itk::AddImageFilter<InputImageType>;
-    auto addHighAndLow = AddFilterType::New();
-    addHighAndLow->SetInput1(reconstructed.GetPointer()); // HighBands
-    // addHighAndLow->SetInput2(multiplyLowByReconstructLevelFactor->GetOutput());
-    addHighAndLow->SetInput2(low_pass_per_level);
-    addHighAndLow->InPlaceOn();
-    addHighAndLow->Update();
-
-    if (level == 0 /* Last level to compute */) // Graft Output
+    /******* Add low pass and high pass sub-bands multiplied by their masks. *****/
+    const InputImageType * bandInputImage = this->GetInput(level * this->m_HighPassSubBands);
+    if (level == 0 /* Last level to compute */)
     {
-      using CastFilterType = itk::CastImageFilter<InputImageType, OutputImageType>;
-      auto castFilter = CastFilterType::New();
-      castFilter->SetInput(addHighAndLow->GetOutput());
-      castFilter->GraftOutput(this->GetOutput());
-      castFilter->Update();
-      this->GraftOutput(castFilter->GetOutput());
+      OutputImageType * outputPtr = this->GetOutput();
+      outputPtr->SetBufferedRegion(outputPtr->GetLargestPossibleRegion());
+      outputPtr->Allocate();
+      this->SumBandsPerLevel(level, expandedLowPass, waveletLow, highPassMasks, outputPtr);
     }
     else // Update low_pass
     {
-      low_pass_per_level = addHighAndLow->GetOutput();
+      auto sumOfBands = InputImageType::New();
+      sumOfBands->SetRegions(bandInputImage->GetLargestPossibleRegion());
+      sumOfBands->SetSpacing(bandInputImage->GetSpacing());
+      sumOfBands->SetOrigin(bandInputImage->GetOrigin());
+      sumOfBands->Allocate();
+      this->SumBandsPerLevel(level, expandedLowPass, waveletLow, highPassMasks, sumOfBands.GetPointer());
+      low_pass_per_level = sumOfBands;
     }
+    this->UpdateProgress(static_cast<float>(this->m_Levels - level) / static_cast<float>(this->m_Levels));
   }
+  this->InsertWaveletFilterBankPyramidInCache();
 }
 } // end namespace itk
 #endif
@@ -24,6 +24,7 @@
 #include <complex>
 #include <itkFixedArray.h>
 #include <itkImageToImageFilter.h>
+#include <itkWaveletFilterBankPyramidCache.h>
 
 namespace itk
 {
@@ -60,6 +61,8 @@ public:
   using WaveletFunctionType = typename WaveletFilterBankType::WaveletFunctionType;
   using FunctionValueType = typename WaveletFilterBankType::FunctionValueType;
 
+  using WaveletFilterBankPyramidCacheType = WaveletFilterBankPyramidCache<WaveletFilterBankType>;
+
   /** ImageDimension constants */
   static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
 
@@ -109,6 +112,15 @@ public:
     this->m_WaveletFilterBankPyramid = filterBankPyramid;
   }
 
+  /** Cache of filter bank pyramids, looked up before generating the filter banks of the levels, and
+   * filled with them on a miss if the pyramid fits in the cache, \sa WaveletFilterBankPyramidCache::CanInsert.
+   * Otherwise the filter bank of each level is generated when it is used and released after it.
+   * The images of a cached pyramid share their buffers with the cache.
+   * Default: the process-wide cache \sa WaveletFilterBankPyramidCache::GetInstance.
+   * Set to nullptr to always generate the filter banks. Not used with UseWaveletFilterBankPyramid. */
+  itkSetObjectMacro(WaveletFilterBankPyramidCache, WaveletFilterBankPyramidCacheType);
+  itkGetModifiableObjectMacro(WaveletFilterBankPyramidCache, WaveletFilterBankPyramidCacheType);
+
   using IndexPairType = std::pair<unsigned int, unsigned int>;
   /** Get the (Level,Band) from a linear index input */
   IndexPairType
@@ -178,6 +190,8 @@ private:
   bool                     m_UseWaveletFilterBankPyramid{ false };
   WaveletFilterBankPointer m_WaveletFilterBank;
   InputsType               m_WaveletFilterBankPyramid;
+
+  typename WaveletFilterBankPyramidCacheType::Pointer m_WaveletFilterBankPyramidCache;
 };
 } // end namespace itk
 #ifndef ITK_MANUAL_INSTANTIATION
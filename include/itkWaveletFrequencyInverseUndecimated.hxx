@@ -21,10 +21,8 @@
 #include <itkCastImageFilter.h>
 #include <itkImage.h>
 #include <algorithm>
-#include <itkMultiplyImageFilter.h>
-#include <itkAddImageFilter.h>
 #include <itkImageDuplicator.h>
-#include <itkChangeInformationImageFilter.h>
+#include <itkImageRegionIndexRange.h>
 #include <itkWaveletUtilities.h>
 namespace itk
 {
@@ -35,6 +33,7 @@ WaveletFrequencyInverseUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
 {
   this->SetNumberOfRequiredOutputs(1);
   this->m_WaveletFilterBank = WaveletFilterBankType::New();
+  this->m_WaveletFilterBankPyramidCache = WaveletFilterBankPyramidCacheType::GetInstance();
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank>
@@ -133,6 +132,7 @@ WaveletFrequencyInverseUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
   os << indent << "ApplyReconstructionFactors: " << this->m_ApplyReconstructionFactors << std::endl;
   os << indent << "UseWaveletFilterBankPyramid: " << this->m_UseWaveletFilterBankPyramid << std::endl;
   itkPrintSelfObjectMacro(WaveletFilterBank);
+  itkPrintSelfObjectMacro(WaveletFilterBankPyramidCache);
 }
 
 template <typename TInputImage, typename TOutputImage, typename TWaveletFilterBank>
@@ -235,8 +235,61 @@ WaveletFrequencyInverseUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
   duplicator->Update();
   InputImagePointer low_pass_per_level = duplicator->GetOutput();
 
-  using MultiplyFilterType = itk::MultiplyImageFilter<InputImageType>;
-  auto scaleFactor = static_cast<double>(this->m_ScaleFactor);
+  // Look up the filter bank pyramid in the cache. On a miss, the masks generated for each level are kept and
+  // inserted at the end, only if the cache can hold the pyramid.
+  InputsType                                          cachedPyramid;
+  InputsType                                          generatedPyramid;
+  typename WaveletFilterBankPyramidCacheType::KeyType cacheKey;
+  if (this->m_WaveletFilterBankPyramidCache.IsNotNull() && !this->m_UseWaveletFilterBankPyramid)
+  {
+    const auto size = low_pass_per_level->GetLargestPossibleRegion().GetSize();
+    this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
+    this->m_WaveletFilterBank->SetSize(size);
+    this->m_WaveletFilterBank->SetInverseBank(true);
+    cacheKey = WaveletFilterBankPyramidCacheType::ComputeKey(
+      this->m_WaveletFilterBank, { size }, this->m_Levels, this->m_ScaleFactor, true);
+    const SizeValueType pyramidBytes = static_cast<SizeValueType>(this->m_Levels) * (this->m_HighPassSubBands + 1) *
+                                       low_pass_per_level->GetLargestPossibleRegion().GetNumberOfPixels() *
+                                       sizeof(typename InputImageType::PixelType);
+    if (!this->m_WaveletFilterBankPyramidCache->Find(cacheKey, cachedPyramid) &&
+        this->m_WaveletFilterBankPyramidCache->CanInsert(pyramidBytes))
+    {
+      generatedPyramid.resize(this->m_Levels * (this->m_HighPassSubBands + 1));
+    }
+  }
+  const bool         usePyramid = this->m_UseWaveletFilterBankPyramid || !cachedPyramid.empty();
+  const InputsType & pyramid = this->m_UseWaveletFilterBankPyramid ? this->m_WaveletFilterBankPyramid : cachedPyramid;
+
+  using PixelType = typename InputImageType::PixelType;
+  using RegionType = typename InputImageType::RegionType;
+  using IndexType = typename InputImageType::IndexType;
+  // The sum of the bands of each bin is accumulated in double precision, also for float pixels.
+  using SumPixelType = typename NumericTraits<PixelType>::RealType;
+  using SumValueType = typename NumericTraits<SumPixelType>::ValueType;
+
+  const auto         scaleFactor = static_cast<double>(this->m_ScaleFactor);
+  const unsigned int highPassSubBands = this->m_HighPassSubBands;
+  /******* Band dilation factor for HighPass bands *****/
+  //  2^(1/#bands) instead of Dyadic dilations.
+  std::vector<SumValueType> reconstructionBandFactors(highPassSubBands);
+  for (unsigned int band = 0; band < highPassSubBands; ++band)
+  {
+    double expBandFactor = 0;
+    if (this->GetApplyReconstructionFactors())
+    {
+      expBandFactor = -(band / static_cast<double>(highPassSubBands)) * ImageDimension / 2.0;
+    }
+    reconstructionBandFactors[band] = static_cast<SumValueType>(std::pow(scaleFactor, expBandFactor));
+  }
+  // Dilation factor for reconstructed by one level.
+  double expLevelFactor = 0;
+  if (this->GetApplyReconstructionFactors())
+  {
+    expLevelFactor = static_cast<double>(ImageDimension) / 2.0;
+  }
+  const auto levelFactor = static_cast<SumValueType>(std::pow(scaleFactor, expLevelFactor));
+
+  const RegionType levelRegion = low_pass_per_level->GetBufferedRegion();
   for (int level = this->m_Levels - 1; level > -1; --level)
   {
     itkDebugMacro(<< "LEVEL: " << level);
@@ -245,7 +298,8 @@ WaveletFrequencyInverseUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
     /******* Calculate FilterBank with the right size per level. *****/
     // Save the FilterBank vector created in the forward wavelet and load it here to save compute it again.
     InputImagePointer waveletLow;
-    if (!this->m_UseWaveletFilterBankPyramid)
+    InputsType        highPassMasks;
+    if (!usePyramid)
     {
       this->m_WaveletFilterBank->SetHighPassSubBands(this->m_HighPassSubBands);
       this->m_WaveletFilterBank->SetSize(low_pass_per_level->GetLargestPossibleRegion().GetSize());
@@ -255,125 +309,95 @@ WaveletFrequencyInverseUndecimated<TInputImage, TOutputImage, TWaveletFilterBank
       this->m_WaveletFilterBank->Modified();
       this->m_WaveletFilterBank->UpdateLargestPossibleRegion();
       waveletLow = this->m_WaveletFilterBank->GetOutputLowPass();
+      highPassMasks = this->m_WaveletFilterBank->GetOutputsHighPassBands();
+      if (!generatedPyramid.empty())
+      {
+        // The filter bank is generated again in the next levels, keep the images of this level for the cache.
+        const unsigned int firstBankOutput = level * (1 + this->m_HighPassSubBands);
+        waveletLow->DisconnectPipeline();
+        generatedPyramid[firstBankOutput] = waveletLow;
+        for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
+        {
+          highPassMasks[band]->DisconnectPipeline();
+          generatedPyramid[firstBankOutput + 1 + band] = highPassMasks[band];
+        }
+      }
     }
     else
     {
-      waveletLow = this->m_WaveletFilterBankPyramid[level * (1 + this->m_HighPassSubBands)];
+      waveletLow = pyramid[level * (1 + this->m_HighPassSubBands)];
+      highPassMasks.insert(highPassMasks.begin(),
+                           pyramid.begin() + 1 + level * (1 + this->m_HighPassSubBands),
+                           pyramid.begin() + this->m_HighPassSubBands + 1 + level * (1 + this->m_HighPassSubBands));
     }
     itkDebugMacro(<< "waveletLow: " << level << " Region:" << waveletLow->GetLargestPossibleRegion());
-    using ChangeInformationFilterType = itk::ChangeInformationImageFilter<InputImageType>;
-
-    /******* LowPass band *****/
-    auto multiplyLowPass = MultiplyFilterType::New();
-    multiplyLowPass->SetInput1(waveletLow);
-    multiplyLowPass->SetInput2(low_pass_per_level);
-    multiplyLowPass->Update();
-
-    low_pass_per_level = multiplyLowPass->GetOutput();
 
-    /******* HighPass sub-bands *****/
-    InputsType highPassMasks;
-    if (!this->m_UseWaveletFilterBankPyramid)
+    // The bands of the level have the buffered region of the low pass. The filter bank is generated on a grid of
+    // the same size, but its start index can differ: its bins are matched by position in the buffers.
+    const RegionType maskRegion = waveletLow->GetBufferedRegion();
+    if (maskRegion.GetSize() != levelRegion.GetSize())
     {
-      highPassMasks = this->m_WaveletFilterBank->GetOutputsHighPassBands();
+      itkExceptionMacro(<< "Low pass filter bank of level: " << level << " does not have the expected size.");
     }
-    else
+    std::vector<const PixelType *> bandInputBuffers(highPassSubBands);
+    std::vector<const PixelType *> highPassMaskBuffers(highPassSubBands);
+    for (unsigned int band = 0; band < highPassSubBands; ++band)
     {
-      highPassMasks.insert(highPassMasks.begin(),
-                           this->m_WaveletFilterBankPyramid.begin() + 1 + level * (1 + this->m_HighPassSubBands),
-                           this->m_WaveletFilterBankPyramid.begin() + this->m_HighPassSubBands + 1 +
-                             level * (1 + this->m_HighPassSubBands));
-    }
-    // Store HighBands steps into high_pass_reconstruction image:
-    InputImagePointer reconstructed = InputImageType::New();
-    reconstructed->SetRegions(low_pass_per_level->GetLargestPossibleRegion());
-    reconstructed->Allocate();
-    reconstructed->FillBuffer(0);
-    InputImagePointer bandInputImage;
-    for (unsigned int band = 0; band < this->m_HighPassSubBands; ++band)
-    {
-      unsigned int nInput = level * this->m_HighPassSubBands + band;
-      bandInputImage = const_cast<InputImageType *>(this->GetInput(nInput));
-      reconstructed->SetSpacing(bandInputImage->GetSpacing());
-      reconstructed->SetOrigin(bandInputImage->GetOrigin());
-      reconstructed->SetDirection(bandInputImage->GetDirection());
-
-      auto changeWaveletHighInfoFilter = ChangeInformationFilterType::New();
-      changeWaveletHighInfoFilter->SetInput(highPassMasks[band]);
-      changeWaveletHighInfoFilter->UseReferenceImageOn();
-      changeWaveletHighInfoFilter->SetReferenceImage(bandInputImage);
-      changeWaveletHighInfoFilter->ChangeRegionOff();
-      changeWaveletHighInfoFilter->ChangeDirectionOn();
-      changeWaveletHighInfoFilter->ChangeSpacingOn();
-      changeWaveletHighInfoFilter->ChangeOriginOn();
-      changeWaveletHighInfoFilter->UpdateLargestPossibleRegion();
-      highPassMasks[band] = changeWaveletHighInfoFilter->GetOutput();
-      highPassMasks[band]->DisconnectPipeline();
-
-      auto multiplyHighBandFilter = MultiplyFilterType::New();
-      multiplyHighBandFilter->SetInput1(highPassMasks[band]);
-      multiplyHighBandFilter->SetInput2(bandInputImage);
-      multiplyHighBandFilter->UpdateLargestPossibleRegion();
-
-      /******* Band dilation factor for HighPass bands *****/
-      //  2^(1/#bands) instead of Dyadic dilations.
-      auto multiplyByReconstructionBandFactor = MultiplyFilterType::New();
-      multiplyByReconstructionBandFactor->SetInput1(multiplyHighBandFilter->GetOutput());
-      double expBandFactor = 0;
-      if (this->GetApplyReconstructionFactors())
+      const InputImageType * bandInputImage = this->GetInput(level * highPassSubBands + band);
+      if (bandInputImage->GetBufferedRegion() != levelRegion || highPassMasks[band]->GetBufferedRegion() != maskRegion)
       {
-        expBandFactor = -(band / static_cast<double>(this->m_HighPassSubBands)) * ImageDimension / 2.0;
+        itkExceptionMacro(<< "Band: " << band << " of level: " << level << " does not have the expected region.");
       }
-      multiplyByReconstructionBandFactor->SetConstant(std::pow(scaleFactor, expBandFactor));
-      multiplyByReconstructionBandFactor->InPlaceOn();
-      multiplyByReconstructionBandFactor->Update();
-
-      /******* Add high bands *****/
-      using AddFilterType = itk::AddImageFilter<InputImageType>;
-      auto addFilter = AddFilterType::New();
-      addFilter->SetInput1(reconstructed);
-      addFilter->SetInput2(multiplyByReconstructionBandFactor->GetOutput());
-      addFilter->InPlaceOn();
-      addFilter->Update();
-      reconstructed = addFilter->GetOutput();
-
-      this->UpdateProgress(static_cast<float>(m_TotalInputs - nInput - 1) / static_cast<float>(m_TotalInputs));
-    }
-
-    /******* Add low pass to the sum of high pass bands. *****/
-    using AddFilterType = itk::AddImageFilter<InputImageType>;
-    auto addHighAndLow = AddFilterType::New();
-    addHighAndLow->SetInput1(reconstructed.GetPointer()); // HighBands
-    addHighAndLow->SetInput2(low_pass_per_level);
-    addHighAndLow->InPlaceOn();
-    addHighAndLow->Update();
-
-    // Dilation factor for reconstructed by one level.
-    auto multiplyByLevelFactor = MultiplyFilterType::New();
-    multiplyByLevelFactor->SetInput1(addHighAndLow->GetOutput());
-    double expLevelFactor = 0;
-    if (this->GetApplyReconstructionFactors())
-    {
-      expLevelFactor = static_cast<double>(ImageDimension) / 2.0;
+      bandInputBuffers[band] = bandInputImage->GetBufferPointer();
+      highPassMaskBuffers[band] = highPassMasks[band]->GetBufferPointer();
     }
-    multiplyByLevelFactor->SetConstant(std::pow(scaleFactor, expLevelFactor));
-    multiplyByLevelFactor->InPlaceOn();
-    multiplyByLevelFactor->Update();
 
-    if (level == 0 /* Last level to compute */) // Graft Output
-    {
-      using CastFilterType = itk::CastImageFilter<InputImageType, OutputImageType>;
-      auto castFilter = CastFilterType::New();
-      castFilter->SetInput(multiplyByLevelFactor->GetOutput());
-      castFilter->GraftOutput(this->GetOutput());
-      castFilter->Update();
-      this->GraftOutput(castFilter->GetOutput());
-    }
-    else // Update low_pass
-    {
-      low_pass_per_level = multiplyByLevelFactor->GetOutput();
-    }
+    // Multiply the low pass and the high pass bands with their masks, and add them in one sweep.
+    // The low pass of the level is owned by this filter, it is replaced by the reconstruction.
+    const PixelType * lowPassMaskBuffer = waveletLow->GetBufferPointer();
+    PixelType *       lowPassBuffer = low_pass_per_level->GetBufferPointer();
+    const auto *      lowPassImage = low_pass_per_level.GetPointer();
+    const auto *      lowPassMaskImage = waveletLow.GetPointer();
+    const IndexType   levelStartIndex = levelRegion.GetIndex();
+    const IndexType   maskStartIndex = maskRegion.GetIndex();
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      levelRegion,
+      [&](const RegionType & region) {
+        for (const IndexType & index : ImageRegionIndexRange<ImageDimension>(region))
+        {
+          const OffsetValueType offset = lowPassImage->ComputeOffset(index);
+          const OffsetValueType maskOffset =
+            lowPassMaskImage->ComputeOffset(maskStartIndex + (index - levelStartIndex));
+          SumPixelType          value =
+            static_cast<SumPixelType>(lowPassMaskBuffer[maskOffset]) * static_cast<SumPixelType>(lowPassBuffer[offset]);
+          for (unsigned int band = 0; band < highPassSubBands; ++band)
+          {
+            value += static_cast<SumPixelType>(highPassMaskBuffers[band][maskOffset]) *
+                     static_cast<SumPixelType>(bandInputBuffers[band][offset]) * reconstructionBandFactors[band];
+          }
+          lowPassBuffer[offset] = static_cast<PixelType>(value * levelFactor);
+        }
+      },
+      nullptr);
+
+    this->UpdateProgress(static_cast<float>(this->m_Levels - level) / static_cast<float>(this->m_Levels));
+  }
+  if (!generatedPyramid.empty())
+  {
+    this->m_WaveletFilterBankPyramidCache->Insert(cacheKey, generatedPyramid);
   }
+
+  // Graft Output, with the information of the coefficients.
+  const InputImageType * bandInputImage = this->GetInput(0);
+  low_pass_per_level->SetSpacing(bandInputImage->GetSpacing());
+  low_pass_per_level->SetOrigin(bandInputImage->GetOrigin());
+  low_pass_per_level->SetDirection(bandInputImage->GetDirection());
+  using CastFilterType = itk::CastImageFilter<InputImageType, OutputImageType>;
+  auto castFilter = CastFilterType::New();
+  castFilter->SetInput(low_pass_per_level);
+  castFilter->GraftOutput(this->GetOutput());
+  castFilter->Update();
+  this->GraftOutput(castFilter->GetOutput());
 }
 } // end namespace itk
 #endif
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <complex>
 #include <vector>
 #include <itkFixedArray.h>
 #include <itkMath.h>
@@ -102,6 +103,132 @@ ComputeMaxNumberOfLevels(const Size<VImageDimension> & inputSize, const unsigned
   return *std::min_element(exponentPerAxis.Begin(), exponentPerAxis.End());
 }
 
+/** Compute, per dimension, the square of the frequency (in Hz, with unit spacing) of each bin of an image in the
+ * standard FFT layout. The sum over dimensions gives the frequency modulo square used in the
+ * WaveletFrequencyFilterBankGenerator.
+ *
+ * The bins of the image of size \c levelSize are taken from a grid of size \c fullSize decimated by
+ * \c decimationFactor, as ShrinkDecimateImageFilter does with the filter bank in WaveletFrequencyForward.
+ * Use fullSize == levelSize and decimationFactor = 1 to get the frequencies of a filter bank generated with levelSize.
+ * It is also valid for the half-Hermitian layout, using the size of the full spectrum as \c fullSize.
+ */
+template <unsigned int VImageDimension>
+std::vector<std::vector<double>>
+ComputeFrequencyModuloSquarePerDimension(const Size<VImageDimension> & levelSize,
+                                         const Size<VImageDimension> & fullSize,
+                                         const SizeValueType &         decimationFactor = 1)
+{
+  std::vector<std::vector<double>> frequencyModuloSquare(VImageDimension);
+  for (unsigned int axis = 0; axis < VImageDimension; ++axis)
+  {
+    frequencyModuloSquare[axis].resize(levelSize[axis]);
+    const auto fullSizeAxis = static_cast<double>(fullSize[axis]);
+    for (SizeValueType k = 0; k < levelSize[axis]; ++k)
+    {
+      const SizeValueType fullIndex = k * decimationFactor;
+      // Positive and negative frequencies have the same square.
+      const SizeValueType bin = std::min(fullIndex, fullSize[axis] - fullIndex);
+      const double        frequency = static_cast<double>(bin) / fullSizeAxis;
+      frequencyModuloSquare[axis][k] = frequency * frequency;
+    }
+  }
+  return frequencyModuloSquare;
+}
+
+/** Size of the half-Hermitian layout of RealToHalfHermitianForwardFFTImageFilter for a
+ * full spectrum of size \c fullSize: only the first dimension is halved, fullSize[0]/2 + 1. */
+template <unsigned int VImageDimension>
+Size<VImageDimension>
+ComputeHalfHermitianSize(const Size<VImageDimension> & fullSize)
+{
+  Size<VImageDimension> halfSize = fullSize;
+  halfSize[0] = fullSize[0] / 2 + 1;
+  return halfSize;
+}
+
+/** Size of the full spectrum of an image stored in the half-Hermitian layout.
+ * The first dimension of the full spectrum is 2 * (halfSize[0] - 1), plus one if \c actualXDimensionIsOdd.
+ * \sa ComputeHalfHermitianSize */
+template <unsigned int VImageDimension>
+Size<VImageDimension>
+ComputeFullSizeFromHalfHermitianSize(const Size<VImageDimension> & halfSize, const bool & actualXDimensionIsOdd)
+{
+  Size<VImageDimension> fullSize = halfSize;
+  fullSize[0] = 2 * (halfSize[0] - 1) + (actualXDimensionIsOdd ? 1 : 0);
+  return fullSize;
+}
+
+/** Compute, per dimension, the signed frequency (in Hz, bin / (fullSize * spacing)) of each bin of an image
+ * of size \c levelSize in the standard FFT layout of a spectrum of size \c fullSize.
+ * Bins up to fullSize/2 are positive frequencies, the rest negative.
+ * Use levelSize == fullSize for images in the full layout, and the half size of \c fullSize
+ * for the half-Hermitian layout, where all the stored bins of the first dimension are positive.
+ */
+template <unsigned int VImageDimension, typename TSpacing>
+std::vector<std::vector<double>>
+ComputeFrequencyPerDimension(const Size<VImageDimension> & levelSize,
+                             const Size<VImageDimension> & fullSize,
+                             const TSpacing &              spacing)
+{
+  std::vector<std::vector<double>> frequency(VImageDimension);
+  for (unsigned int axis = 0; axis < VImageDimension; ++axis)
+  {
+    frequency[axis].resize(levelSize[axis]);
+    const double frequencySpacing = 1.0 / (static_cast<double>(fullSize[axis]) * spacing[axis]);
+    for (SizeValueType k = 0; k < levelSize[axis]; ++k)
+    {
+      const double bin = (k <= fullSize[axis] / 2) ? static_cast<double>(k)
+                                                   : static_cast<double>(k) - static_cast<double>(fullSize[axis]);
+      frequency[axis][k] = bin * frequencySpacing;
+    }
+  }
+  return frequency;
+}
+
+/** Offset in the buffer of an image in the half-Hermitian layout, with first dimension of size \c halfSize0
+ * and offset table \c offsetTable, of the bin \c fullIndex (relative to the start of the image)
+ * of the full spectrum of size \c fullSize.
+ * The bins of the first dimension bigger than the stored ones are read from the mirrored bin,
+ * I(k) = conj(I(-k)) for hermitian spectra. Return true if the value at the offset has to be conjugated.
+ */
+template <unsigned int VImageDimension>
+inline bool
+ComputeHalfHermitianOffset(const IndexValueType *        fullIndex,
+                           const Size<VImageDimension> & fullSize,
+                           const SizeValueType &         halfSize0,
+                           const OffsetValueType *       offsetTable,
+                           OffsetValueType &             offset)
+{
+  const bool isMirrored = static_cast<SizeValueType>(fullIndex[0]) >= halfSize0;
+  offset = 0;
+  for (unsigned int axis = 0; axis < VImageDimension; ++axis)
+  {
+    IndexValueType k = fullIndex[axis];
+    if (isMirrored && k != 0)
+    {
+      k = static_cast<IndexValueType>(fullSize[axis]) - k;
+    }
+    offset += k * offsetTable[axis];
+  }
+  return isMirrored;
+}
+
+/** Complex conjugate preserving the pixel type, identity for real pixels.
+ * Used to read the bins of the half-Hermitian layout from their mirror. */
+template <typename TPixel>
+inline TPixel
+ComplexConjugate(const TPixel & value)
+{
+  return value;
+}
+
+template <typename TValue>
+inline std::complex<TValue>
+ComplexConjugate(const std::complex<TValue> & value)
+{
+  return std::conj(value);
+}
+
 } // end namespace utils
 } // end namespace itk
 
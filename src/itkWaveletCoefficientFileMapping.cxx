@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWaveletCoefficientFileMapping.h"
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+WaveletCoefficientFileMapping::~WaveletCoefficientFileMapping()
+{
+  this->Close();
+}
+
+void
+WaveletCoefficientFileMapping::Open(const std::string & fileName)
+{
+  this->Close();
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(
+    fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    itkExceptionMacro(<< "Cannot open the file " << fileName);
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+  {
+    CloseHandle(file);
+    itkExceptionMacro(<< "Cannot map the file " << fileName << ", it is empty or its size is unknown.");
+  }
+  // PAGE_WRITECOPY and FILE_MAP_COPY: the modified pages are private copies, the file is read-only.
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  void * data = mapping ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+  if (data == nullptr)
+  {
+    if (mapping)
+    {
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    itkExceptionMacro(<< "Cannot map the file " << fileName);
+  }
+  m_FileHandle = file;
+  m_MappingHandle = mapping;
+  m_Size = static_cast<SizeValueType>(fileSize.QuadPart);
+#else
+  const int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+  {
+    itkExceptionMacro(<< "Cannot open the file " << fileName);
+  }
+  struct stat fileStatus;
+  if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+  {
+    close(fileDescriptor);
+    itkExceptionMacro(<< "Cannot map the file " << fileName << ", it is empty or its size is unknown.");
+  }
+  const auto size = static_cast<size_t>(fileStatus.st_size);
+  // MAP_PRIVATE: the modified pages are private copies, the file is opened read-only.
+  void * data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+  // The mapping keeps its own reference to the file.
+  close(fileDescriptor);
+  if (data == MAP_FAILED)
+  {
+    itkExceptionMacro(<< "Cannot map the file " << fileName);
+  }
+  m_Size = static_cast<SizeValueType>(size);
+#endif
+  m_Data = static_cast<char *>(data);
+  m_FileName = fileName;
+  this->Modified();
+}
+
+void
+WaveletCoefficientFileMapping::Close()
+{
+  if (m_Data == nullptr)
+  {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(m_Data);
+  CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+  CloseHandle(static_cast<HANDLE>(m_FileHandle));
+  m_MappingHandle = nullptr;
+  m_FileHandle = nullptr;
+#else
+  munmap(m_Data, static_cast<size_t>(m_Size));
+#endif
+  m_Data = nullptr;
+  m_Size = 0;
+  m_FileName.clear();
+  this->Modified();
+}
+
+void
+WaveletCoefficientFileMapping::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "Size: " << m_Size << std::endl;
+}
+
+} // end namespace itk
@@ -103,6 +103,35 @@ runFrequencyExpandTest(const std::string & inputImage, const std::string & outpu
     testPassed = false;
   }
 
+  // Fused upsample correction: the output is multiplied by expandFactor^Dimension.
+  auto correctedExpandFilter = ExpandType::New();
+  correctedExpandFilter->SetInput(fftFilter->GetOutput());
+  correctedExpandFilter->SetExpandFactors(expandFactors);
+  ITK_TEST_SET_GET_BOOLEAN(correctedExpandFilter, ApplyUpsampleCorrection, true);
+  correctedExpandFilter->Update();
+  {
+    const auto upsampleCorrection = static_cast<typename ComplexImageType::PixelType::value_type>(
+      std::pow(static_cast<double>(expandFactor), static_cast<double>(Dimension)));
+    itk::ImageRegionConstIterator<ComplexImageType> expandIt(expandFilter->GetOutput(),
+                                                             expandFilter->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ComplexImageType> correctedIt(
+      correctedExpandFilter->GetOutput(), correctedExpandFilter->GetOutput()->GetLargestPossibleRegion());
+    unsigned int numberOfDifferences = 0;
+    for (; !expandIt.IsAtEnd(); ++expandIt, ++correctedIt)
+    {
+      if (expandIt.Get() * upsampleCorrection != correctedIt.Get())
+      {
+        ++numberOfDifferences;
+      }
+    }
+    if (numberOfDifferences > 0)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in upsample correction, pixels with differences: " << numberOfDifferences << std::endl;
+      testPassed = false;
+    }
+  }
+
   // InverseFFT
   using InverseFFTFilterType = itk::InverseFFTImageFilter<ComplexImageType, ImageType>;
   auto inverseFFT = InverseFFTFilterType::New();
@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkIsotropicWaveletProfileTable.h"
+#include "itkIsotropicWaveletProfileTableCache.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkVowIsotropicWavelet.h"
+#include "itkSimoncelliIsotropicWavelet.h"
+#include "itkShannonIsotropicWavelet.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <string>
+
+/** Compare the table against the direct evaluation of the wavelet function. */
+template <typename TWaveletFunction>
+bool
+checkProfileTable(const std::string &  waveletName,
+                  const unsigned int & inputBands,
+                  const bool &         inverseBank,
+                  const double &       tolerance)
+{
+  using ProfileTableType = itk::IsotropicWaveletProfileTable<TWaveletFunction>;
+  using FunctionValueType = typename TWaveletFunction::FunctionValueType;
+
+  auto waveletFunction = TWaveletFunction::New();
+  waveletFunction->SetHighPassSubBands(inputBands);
+
+  auto         table = ProfileTableType::New();
+  const double levelFactor = 2;
+  table->SetInverseBank(inverseBank);
+  table->SetLevelFactor(levelFactor);
+  table->SetTolerance(tolerance);
+  table->Compute(waveletFunction);
+
+  std::cout << waveletName << " Bands: " << inputBands << " NumberOfIntervals: " << table->GetNumberOfIntervals()
+            << " MaximumError: " << table->GetMaximumError() << std::endl;
+  if (!table->GetIsWithinTolerance())
+  {
+    std::cerr << waveletName << " table does not reach the tolerance: " << tolerance << std::endl;
+    return false;
+  }
+
+  // The error is estimated at the middle points, allow some margin at any other point.
+  bool                           passed = true;
+  double                         maximumError = 0;
+  std::vector<FunctionValueType> subBands(inputBands + 1);
+  const unsigned int             samples = 10007;
+  for (unsigned int i = 0; i <= samples; ++i)
+  {
+    const double w2 = table->GetMaximumFrequencyModuloSquare() * i / samples;
+    const auto   w = static_cast<FunctionValueType>(levelFactor * std::sqrt(w2));
+    table->EvaluateSubBands(w2, subBands.data());
+    for (unsigned int j = 0; j < inputBands + 1; ++j)
+    {
+      const FunctionValueType expected = inverseBank ? waveletFunction->EvaluateInverseSubBand(w, j)
+                                                     : waveletFunction->EvaluateForwardSubBand(w, j);
+      maximumError = std::max(maximumError, static_cast<double>(std::abs(expected - subBands[j])));
+      if (subBands[j] != table->EvaluateSubBand(w2, j))
+      {
+        passed = false;
+      }
+    }
+  }
+  if (maximumError > 10 * tolerance || !passed)
+  {
+    std::cerr << waveletName << " table differs from the wavelet function. Error: " << maximumError << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int
+itkIsotropicWaveletProfileTableTest(int, char *[])
+{
+  bool testPassed = true;
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = double;
+  using PointType = itk::Point<PixelType, Dimension>;
+  using HeldWaveletType = itk::HeldIsotropicWavelet<PixelType, Dimension, PointType>;
+  using VowWaveletType = itk::VowIsotropicWavelet<PixelType, Dimension, PointType>;
+  using SimoncelliWaveletType = itk::SimoncelliIsotropicWavelet<PixelType, Dimension, PointType>;
+  using ShannonWaveletType = itk::ShannonIsotropicWavelet<PixelType, Dimension, PointType>;
+
+  using ProfileTableType = itk::IsotropicWaveletProfileTable<HeldWaveletType>;
+  auto table = ProfileTableType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(table, IsotropicWaveletProfileTable, Object);
+  ITK_TRY_EXPECT_EXCEPTION(table->Compute(nullptr));
+
+  for (unsigned int bands = 1; bands < 4; ++bands)
+  {
+    testPassed &= checkProfileTable<HeldWaveletType>("Held", bands, false, 1e-6);
+    testPassed &= checkProfileTable<HeldWaveletType>("Held", bands, true, 1e-6);
+    // Singular derivatives at the edges of the support only allow coarse tolerances.
+    testPassed &= checkProfileTable<VowWaveletType>("Vow", bands, false, 5e-2);
+    testPassed &= checkProfileTable<SimoncelliWaveletType>("Simoncelli", bands, false, 1e-2);
+  }
+
+  // Discontinuous profiles cannot be tabulated.
+  auto shannonTable = itk::IsotropicWaveletProfileTable<ShannonWaveletType>::New();
+  auto shannonWavelet = ShannonWaveletType::New();
+  shannonTable->SetMaximumNumberOfIntervals(1024);
+  shannonTable->Compute(shannonWavelet);
+  ITK_TEST_EXPECT_TRUE(!shannonTable->GetIsWithinTolerance());
+  ITK_TEST_EXPECT_EQUAL(shannonTable->GetNumberOfIntervals(), static_cast<itk::SizeValueType>(1024));
+
+  // Filter bank generator and fused forward with profile tables against direct evaluation.
+  using ComplexImageType = itk::Image<std::complex<PixelType>, Dimension>;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator<ComplexImageType, HeldWaveletType>;
+  const unsigned int         inputBands = 2;
+  ComplexImageType::SizeType size;
+  size.Fill(32);
+
+  auto filterBank = WaveletFilterBankType::New();
+  filterBank->SetHighPassSubBands(inputBands);
+  filterBank->SetSize(size);
+  filterBank->Update();
+
+  auto tabulatedFilterBank = WaveletFilterBankType::New();
+  tabulatedFilterBank->SetHighPassSubBands(inputBands);
+  tabulatedFilterBank->SetSize(size);
+  ITK_TEST_SET_GET_BOOLEAN(tabulatedFilterBank, UseProfileTable, true);
+  tabulatedFilterBank->Update();
+
+  for (unsigned int band = 0; band < inputBands + 1; ++band)
+  {
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(filterBank->GetOutput(band),
+                                                              tabulatedFilterBank->GetOutput(band)))
+    {
+      std::cerr << "Tabulated filter bank output " << band << " differs from the direct evaluation." << std::endl;
+      testPassed = false;
+    }
+  }
+  // The cached table is reused.
+  WaveletFilterBankType::ProfileTableType::ConstPointer cachedTable = tabulatedFilterBank->GetProfileTable(0.75);
+  ITK_TEST_EXPECT_TRUE(cachedTable.IsNotNull());
+  ITK_TEST_EXPECT_TRUE(cachedTable.GetPointer() == tabulatedFilterBank->GetProfileTable(0.5));
+  // Modifying the wavelet function invalidates the table.
+  tabulatedFilterBank->GetModifiableWaveletFunction()->SetPolynomialOrder(3);
+  ITK_TEST_EXPECT_TRUE(cachedTable.GetPointer() != tabulatedFilterBank->GetProfileTable(0.75));
+
+  // Filter banks with the same wavelet share the table, for any level.
+  using ProfileTableCacheType = WaveletFilterBankType::ProfileTableCacheType;
+  ProfileTableCacheType::Pointer profileTableCache = ProfileTableCacheType::GetInstance();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(profileTableCache, IsotropicWaveletProfileTableCache, Object);
+  WaveletFilterBankType::ProfileTableType::ConstPointer sharedTable = tabulatedFilterBank->GetProfileTable(0.75);
+  ITK_TEST_EXPECT_TRUE(sharedTable->GetIsConstantBeyondMaximum());
+  const itk::SizeValueType computedTables = profileTableCache->GetNumberOfComputedTables();
+  for (unsigned int level = 0; level < 3; ++level)
+  {
+    auto levelFilterBank = WaveletFilterBankType::New();
+    levelFilterBank->SetHighPassSubBands(inputBands);
+    levelFilterBank->SetSize(size);
+    levelFilterBank->SetLevel(level);
+    levelFilterBank->GetModifiableWaveletFunction()->SetPolynomialOrder(3);
+    ITK_TEST_EXPECT_TRUE(levelFilterBank->GetProfileTable(0.75) == sharedTable.GetPointer());
+    levelFilterBank->Update();
+
+    auto tabulatedLevelFilterBank = WaveletFilterBankType::New();
+    tabulatedLevelFilterBank->SetHighPassSubBands(inputBands);
+    tabulatedLevelFilterBank->SetSize(size);
+    tabulatedLevelFilterBank->SetLevel(level);
+    tabulatedLevelFilterBank->GetModifiableWaveletFunction()->SetPolynomialOrder(3);
+    tabulatedLevelFilterBank->UseProfileTableOn();
+    tabulatedLevelFilterBank->Update();
+    for (unsigned int band = 0; band < inputBands + 1; ++band)
+    {
+      if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(levelFilterBank->GetOutput(band),
+                                                                tabulatedLevelFilterBank->GetOutput(band)))
+      {
+        std::cerr << "Tabulated filter bank output " << band << " at level " << level
+                  << " differs from the direct evaluation." << std::endl;
+        testPassed = false;
+      }
+    }
+  }
+  ITK_TEST_EXPECT_EQUAL(profileTableCache->GetNumberOfComputedTables(), computedTables);
+  // Without cache every filter bank computes its own table.
+  tabulatedFilterBank->SetProfileTableCache(nullptr);
+  ITK_TEST_EXPECT_TRUE(tabulatedFilterBank->GetProfileTable(0.75) != sharedTable.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(profileTableCache->GetNumberOfComputedTables(), computedTables);
+  tabulatedFilterBank->SetProfileTableCache(profileTableCache);
+
+  auto input = ComplexImageType::New();
+  input->SetRegions(size);
+  input->Allocate();
+  input->FillBuffer(std::complex<PixelType>(1, 0));
+
+  using ForwardWaveletType = itk::WaveletFrequencyForward<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetHighPassSubBands(inputBands);
+  forwardWavelet->SetLevels(2);
+  forwardWavelet->SetInput(input);
+  forwardWavelet->Update();
+
+  auto tabulatedForwardWavelet = ForwardWaveletType::New();
+  tabulatedForwardWavelet->SetHighPassSubBands(inputBands);
+  tabulatedForwardWavelet->SetLevels(2);
+  tabulatedForwardWavelet->SetInput(input);
+  tabulatedForwardWavelet->UseVirtualFilterBankOn();
+  tabulatedForwardWavelet->GetModifiableWaveletFilterBank()->UseProfileTableOn();
+  tabulatedForwardWavelet->Update();
+
+  for (unsigned int nOutput = 0; nOutput < forwardWavelet->GetTotalOutputs(); ++nOutput)
+  {
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(forwardWavelet->GetOutput(nOutput),
+                                                              tabulatedForwardWavelet->GetOutput(nOutput)))
+    {
+      std::cerr << "Tabulated forward output " << nOutput << " differs from the default pipeline." << std::endl;
+      testPassed = false;
+    }
+  }
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -21,6 +21,10 @@
 #include <complex>
 #include <itkMathDetail.h>
 #include <iomanip>
+#include <algorithm>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include <cmath>
 namespace itk
 {
 namespace Testing
@@ -88,6 +92,126 @@ ComplexImageIsHermitian(Image<std::complex<TValueType>, N> *
   }
   return isHermitian;
 }
+
+/** Check if two images have the same metadata, and their pixel values are equal up to a tolerance.
+ * The tolerance is relative to the maximum absolute value of the reference image.
+ * @param reference image.
+ * @param test image.
+ * @param relativeTolerance tolerance for the pixel difference.
+ */
+template <typename TImage>
+bool
+ImagesAreAlmostEqual(const TImage * reference, const TImage * test, double relativeTolerance = 1e-5)
+{
+  if (reference->GetLargestPossibleRegion() != test->GetLargestPossibleRegion())
+  {
+    std::cerr << "Regions are different: " << reference->GetLargestPossibleRegion() << " vs "
+              << test->GetLargestPossibleRegion() << std::endl;
+    return false;
+  }
+  if (reference->GetSpacing() != test->GetSpacing() || reference->GetOrigin() != test->GetOrigin() ||
+      reference->GetDirection() != test->GetDirection())
+  {
+    std::cerr << "Metadata is different. Spacing: " << reference->GetSpacing() << " vs " << test->GetSpacing()
+              << ", Origin: " << reference->GetOrigin() << " vs " << test->GetOrigin() << std::endl;
+    return false;
+  }
+
+  double maxReference = 0.0;
+  double maxDifference = 0.0;
+  using ConstIteratorType = itk::ImageRegionConstIteratorWithIndex<TImage>;
+  ConstIteratorType refIt(reference, reference->GetLargestPossibleRegion());
+  ConstIteratorType testIt(test, test->GetLargestPossibleRegion());
+  typename TImage::IndexType maxDifferenceIndex = refIt.GetIndex();
+  for (; !refIt.IsAtEnd(); ++refIt, ++testIt)
+  {
+    maxReference = std::max(maxReference, static_cast<double>(std::abs(refIt.Get())));
+    const auto difference = static_cast<double>(std::abs(refIt.Get() - testIt.Get()));
+    if (difference > maxDifference)
+    {
+      maxDifference = difference;
+      maxDifferenceIndex = refIt.GetIndex();
+    }
+  }
+  if (maxDifference > relativeTolerance * maxReference)
+  {
+    std::cerr << std::setprecision(20) << "Max difference: " << maxDifference << " at index: " << maxDifferenceIndex
+              << " is greater than tolerance: " << relativeTolerance * maxReference << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/** Check ImagesAreAlmostEqual for each pair of images of two containers with the same number of images. */
+template <typename TImage, typename TImages>
+bool
+AllImagesAreAlmostEqual(const TImages & reference, const TImages & test, double relativeTolerance = 1e-5)
+{
+  if (reference.size() != test.size())
+  {
+    std::cerr << "Number of images is different: " << reference.size() << " vs " << test.size() << std::endl;
+    return false;
+  }
+  bool passed = true;
+  for (unsigned int n = 0; n < reference.size(); ++n)
+  {
+    if (!ImagesAreAlmostEqual<TImage>(reference[n], test[n], relativeTolerance))
+    {
+      std::cerr << "Image " << n << " is different." << std::endl;
+      passed = false;
+    }
+  }
+  return passed;
+}
+
+template <typename TValue>
+void
+SetSyntheticPixel(TValue & pixel, const double & real, const double &)
+{
+  pixel = static_cast<TValue>(real);
+}
+
+template <typename TValue>
+void
+SetSyntheticPixel(std::complex<TValue> & pixel, const double & real, const double & imag)
+{
+  pixel = std::complex<TValue>(static_cast<TValue>(real), static_cast<TValue>(imag));
+}
+
+/** Deterministic input image for the tests.
+ * Each pixel n has a pseudo-random value in [0, 1), from a multiplicative hash of n + seed, in the real part
+ * and another one in the imaginary part of complex pixels.
+ * If waveFrequency is not zero the waves sin(waveFrequency * x_0 + 0.2 * seed) + cos(waveFrequency * (x_1 + ...) / 2)
+ * are added to the real part, to have also smooth content.
+ */
+template <typename TImage>
+typename TImage::Pointer
+CreateSyntheticImage(const typename TImage::SizeType & size, double waveFrequency = 0, unsigned int seed = 0)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  unsigned int                              n = 0;
+  itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++n)
+  {
+    double real = ((n + seed) * 7919) % 101 / 101.0;
+    if (waveFrequency != 0)
+    {
+      const auto index = it.GetIndex();
+      double     otherAxes = 0;
+      for (unsigned int d = 1; d < TImage::ImageDimension; ++d)
+      {
+        otherAxes += index[d];
+      }
+      real += std::sin(waveFrequency * index[0] + 0.2 * seed) + std::cos(waveFrequency * otherAxes / 2);
+    }
+    typename TImage::PixelType pixel;
+    SetSyntheticPixel(pixel, real, ((n + seed) * 104729) % 97 / 97.0);
+    it.Set(pixel);
+  }
+  return image;
+}
 } // namespace Testing
 } // namespace itk
 #endif
@@ -0,0 +1,140 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMonogenicPhaseAnalysisImageFilter.h"
+#include "itkMonogenicSignalFrequencyImageFilter.h"
+#include "itkVectorInverseFFTImageFilter.h"
+#include "itkPhaseAnalysisSoftThresholdImageFilter.h"
+#include "itkForwardFFTImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<double, Dimension>;
+using FFTForwardType = itk::ForwardFFTImageFilter<ImageType>;
+using ComplexImageType = FFTForwardType::OutputImageType;
+using FusedFilterType = itk::MonogenicPhaseAnalysisImageFilter<ComplexImageType>;
+
+int
+compareOutputs(const ImageType * expected, const ImageType * test, const double & tolerance, const std::string & name)
+{
+  itk::ImageRegionConstIterator<ImageType> expectedIt(expected, expected->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> testIt(test, expected->GetLargestPossibleRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++testIt)
+  {
+    if (std::abs(expectedIt.Get() - testIt.Get()) > tolerance)
+    {
+      std::cerr << "Error. " << name << " differs at " << expectedIt.GetIndex() << ": " << testIt.Get()
+                << " != " << expectedIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkMonogenicPhaseAnalysisImageFilterTest(int, char *[])
+{
+  bool testPassed = true;
+
+  auto fusedFilter = FusedFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fusedFilter, MonogenicPhaseAnalysisImageFilter, ImageToImageFilter);
+  ITK_TEST_SET_GET_BOOLEAN(fusedFilter, GeneratePhase, true);
+  ITK_TEST_SET_GET_BOOLEAN(fusedFilter, GenerateAmplitude, true);
+  ITK_TEST_SET_GET_BOOLEAN(fusedFilter, GenerateCosPhase, true);
+  ITK_TEST_SET_GET_BOOLEAN(fusedFilter, ApplySoftThreshold, true);
+
+  ImageType::SizeType size;
+  size.Fill(16);
+  auto input = itk::Testing::CreateSyntheticImage<ImageType>(size, 0.4);
+  auto forwardFFT = FFTForwardType::New();
+  forwardFFT->SetInput(input);
+  forwardFFT->Update();
+
+  // Reference: MonogenicSignalFrequencyImageFilter -> VectorInverseFFTImageFilter -> PhaseAnalysisSoftThreshold.
+  using MonogenicSignalFrequencyType = itk::MonogenicSignalFrequencyImageFilter<ComplexImageType>;
+  using VectorInverseFFTType = itk::VectorInverseFFTImageFilter<MonogenicSignalFrequencyType::OutputImageType>;
+  using PhaseAnalysisType = itk::PhaseAnalysisSoftThresholdImageFilter<VectorInverseFFTType::OutputImageType>;
+  auto monogenic = MonogenicSignalFrequencyType::New();
+  monogenic->SetInput(forwardFFT->GetOutput());
+  auto vectorInverseFFT = VectorInverseFFTType::New();
+  vectorInverseFFT->SetInput(monogenic->GetOutput());
+  auto phaseAnalysis = PhaseAnalysisType::New();
+  phaseAnalysis->SetInput(vectorInverseFFT->GetOutput());
+
+  for (const bool applySoftThreshold : { false, true })
+  {
+    const std::string thresholdName = applySoftThreshold ? " with soft threshold" : " without soft threshold";
+    phaseAnalysis->SetApplySoftThreshold(applySoftThreshold);
+    phaseAnalysis->Update();
+
+    fusedFilter = FusedFilterType::New();
+    fusedFilter->SetInput(forwardFFT->GetOutput());
+    fusedFilter->SetApplySoftThreshold(applySoftThreshold);
+    ITK_TRY_EXPECT_NO_EXCEPTION(fusedFilter->Update());
+
+    const double tolerance = 1e-9;
+    testPassed &= compareOutputs(phaseAnalysis->GetOutputPhase(),
+                                 fusedFilter->GetOutputPhase(),
+                                 tolerance,
+                                 "Phase" + thresholdName) == EXIT_SUCCESS;
+    testPassed &= compareOutputs(phaseAnalysis->GetOutputAmplitude(),
+                                 fusedFilter->GetOutputAmplitude(),
+                                 tolerance,
+                                 "Amplitude" + thresholdName) == EXIT_SUCCESS;
+    testPassed &= compareOutputs(phaseAnalysis->GetOutputCosPhase(),
+                                 fusedFilter->GetOutputCosPhase(),
+                                 tolerance,
+                                 "CosPhase" + thresholdName) == EXIT_SUCCESS;
+    if (applySoftThreshold)
+    {
+      ITK_TEST_EXPECT_TRUE(std::abs(phaseAnalysis->GetMeanAmp() - fusedFilter->GetMeanAmp()) < tolerance);
+      ITK_TEST_EXPECT_TRUE(std::abs(phaseAnalysis->GetSigmaAmp() - fusedFilter->GetSigmaAmp()) < tolerance);
+      ITK_TEST_EXPECT_TRUE(std::abs(phaseAnalysis->GetThreshold() - fusedFilter->GetThreshold()) < tolerance);
+    }
+  }
+
+  // Only cos(phase) is generated, the other outputs have no buffer.
+  fusedFilter = FusedFilterType::New();
+  fusedFilter->SetInput(forwardFFT->GetOutput());
+  fusedFilter->GeneratePhaseOff();
+  fusedFilter->GenerateAmplitudeOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(fusedFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(fusedFilter->GetOutputPhase()->GetBufferedRegion().GetNumberOfPixels(), 0);
+  ITK_TEST_EXPECT_EQUAL(fusedFilter->GetOutputAmplitude()->GetBufferedRegion().GetNumberOfPixels(), 0);
+  testPassed &=
+    compareOutputs(phaseAnalysis->GetOutputCosPhase(), fusedFilter->GetOutputCosPhase(), 1e-9, "CosPhase only") ==
+    EXIT_SUCCESS;
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
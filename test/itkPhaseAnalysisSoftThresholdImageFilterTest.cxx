@@ -27,6 +27,7 @@
 
 #include "itkVectorInverseFFTImageFilter.h"
 
+#include "itkImageRegionConstIterator.h"
 #include "itkMath.h"
 #include "itkTestingMacros.h"
 
@@ -103,6 +104,9 @@ itkPhaseAnalysisSoftThresholdImageFilterTest(int argc, char * argv[])
 
   ITK_EXERCISE_BASIC_OBJECT_METHODS(phaseAnalyzer, PhaseAnalysisSoftThresholdImageFilter, PhaseAnalysisImageFilter);
 
+  ITK_TEST_SET_GET_BOOLEAN(phaseAnalyzer, GeneratePhase, true);
+  ITK_TEST_SET_GET_BOOLEAN(phaseAnalyzer, GenerateAmplitude, true);
+
   auto applySoftThreshold = static_cast<bool>(std::stoi(argv[3]));
   ITK_TEST_SET_GET_BOOLEAN(phaseAnalyzer, ApplySoftThreshold, applySoftThreshold);
 
@@ -154,6 +158,35 @@ itkPhaseAnalysisSoftThresholdImageFilterTest(int argc, char * argv[])
   PhaseAnalysisSoftThresholdFilterType::OutputImageType::Pointer amp = phaseAnalyzer->GetOutputAmplitude();
   PhaseAnalysisSoftThresholdFilterType::OutputImageType::Pointer phase = phaseAnalyzer->GetOutputPhase();
 
+  // Only cos(phase): phase and amplitude are not stored, and the amplitude is recomputed for the threshold.
+  auto cosPhaseOnlyAnalyzer = PhaseAnalysisSoftThresholdFilterType::New();
+  cosPhaseOnlyAnalyzer->SetInput(vecInverseFFT->GetOutput());
+  cosPhaseOnlyAnalyzer->SetApplySoftThreshold(applySoftThreshold);
+  cosPhaseOnlyAnalyzer->SetNumOfSigmas(numOfSigmas);
+  cosPhaseOnlyAnalyzer->GeneratePhaseOff();
+  cosPhaseOnlyAnalyzer->GenerateAmplitudeOff();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(cosPhaseOnlyAnalyzer->Update());
+
+  ITK_TEST_EXPECT_EQUAL(cosPhaseOnlyAnalyzer->GetOutputPhase()->GetBufferedRegion().GetNumberOfPixels(), 0);
+  ITK_TEST_EXPECT_EQUAL(cosPhaseOnlyAnalyzer->GetOutputAmplitude()->GetBufferedRegion().GetNumberOfPixels(), 0);
+  ITK_TEST_EXPECT_EQUAL(cosPhaseOnlyAnalyzer->GetThreshold(), computedThreshold);
+  itk::ImageRegionConstIterator<PhaseAnalysisSoftThresholdFilterType::OutputImageType> cosIt(
+    cosPhase, cosPhase->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<PhaseAnalysisSoftThresholdFilterType::OutputImageType> cosOnlyIt(
+    cosPhaseOnlyAnalyzer->GetOutputCosPhase(), cosPhase->GetLargestPossibleRegion());
+  for (; !cosIt.IsAtEnd(); ++cosIt, ++cosOnlyIt)
+  {
+    if (cosIt.Get() != cosOnlyIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in cos(phase) without phase and amplitude outputs at " << cosIt.GetIndex() << std::endl;
+      std::cerr << "Expected: " << cosIt.Get() << ", but got: " << cosOnlyIt.Get() << std::endl;
+      testStatus = EXIT_FAILURE;
+      break;
+    }
+  }
+
 #ifdef ITK_VISUALIZE_TESTS
   itk::ViewImage<ImageType>::View(cosPhase.GetPointer(), "PhaseAnalyzer(Soft) output");
 #endif
@@ -0,0 +1,201 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPhaseAnalysisAmplitudeStatistics.h"
+#include "itkMedianAbsoluteDeviationThresholdEstimator.h"
+#include "itkPercentileThresholdEstimator.h"
+#include "itkPhaseAnalysisSoftThresholdImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Value of the sorted values at the rank q * (n - 1), the same convention than the sketch.
+double
+exactQuantile(const std::vector<double> & sortedValues, const double & q)
+{
+  const auto rank = static_cast<size_t>(std::ceil(q * (sortedValues.size() - 1)));
+  return sortedValues[rank];
+}
+
+int
+checkRelativeError(const double & expected, const double & result, const double & tolerance, const std::string & name)
+{
+  if (std::abs(result - expected) > tolerance * std::abs(expected))
+  {
+    std::cerr << "Error in " << name << ". Expected: " << expected << ", but got: " << result << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkPhaseAnalysisThresholdEstimatorTest(int, char *[])
+{
+  bool testPassed = true;
+
+  // Skewed positive values, with some zeros, accumulated in three parts and merged.
+  std::mt19937                          generator(1234);
+  std::lognormal_distribution<>         distribution(2.0, 1.0);
+  std::vector<double>                   values(30001);
+  const double                          accuracy = 0.01;
+  itk::PhaseAnalysisAmplitudeStatistics statistics(accuracy);
+  {
+    std::vector<itk::PhaseAnalysisAmplitudeStatistics> parts(3, itk::PhaseAnalysisAmplitudeStatistics(accuracy));
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      values[i] = i % 100 == 0 ? 0.0 : distribution(generator);
+      parts[i % 3].Add(values[i]);
+    }
+    for (const auto & part : parts)
+    {
+      statistics.Merge(part);
+    }
+  }
+  ITK_TEST_EXPECT_EQUAL(statistics.GetCount(), values.size());
+
+  double mean = 0.0;
+  for (const double & value : values)
+  {
+    mean += value;
+  }
+  mean /= values.size();
+  double variance = 0.0;
+  for (const double & value : values)
+  {
+    variance += (value - mean) * (value - mean);
+  }
+  variance /= values.size() - 1;
+  testPassed &= checkRelativeError(mean, statistics.GetMean(), 1e-12, "GetMean") == EXIT_SUCCESS;
+  testPassed &= checkRelativeError(variance, statistics.GetVariance(), 1e-10, "GetVariance") == EXIT_SUCCESS;
+
+  std::vector<double> sortedValues(values);
+  std::sort(sortedValues.begin(), sortedValues.end());
+  for (const double q : { 0.005, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 1.0 })
+  {
+    testPassed &= checkRelativeError(exactQuantile(sortedValues, q),
+                                     statistics.GetQuantile(q),
+                                     accuracy,
+                                     "GetQuantile(" + std::to_string(q) + ")") == EXIT_SUCCESS;
+  }
+  ITK_TEST_EXPECT_EQUAL(statistics.GetQuantile(0.0), 0.0);
+
+  const double        median = exactQuantile(sortedValues, 0.5);
+  std::vector<double> deviations;
+  for (const double & value : values)
+  {
+    deviations.push_back(std::abs(value - median));
+  }
+  std::sort(deviations.begin(), deviations.end());
+  const double mad = exactQuantile(deviations, 0.5);
+  // The deviations of the bucket values are shifted by the error of the median too.
+  testPassed &= checkRelativeError(mad, statistics.GetMedianAbsoluteDeviation(), 4 * accuracy, "MAD") == EXIT_SUCCESS;
+
+  // Estimators.
+  auto madEstimator = itk::MedianAbsoluteDeviationThresholdEstimator::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    madEstimator, MedianAbsoluteDeviationThresholdEstimator, PhaseAnalysisThresholdEstimator);
+  ITK_TEST_SET_GET_VALUE(2.0, madEstimator->GetNumOfSigmas());
+  ITK_TEST_SET_GET_VALUE(1.4826, madEstimator->GetScaleFactor());
+  ITK_TEST_SET_GET_VALUE(0.01, madEstimator->GetQuantileRelativeAccuracy());
+  ITK_TEST_EXPECT_TRUE(madEstimator->GetRequiresQuantiles());
+  madEstimator->SetNumOfSigmas(3.0);
+  testPassed &= checkRelativeError(median + 3.0 * 1.4826 * mad,
+                                   madEstimator->ComputeThreshold(statistics),
+                                   4 * accuracy,
+                                   "MedianAbsoluteDeviationThresholdEstimator") == EXIT_SUCCESS;
+
+  auto percentileEstimator = itk::PercentileThresholdEstimator::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(percentileEstimator, PercentileThresholdEstimator, PhaseAnalysisThresholdEstimator);
+  ITK_TEST_SET_GET_VALUE(90.0, percentileEstimator->GetPercentile());
+  percentileEstimator->SetPercentile(150.0);
+  ITK_TEST_SET_GET_VALUE(100.0, percentileEstimator->GetPercentile());
+  percentileEstimator->SetPercentile(75.0);
+  percentileEstimator->SetQuantileRelativeAccuracy(0.005);
+  ITK_TEST_SET_GET_VALUE(0.005, percentileEstimator->GetQuantileRelativeAccuracy());
+  testPassed &= checkRelativeError(exactQuantile(sortedValues, 0.75),
+                                   percentileEstimator->ComputeThreshold(statistics),
+                                   accuracy,
+                                   "PercentileThresholdEstimator") == EXIT_SUCCESS;
+
+  // PhaseAnalysisSoftThresholdImageFilter with an estimator: about 75% of the amplitudes are below the threshold.
+  constexpr unsigned int Dimension = 3;
+  using VectorImageType = itk::VectorImage<float, Dimension>;
+  auto                      monogenic = VectorImageType::New();
+  VectorImageType::SizeType size;
+  size.Fill(20);
+  monogenic->SetRegions(size);
+  monogenic->SetNumberOfComponentsPerPixel(Dimension + 1);
+  monogenic->Allocate();
+  std::normal_distribution<>                normal(0.0, 1.0);
+  itk::ImageRegionIterator<VectorImageType> monogenicIt(monogenic, monogenic->GetLargestPossibleRegion());
+  itk::VariableLengthVector<float>          monogenicValue(Dimension + 1);
+  for (; !monogenicIt.IsAtEnd(); ++monogenicIt)
+  {
+    for (unsigned int c = 0; c < Dimension + 1; ++c)
+    {
+      monogenicValue[c] = normal(generator);
+    }
+    monogenicIt.Set(monogenicValue);
+  }
+
+  using PhaseAnalysisType = itk::PhaseAnalysisSoftThresholdImageFilter<VectorImageType>;
+  auto phaseAnalysis = PhaseAnalysisType::New();
+  phaseAnalysis->SetInput(monogenic);
+  phaseAnalysis->SetThresholdEstimator(percentileEstimator);
+  ITK_TEST_SET_GET_VALUE(percentileEstimator, phaseAnalysis->GetThresholdEstimator());
+  ITK_TRY_EXPECT_NO_EXCEPTION(phaseAnalysis->Update());
+
+  using AmplitudeImageType = PhaseAnalysisType::OutputImageType;
+  const AmplitudeImageType * amplitude = phaseAnalysis->GetOutputAmplitude();
+  const double               threshold = phaseAnalysis->GetThreshold();
+  size_t                     belowThreshold = 0;
+
+  itk::ImageRegionConstIterator<AmplitudeImageType> ampIt(amplitude, amplitude->GetLargestPossibleRegion());
+  for (; !ampIt.IsAtEnd(); ++ampIt)
+  {
+    belowThreshold += ampIt.Get() < threshold;
+  }
+  const double fractionBelow =
+    static_cast<double>(belowThreshold) / amplitude->GetLargestPossibleRegion().GetNumberOfPixels();
+  if (std::abs(fractionBelow - 0.75) > 0.01)
+  {
+    std::cerr << "Error in the threshold of PercentileThresholdEstimator: " << fractionBelow
+              << " of the amplitudes are below it, expected 0.75" << std::endl;
+    testPassed = false;
+  }
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRieszFrequencyFunctionFixedOrder.h"
+#include "itkRieszFrequencyFilterBankGenerator.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+
+namespace
+{
+using OutputType = std::complex<double>;
+
+/** Compare all the components of the fixed order function with the ones of RieszFrequencyFunction. */
+template <unsigned int VOrder, unsigned int VDimension>
+int
+runRieszFrequencyFunctionFixedOrderTest()
+{
+  bool testPassed = true;
+  using InputType = itk::Point<itk::SpacePrecisionType, VDimension>;
+  using RieszFunctionType = itk::RieszFrequencyFunction<OutputType, VDimension, InputType>;
+  using FixedOrderFunctionType = itk::RieszFrequencyFunctionFixedOrder<VOrder, OutputType, VDimension, InputType>;
+
+  auto rieszFunction = RieszFunctionType::New();
+  rieszFunction->SetOrder(VOrder);
+  auto fixedOrderFunction = FixedOrderFunctionType::New();
+  ITK_TEST_EXPECT_EQUAL(fixedOrderFunction->GetOrder(), VOrder);
+  ITK_TEST_EXPECT_EQUAL(FixedOrderFunctionType::NumberOfComponents,
+                        RieszFunctionType::ComputeNumberOfComponents(VOrder));
+  ITK_TRY_EXPECT_EXCEPTION(fixedOrderFunction->SetOrder(VOrder + 1));
+  ITK_TRY_EXPECT_NO_EXCEPTION(fixedOrderFunction->SetOrder(VOrder));
+
+  // The compile time table has the order of GetIndices.
+  unsigned int comp = 0;
+  for (const auto & index : rieszFunction->GetIndices())
+  {
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      if (FixedOrderFunctionType::ComponentTable.Exponents[comp][dim] != index[dim])
+      {
+        std::cerr << "Error. Order: " << VOrder << ", Dimension: " << VDimension << ". Exponents of component "
+                  << comp << " differ from GetIndices." << std::endl;
+        testPassed = false;
+      }
+    }
+    ++comp;
+  }
+
+  // Scanline of points, including the zero frequency.
+  const unsigned int                                numberOfPoints = 9;
+  std::vector<double>                               frequencyBuffer(VDimension * numberOfPoints);
+  typename RieszFunctionType::FrequencyScanlineType frequencyScanline;
+  for (unsigned int dim = 0; dim < VDimension; ++dim)
+  {
+    frequencyScanline[dim] = &frequencyBuffer[dim * numberOfPoints];
+    for (unsigned int p = 0; p < numberOfPoints; ++p)
+    {
+      frequencyBuffer[dim * numberOfPoints + p] = (p == 0) ? 0.0 : -0.5 + 0.11 * p - 0.05 * dim;
+    }
+  }
+  const unsigned int                               numberOfComponents = FixedOrderFunctionType::NumberOfComponents;
+  std::vector<OutputType>                          expectedBuffer(numberOfComponents * numberOfPoints);
+  std::vector<OutputType>                          componentBuffer(numberOfComponents * numberOfPoints);
+  typename RieszFunctionType::ComponentBuffersType expectedScanline(numberOfComponents);
+  typename RieszFunctionType::ComponentBuffersType componentScanline(numberOfComponents);
+  for (comp = 0; comp < numberOfComponents; ++comp)
+  {
+    expectedScanline[comp] = &expectedBuffer[comp * numberOfPoints];
+    componentScanline[comp] = &componentBuffer[comp * numberOfPoints];
+  }
+  rieszFunction->EvaluateAllComponentsOnScanline(frequencyScanline, numberOfPoints, expectedScanline);
+  fixedOrderFunction->EvaluateAllComponentsOnScanline(frequencyScanline, numberOfPoints, componentScanline);
+
+  for (unsigned int p = 0; p < numberOfPoints; ++p)
+  {
+    InputType point;
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      point[dim] = frequencyScanline[dim][p];
+    }
+    const auto pointComponents = fixedOrderFunction->EvaluateAllComponents(point);
+    for (comp = 0; comp < numberOfComponents; ++comp)
+    {
+      const OutputType expected = expectedScanline[comp][p];
+      if (std::abs(componentScanline[comp][p] - expected) > 1e-12 ||
+          std::abs(pointComponents[comp] - expected) > 1e-12)
+      {
+        std::cerr << "Error. Order: " << VOrder << ", point: " << point << ", component: " << comp
+                  << ". EvaluateAllComponentsOnScanline: " << componentScanline[comp][p]
+                  << ", EvaluateAllComponents: " << pointComponents[comp] << ", expected: " << expected << std::endl;
+        testPassed = false;
+      }
+    }
+  }
+
+  // A single component gives the same values than all the components.
+  std::vector<OutputType> singleComponent(numberOfPoints);
+  for (comp = 0; comp < numberOfComponents; ++comp)
+  {
+    fixedOrderFunction->EvaluateComponentOnScanline(frequencyScanline, numberOfPoints, comp, singleComponent.data());
+    for (unsigned int p = 0; p < numberOfPoints; ++p)
+    {
+      if (std::abs(singleComponent[p] - expectedScanline[comp][p]) > 1e-12)
+      {
+        std::cerr << "Error. Order: " << VOrder << ", component: " << comp
+                  << ". EvaluateComponentOnScanline: " << singleComponent[p]
+                  << ", expected: " << expectedScanline[comp][p] << std::endl;
+        testPassed = false;
+      }
+    }
+  }
+  ITK_TRY_EXPECT_EXCEPTION(fixedOrderFunction->EvaluateComponentOnScanline(
+    frequencyScanline, numberOfPoints, numberOfComponents, singleComponent.data()));
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+} // namespace
+
+int
+itkRieszFrequencyFunctionFixedOrderTest(int, char *[])
+{
+  bool testPassed = true;
+
+  auto fixedOrderFunction = itk::RieszFrequencyFunctionFixedOrder<2>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fixedOrderFunction, RieszFrequencyFunctionFixedOrder, RieszFrequencyFunction);
+
+  testPassed &= runRieszFrequencyFunctionFixedOrderTest<1, 2>() == EXIT_SUCCESS;
+  testPassed &= runRieszFrequencyFunctionFixedOrderTest<2, 2>() == EXIT_SUCCESS;
+  testPassed &= runRieszFrequencyFunctionFixedOrderTest<3, 2>() == EXIT_SUCCESS;
+  testPassed &= runRieszFrequencyFunctionFixedOrderTest<4, 2>() == EXIT_SUCCESS;
+  testPassed &= runRieszFrequencyFunctionFixedOrderTest<1, 3>() == EXIT_SUCCESS;
+  testPassed &= runRieszFrequencyFunctionFixedOrderTest<2, 3>() == EXIT_SUCCESS;
+  testPassed &= runRieszFrequencyFunctionFixedOrderTest<3, 3>() == EXIT_SUCCESS;
+  testPassed &= runRieszFrequencyFunctionFixedOrderTest<4, 3>() == EXIT_SUCCESS;
+
+  // The filter bank generated with the fixed order function is the same.
+  constexpr unsigned int Dimension = 3;
+  constexpr unsigned int Order = 3;
+  using ComplexImageType = itk::Image<OutputType, Dimension>;
+  using FilterBankType = itk::RieszFrequencyFilterBankGenerator<ComplexImageType>;
+  using FixedOrderFilterBankType =
+    itk::RieszFrequencyFilterBankGenerator<ComplexImageType,
+                                           itk::RieszFrequencyFunctionFixedOrder<Order, OutputType, Dimension>>;
+  ComplexImageType::SizeType size;
+  size.Fill(12);
+  auto filterBank = FilterBankType::New();
+  filterBank->SetSize(size);
+  filterBank->SetOrder(Order);
+  filterBank->Update();
+  auto fixedOrderFilterBank = FixedOrderFilterBankType::New();
+  ITK_TEST_EXPECT_EQUAL(fixedOrderFilterBank->GetOrder(), Order);
+  fixedOrderFilterBank->SetSize(size);
+  fixedOrderFilterBank->Update();
+  ITK_TEST_EXPECT_EQUAL(fixedOrderFilterBank->GetNumberOfOutputs(), filterBank->GetNumberOfOutputs());
+  for (unsigned int comp = 0; comp < filterBank->GetNumberOfOutputs(); ++comp)
+  {
+    itk::ImageRegionConstIterator<ComplexImageType> it(filterBank->GetOutput(comp),
+                                                       filterBank->GetOutput(comp)->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ComplexImageType> fixedIt(
+      fixedOrderFilterBank->GetOutput(comp), fixedOrderFilterBank->GetOutput(comp)->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it, ++fixedIt)
+    {
+      if (std::abs(it.Get() - fixedIt.Get()) > 1e-12)
+      {
+        std::cerr << "Error. Filter bank component " << comp << " differs at " << it.GetIndex() << std::endl;
+        testPassed = false;
+        break;
+      }
+    }
+  }
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
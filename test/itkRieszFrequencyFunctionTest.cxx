@@ -26,6 +26,7 @@
 #include <memory>
 #include <string>
 #include <cmath>
+#include <vector>
 
 // Visualize for dev/debug purposes. Set in cmake file. Requires VTK
 #ifdef ITK_VISUALIZE_TESTS
@@ -138,6 +139,71 @@ runRieszFrequencyFunctionTest(unsigned int inputOrder)
   }
   std::cout << std::endl;
 
+  // Evaluate a scanline of points, including the zero frequency, and compare with EvaluateWithIndices.
+  const unsigned int  numberOfPoints = 7;
+  std::vector<double> frequencyBuffer(Dimension * numberOfPoints);
+  typename RieszFrequencyFunctionType::FrequencyScanlineType frequencyScanline;
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    frequencyScanline[dim] = &frequencyBuffer[dim * numberOfPoints];
+    for (unsigned int p = 0; p < numberOfPoints; ++p)
+    {
+      frequencyBuffer[dim * numberOfPoints + p] = (p == 0) ? 0.0 : 0.5 - 0.13 * p + 0.07 * dim;
+    }
+  }
+  for (unsigned int order = 1; order < 6; ++order)
+  {
+    rieszFunction->SetOrder(order);
+    const unsigned int                                        numberOfComponents = rieszFunction->GetIndices().size();
+    std::vector<OutputType>                                   componentBuffer(numberOfComponents * numberOfPoints);
+    typename RieszFrequencyFunctionType::ComponentBuffersType componentScanline(numberOfComponents);
+    for (unsigned int comp = 0; comp < numberOfComponents; ++comp)
+    {
+      componentScanline[comp] = &componentBuffer[comp * numberOfPoints];
+    }
+    rieszFunction->EvaluateAllComponentsOnScanline(frequencyScanline, numberOfPoints, componentScanline);
+    std::vector<OutputType> singleComponent(numberOfPoints);
+    for (unsigned int comp = 0; comp < numberOfComponents; ++comp)
+    {
+      rieszFunction->EvaluateComponentOnScanline(frequencyScanline, numberOfPoints, comp, singleComponent.data());
+      for (unsigned int p = 0; p < numberOfPoints; ++p)
+      {
+        if (std::abs(singleComponent[p] - componentScanline[comp][p]) > 1e-12)
+        {
+          std::cerr << "Error. Order: " << order << ", component: " << comp
+                    << ". EvaluateComponentOnScanline: " << singleComponent[p]
+                    << ", EvaluateAllComponentsOnScanline: " << componentScanline[comp][p] << std::endl;
+          testPassed = false;
+        }
+      }
+    }
+    ITK_TRY_EXPECT_EXCEPTION(
+      rieszFunction->EvaluateComponentOnScanline(frequencyScanline, numberOfPoints, numberOfComponents, nullptr));
+    for (unsigned int p = 0; p < numberOfPoints; ++p)
+    {
+      InputType point;
+      for (unsigned int dim = 0; dim < Dimension; ++dim)
+      {
+        point[dim] = frequencyScanline[dim][p];
+      }
+      const OutputComponentType pointComponents = rieszFunction->EvaluateAllComponents(point);
+      unsigned int              comp = 0;
+      for (const auto & index : rieszFunction->GetIndices())
+      {
+        const OutputType expected = rieszFunction->EvaluateWithIndices(point, index);
+        if (std::abs(componentScanline[comp][p] - expected) > 1e-12 ||
+            std::abs(pointComponents[comp] - expected) > 1e-12)
+        {
+          std::cerr << "Error. Order: " << order << ", point: " << point << ", component: " << comp
+                    << ". EvaluateAllComponentsOnScanline: " << componentScanline[comp][p]
+                    << ", EvaluateAllComponents: " << pointComponents[comp] << ", expected: " << expected << std::endl;
+          testPassed = false;
+        }
+        ++comp;
+      }
+    }
+  }
+
   if (testPassed)
   {
     std::cout << "Test Passed!" << std::endl;
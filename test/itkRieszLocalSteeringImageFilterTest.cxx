@@ -0,0 +1,232 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRieszLocalSteeringImageFilter.h"
+#include "itkRieszRotationMatrix.h"
+#include "itkStructureTensor.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+createImage(const unsigned int & sideSize, const unsigned int & seed)
+{
+  typename TImage::SizeType size;
+  size.Fill(sideSize);
+  return itk::Testing::CreateSyntheticImage<TImage>(size, 0.3 * (seed + 1), seed);
+}
+
+/** Compare the steerable matrix of RieszSteeringPolynomials with RieszRotationMatrix::ComputeSteerableMatrix. */
+template <unsigned int VDimension>
+int
+runSteeringPolynomialsTest(const typename itk::RieszRotationMatrix<double, VDimension>::SpatialRotationMatrixType & R)
+{
+  bool testPassed = true;
+  using PolynomialsType = itk::RieszSteeringPolynomials<VDimension>;
+  ITK_TRY_EXPECT_EXCEPTION(PolynomialsType::GetCached(0));
+
+  double rotation[VDimension * VDimension];
+  for (unsigned int i = 0; i < VDimension; ++i)
+  {
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      rotation[i * VDimension + j] = R[i][j];
+    }
+  }
+  for (unsigned int order = 1; order < 5; ++order)
+  {
+    const auto polynomials = PolynomialsType::GetCached(order);
+    ITK_TEST_EXPECT_TRUE(polynomials == PolynomialsType::GetCached(order));
+    ITK_TEST_EXPECT_EQUAL(polynomials->GetOrder(), order);
+
+    itk::RieszRotationMatrix<double, VDimension> steerableMatrix(R, order);
+    const unsigned int                           components = steerableMatrix.GetComponents();
+    ITK_TEST_EXPECT_EQUAL(polynomials->GetNumberOfComponents(), components);
+    std::vector<double> workspace(polynomials->GetWorkspaceSize());
+    std::vector<double> S(components * components);
+    polynomials->Evaluate(rotation, workspace.data(), S.data());
+    for (unsigned int i = 0; i < components; ++i)
+    {
+      for (unsigned int j = 0; j < components; ++j)
+      {
+        if (std::abs(S[i * components + j] - steerableMatrix[i][j]) > 1e-12)
+        {
+          std::cerr << "Error. Dimension: " << VDimension << ", order: " << order << ". S[" << i << "][" << j
+                    << "] = " << S[i * components + j] << ", ComputeSteerableMatrix: " << steerableMatrix[i][j]
+                    << std::endl;
+          testPassed = false;
+        }
+      }
+    }
+  }
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+template <unsigned int VDimension>
+int
+runRieszLocalSteeringImageFilterTest()
+{
+  bool testPassed = true;
+  using ImageType = itk::Image<double, VDimension>;
+  using StructureTensorType = itk::StructureTensor<ImageType>;
+  using SteeringFilterType = itk::RieszLocalSteeringImageFilter<ImageType>;
+  using RieszRotationMatrixType = itk::RieszRotationMatrix<double, VDimension>;
+  using SpatialRotationMatrixType = typename RieszRotationMatrixType::SpatialRotationMatrixType;
+
+  // Rotation of angle around the first axis and then around the last axis.
+  const double              angle = 0.7;
+  SpatialRotationMatrixType R;
+  R.SetIdentity();
+  R[0][0] = std::cos(angle);
+  R[0][1] = -std::sin(angle);
+  R[1][0] = std::sin(angle);
+  R[1][1] = std::cos(angle);
+  if (VDimension == 3)
+  {
+    SpatialRotationMatrixType Rx;
+    Rx.SetIdentity();
+    Rx[1][1] = std::cos(2 * angle);
+    Rx[1][2] = -std::sin(2 * angle);
+    Rx[2][1] = std::sin(2 * angle);
+    Rx[2][2] = std::cos(2 * angle);
+    R = R * Rx;
+  }
+  testPassed &= runSteeringPolynomialsTest<VDimension>(R) == EXIT_SUCCESS;
+
+  // Local orientation from the StructureTensor of VDimension images.
+  const unsigned int                       sideSize = 8;
+  typename StructureTensorType::InputsType tensorInputs;
+  for (unsigned int dim = 0; dim < VDimension; ++dim)
+  {
+    tensorInputs.push_back(createImage<ImageType>(sideSize, dim));
+  }
+  auto tensor = StructureTensorType::New();
+  tensor->SetInputs(tensorInputs);
+  tensor->Update();
+
+  // Order 1: the first output is the projection along the largest eigenvector.
+  auto steering = SteeringFilterType::New();
+  ITK_TEST_EXPECT_EQUAL(steering->GetOrder(), 1);
+  ITK_TEST_EXPECT_TRUE(steering->GetLargestEigenvectorInFirstRow());
+  ITK_TEST_EXPECT_EQUAL(steering->GetNumberOfOutputs(), VDimension);
+  steering->SetInputs(tensorInputs);
+  steering->SetStructureTensor(tensor->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(steering->Update());
+  const auto projection = tensor->ComputeProjectionImageWithLargestResponse();
+  itk::ImageRegionConstIterator<ImageType> projectionIt(projection, projection->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> steeredIt(steering->GetOutput(0), projection->GetLargestPossibleRegion());
+  for (; !projectionIt.IsAtEnd(); ++projectionIt, ++steeredIt)
+  {
+    if (std::abs(projectionIt.Get() - steeredIt.Get()) > 1e-9)
+    {
+      std::cerr << "Error. Order 1, the first output differs from ComputeProjectionImageWithLargestResponse at "
+                << projectionIt.GetIndex() << ": " << steeredIt.Get() << " != " << projectionIt.Get() << std::endl;
+      testPassed = false;
+      break;
+    }
+  }
+
+  // Any order: compare with RieszRotationMatrix at every pixel.
+  for (unsigned int order = 1; order < 4; ++order)
+  {
+    const unsigned int                      components = itk::utils::ComputeNumberOfComponents(order, VDimension);
+    typename SteeringFilterType::InputsType rieszComponents;
+    for (unsigned int comp = 0; comp < components; ++comp)
+    {
+      rieszComponents.push_back(createImage<ImageType>(sideSize, comp + 7));
+    }
+    steering = SteeringFilterType::New();
+    steering->SetOrder(order);
+    ITK_TEST_EXPECT_EQUAL(steering->GetNumberOfOutputs(), components);
+    steering->SetStructureTensor(tensor->GetOutput());
+    steering->SetInputs(typename SteeringFilterType::InputsType(rieszComponents.begin(), rieszComponents.end() - 1));
+    ITK_TRY_EXPECT_EXCEPTION(steering->Update());
+    steering->SetInputs(rieszComponents);
+    ITK_TRY_EXPECT_NO_EXCEPTION(steering->Update());
+    const auto outputs = steering->GetOutputs();
+
+    itk::ImageRegionConstIterator<typename StructureTensorType::OutputImageType> tensorIt(
+      tensor->GetOutput(), tensor->GetOutput()->GetLargestPossibleRegion());
+    for (; !tensorIt.IsAtEnd(); ++tensorIt)
+    {
+      const auto                eigenvectors = tensor->GetRotationMatrixFromOutputMatrix(tensorIt.Get(), true);
+      SpatialRotationMatrixType localRotation;
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        for (unsigned int j = 0; j < VDimension; ++j)
+        {
+          localRotation[i][j] = eigenvectors[i][j];
+        }
+      }
+      const RieszRotationMatrixType steerableMatrix(localRotation, order);
+      std::vector<double>           values(components);
+      for (unsigned int comp = 0; comp < components; ++comp)
+      {
+        values[comp] = rieszComponents[comp]->GetPixel(tensorIt.GetIndex());
+      }
+      const auto expected = steerableMatrix.MultiplyWithVector(values);
+      for (unsigned int comp = 0; comp < components; ++comp)
+      {
+        const double steered = outputs[comp]->GetPixel(tensorIt.GetIndex());
+        if (std::abs(steered - expected[comp]) > 1e-9)
+        {
+          std::cerr << "Error. Dimension: " << VDimension << ", order: " << order << ", component: " << comp
+                    << ", index: " << tensorIt.GetIndex() << ". Steered: " << steered
+                    << ", expected: " << expected[comp] << std::endl;
+          testPassed = false;
+        }
+      }
+    }
+  }
+
+  return testPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+} // namespace
+
+int
+itkRieszLocalSteeringImageFilterTest(int, char *[])
+{
+  bool testPassed = true;
+
+  using ImageType = itk::Image<float, 3>;
+  using SteeringFilterType = itk::RieszLocalSteeringImageFilter<ImageType>;
+  auto steering = SteeringFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(steering, RieszLocalSteeringImageFilter, ImageToImageFilter);
+  ITK_TEST_SET_GET_BOOLEAN(steering, LargestEigenvectorInFirstRow, false);
+  ITK_TRY_EXPECT_EXCEPTION(steering->SetOrder(0));
+
+  testPassed &= runRieszLocalSteeringImageFilterTest<2>() == EXIT_SUCCESS;
+  testPassed &= runRieszLocalSteeringImageFilterTest<3>() == EXIT_SUCCESS;
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
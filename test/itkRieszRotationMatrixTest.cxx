@@ -20,6 +20,7 @@
 #include <complex>
 #include "itkImage.h"
 #include "itkImageDuplicator.h"
+#include "itkMultiplyImageFilter.h"
 #include "itkMath.h"
 #include "itkTestingComparisonImageFilter.h"
 
@@ -181,6 +182,26 @@ runRieszRotationMatrixInterfaceWithRieszFrequencyFilterBankGeneratorTest()
   // result = 1.0 * images[0]
   int thirdComponentStatus = compareImagesAndReport<ImageType>(images[0], imagesMultipliedByRieszRotationMatrix[2]);
 
+  // In place, the input images are overwritten with the same result.
+  using DuplicatorType = itk::ImageDuplicator<ImageType>;
+  std::vector<ImagePointer> inPlaceImages(M);
+  for (unsigned int i = 0; i < M; i++)
+  {
+    auto duplicator = DuplicatorType::New();
+    duplicator->SetInputImage(images[i]);
+    duplicator->Update();
+    inPlaceImages[i] = duplicator->GetOutput();
+  }
+  S.MultiplyWithVectorOfImagesInPlace<ImageType>(inPlaceImages);
+  for (unsigned int i = 0; i < M; i++)
+  {
+    if (compareImagesAndReport<ImageType>(imagesMultipliedByRieszRotationMatrix[i], inPlaceImages[i]) != EXIT_SUCCESS)
+    {
+      std::cerr << "MultiplyWithVectorOfImagesInPlace differs in component " << i << std::endl;
+      multiplyWithSomethingPassed = false;
+    }
+  }
+
   if (!multiplyWithSomethingPassed)
   {
     return EXIT_FAILURE;
@@ -20,12 +20,18 @@
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkStreamingImageFilter.h"
 #include "itkTestingComparisonImageFilter.h"
 #include "itkStructureTensor.h"
+#include "itkFixedSizeSymmetricEigenSolver.h"
 #include "itkTestingMacros.h"
 
 #include <string>
 #include <cmath>
+#include <random>
+#include <algorithm>
 
 // Visualize for dev/debug purposes. Set in cmake file. Requires VTK
 #ifdef ITK_VISUALIZE_TESTS
@@ -118,11 +124,12 @@ runStructureTensorTest()
   tensor->SetGaussianWindowSigma(nonDefaultGaussianSigma);
   ITK_TEST_SET_GET_VALUE(nonDefaultGaussianSigma, tensor->GetGaussianWindowSigma());
   tensor->SetGaussianWindowSigma(1.0); // Restore default.
-  // Use a external, new GaussianSource:
-  // The gaussian source is modified in BeforeThreadedGenerateData() only if
-  // the source has different sigma or radius than this class.
-  typename StructureTensorType::GaussianSourceType::Pointer gaussianSource = tensor->GetModifiableGaussianSource();
-  gaussianSource = StructureTensorType::GaussianSourceType::New();
+  ITK_TEST_SET_GET_BOOLEAN(tensor, UseRecursiveGaussian, false);
+  // The GaussianSource is only built when requested, with the current radius.
+  ITK_TEST_EXPECT_EQUAL(tensor->GetGaussianSource()->GetSize()[0], 5u);
+  tensor->SetGaussianWindowRadius(3);
+  ITK_TEST_EXPECT_EQUAL(tensor->GetGaussianSource()->GetSize()[0], 7u);
+  tensor->SetGaussianWindowRadius(2);
 
   std::vector<typename ImageType::Pointer> inputs;
   inputs.push_back(inputImage1);
@@ -237,9 +244,369 @@ runStructureTensorTest()
   return EXIT_SUCCESS;
 }
 
+// Maximum difference between the matrix J = V * diag(lambda) * V^T of the output matrix, where the columns of V are
+// the eigenvectors, and the expected matrix. Also checks that the eigenvectors are orthonormal.
+template <typename TOutputMatrix>
+double
+eigenSystemError(const TOutputMatrix & outputMatrix, const vnl_matrix<double> & expected)
+{
+  const unsigned int nInputs = expected.rows();
+  double             error = 0;
+  for (unsigned int m = 0; m < nInputs; ++m)
+  {
+    for (unsigned int n = 0; n < nInputs; ++n)
+    {
+      double tensor = 0;
+      double dotProduct = 0;
+      for (unsigned int k = 0; k < nInputs; ++k)
+      {
+        tensor += outputMatrix(m, k) * outputMatrix(k, nInputs) * outputMatrix(n, k);
+        dotProduct += outputMatrix(k, m) * outputMatrix(k, n);
+      }
+      error = std::max(error, std::abs(tensor - expected(m, n)));
+      error = std::max(error, std::abs(dotProduct - (m == n ? 1.0 : 0.0)));
+    }
+  }
+  return error;
+}
+
+// Compare the eigen system of the output with a brute-force weighted sum in the window,
+// for random inputs and anisotropic spacing, with and without streaming, and with a fixed size output pixel.
+template <unsigned int VDimension, unsigned int VInputs>
+int
+runStructureTensorSmoothingTest()
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using StructureTensorType = itk::StructureTensor<ImageType>;
+  using FixedSizeOutputImageType = itk::Image<itk::Matrix<double, VInputs, VInputs + 1>, VDimension>;
+  using FixedSizeStructureTensorType = itk::StructureTensor<ImageType, FixedSizeOutputImageType>;
+  const unsigned int radius = 2;
+  const double       sigma = 1.5;
+
+  typename ImageType::SizeType    size;
+  typename ImageType::SpacingType spacing;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    size[d] = 9 + d;
+    spacing[d] = 1.0 + 0.25 * d;
+  }
+  std::mt19937                             generator(42);
+  std::uniform_real_distribution<float>    distribution(-1.0, 1.0);
+  typename StructureTensorType::InputsType inputs;
+  for (unsigned int m = 0; m < VInputs; ++m)
+  {
+    auto input = ImageType::New();
+    input->SetRegions(size);
+    input->SetSpacing(spacing);
+    input->Allocate();
+    itk::ImageRegionIterator<ImageType> it(input, input->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      it.Set(distribution(generator));
+    }
+    inputs.push_back(input);
+  }
+
+  auto tensor = StructureTensorType::New();
+  tensor->SetInputs(inputs);
+  tensor->SetGaussianWindowRadius(radius);
+  tensor->SetGaussianWindowSigma(sigma);
+  ITK_TRY_EXPECT_NO_EXCEPTION(tensor->Update());
+
+  using StreamingFilterType = itk::StreamingImageFilter<typename StructureTensorType::OutputImageType,
+                                                        typename StructureTensorType::OutputImageType>;
+  auto streamedTensor = StructureTensorType::New();
+  streamedTensor->SetInputs(inputs);
+  streamedTensor->SetGaussianWindowRadius(radius);
+  streamedTensor->SetGaussianWindowSigma(sigma);
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(streamedTensor->GetOutput());
+  streamer->SetNumberOfStreamDivisions(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  auto fixedSizeTensor = FixedSizeStructureTensorType::New();
+  fixedSizeTensor->SetInputs(inputs);
+  fixedSizeTensor->SetGaussianWindowRadius(radius);
+  fixedSizeTensor->SetGaussianWindowSigma(sigma);
+  ITK_TRY_EXPECT_NO_EXCEPTION(fixedSizeTensor->Update());
+
+  // The size of a fixed size output pixel must match the number of inputs.
+  using WrongSizeStructureTensorType =
+    itk::StructureTensor<ImageType, itk::Image<itk::Matrix<double, VInputs + 1, VInputs + 2>, VDimension>>;
+  auto wrongSizeTensor = WrongSizeStructureTensorType::New();
+  wrongSizeTensor->SetInputs(inputs);
+  ITK_TRY_EXPECT_EXCEPTION(wrongSizeTensor->Update());
+
+  // Only the compact output: packed tensor and eigenvalues.
+  auto compactTensor = StructureTensorType::New();
+  ITK_TEST_SET_GET_BOOLEAN(compactTensor, GenerateEigenMatrix, true);
+  ITK_TEST_SET_GET_BOOLEAN(compactTensor, GenerateCompactTensor, false);
+  compactTensor->SetInputs(inputs);
+  compactTensor->SetGaussianWindowRadius(radius);
+  compactTensor->SetGaussianWindowSigma(sigma);
+  compactTensor->GenerateEigenMatrixOff();
+  ITK_TRY_EXPECT_EXCEPTION(compactTensor->Update());
+  compactTensor->GenerateCompactTensorOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(compactTensor->Update());
+  ITK_TEST_EXPECT_EQUAL(compactTensor->GetOutput()->GetBufferedRegion().GetNumberOfPixels(), 0);
+  ITK_TEST_EXPECT_EQUAL(compactTensor->GetCompactTensorOutput()->GetNumberOfComponentsPerPixel(),
+                        VInputs * (VInputs + 3) / 2);
+
+  typename itk::ConstNeighborhoodIterator<ImageType>::RadiusType neighborhoodRadius;
+  neighborhoodRadius.Fill(radius);
+  std::vector<itk::ConstNeighborhoodIterator<ImageType>> neighborhoodIts;
+  for (const auto & input : inputs)
+  {
+    neighborhoodIts.emplace_back(neighborhoodRadius, input, input->GetLargestPossibleRegion());
+  }
+  const unsigned int  neighborhoodSize = neighborhoodIts[0].Size();
+  std::vector<double> weights(neighborhoodSize);
+  double              weightsSum = 0;
+  for (unsigned int i = 0; i < neighborhoodSize; ++i)
+  {
+    double squaredDistance = 0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      const double x = neighborhoodIts[0].GetOffset(i)[d] * spacing[d] / sigma;
+      squaredDistance += x * x;
+    }
+    weights[i] = std::exp(-0.5 * squaredDistance);
+    weightsSum += weights[i];
+  }
+
+  const double       tolerance = 1e-9;
+  vnl_matrix<double> expected(VInputs, VInputs);
+  while (!neighborhoodIts[0].IsAtEnd())
+  {
+    for (unsigned int m = 0; m < VInputs; ++m)
+    {
+      for (unsigned int n = m; n < VInputs; ++n)
+      {
+        double sum = 0;
+        for (unsigned int i = 0; i < neighborhoodSize; ++i)
+        {
+          sum += weights[i] * neighborhoodIts[m].GetPixel(i) * neighborhoodIts[n].GetPixel(i);
+        }
+        expected(m, n) = expected(n, m) = sum / weightsSum;
+      }
+    }
+
+    const auto index = neighborhoodIts[0].GetIndex();
+    double     error = std::max({ eigenSystemError(tensor->GetOutput()->GetPixel(index), expected),
+                                  eigenSystemError(streamer->GetOutput()->GetPixel(index), expected),
+                                  eigenSystemError(fixedSizeTensor->GetOutput()->GetPixel(index), expected) });
+    const auto compactPixel = compactTensor->GetCompactTensorOutput()->GetPixel(index);
+    for (unsigned int n = 0; n < VInputs; ++n)
+    {
+      for (unsigned int m = 0; m <= n; ++m)
+      {
+        error = std::max(error, std::abs(compactPixel[m + (n + 1) * n / 2] - expected(m, n)));
+      }
+      error = std::max(error,
+                       std::abs(compactPixel[VInputs * (VInputs + 1) / 2 + n] -
+                                tensor->GetOutput()->GetPixel(index)(n, VInputs)));
+    }
+    if (error > tolerance)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in the eigen system of the smoothed tensor with " << VInputs << " inputs at " << index
+                << ". Expected tensor:\n"
+                << expected << "Error: " << error << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (auto & neighborhoodIt : neighborhoodIts)
+    {
+      ++neighborhoodIt;
+    }
+  }
+
+  // The derived images from the compact output and from the matrix of eigenvectors are the same.
+  std::vector<std::pair<typename ImageType::Pointer, typename ImageType::Pointer>> derivedImages;
+  for (unsigned int eigenNumber = 0; eigenNumber < VInputs; ++eigenNumber)
+  {
+    derivedImages.emplace_back(tensor->ComputeProjectionImage(eigenNumber),
+                               compactTensor->ComputeProjectionImage(eigenNumber));
+  }
+  derivedImages.emplace_back(tensor->ComputeCoherencyImage(), compactTensor->ComputeCoherencyImage());
+
+  using ProjectionFilterType = typename StructureTensorType::ProjectionFilterType;
+  auto projectionFilter = ProjectionFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(projectionFilter, StructureTensorProjectionImageFilter, ImageToImageFilter);
+  ITK_TEST_SET_GET_BOOLEAN(projectionFilter, LargestResponse, true);
+  projectionFilter->SetInputs(inputs);
+  projectionFilter->SetCompactTensor(compactTensor->GetCompactTensorOutput());
+  projectionFilter->LargestResponseOff();
+  projectionFilter->SetEigenNumber(VInputs);
+  ITK_TRY_EXPECT_EXCEPTION(projectionFilter->Update());
+  projectionFilter->LargestResponseOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(projectionFilter->Update());
+  derivedImages.emplace_back(tensor->ComputeProjectionImageWithLargestResponse(), projectionFilter->GetOutput());
+  for (const auto & derivedImage : derivedImages)
+  {
+    itk::ImageRegionConstIterator<ImageType> matrixIt(derivedImage.first, derivedImage.first->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> compactIt(derivedImage.second, derivedImage.first->GetBufferedRegion());
+    for (; !matrixIt.IsAtEnd(); ++matrixIt, ++compactIt)
+    {
+      if (std::abs(matrixIt.Get() - compactIt.Get()) > 1e-6)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in the image derived from the compact tensor at " << matrixIt.GetIndex()
+                  << ". Expected: " << matrixIt.Get() << ", but got: " << compactIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// The recursive Gaussian approximates the truncated window with a radius of 4 sigma, for smooth inputs.
+int
+runStructureTensorRecursiveGaussianTest()
+{
+  constexpr unsigned int Dimension = 2;
+  constexpr unsigned int nInputs = 2;
+  using ImageType = itk::Image<double, Dimension>;
+  using StructureTensorType = itk::StructureTensor<ImageType>;
+  const double       sigma = 2.0;
+  const unsigned int radius = 8;
+
+  ImageType::SizeType size;
+  size[0] = 48;
+  size[1] = 40;
+  StructureTensorType::InputsType inputs;
+  for (unsigned int m = 0; m < nInputs; ++m)
+  {
+    auto input = ImageType::New();
+    input->SetRegions(size);
+    input->Allocate();
+    itk::ImageRegionIteratorWithIndex<ImageType> it(input, input->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      it.Set(m == 0 ? std::cos(2 * itk::Math::pi * index[0] / 24.0)
+                    : 0.5 + std::sin(2 * itk::Math::pi * index[1] / 20.0));
+    }
+    inputs.push_back(input);
+  }
+
+  auto windowTensor = StructureTensorType::New();
+  windowTensor->SetInputs(inputs);
+  windowTensor->SetGaussianWindowRadius(radius);
+  windowTensor->SetGaussianWindowSigma(sigma);
+  windowTensor->GenerateCompactTensorOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(windowTensor->Update());
+
+  auto recursiveTensor = StructureTensorType::New();
+  recursiveTensor->SetInputs(inputs);
+  recursiveTensor->SetGaussianWindowSigma(sigma);
+  recursiveTensor->GenerateCompactTensorOn();
+  recursiveTensor->UseRecursiveGaussianOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(recursiveTensor->Update());
+
+  // The recursive filter reads the whole inputs, the streamed output is the same.
+  using StreamingFilterType =
+    itk::StreamingImageFilter<StructureTensorType::OutputImageType, StructureTensorType::OutputImageType>;
+  auto streamedTensor = StructureTensorType::New();
+  streamedTensor->SetInputs(inputs);
+  streamedTensor->SetGaussianWindowSigma(sigma);
+  streamedTensor->UseRecursiveGaussianOn();
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(streamedTensor->GetOutput());
+  streamer->SetNumberOfStreamDivisions(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  const unsigned int nCompactComponents = StructureTensorType::GetNumberOfCompactTensorComponents(nInputs);
+  itk::ImageRegionConstIteratorWithIndex<ImageType> indexIt(inputs[0], inputs[0]->GetLargestPossibleRegion());
+  for (; !indexIt.IsAtEnd(); ++indexIt)
+  {
+    const auto index = indexIt.GetIndex();
+    const auto recursivePixel = recursiveTensor->GetCompactTensorOutput()->GetPixel(index);
+    const auto windowPixel = windowTensor->GetCompactTensorOutput()->GetPixel(index);
+    double     error = 0;
+    for (unsigned int c = 0; c < nCompactComponents; ++c)
+    {
+      error = std::max(error, std::abs(recursivePixel[c] - windowPixel[c]));
+    }
+    const auto recursiveMatrix = recursiveTensor->GetOutput()->GetPixel(index);
+    const auto streamedMatrix = streamer->GetOutput()->GetPixel(index);
+    for (unsigned int r = 0; r < nInputs; ++r)
+    {
+      for (unsigned int c = 0; c < nInputs + 1; ++c)
+      {
+        if (std::abs(recursiveMatrix(r, c) - streamedMatrix(r, c)) > 1e-12)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "The streamed recursive tensor differs at " << index << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    // The boundary conditions of the anti-causal pass differ from the window ones.
+    bool isInterior = true;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      isInterior &= index[d] >= static_cast<itk::IndexValueType>(radius) &&
+                    index[d] < static_cast<itk::IndexValueType>(size[d] - radius);
+    }
+    if (isInterior && error > 1e-2)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The recursive Gaussian differs from the window at " << index << ". Error: " << error << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The recursive filter requires a sigma of at least half the spacing.
+  recursiveTensor->SetGaussianWindowSigma(0.25);
+  ITK_TRY_EXPECT_EXCEPTION(recursiveTensor->Update());
+  return EXIT_SUCCESS;
+}
+
+// Repeated and zero eigenvalues, where the eigenvectors are not unique.
+int
+runFixedSizeSymmetricEigenSolverTest()
+{
+  using EigenSolverType = itk::FixedSizeSymmetricEigenSolver<3>;
+  const std::vector<std::vector<double>> packedMatrices = {
+    { 0, 0, 0, 0, 0, 0 }, { 2, 0, 2, 0, 0, 2 }, { 1, 1, 1, 0, 0, 3 }, { 1, 1e-14, 1, 0, 0, 1 + 1e-15 }
+  };
+  double eigenValues[3];
+  double eigenVectors[9];
+  for (const auto & packedMatrix : packedMatrices)
+  {
+    EigenSolverType::Compute(packedMatrix.data(), eigenValues, eigenVectors);
+    vnl_matrix<double>        expected(3, 3);
+    itk::Matrix<double, 3, 4> outputMatrix;
+    for (unsigned int c = 0; c < 3; ++c)
+    {
+      for (unsigned int r = 0; r <= c; ++r)
+      {
+        expected(r, c) = expected(c, r) = packedMatrix[EigenSolverType::PackedIndex(r, c)];
+      }
+      for (unsigned int r = 0; r < 3; ++r)
+      {
+        outputMatrix(r, c) = eigenVectors[r * 3 + c];
+      }
+      outputMatrix(c, 3) = eigenValues[c];
+      ITK_TEST_EXPECT_TRUE(c == 0 || eigenValues[c - 1] <= eigenValues[c]);
+    }
+    ITK_TEST_EXPECT_TRUE(eigenSystemError(outputMatrix, expected) < 1e-12);
+  }
+  return EXIT_SUCCESS;
+}
+
 int
 itkStructureTensorTest(int, char *[])
 {
+  if (runFixedSizeSymmetricEigenSolverTest() == EXIT_FAILURE ||
+      runStructureTensorSmoothingTest<2, 2>() == EXIT_FAILURE ||
+      runStructureTensorSmoothingTest<3, 3>() == EXIT_FAILURE ||
+      runStructureTensorSmoothingTest<2, 4>() == EXIT_FAILURE ||
+      runStructureTensorRecursiveGaussianTest() == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
   int result2D = runStructureTensorTest<2>();
   int result3D = runStructureTensorTest<3>();
 
@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkForwardFFTImageFilter.h"
+#include "itkMultiplyImageFilter.h"
+
+#include "itkVectorForwardFFTImageFilter.h"
+#include "itkVectorInverseFFTImageFilter.h"
+#include "itkComposeImageFilter.h"
+#include "itkVectorIndexSelectionCastImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+int
+itkVectorForwardFFTImageFilterTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " inputImage " << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string inputImage = argv[1];
+
+  constexpr unsigned int dimension = 3;
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, dimension>;
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetFileName(inputImage);
+  reader->Update();
+
+  // Components with different values: the image and the image scaled.
+  using MultiplyFilterType = itk::MultiplyImageFilter<ImageType, ImageType, ImageType>;
+  auto multiplyFilter = MultiplyFilterType::New();
+  multiplyFilter->SetInput(reader->GetOutput());
+  multiplyFilter->SetConstant(-3.0);
+  multiplyFilter->Update();
+  std::vector<ImageType::Pointer> components = { reader->GetOutput(), multiplyFilter->GetOutput() };
+
+  using ComposeFilterType = itk::ComposeImageFilter<ImageType>;
+  auto composeFilter = ComposeFilterType::New();
+  for (unsigned int c = 0; c < components.size(); ++c)
+  {
+    composeFilter->SetInput(c, components[c]);
+  }
+  composeFilter->Update();
+
+  using VectorForwardFFTType = itk::VectorForwardFFTImageFilter<ComposeFilterType::OutputImageType>;
+  auto vecForwardFFT = VectorForwardFFTType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(vecForwardFFT, VectorForwardFFTImageFilter, ImageToImageFilter);
+  vecForwardFFT->SetInput(composeFilter->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(vecForwardFFT->Update());
+  ITK_TEST_EXPECT_EQUAL(vecForwardFFT->GetOutput()->GetNumberOfComponentsPerPixel(), components.size());
+
+  // Each component has to be equal to the ForwardFFT of the scalar image.
+  using FFTForwardFilterType = itk::ForwardFFTImageFilter<ImageType>;
+  using ComplexImageType = FFTForwardFilterType::OutputImageType;
+  using VectorCastFilterType = itk::VectorIndexSelectionCastImageFilter<VectorForwardFFTType::OutputImageType,
+                                                                        ComplexImageType>;
+  auto vectorCastFilter = VectorCastFilterType::New();
+  vectorCastFilter->SetInput(vecForwardFFT->GetOutput());
+  for (unsigned int c = 0; c < components.size(); ++c)
+  {
+    auto fftForwardFilter = FFTForwardFilterType::New();
+    fftForwardFilter->SetInput(components[c]);
+    fftForwardFilter->Update();
+    vectorCastFilter->SetIndex(c);
+    vectorCastFilter->Update();
+
+    const ComplexImageType *                        expected = fftForwardFilter->GetOutput();
+    itk::ImageRegionConstIterator<ComplexImageType> expectedIt(expected, expected->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ComplexImageType> testIt(vectorCastFilter->GetOutput(),
+                                                           expected->GetLargestPossibleRegion());
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++testIt)
+    {
+      if (expectedIt.Get() != testIt.Get())
+      {
+        std::cerr << "Test failed! " << std::endl;
+        std::cerr << "Component " << c << " differs at " << expectedIt.GetIndex() << ": " << testIt.Get()
+                  << " != " << expectedIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Round trip with VectorInverseFFTImageFilter.
+  using VectorInverseFFTType = itk::VectorInverseFFTImageFilter<VectorForwardFFTType::OutputImageType>;
+  auto vecInverseFFT = VectorInverseFFTType::New();
+  vecInverseFFT->SetInput(vecForwardFFT->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(vecInverseFFT->Update());
+
+  using VectorImageType = ComposeFilterType::OutputImageType;
+  itk::ImageRegionConstIterator<VectorImageType> inputIt(composeFilter->GetOutput(),
+                                                         composeFilter->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<VectorInverseFFTType::OutputImageType> roundTripIt(
+    vecInverseFFT->GetOutput(), composeFilter->GetOutput()->GetLargestPossibleRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++roundTripIt)
+  {
+    for (unsigned int c = 0; c < components.size(); ++c)
+    {
+      const double expected = inputIt.Get()[c];
+      if (std::abs(roundTripIt.Get()[c] - expected) > 1e-4 * std::max(1.0, std::abs(expected)))
+      {
+        std::cerr << "Test failed! " << std::endl;
+        std::cerr << "Round trip of component " << c << " differs at " << inputIt.GetIndex() << ": "
+                  << roundTripIt.Get()[c] << " != " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
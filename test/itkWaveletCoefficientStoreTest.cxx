@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWaveletCoefficientStore.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkSimoncelliIsotropicWavelet.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using PixelType = double;
+using ComplexImageType = itk::Image<std::complex<PixelType>, Dimension>;
+using PointType = itk::Point<PixelType, Dimension>;
+using WaveletFunctionType = itk::HeldIsotropicWavelet<PixelType, Dimension, PointType>;
+using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator<ComplexImageType, WaveletFunctionType>;
+using ForwardWaveletType = itk::WaveletFrequencyForward<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+using InverseWaveletType = itk::WaveletFrequencyInverse<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+using ForwardUndecimatedType =
+  itk::WaveletFrequencyForwardUndecimated<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+using InverseUndecimatedType =
+  itk::WaveletFrequencyInverseUndecimated<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+using StoreType = itk::WaveletCoefficientStore<ComplexImageType>;
+
+constexpr unsigned int levels = 2;
+constexpr unsigned int bands = 2;
+
+/** Check that the store read from a file has the metadata and the coefficients of the written one,
+ * and that the coefficients use the mapped file as buffers. */
+bool
+storesAreEqual(const StoreType * written, const StoreType * read, const std::string & name)
+{
+  bool passed = written->GetLevels() == read->GetLevels() &&
+                written->GetHighPassSubBands() == read->GetHighPassSubBands() &&
+                written->GetScaleFactor() == read->GetScaleFactor() &&
+                written->GetUndecimated() == read->GetUndecimated() &&
+                written->GetHalfHermitian() == read->GetHalfHermitian() &&
+                written->GetActualXDimensionIsOdd() == read->GetActualXDimensionIsOdd() &&
+                written->GetWaveletName() == read->GetWaveletName() &&
+                written->GetWaveletParameters() == read->GetWaveletParameters() &&
+                written->GetInputOrigin() == read->GetInputOrigin() &&
+                written->GetInputSpacing() == read->GetInputSpacing() &&
+                written->GetInputDirection() == read->GetInputDirection() &&
+                written->GetCoefficients().size() == read->GetCoefficients().size();
+  if (!passed)
+  {
+    std::cerr << name << ": the metadata read differs from the written one." << std::endl;
+    return false;
+  }
+  const itk::WaveletCoefficientFileMapping * fileMapping = read->GetFileMapping();
+  for (unsigned int n = 0; n < written->GetCoefficients().size(); ++n)
+  {
+    const ComplexImageType * reference = written->GetCoefficient(n);
+    const ComplexImageType * test = read->GetCoefficient(n);
+    const auto *             buffer = reinterpret_cast<const char *>(test->GetBufferPointer());
+    if (buffer < fileMapping->GetData() || buffer >= fileMapping->GetData() + fileMapping->GetSize())
+    {
+      std::cerr << name << ": coefficient " << n << " does not use the mapped file as buffer." << std::endl;
+      passed = false;
+    }
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(reference, test, 0))
+    {
+      std::cerr << name << ": coefficient " << n << " differs from the written one." << std::endl;
+      passed = false;
+    }
+  }
+  return passed;
+}
+} // namespace
+
+int
+itkWaveletCoefficientStoreTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " outputFilePrefix" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputFilePrefix = argv[1];
+
+  bool testPassed = true;
+
+  auto store = StoreType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(store, WaveletCoefficientStore, Object);
+  ITK_TEST_SET_GET_VALUE(4096, store->GetChunkAlignment());
+  ITK_TEST_EXPECT_TRUE(store->GetFileMapping() == nullptr);
+
+  // No coefficients to write.
+  ITK_TRY_EXPECT_EXCEPTION(store->Write(outputFilePrefix + "Empty.wcf"));
+
+  // Non default metadata, stored with the coefficients.
+  ComplexImageType::SizeType size;
+  size.Fill(32);
+  auto                        input = itk::Testing::CreateSyntheticImage<ComplexImageType>(size);
+  ComplexImageType::PointType origin;
+  origin.Fill(-3.5);
+  ComplexImageType::SpacingType spacing;
+  spacing.Fill(0.25);
+  input->SetOrigin(origin);
+  input->SetSpacing(spacing);
+
+  // Decimated transform.
+  const std::string decimatedFileName = outputFilePrefix + "Decimated.wcf";
+  auto              forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetHighPassSubBands(bands);
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetInput(input);
+  forwardWavelet->Update();
+  store->SetWaveletForward(forwardWavelet.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(store->GetCoefficients().size(), levels * bands + 1);
+  ITK_TEST_EXPECT_TRUE(store->GetInputOrigin() == input->GetOrigin());
+  ITK_TEST_EXPECT_TRUE(store->GetInputSpacing() == input->GetSpacing());
+  ITK_TEST_EXPECT_TRUE(store->GetWaveletName() == std::string("HeldIsotropicWavelet"));
+  ITK_TRY_EXPECT_NO_EXCEPTION(store->Write(decimatedFileName));
+
+  auto readStore = StoreType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(readStore->Read(decimatedFileName));
+  ITK_TEST_EXPECT_TRUE(readStore->GetFileMapping() != nullptr);
+  testPassed &= storesAreEqual(store, readStore, "Decimated");
+
+  // The inverse of the mapped coefficients is the inverse of the outputs of the forward transform.
+  auto inverseWavelet = InverseWaveletType::New();
+  inverseWavelet->SetHighPassSubBands(bands);
+  inverseWavelet->SetLevels(levels);
+  inverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+  inverseWavelet->Update();
+  auto inverseFromStore = InverseWaveletType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(readStore->SetupWaveletInverse(inverseFromStore.GetPointer()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(inverseFromStore->Update());
+  if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(inverseWavelet->GetOutput(),
+                                                            inverseFromStore->GetOutput()))
+  {
+    std::cerr << "Decimated: the inverse of the mapped coefficients differs." << std::endl;
+    testPassed = false;
+  }
+
+  // The layout of the coefficients is passed to the inverse, which throws if it does not match their sizes.
+  readStore->HalfHermitianOn();
+  readStore->ActualXDimensionIsOddOn();
+  auto oddInverse = InverseWaveletType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(readStore->SetupWaveletInverse(oddInverse.GetPointer()));
+  ITK_TEST_EXPECT_TRUE(oddInverse->GetHalfHermitian() && oddInverse->GetActualXDimensionIsOdd());
+  ITK_TRY_EXPECT_EXCEPTION(oddInverse->Update());
+  readStore->HalfHermitianOff();
+  readStore->ActualXDimensionIsOddOff();
+
+  // The store does not match the kind of transform or the wavelet function of the inverse.
+  auto inverseUndecimated = InverseUndecimatedType::New();
+  ITK_TRY_EXPECT_EXCEPTION(readStore->SetupWaveletInverse(inverseUndecimated.GetPointer()));
+  using SimoncelliWaveletFunctionType = itk::SimoncelliIsotropicWavelet<PixelType, Dimension, PointType>;
+  using SimoncelliFilterBankType =
+    itk::WaveletFrequencyFilterBankGenerator<ComplexImageType, SimoncelliWaveletFunctionType>;
+  using SimoncelliInverseType =
+    itk::WaveletFrequencyInverse<ComplexImageType, ComplexImageType, SimoncelliFilterBankType>;
+  auto simoncelliInverse = SimoncelliInverseType::New();
+  ITK_TRY_EXPECT_EXCEPTION(readStore->SetupWaveletInverse(simoncelliInverse.GetPointer()));
+
+  // Undecimated transform.
+  const std::string undecimatedFileName = outputFilePrefix + "Undecimated.wcf";
+  auto              forwardUndecimated = ForwardUndecimatedType::New();
+  forwardUndecimated->SetHighPassSubBands(bands);
+  forwardUndecimated->SetLevels(levels);
+  forwardUndecimated->SetInput(input);
+  forwardUndecimated->Update();
+  auto undecimatedStore = StoreType::New();
+  undecimatedStore->SetWaveletForward(forwardUndecimated.GetPointer());
+  ITK_TEST_EXPECT_TRUE(undecimatedStore->GetUndecimated());
+  ITK_TRY_EXPECT_NO_EXCEPTION(undecimatedStore->Write(undecimatedFileName));
+
+  auto readUndecimatedStore = StoreType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(readUndecimatedStore->Read(undecimatedFileName));
+  testPassed &= storesAreEqual(undecimatedStore, readUndecimatedStore, "Undecimated");
+
+  inverseUndecimated->SetHighPassSubBands(bands);
+  inverseUndecimated->SetLevels(levels);
+  inverseUndecimated->SetInputs(forwardUndecimated->GetOutputs());
+  inverseUndecimated->Update();
+  auto inverseUndecimatedFromStore = InverseUndecimatedType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(readUndecimatedStore->SetupWaveletInverse(inverseUndecimatedFromStore.GetPointer()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(inverseUndecimatedFromStore->Update());
+  if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(inverseUndecimated->GetOutput(),
+                                                            inverseUndecimatedFromStore->GetOutput()))
+  {
+    std::cerr << "Undecimated: the inverse of the mapped coefficients differs." << std::endl;
+    testPassed = false;
+  }
+  auto decimatedInverse = InverseWaveletType::New();
+  ITK_TRY_EXPECT_EXCEPTION(readUndecimatedStore->SetupWaveletInverse(decimatedInverse.GetPointer()));
+
+  // Files that are not coefficients, or are truncated.
+  const std::string invalidFileName = outputFilePrefix + "Invalid.wcf";
+  {
+    std::ofstream invalidFile(invalidFileName, std::ios::binary);
+    invalidFile << "These are not wavelet coefficients.";
+  }
+  ITK_TRY_EXPECT_EXCEPTION(readStore->Read(invalidFileName));
+  const std::string truncatedFileName = outputFilePrefix + "Truncated.wcf";
+  {
+    std::ifstream     validFile(decimatedFileName, std::ios::binary);
+    std::vector<char> header(256);
+    validFile.read(header.data(), static_cast<std::streamsize>(header.size()));
+    std::ofstream truncatedFile(truncatedFileName, std::ios::binary);
+    truncatedFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+  }
+  ITK_TRY_EXPECT_EXCEPTION(readStore->Read(truncatedFileName));
+  ITK_TRY_EXPECT_EXCEPTION(readStore->Read(outputFilePrefix + "Missing.wcf"));
+  // A failed Read keeps the previous coefficients.
+  testPassed &= storesAreEqual(store, readStore, "Decimated after failed reads");
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWaveletCoeffsSpatialDomainTiledImageFilter.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkCastImageFilter.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using InputImageType = itk::Image<float, Dimension>;
+using OutputImageType = itk::Image<double, Dimension>;
+using WaveletFunctionType = itk::HeldIsotropicWavelet<double, Dimension>;
+using TiledFilterType =
+  itk::WaveletCoeffsSpatialDomainTiledImageFilter<InputImageType, OutputImageType, WaveletFunctionType>;
+using OutputsType = std::vector<OutputImageType::Pointer>;
+
+constexpr unsigned int levels = 2;
+constexpr unsigned int bands = 2;
+constexpr unsigned int totalOutputs = levels * bands + 1;
+
+/** Transform of the whole image: ForwardFFT, WaveletFrequencyForwardUndecimated and InverseFFT of every output. */
+OutputsType
+runWholeImage(InputImageType * input)
+{
+  using CastType = itk::CastImageFilter<InputImageType, TiledFilterType::RealImageType>;
+  auto cast = CastType::New();
+  cast->SetInput(input);
+  auto forwardFFT = TiledFilterType::FFTForwardType::New();
+  forwardFFT->SetInput(cast->GetOutput());
+  auto forwardWavelet = TiledFilterType::ForwardWaveletType::New();
+  forwardWavelet->SetHighPassSubBands(bands);
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetInput(forwardFFT->GetOutput());
+
+  OutputsType outputs;
+  for (unsigned int nOutput = 0; nOutput < totalOutputs; ++nOutput)
+  {
+    auto inverseFFT = TiledFilterType::InverseFFTType::New();
+    inverseFFT->SetInput(forwardWavelet->GetOutput(nOutput));
+    inverseFFT->Update();
+    outputs.push_back(inverseFFT->GetOutput());
+    outputs.back()->DisconnectPipeline();
+  }
+  return outputs;
+}
+
+TiledFilterType::Pointer
+createTiledFilter(InputImageType * input, const unsigned int & tileSize, const unsigned int & apron)
+{
+  auto tiledFilter = TiledFilterType::New();
+  tiledFilter->SetHighPassSubBands(bands);
+  tiledFilter->SetLevels(levels);
+  TiledFilterType::SizeType size;
+  size.Fill(tileSize);
+  tiledFilter->SetTileSize(size);
+  size.Fill(apron);
+  tiledFilter->SetApron(size);
+  tiledFilter->SetInput(input);
+  return tiledFilter;
+}
+
+OutputsType
+runTiled(TiledFilterType * tiledFilter)
+{
+  tiledFilter->Update();
+  OutputsType outputs;
+  for (unsigned int nOutput = 0; nOutput < totalOutputs; ++nOutput)
+  {
+    outputs.push_back(tiledFilter->GetOutput(nOutput));
+    outputs.back()->DisconnectPipeline();
+  }
+  return outputs;
+}
+
+double
+maxDifference(const OutputsType & reference, const OutputsType & test, const OutputImageType::RegionType & region)
+{
+  double maxDiff = 0.0;
+  for (unsigned int nOutput = 0; nOutput < reference.size(); ++nOutput)
+  {
+    itk::ImageRegionConstIterator<OutputImageType> refIt(reference[nOutput], region);
+    itk::ImageRegionConstIterator<OutputImageType> testIt(test[nOutput], region);
+    for (; !refIt.IsAtEnd(); ++refIt, ++testIt)
+    {
+      maxDiff = std::max(maxDiff, std::abs(refIt.Get() - testIt.Get()));
+    }
+  }
+  return maxDiff;
+}
+} // namespace
+
+int
+itkWaveletCoeffsSpatialDomainTiledImageFilterTest(int, char *[])
+{
+  bool testPassed = true;
+
+  auto tiledFilter = TiledFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(tiledFilter, WaveletCoeffsSpatialDomainTiledImageFilter, ImageToImageFilter);
+  TiledFilterType::SizeType size;
+  size.Fill(256);
+  ITK_TEST_EXPECT_EQUAL(tiledFilter->GetTileSize(), size);
+  size.Fill(32);
+  ITK_TEST_EXPECT_EQUAL(tiledFilter->GetApron(), size);
+  ITK_TEST_EXPECT_EQUAL(tiledFilter->GetTotalOutputs(), 2);
+
+  const unsigned int sideSize = 96;
+  size.Fill(sideSize);
+  auto       input = itk::Testing::CreateSyntheticImage<InputImageType>(size, 0.2);
+  const auto reference = runWholeImage(input);
+  size.Fill(32);
+
+  tiledFilter = createTiledFilter(input, 32, 16);
+  ITK_TEST_EXPECT_EQUAL(tiledFilter->GetTotalOutputs(), totalOutputs);
+  ITK_TEST_EXPECT_EQUAL(tiledFilter->GetPaddedTileSize()[0], 64);
+
+  // A single tile without apron, with periodic boundary condition, is the transform of the whole image.
+  auto singleTileFilter = createTiledFilter(input, sideSize, 0);
+  itk::PeriodicBoundaryCondition<InputImageType, TiledFilterType::RealImageType> periodicBoundaryCondition;
+  singleTileFilter->SetBoundaryCondition(&periodicBoundaryCondition);
+  ITK_TEST_SET_GET_VALUE(&periodicBoundaryCondition, singleTileFilter->GetBoundaryCondition());
+  testPassed &= itk::Testing::AllImagesAreAlmostEqual<OutputImageType>(reference, runTiled(singleTileFilter), 1e-8);
+
+  // The output does not depend on the number of stream divisions.
+  const auto tiled = runTiled(tiledFilter);
+  for (unsigned int nOutput = 0; nOutput < totalOutputs; ++nOutput)
+  {
+    auto streamedFilter = createTiledFilter(input, 32, 16);
+    using StreamingFilterType = itk::StreamingImageFilter<OutputImageType, OutputImageType>;
+    auto streamer = StreamingFilterType::New();
+    streamer->SetInput(streamedFilter->GetOutput(nOutput));
+    streamer->SetNumberOfStreamDivisions(5);
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+    if (!itk::Testing::ImagesAreAlmostEqual<OutputImageType>(tiled[nOutput], streamer->GetOutput(), 1e-12))
+    {
+      std::cerr << "Streamed output " << nOutput << " differs from the output without streaming." << std::endl;
+      testPassed = false;
+    }
+  }
+
+  // The apron reduces the error at the borders of the tiles, compared with the whole image.
+  // The central tile is not affected by the boundary condition.
+  OutputImageType::RegionType centralTile;
+  centralTile.SetIndex(0, 32);
+  centralTile.SetIndex(1, 32);
+  centralTile.SetSize(size);
+  const double errorWithApron = maxDifference(reference, tiled, centralTile);
+  const double errorWithoutApron = maxDifference(reference, runTiled(createTiledFilter(input, 32, 0)), centralTile);
+  std::cout << "Max error in the central tile. Apron 16: " << errorWithApron << ", without apron: " << errorWithoutApron
+            << std::endl;
+  if (!(errorWithApron < 0.5 * errorWithoutApron))
+  {
+    std::cerr << "The apron does not reduce the error at the borders of the tiles." << std::endl;
+    testPassed = false;
+  }
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,270 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWaveletFilterBankPyramidCache.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkWaveletFrequencyForwardUndecimated.h"
+#include "itkWaveletFrequencyInverseUndecimated.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using PixelType = double;
+using ComplexImageType = itk::Image<std::complex<PixelType>, Dimension>;
+using PointType = itk::Point<PixelType, Dimension>;
+using WaveletFunctionType = itk::HeldIsotropicWavelet<PixelType, Dimension, PointType>;
+using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator<ComplexImageType, WaveletFunctionType>;
+using CacheType = itk::WaveletFilterBankPyramidCache<WaveletFilterBankType>;
+using ForwardWaveletType = itk::WaveletFrequencyForward<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+using InverseWaveletType = itk::WaveletFrequencyInverse<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+using ForwardUndecimatedType =
+  itk::WaveletFrequencyForwardUndecimated<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+using InverseUndecimatedType =
+  itk::WaveletFrequencyInverseUndecimated<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+
+constexpr unsigned int levels = 2;
+constexpr unsigned int bands = 2;
+
+ForwardWaveletType::OutputsType
+runForward(ComplexImageType * input, CacheType * cache, const bool & useFusedKernel = false)
+{
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetHighPassSubBands(bands);
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetUseFusedKernel(useFusedKernel);
+  forwardWavelet->SetWaveletFilterBankPyramidCache(cache);
+  forwardWavelet->SetInput(input);
+  forwardWavelet->Update();
+  return forwardWavelet->GetOutputs();
+}
+
+ComplexImageType::Pointer
+runInverse(const ForwardWaveletType::OutputsType & coefficients, CacheType * cache)
+{
+  auto inverseWavelet = InverseWaveletType::New();
+  inverseWavelet->SetHighPassSubBands(bands);
+  inverseWavelet->SetLevels(levels);
+  inverseWavelet->SetWaveletFilterBankPyramidCache(cache);
+  inverseWavelet->SetInputs(coefficients);
+  inverseWavelet->Update();
+  return inverseWavelet->GetOutput();
+}
+
+ForwardUndecimatedType::OutputsType
+runForwardUndecimated(ComplexImageType * input, CacheType * cache)
+{
+  auto forwardWavelet = ForwardUndecimatedType::New();
+  forwardWavelet->SetHighPassSubBands(bands);
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetWaveletFilterBankPyramidCache(cache);
+  forwardWavelet->SetInput(input);
+  forwardWavelet->Update();
+  return forwardWavelet->GetOutputs();
+}
+
+ComplexImageType::Pointer
+runInverseUndecimated(const ForwardUndecimatedType::OutputsType & coefficients, CacheType * cache)
+{
+  auto inverseWavelet = InverseUndecimatedType::New();
+  inverseWavelet->SetHighPassSubBands(bands);
+  inverseWavelet->SetLevels(levels);
+  inverseWavelet->SetWaveletFilterBankPyramidCache(cache);
+  inverseWavelet->SetInputs(coefficients);
+  inverseWavelet->Update();
+  return inverseWavelet->GetOutput();
+}
+} // namespace
+
+int
+itkWaveletFilterBankPyramidCacheTest(int, char *[])
+{
+  bool testPassed = true;
+
+  auto cache = CacheType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(cache, WaveletFilterBankPyramidCache, Object);
+  ITK_TEST_EXPECT_TRUE(CacheType::GetInstance() != nullptr);
+  ITK_TEST_EXPECT_TRUE(CacheType::GetInstance() == CacheType::GetInstance());
+
+  // The transforms use the process-wide cache by default.
+  auto forwardWavelet = ForwardWaveletType::New();
+  ITK_TEST_EXPECT_TRUE(forwardWavelet->GetWaveletFilterBankPyramidCache() == CacheType::GetInstance());
+
+  ComplexImageType::SizeType inputSize;
+  inputSize.Fill(32);
+  auto input = itk::Testing::CreateSyntheticImage<ComplexImageType>(inputSize);
+
+  // Decimated forward and inverse.
+  const auto referenceCoefficients = runForward(input, nullptr);
+  const auto referenceReconstruction = runInverse(referenceCoefficients, nullptr);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 0);
+
+  testPassed &=
+    itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(referenceCoefficients, runForward(input, cache));
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfMisses(), 1);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 1);
+  testPassed &=
+    itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(referenceCoefficients, runForward(input, cache));
+  testPassed &=
+    itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(referenceCoefficients, runForward(input, cache, true));
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfHits(), 2);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 1);
+
+  for (unsigned int run = 0; run < 2; ++run)
+  {
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(referenceReconstruction,
+                                                              runInverse(referenceCoefficients, cache)))
+    {
+      std::cerr << "Inverse with cache differs from the inverse without cache. Run: " << run << std::endl;
+      testPassed = false;
+    }
+  }
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfHits(), 3);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 2);
+
+  // Undecimated forward and inverse.
+  const auto referenceUndecimated = runForwardUndecimated(input, nullptr);
+  const auto referenceUndecimatedReconstruction = runInverseUndecimated(referenceUndecimated, nullptr);
+  for (unsigned int run = 0; run < 2; ++run)
+  {
+    testPassed &= itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(
+      referenceUndecimated, runForwardUndecimated(input, cache));
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(referenceUndecimatedReconstruction,
+                                                              runInverseUndecimated(referenceUndecimated, cache)))
+    {
+      std::cerr << "Undecimated inverse with cache differs from the inverse without cache. Run: " << run << std::endl;
+      testPassed = false;
+    }
+  }
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfHits(), 5);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 4);
+
+  // A different wavelet parameter is a different pyramid.
+  auto filterBank = WaveletFilterBankType::New();
+  filterBank->SetHighPassSubBands(bands);
+  std::vector<ComplexImageType::SizeType> sizes(1, input->GetLargestPossibleRegion().GetSize());
+  const auto                              key = CacheType::ComputeKey(filterBank, sizes, levels, 2, false);
+  CacheType::PyramidType                  pyramid;
+  ITK_TEST_EXPECT_TRUE(cache->Find(key, pyramid));
+  ITK_TEST_EXPECT_EQUAL(pyramid.size(), levels * (bands + 1));
+  filterBank->GetModifiableWaveletFunction()->SetPolynomialOrder(3);
+  ITK_TEST_EXPECT_TRUE(!cache->Find(CacheType::ComputeKey(filterBank, sizes, levels, 2, false), pyramid));
+
+  // Concurrent transforms of equally sized images share the cache.
+  cache->Clear();
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfBytes(), 0);
+  const unsigned int                           numberOfThreads = 4;
+  std::vector<ForwardWaveletType::OutputsType> threadCoefficients(numberOfThreads);
+  std::vector<std::thread>                     threads;
+  for (unsigned int thread = 0; thread < numberOfThreads; ++thread)
+  {
+    threads.emplace_back([&threadCoefficients, &cache, &inputSize, thread]() {
+      auto threadInput = itk::Testing::CreateSyntheticImage<ComplexImageType>(inputSize);
+      threadCoefficients[thread] = runForward(threadInput, cache);
+    });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  for (unsigned int thread = 0; thread < numberOfThreads; ++thread)
+  {
+    testPassed &=
+      itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(referenceCoefficients, threadCoefficients[thread]);
+  }
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 1);
+
+  // Least recently used eviction.
+  ComplexImageType::SizeType smallSize;
+  smallSize.Fill(16);
+  runForward(itk::Testing::CreateSyntheticImage<ComplexImageType>(smallSize), cache);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 2);
+  ITK_TEST_EXPECT_EQUAL(cache->GetMaximumNumberOfEntries(), 16);
+  cache->SetMaximumNumberOfEntries(1);
+  ITK_TEST_SET_GET_VALUE(1, cache->GetMaximumNumberOfEntries());
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 1);
+  // The pyramid of the last transform, size 16, is kept.
+  sizes[0].Fill(16);
+  filterBank->GetModifiableWaveletFunction()->SetPolynomialOrder(5);
+  ITK_TEST_EXPECT_TRUE(cache->Find(CacheType::ComputeKey(filterBank, sizes, levels, 2, false), pyramid));
+
+  // Pyramids bigger than MaximumNumberOfBytes are not cached.
+  cache->SetMaximumNumberOfBytes(1024);
+  ITK_TEST_SET_GET_VALUE(1024, cache->GetMaximumNumberOfBytes());
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 0);
+  ITK_TEST_EXPECT_TRUE(cache->CanInsert(1024));
+  ITK_TEST_EXPECT_TRUE(!cache->CanInsert(1025));
+  testPassed &=
+    itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(referenceCoefficients, runForward(input, cache));
+  if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(referenceReconstruction,
+                                                            runInverse(referenceCoefficients, cache)))
+  {
+    std::cerr << "Inverse with a cache too small differs from the inverse without cache." << std::endl;
+    testPassed = false;
+  }
+  testPassed &=
+    itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(referenceUndecimated, runForwardUndecimated(input, cache));
+  if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(referenceUndecimatedReconstruction,
+                                                            runInverseUndecimated(referenceUndecimated, cache)))
+  {
+    std::cerr << "Undecimated inverse with a cache too small differs from the inverse without cache." << std::endl;
+    testPassed = false;
+  }
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfEntries(), 0);
+
+  // A pyramid that cannot be cached is not kept: the filter bank of each level is released after use,
+  // the forward transform holds the same memory than without cache.
+  for (const bool useFusedKernel : { false, true })
+  {
+    auto forwardWithoutCache = ForwardWaveletType::New();
+    forwardWithoutCache->SetHighPassSubBands(bands);
+    forwardWithoutCache->SetLevels(levels);
+    forwardWithoutCache->SetUseFusedKernel(useFusedKernel);
+    forwardWithoutCache->SetWaveletFilterBankPyramidCache(nullptr);
+    forwardWithoutCache->SetInput(input);
+    forwardWithoutCache->Update();
+    auto forwardNotCached = ForwardWaveletType::New();
+    forwardNotCached->SetHighPassSubBands(bands);
+    forwardNotCached->SetLevels(levels);
+    forwardNotCached->SetUseFusedKernel(useFusedKernel);
+    forwardNotCached->SetWaveletFilterBankPyramidCache(cache);
+    forwardNotCached->SetInput(input);
+    forwardNotCached->Update();
+    ITK_TEST_EXPECT_EQUAL(forwardNotCached->GetMeasuredPeakBytes(), forwardWithoutCache->GetMeasuredPeakBytes());
+    ITK_TEST_EXPECT_EQUAL(forwardNotCached->GetPredictedPeakBytes(), forwardWithoutCache->GetPredictedPeakBytes());
+    ITK_TEST_EXPECT_EQUAL(forwardNotCached->GetWaveletFilterBankPyramid().size(), 0);
+  }
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
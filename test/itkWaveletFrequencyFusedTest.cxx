@@ -0,0 +1,312 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkRegionOfInterestImageFilter.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkForwardFFTImageFilter.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <string>
+
+/** Compare the outputs of the fused engines, with and without virtual filter bank, against the default pipeline. */
+template <typename TImage>
+int
+compareWaveletFrequencyFused(const TImage *       inputImage,
+                             const unsigned int & inputLevels,
+                             const unsigned int & inputBands,
+                             const bool &         compareInverse)
+{
+  bool testPassed = true;
+
+  using ImageType = TImage;
+  using FFTFilterType = itk::ForwardFFTImageFilter<ImageType>;
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetInput(inputImage);
+  fftFilter->Update();
+
+  using ComplexImageType = typename FFTFilterType::OutputImageType;
+  using WaveletFunctionType = itk::HeldIsotropicWavelet<>;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator<ComplexImageType, WaveletFunctionType>;
+  using ForwardWaveletType = itk::WaveletFrequencyForward<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetHighPassSubBands(inputBands);
+  forwardWavelet->SetLevels(inputLevels);
+  forwardWavelet->SetInput(fftFilter->GetOutput());
+  forwardWavelet->Update();
+
+  auto fusedForwardWavelet = ForwardWaveletType::New();
+  fusedForwardWavelet->SetHighPassSubBands(inputBands);
+  fusedForwardWavelet->SetLevels(inputLevels);
+  fusedForwardWavelet->SetInput(fftFilter->GetOutput());
+  ITK_TEST_SET_GET_BOOLEAN(fusedForwardWavelet, UseFusedKernel, true);
+  fusedForwardWavelet->Update();
+
+  for (unsigned int nOutput = 0; nOutput < forwardWavelet->GetTotalOutputs(); ++nOutput)
+  {
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(forwardWavelet->GetOutput(nOutput),
+                                                              fusedForwardWavelet->GetOutput(nOutput)))
+    {
+      std::cerr << "Fused forward output " << nOutput << " differs from the default pipeline." << std::endl;
+      testPassed = false;
+    }
+  }
+
+  auto virtualForwardWavelet = ForwardWaveletType::New();
+  virtualForwardWavelet->SetHighPassSubBands(inputBands);
+  virtualForwardWavelet->SetLevels(inputLevels);
+  virtualForwardWavelet->SetInput(fftFilter->GetOutput());
+  ITK_TEST_SET_GET_BOOLEAN(virtualForwardWavelet, UseVirtualFilterBank, true);
+  virtualForwardWavelet->Update();
+
+  for (unsigned int nOutput = 0; nOutput < forwardWavelet->GetTotalOutputs(); ++nOutput)
+  {
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(forwardWavelet->GetOutput(nOutput),
+                                                              virtualForwardWavelet->GetOutput(nOutput)))
+    {
+      std::cerr << "Virtual filter bank forward output " << nOutput << " differs from the default pipeline."
+                << std::endl;
+      testPassed = false;
+    }
+  }
+
+  // Only the requested outputs are generated: a band of the last level, and then the low pass.
+  for (const bool useFusedKernel : { false, true })
+  {
+    auto lazyForwardWavelet = ForwardWaveletType::New();
+    lazyForwardWavelet->SetHighPassSubBands(inputBands);
+    lazyForwardWavelet->SetLevels(inputLevels);
+    lazyForwardWavelet->SetInput(fftFilter->GetOutput());
+    lazyForwardWavelet->SetUseFusedKernel(useFusedKernel);
+    ITK_TEST_SET_GET_BOOLEAN(lazyForwardWavelet, GenerateOnlyRequestedOutputs, true);
+
+    const unsigned int bandOutput = (inputLevels - 1) * inputBands;
+    const unsigned int lowPassOutput = lazyForwardWavelet->GetTotalOutputs() - 1;
+    ITK_TRY_EXPECT_NO_EXCEPTION(lazyForwardWavelet->GetOutput(bandOutput)->Update());
+    for (unsigned int nOutput = 0; nOutput < lazyForwardWavelet->GetTotalOutputs(); ++nOutput)
+    {
+      const itk::SizeValueType bufferedPixels =
+        lazyForwardWavelet->GetOutput(nOutput)->GetBufferedRegion().GetNumberOfPixels();
+      if ((nOutput == bandOutput) != (bufferedPixels > 0))
+      {
+        std::cerr << "Output " << nOutput << " has " << bufferedPixels << " buffered pixels after requesting output "
+                  << bandOutput << ", fused kernel: " << useFusedKernel << std::endl;
+        testPassed = false;
+      }
+    }
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(lazyForwardWavelet->GetOutput(lowPassOutput)->Update());
+    for (const unsigned int nOutput : { bandOutput, lowPassOutput })
+    {
+      if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(forwardWavelet->GetOutput(nOutput),
+                                                                lazyForwardWavelet->GetOutput(nOutput)))
+      {
+        std::cerr << "Requested output " << nOutput << " differs from the default pipeline, fused kernel: "
+                  << useFusedKernel << std::endl;
+        testPassed = false;
+      }
+    }
+  }
+
+  // Memory budget: the predicted peak decreases with the leaner strategies, and the planner chooses the first one
+  // that fits in the budget. The measured peak of the buffers held by the filter does not exceed the prediction.
+  using ExecutionStrategy = typename ForwardWaveletType::ExecutionStrategy;
+  auto budgetForwardWavelet = ForwardWaveletType::New();
+  budgetForwardWavelet->SetHighPassSubBands(inputBands);
+  budgetForwardWavelet->SetLevels(inputLevels);
+  budgetForwardWavelet->SetInput(fftFilter->GetOutput());
+  budgetForwardWavelet->UpdateOutputInformation();
+  const itk::SizeValueType pipelineBytes =
+    budgetForwardWavelet->ComputePredictedPeakBytes(ExecutionStrategy::FilterBankPipeline);
+  const itk::SizeValueType fusedBytes = budgetForwardWavelet->ComputePredictedPeakBytes(ExecutionStrategy::FusedKernel);
+  const itk::SizeValueType withoutCacheBytes =
+    budgetForwardWavelet->ComputePredictedPeakBytes(ExecutionStrategy::FusedKernelWithoutCache);
+  const itk::SizeValueType virtualBytes =
+    budgetForwardWavelet->ComputePredictedPeakBytes(ExecutionStrategy::VirtualFilterBank);
+  ITK_TEST_EXPECT_TRUE(pipelineBytes > fusedBytes);
+  ITK_TEST_EXPECT_TRUE(fusedBytes >= withoutCacheBytes);
+  ITK_TEST_EXPECT_TRUE(withoutCacheBytes > virtualBytes);
+
+  budgetForwardWavelet->SetMemoryBudget(virtualBytes - 1);
+  ITK_TRY_EXPECT_EXCEPTION(budgetForwardWavelet->Update());
+
+  for (const itk::SizeValueType budget : { pipelineBytes, withoutCacheBytes, virtualBytes })
+  {
+    budgetForwardWavelet->SetMemoryBudget(budget);
+    ITK_TRY_EXPECT_NO_EXCEPTION(budgetForwardWavelet->Update());
+    ITK_TEST_EXPECT_TRUE(budgetForwardWavelet->GetPredictedPeakBytes() <= budget);
+    ITK_TEST_EXPECT_TRUE(budgetForwardWavelet->GetMeasuredPeakBytes() <= budgetForwardWavelet->GetPredictedPeakBytes());
+    if (budget == virtualBytes)
+    {
+      ITK_TEST_EXPECT_TRUE(budgetForwardWavelet->GetExecutionStrategy() == ExecutionStrategy::VirtualFilterBank);
+    }
+    for (unsigned int nOutput = 0; nOutput < forwardWavelet->GetTotalOutputs(); ++nOutput)
+    {
+      if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(forwardWavelet->GetOutput(nOutput),
+                                                                budgetForwardWavelet->GetOutput(nOutput)))
+      {
+        std::cerr << "Forward output " << nOutput << " with a MemoryBudget of " << budget
+                  << " bytes differs from the default pipeline." << std::endl;
+        testPassed = false;
+      }
+    }
+  }
+
+  // The inverse requires sizes divisible by the scale factor at each level.
+  if (compareInverse)
+  {
+    using InverseWaveletType = itk::WaveletFrequencyInverse<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+    auto inverseWavelet = InverseWaveletType::New();
+    inverseWavelet->SetHighPassSubBands(inputBands);
+    inverseWavelet->SetLevels(inputLevels);
+    inverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+    inverseWavelet->Update();
+
+    auto fusedInverseWavelet = InverseWaveletType::New();
+    fusedInverseWavelet->SetHighPassSubBands(inputBands);
+    fusedInverseWavelet->SetLevels(inputLevels);
+    fusedInverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+    ITK_TEST_SET_GET_BOOLEAN(fusedInverseWavelet, UseFusedKernel, true);
+    fusedInverseWavelet->Update();
+
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(inverseWavelet->GetOutput(),
+                                                              fusedInverseWavelet->GetOutput()))
+    {
+      std::cerr << "Fused inverse output differs from the default pipeline." << std::endl;
+      testPassed = false;
+    }
+
+    auto virtualInverseWavelet = InverseWaveletType::New();
+    virtualInverseWavelet->SetHighPassSubBands(inputBands);
+    virtualInverseWavelet->SetLevels(inputLevels);
+    virtualInverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+    ITK_TEST_SET_GET_BOOLEAN(virtualInverseWavelet, UseVirtualFilterBank, true);
+    virtualInverseWavelet->Update();
+
+    if (!itk::Testing::ImagesAreAlmostEqual<ComplexImageType>(inverseWavelet->GetOutput(),
+                                                              virtualInverseWavelet->GetOutput()))
+    {
+      std::cerr << "Virtual filter bank inverse output differs from the default pipeline." << std::endl;
+      testPassed = false;
+    }
+  }
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    return EXIT_FAILURE;
+  }
+}
+
+template <unsigned int VDimension>
+int
+runWaveletFrequencyFusedTest(const std::string &  inputImage,
+                             const unsigned int & inputLevels,
+                             const unsigned int & inputBands)
+{
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, VDimension>;
+  using ReaderType = itk::ImageFileReader<ImageType>;
+
+  auto reader = ReaderType::New();
+  reader->SetFileName(inputImage);
+  reader->Update();
+
+  int result = compareWaveletFrequencyFused<ImageType>(reader->GetOutput(), inputLevels, inputBands, true);
+
+  // Odd sizes: the central frequency bin is not aliased when shrinking.
+  // Use the largest odd size that can be factorized with 3 and 5, supported by all FFT backends.
+  using ROIFilterType = itk::RegionOfInterestImageFilter<ImageType, ImageType>;
+  auto                           roiFilter = ROIFilterType::New();
+  typename ImageType::RegionType oddRegion = reader->GetOutput()->GetLargestPossibleRegion();
+  typename ImageType::SizeType   oddSize = oddRegion.GetSize();
+  for (unsigned int i = 0; i < VDimension; ++i)
+  {
+    oddSize[i] = 1;
+    for (itk::SizeValueType candidate = 1; candidate <= oddRegion.GetSize(i); candidate += 2)
+    {
+      itk::SizeValueType remainder = candidate;
+      while (remainder % 3 == 0)
+      {
+        remainder /= 3;
+      }
+      while (remainder % 5 == 0)
+      {
+        remainder /= 5;
+      }
+      if (remainder == 1)
+      {
+        oddSize[i] = candidate;
+      }
+    }
+  }
+  oddRegion.SetSize(oddSize);
+  roiFilter->SetRegionOfInterest(oddRegion);
+  roiFilter->SetInput(reader->GetOutput());
+  roiFilter->Update();
+
+  if (compareWaveletFrequencyFused<ImageType>(roiFilter->GetOutput(), inputLevels, inputBands, false) !=
+      EXIT_SUCCESS)
+  {
+    std::cerr << "Test failed for odd size: " << oddSize << std::endl;
+    result = EXIT_FAILURE;
+  }
+  return result;
+}
+
+int
+itkWaveletFrequencyFusedTest(int argc, char * argv[])
+{
+  if (argc < 4 || argc > 5)
+  {
+    std::cerr << "Usage: " << argv[0] << " inputImage inputLevels inputBands [dimension]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string  inputImage = argv[1];
+  const unsigned int inputLevels = std::stoi(argv[2]);
+  const unsigned int inputBands = std::stoi(argv[3]);
+
+  unsigned int dimension = 3;
+  if (argc == 5)
+  {
+    dimension = std::stoi(argv[4]);
+  }
+
+  if (dimension == 2)
+  {
+    return runWaveletFrequencyFusedTest<2>(inputImage, inputLevels, inputBands);
+  }
+  else if (dimension == 3)
+  {
+    return runWaveletFrequencyFusedTest<3>(inputImage, inputLevels, inputBands);
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Error: only 2 or 3 dimensions allowed, " << dimension << " selected." << std::endl;
+    return EXIT_FAILURE;
+  }
+}
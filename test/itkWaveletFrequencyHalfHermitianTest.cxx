@@ -0,0 +1,329 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkFrequencyShrinkImageFilter.h"
+#include "itkFrequencyExpandImageFilter.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkForwardFFTImageFilter.h"
+#include "itkRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkRegionOfInterestImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <string>
+
+/** Check that the image in the half-Hermitian layout is the first half of the image in the full layout. */
+template <typename TComplexImage>
+bool
+halfIsCropOfFull(const TComplexImage * fullImage, const TComplexImage * halfImage, const std::string & name)
+{
+  typename TComplexImage::SizeType expectedHalfSize = fullImage->GetLargestPossibleRegion().GetSize();
+  expectedHalfSize[0] = expectedHalfSize[0] / 2 + 1;
+  if (halfImage->GetLargestPossibleRegion().GetSize() != expectedHalfSize)
+  {
+    std::cerr << name << ": half size " << halfImage->GetLargestPossibleRegion().GetSize()
+              << " differs from the expected " << expectedHalfSize << std::endl;
+    return false;
+  }
+
+  double maximumModulo = 0;
+  double maximumDifference = 0;
+  itk::ImageRegionConstIteratorWithIndex<TComplexImage> halfIt(halfImage, halfImage->GetLargestPossibleRegion());
+  for (; !halfIt.IsAtEnd(); ++halfIt)
+  {
+    const auto fullValue = fullImage->GetPixel(fullImage->GetLargestPossibleRegion().GetIndex() +
+                                               (halfIt.GetIndex() - halfImage->GetLargestPossibleRegion().GetIndex()));
+    maximumModulo = std::max(maximumModulo, static_cast<double>(std::abs(fullValue)));
+    maximumDifference = std::max(maximumDifference, static_cast<double>(std::abs(fullValue - halfIt.Get())));
+  }
+  if (maximumDifference > 1e-4 * maximumModulo + 1e-6)
+  {
+    std::cerr << name << ": half layout differs from the full layout. Maximum difference: " << maximumDifference
+              << " Maximum modulo: " << maximumModulo << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/** An odd first dimension of the full spectrum is not divisible by the scale factor,
+ * the inverse has to throw instead of reconstructing an image of a different size. */
+template <typename TImage, typename TWaveletFilterBank>
+bool
+inverseThrowsWithOddWidth(const TImage * image, const unsigned int & inputLevels, const unsigned int & inputBands)
+{
+  using HalfFFTFilterType = itk::RealToHalfHermitianForwardFFTImageFilter<TImage>;
+  using ComplexImageType = typename HalfFFTFilterType::OutputImageType;
+  auto halfFFTFilter = HalfFFTFilterType::New();
+  halfFFTFilter->SetInput(image);
+  halfFFTFilter->Update();
+  if (!halfFFTFilter->GetActualXDimensionIsOdd())
+  {
+    std::cerr << "The first dimension of the image " << image->GetLargestPossibleRegion().GetSize()
+              << " is expected to be odd." << std::endl;
+    return false;
+  }
+
+  using ForwardWaveletType = itk::WaveletFrequencyForward<ComplexImageType, ComplexImageType, TWaveletFilterBank>;
+  auto halfForwardWavelet = ForwardWaveletType::New();
+  halfForwardWavelet->SetHighPassSubBands(inputBands);
+  halfForwardWavelet->SetLevels(inputLevels);
+  halfForwardWavelet->SetInput(halfFFTFilter->GetOutput());
+  halfForwardWavelet->HalfHermitianOn();
+  halfForwardWavelet->ActualXDimensionIsOddOn();
+  halfForwardWavelet->Update();
+
+  using InverseWaveletType = itk::WaveletFrequencyInverse<ComplexImageType, ComplexImageType, TWaveletFilterBank>;
+  auto halfInverseWavelet = InverseWaveletType::New();
+  halfInverseWavelet->SetHighPassSubBands(inputBands);
+  halfInverseWavelet->SetLevels(inputLevels);
+  halfInverseWavelet->SetInputs(halfForwardWavelet->GetOutputs());
+  halfInverseWavelet->HalfHermitianOn();
+  halfInverseWavelet->ActualXDimensionIsOddOn();
+  try
+  {
+    halfInverseWavelet->Update();
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cout << "Expected exception with an odd first dimension: " << error.GetDescription() << std::endl;
+    return true;
+  }
+  std::cerr << "The inverse with an odd first dimension did not throw." << std::endl;
+  return false;
+}
+
+template <unsigned int VDimension>
+int
+runWaveletFrequencyHalfHermitianTest(const std::string &  inputImage,
+                                     const unsigned int & inputLevels,
+                                     const unsigned int & inputBands)
+{
+  bool testPassed = true;
+
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, VDimension>;
+  using ReaderType = itk::ImageFileReader<ImageType>;
+
+  auto reader = ReaderType::New();
+  reader->SetFileName(inputImage);
+  reader->Update();
+
+  using FFTFilterType = itk::ForwardFFTImageFilter<ImageType>;
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetInput(reader->GetOutput());
+  fftFilter->Update();
+
+  using HalfFFTFilterType = itk::RealToHalfHermitianForwardFFTImageFilter<ImageType>;
+  auto halfFFTFilter = HalfFFTFilterType::New();
+  halfFFTFilter->SetInput(reader->GetOutput());
+  halfFFTFilter->Update();
+
+  using ComplexImageType = typename FFTFilterType::OutputImageType;
+  const bool actualXDimensionIsOdd = halfFFTFilter->GetActualXDimensionIsOdd();
+
+  // Shrink and expand.
+  using ShrinkFilterType = itk::FrequencyShrinkImageFilter<ComplexImageType>;
+  auto shrinkFilter = ShrinkFilterType::New();
+  shrinkFilter->SetInput(fftFilter->GetOutput());
+  shrinkFilter->SetShrinkFactors(2);
+  shrinkFilter->Update();
+
+  auto halfShrinkFilter = ShrinkFilterType::New();
+  halfShrinkFilter->SetInput(halfFFTFilter->GetOutput());
+  halfShrinkFilter->SetShrinkFactors(2);
+  ITK_TEST_SET_GET_BOOLEAN(halfShrinkFilter, HalfHermitian, true);
+  ITK_TEST_SET_GET_BOOLEAN(halfShrinkFilter, ActualXDimensionIsOdd, actualXDimensionIsOdd);
+  halfShrinkFilter->Update();
+  testPassed &= halfIsCropOfFull<ComplexImageType>(shrinkFilter->GetOutput(), halfShrinkFilter->GetOutput(), "Shrink");
+
+  auto bandShrinkFilter = ShrinkFilterType::New();
+  bandShrinkFilter->SetInput(fftFilter->GetOutput());
+  bandShrinkFilter->ApplyBandFilterOn();
+  bandShrinkFilter->Update();
+
+  auto halfBandShrinkFilter = ShrinkFilterType::New();
+  halfBandShrinkFilter->SetInput(halfFFTFilter->GetOutput());
+  halfBandShrinkFilter->ApplyBandFilterOn();
+  halfBandShrinkFilter->SetHalfHermitian(true);
+  halfBandShrinkFilter->SetActualXDimensionIsOdd(actualXDimensionIsOdd);
+  halfBandShrinkFilter->Update();
+  testPassed &= halfIsCropOfFull<ComplexImageType>(
+    bandShrinkFilter->GetOutput(), halfBandShrinkFilter->GetOutput(), "Shrink with band filter");
+
+  using ExpandFilterType = itk::FrequencyExpandImageFilter<ComplexImageType>;
+  auto expandFilter = ExpandFilterType::New();
+  expandFilter->SetInput(fftFilter->GetOutput());
+  expandFilter->SetExpandFactors(2);
+  expandFilter->Update();
+
+  auto halfExpandFilter = ExpandFilterType::New();
+  halfExpandFilter->SetInput(halfFFTFilter->GetOutput());
+  halfExpandFilter->SetExpandFactors(2);
+  ITK_TEST_SET_GET_BOOLEAN(halfExpandFilter, HalfHermitian, true);
+  ITK_TEST_SET_GET_BOOLEAN(halfExpandFilter, ActualXDimensionIsOdd, actualXDimensionIsOdd);
+  halfExpandFilter->Update();
+  testPassed &= halfIsCropOfFull<ComplexImageType>(expandFilter->GetOutput(), halfExpandFilter->GetOutput(), "Expand");
+
+  // Filter bank.
+  using WaveletFunctionType = itk::HeldIsotropicWavelet<>;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator<ComplexImageType, WaveletFunctionType>;
+  auto filterBank = WaveletFilterBankType::New();
+  filterBank->SetHighPassSubBands(inputBands);
+  filterBank->SetSize(fftFilter->GetOutput()->GetLargestPossibleRegion().GetSize());
+  filterBank->Update();
+
+  auto halfFilterBank = WaveletFilterBankType::New();
+  halfFilterBank->SetHighPassSubBands(inputBands);
+  halfFilterBank->SetSize(halfFFTFilter->GetOutput()->GetLargestPossibleRegion().GetSize());
+  ITK_TEST_SET_GET_BOOLEAN(halfFilterBank, HalfHermitian, true);
+  ITK_TEST_SET_GET_BOOLEAN(halfFilterBank, ActualXDimensionIsOdd, actualXDimensionIsOdd);
+  halfFilterBank->Update();
+  for (unsigned int band = 0; band < inputBands + 1; ++band)
+  {
+    testPassed &= halfIsCropOfFull<ComplexImageType>(
+      filterBank->GetOutput(band), halfFilterBank->GetOutput(band), "FilterBank output " + std::to_string(band));
+  }
+
+  // Forward, with the default pipeline and the fused engines.
+  using ForwardWaveletType = itk::WaveletFrequencyForward<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetHighPassSubBands(inputBands);
+  forwardWavelet->SetLevels(inputLevels);
+  forwardWavelet->SetInput(fftFilter->GetOutput());
+  forwardWavelet->Update();
+
+  for (unsigned int engine = 0; engine < 3; ++engine)
+  {
+    auto halfForwardWavelet = ForwardWaveletType::New();
+    halfForwardWavelet->SetHighPassSubBands(inputBands);
+    halfForwardWavelet->SetLevels(inputLevels);
+    halfForwardWavelet->SetInput(halfFFTFilter->GetOutput());
+    ITK_TEST_SET_GET_BOOLEAN(halfForwardWavelet, HalfHermitian, true);
+    ITK_TEST_SET_GET_BOOLEAN(halfForwardWavelet, ActualXDimensionIsOdd, actualXDimensionIsOdd);
+    halfForwardWavelet->SetUseFusedKernel(engine == 1);
+    halfForwardWavelet->SetUseVirtualFilterBank(engine == 2);
+    halfForwardWavelet->Update();
+
+    for (unsigned int nOutput = 0; nOutput < forwardWavelet->GetTotalOutputs(); ++nOutput)
+    {
+      testPassed &= halfIsCropOfFull<ComplexImageType>(forwardWavelet->GetOutput(nOutput),
+                                                       halfForwardWavelet->GetOutput(nOutput),
+                                                       "Forward engine " + std::to_string(engine) + " output " +
+                                                         std::to_string(nOutput));
+    }
+  }
+
+  // Inverse. The first dimension of the full spectrum of each level has to be divisible by the scale factor.
+  if (actualXDimensionIsOdd)
+  {
+    testPassed &=
+      inverseThrowsWithOddWidth<ImageType, WaveletFilterBankType>(reader->GetOutput(), inputLevels, inputBands);
+  }
+  else
+  {
+    // Crop one column to get an odd first dimension.
+    using ROIFilterType = itk::RegionOfInterestImageFilter<ImageType, ImageType>;
+    auto oddRegion = reader->GetOutput()->GetLargestPossibleRegion();
+    oddRegion.SetSize(0, oddRegion.GetSize(0) - 1);
+    auto roiFilter = ROIFilterType::New();
+    roiFilter->SetInput(reader->GetOutput());
+    roiFilter->SetRegionOfInterest(oddRegion);
+    roiFilter->Update();
+    testPassed &=
+      inverseThrowsWithOddWidth<ImageType, WaveletFilterBankType>(roiFilter->GetOutput(), inputLevels, inputBands);
+
+    auto halfForwardWavelet = ForwardWaveletType::New();
+    halfForwardWavelet->SetHighPassSubBands(inputBands);
+    halfForwardWavelet->SetLevels(inputLevels);
+    halfForwardWavelet->SetInput(halfFFTFilter->GetOutput());
+    halfForwardWavelet->HalfHermitianOn();
+    halfForwardWavelet->Update();
+
+    using InverseWaveletType = itk::WaveletFrequencyInverse<ComplexImageType, ComplexImageType, WaveletFilterBankType>;
+    auto inverseWavelet = InverseWaveletType::New();
+    inverseWavelet->SetHighPassSubBands(inputBands);
+    inverseWavelet->SetLevels(inputLevels);
+    inverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+    inverseWavelet->Update();
+
+    for (unsigned int engine = 0; engine < 3; ++engine)
+    {
+      auto halfInverseWavelet = InverseWaveletType::New();
+      halfInverseWavelet->SetHighPassSubBands(inputBands);
+      halfInverseWavelet->SetLevels(inputLevels);
+      halfInverseWavelet->SetInputs(halfForwardWavelet->GetOutputs());
+      ITK_TEST_SET_GET_BOOLEAN(halfInverseWavelet, HalfHermitian, true);
+      ITK_TEST_SET_GET_BOOLEAN(halfInverseWavelet, ActualXDimensionIsOdd, false);
+      halfInverseWavelet->SetUseFusedKernel(engine == 1);
+      halfInverseWavelet->SetUseVirtualFilterBank(engine == 2);
+      halfInverseWavelet->Update();
+
+      testPassed &= halfIsCropOfFull<ComplexImageType>(
+        inverseWavelet->GetOutput(), halfInverseWavelet->GetOutput(), "Inverse engine " + std::to_string(engine));
+    }
+  }
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+int
+itkWaveletFrequencyHalfHermitianTest(int argc, char * argv[])
+{
+  if (argc < 4 || argc > 5)
+  {
+    std::cerr << "Usage: " << argv[0] << " inputImage inputLevels inputBands [dimension]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string  inputImage = argv[1];
+  const unsigned int inputLevels = std::stoi(argv[2]);
+  const unsigned int inputBands = std::stoi(argv[3]);
+
+  unsigned int dimension = 3;
+  if (argc == 5)
+  {
+    dimension = std::stoi(argv[4]);
+  }
+
+  if (dimension == 2)
+  {
+    return runWaveletFrequencyHalfHermitianTest<2>(inputImage, inputLevels, inputBands);
+  }
+  else if (dimension == 3)
+  {
+    return runWaveletFrequencyHalfHermitianTest<3>(inputImage, inputLevels, inputBands);
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Error: only 2 or 3 dimensions allowed, " << dimension << " selected." << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,266 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkForwardFFTImageFilter.h"
+#include "itkInverseFFTImageFilter.h"
+#include "itkHeldIsotropicWavelet.h"
+#include "itkWaveletFrequencyFilterBankGenerator.h"
+#include "itkWaveletFrequencyForward.h"
+#include "itkWaveletFrequencyInverse.h"
+#include "itkWaveletFrequencyForwardUndecimated.h"
+#include "itkWaveletFrequencyInverseUndecimated.h"
+#include "itkMonogenicSignalFrequencyImageFilter.h"
+#include "itkVectorInverseFFTImageFilter.h"
+#include "itkPhaseAnalysisSoftThresholdImageFilter.h"
+#include "itkVectorIndexSelectionCastImageFilter.h"
+#include "itkStructureTensor.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMinimumMaximumImageCalculator.h"
+#include "itkIsotropicWaveletTestUtilities.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using RealImageType = itk::Image<double, Dimension>;
+using ComplexImageType = itk::Image<std::complex<double>, Dimension>;
+
+constexpr unsigned int levels = 2;
+constexpr unsigned int bands = 2;
+
+/** Results of the pipeline, cast to double to compare the float pipeline with the double one. */
+struct PipelineResults
+{
+  std::vector<ComplexImageType::Pointer> coefficients;
+  RealImageType::Pointer                 reconstruction;
+  RealImageType::Pointer                 fusedReconstruction;
+  std::vector<ComplexImageType::Pointer> undecimatedCoefficients;
+  RealImageType::Pointer                 undecimatedReconstruction;
+  RealImageType::Pointer                 amplitude;
+  RealImageType::Pointer                 phase;
+  RealImageType::Pointer                 largestEigenValue;
+};
+
+template <typename TOutputImage, typename TInputImage>
+typename TOutputImage::Pointer
+castImage(const TInputImage * image)
+{
+  using CastType = itk::CastImageFilter<TInputImage, TOutputImage>;
+  auto cast = CastType::New();
+  cast->SetInput(image);
+  cast->Update();
+  return cast->GetOutput();
+}
+
+/** Same pipeline with TPixel as the pixel type of every image, and of the wavelet function. */
+template <typename TPixel>
+PipelineResults
+runPipeline(const RealImageType * inputDouble)
+{
+  using PixelImageType = itk::Image<TPixel, Dimension>;
+  using FFTForwardType = itk::ForwardFFTImageFilter<PixelImageType>;
+  using PixelComplexImageType = typename FFTForwardType::OutputImageType;
+  using InverseFFTType = itk::InverseFFTImageFilter<PixelComplexImageType, PixelImageType>;
+  using WaveletFunctionType = itk::HeldIsotropicWavelet<TPixel, Dimension>;
+  using WaveletFilterBankType = itk::WaveletFrequencyFilterBankGenerator<PixelComplexImageType, WaveletFunctionType>;
+  using ForwardWaveletType =
+    itk::WaveletFrequencyForward<PixelComplexImageType, PixelComplexImageType, WaveletFilterBankType>;
+  using InverseWaveletType =
+    itk::WaveletFrequencyInverse<PixelComplexImageType, PixelComplexImageType, WaveletFilterBankType>;
+  using ForwardUndecimatedType =
+    itk::WaveletFrequencyForwardUndecimated<PixelComplexImageType, PixelComplexImageType, WaveletFilterBankType>;
+  using InverseUndecimatedType =
+    itk::WaveletFrequencyInverseUndecimated<PixelComplexImageType, PixelComplexImageType, WaveletFilterBankType>;
+  using MonogenicFilterType = itk::MonogenicSignalFrequencyImageFilter<PixelComplexImageType>;
+  using VectorInverseFFTType = itk::VectorInverseFFTImageFilter<typename MonogenicFilterType::OutputImageType>;
+  using VectorImageType = typename VectorInverseFFTType::OutputImageType;
+  using PhaseAnalysisType = itk::PhaseAnalysisSoftThresholdImageFilter<VectorImageType>;
+  using PhaseImageType = typename PhaseAnalysisType::OutputImageType;
+  using ComponentSelectionType = itk::VectorIndexSelectionCastImageFilter<VectorImageType, PixelImageType>;
+  using StructureTensorType = itk::StructureTensor<PixelImageType>;
+
+  PipelineResults results;
+  const auto      input = castImage<PixelImageType>(inputDouble);
+
+  auto forwardFFT = FFTForwardType::New();
+  forwardFFT->SetInput(input);
+  forwardFFT->Update();
+
+  auto forwardWavelet = ForwardWaveletType::New();
+  forwardWavelet->SetHighPassSubBands(bands);
+  forwardWavelet->SetLevels(levels);
+  forwardWavelet->SetInput(forwardFFT->GetOutput());
+  forwardWavelet->Update();
+  for (const auto & coefficient : forwardWavelet->GetOutputs())
+  {
+    results.coefficients.push_back(castImage<ComplexImageType>(coefficient.GetPointer()));
+  }
+
+  for (const bool useFusedKernel : { false, true })
+  {
+    auto inverseWavelet = InverseWaveletType::New();
+    inverseWavelet->SetHighPassSubBands(bands);
+    inverseWavelet->SetLevels(levels);
+    inverseWavelet->SetInputs(forwardWavelet->GetOutputs());
+    inverseWavelet->SetUseFusedKernel(useFusedKernel);
+    auto inverseFFT = InverseFFTType::New();
+    inverseFFT->SetInput(inverseWavelet->GetOutput());
+    inverseFFT->Update();
+    (useFusedKernel ? results.fusedReconstruction : results.reconstruction) =
+      castImage<RealImageType>(inverseFFT->GetOutput());
+  }
+
+  auto forwardUndecimated = ForwardUndecimatedType::New();
+  forwardUndecimated->SetHighPassSubBands(bands);
+  forwardUndecimated->SetLevels(levels);
+  forwardUndecimated->SetInput(forwardFFT->GetOutput());
+  forwardUndecimated->Update();
+  for (const auto & coefficient : forwardUndecimated->GetOutputs())
+  {
+    results.undecimatedCoefficients.push_back(castImage<ComplexImageType>(coefficient.GetPointer()));
+  }
+  auto inverseUndecimated = InverseUndecimatedType::New();
+  inverseUndecimated->SetHighPassSubBands(bands);
+  inverseUndecimated->SetLevels(levels);
+  inverseUndecimated->SetInputs(forwardUndecimated->GetOutputs());
+  auto inverseUndecimatedFFT = InverseFFTType::New();
+  inverseUndecimatedFFT->SetInput(inverseUndecimated->GetOutput());
+  inverseUndecimatedFFT->Update();
+  results.undecimatedReconstruction = castImage<RealImageType>(inverseUndecimatedFFT->GetOutput());
+
+  // Phase analysis and structure tensor of the monogenic signal of the first band.
+  auto monogenic = MonogenicFilterType::New();
+  monogenic->SetInput(forwardUndecimated->GetOutput(0));
+  auto vectorInverseFFT = VectorInverseFFTType::New();
+  vectorInverseFFT->SetInput(monogenic->GetOutput());
+  vectorInverseFFT->Update();
+
+  auto phaseAnalysis = PhaseAnalysisType::New();
+  phaseAnalysis->SetInput(vectorInverseFFT->GetOutput());
+  phaseAnalysis->SetApplySoftThreshold(false);
+  phaseAnalysis->Update();
+  results.amplitude = castImage<RealImageType, PhaseImageType>(phaseAnalysis->GetOutputAmplitude());
+  results.phase = castImage<RealImageType, PhaseImageType>(phaseAnalysis->GetOutputPhase());
+
+  typename StructureTensorType::InputsType rieszComponents;
+  for (unsigned int component = 1; component < Dimension + 1; ++component)
+  {
+    auto selection = ComponentSelectionType::New();
+    selection->SetInput(vectorInverseFFT->GetOutput());
+    selection->SetIndex(component);
+    selection->Update();
+    rieszComponents.push_back(selection->GetOutput());
+  }
+  auto structureTensor = StructureTensorType::New();
+  structureTensor->SetInputs(rieszComponents);
+  structureTensor->Update();
+  results.largestEigenValue = RealImageType::New();
+  results.largestEigenValue->CopyInformation(inputDouble);
+  results.largestEigenValue->SetRegions(inputDouble->GetLargestPossibleRegion());
+  results.largestEigenValue->Allocate();
+  itk::ImageRegionConstIterator<typename StructureTensorType::OutputImageType> tensorIt(
+    structureTensor->GetOutput(), structureTensor->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<RealImageType> eigenIt(results.largestEigenValue,
+                                                  results.largestEigenValue->GetLargestPossibleRegion());
+  for (; !tensorIt.IsAtEnd(); ++tensorIt, ++eigenIt)
+  {
+    eigenIt.Set(tensorIt.Get()(Dimension - 1, Dimension));
+  }
+
+  return results;
+}
+
+/** Phase only has meaning where the amplitude is not negligible. */
+bool
+phasesAreClose(const PipelineResults & reference, const PipelineResults & test, const double & tolerance)
+{
+  using MinimumMaximumType = itk::MinimumMaximumImageCalculator<RealImageType>;
+  auto amplitudeRange = MinimumMaximumType::New();
+  amplitudeRange->SetImage(reference.amplitude);
+  amplitudeRange->ComputeMaximum();
+  const double amplitudeThreshold = 1e-2 * amplitudeRange->GetMaximum();
+  double       maxDiff = 0.0;
+  itk::ImageRegionConstIterator<RealImageType> ampIt(reference.amplitude,
+                                                     reference.amplitude->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<RealImageType> refIt(reference.phase, reference.phase->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<RealImageType> testIt(test.phase, test.phase->GetLargestPossibleRegion());
+  for (; !refIt.IsAtEnd(); ++ampIt, ++refIt, ++testIt)
+  {
+    if (ampIt.Get() > amplitudeThreshold)
+    {
+      maxDiff = std::max(maxDiff, std::abs(refIt.Get() - testIt.Get()));
+    }
+  }
+  std::cout << "Phase: max difference " << maxDiff << " (tolerance " << tolerance << ")" << std::endl;
+  if (maxDiff > tolerance)
+  {
+    std::cerr << "Phase: the single precision result differs from the double precision one." << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkWaveletFrequencySinglePrecisionTest(int, char *[])
+{
+  bool testPassed = true;
+
+  RealImageType::SizeType size;
+  size.Fill(32);
+  const auto input = itk::Testing::CreateSyntheticImage<RealImageType>(size, 0.4);
+  const auto reference = runPipeline<double>(input);
+  const auto single = runPipeline<float>(input);
+
+  // Documented bounds of the single precision pipeline, see README.
+  const double relativeTolerance = 1e-4;
+  const double phaseTolerance = 1e-3;
+  testPassed &= itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(
+    reference.coefficients, single.coefficients, relativeTolerance);
+  testPassed &= itk::Testing::AllImagesAreAlmostEqual<ComplexImageType>(
+    reference.undecimatedCoefficients, single.undecimatedCoefficients, relativeTolerance);
+  testPassed &= itk::Testing::ImagesAreAlmostEqual<RealImageType>(
+    reference.reconstruction, single.reconstruction, relativeTolerance);
+  testPassed &= itk::Testing::ImagesAreAlmostEqual<RealImageType>(
+    reference.fusedReconstruction, single.fusedReconstruction, relativeTolerance);
+  // Both engines of the decimated inverse accumulate the bands in double, only the expansion of the low pass differs.
+  testPassed &=
+    itk::Testing::ImagesAreAlmostEqual<RealImageType>(single.fusedReconstruction, single.reconstruction, 1e-5);
+  testPassed &= itk::Testing::ImagesAreAlmostEqual<RealImageType>(
+    reference.undecimatedReconstruction, single.undecimatedReconstruction, relativeTolerance);
+  testPassed &=
+    itk::Testing::ImagesAreAlmostEqual<RealImageType>(reference.amplitude, single.amplitude, relativeTolerance);
+  testPassed &= phasesAreClose(reference, single, phaseTolerance);
+  testPassed &= itk::Testing::ImagesAreAlmostEqual<RealImageType>(
+    reference.largestEigenValue, single.largestEigenValue, relativeTolerance);
+
+  if (testPassed)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+}